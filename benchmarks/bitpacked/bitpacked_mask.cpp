@@ -0,0 +1,199 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <type_traits>
+
+#include "fill.hpp"
+
+//================================================================================
+
+// 3D occupancy masks stored one bit per cell (bitpacked_accessor) and one
+// byte per cell (mdspan<bool>), through the same algorithms.
+
+using bool_accessor = stdex::default_accessor<bool>;
+using bit_accessor = stdex::bitpacked_accessor<uint64_t>;
+
+template <class Accessor>
+using mask_3d = stdex::mdspan<typename Accessor::element_type, stdex::dextents<3>, stdex::layout_right, Accessor>;
+
+template <class Accessor>
+struct mask_storage;
+
+template <>
+struct mask_storage<bool_accessor> {
+  static std::unique_ptr<bool[]> allocate(size_t n) { return std::make_unique<bool[]>(n); }
+  static size_t bytes(size_t n) { return n; }
+};
+
+template <>
+struct mask_storage<bit_accessor> {
+  static std::unique_ptr<uint64_t[]> allocate(size_t n) { return std::make_unique<uint64_t[]>(bit_accessor::words_for(n)); }
+  static size_t bytes(size_t n) { return bit_accessor::words_for(n) * sizeof(uint64_t); }
+};
+
+// Random occupancy with the given fraction of occupied cells
+template <class Mask>
+void fill_occupancy(Mask m, double fraction, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::bernoulli_distribution dist(fraction);
+  for(size_t i = 0; i < m.extent(0); ++i) {
+    for(size_t j = 0; j < m.extent(1); ++j) {
+      for(size_t k = 0; k < m.extent(2); ++k) {
+        m(i, j, k) = dist(gen);
+      }
+    }
+  }
+}
+
+//================================================================================
+
+template <class Accessor>
+void BM_MDSpan_Mask_Count(benchmark::State& state, Accessor, size_t n) {
+  auto buffer = mask_storage<Accessor>::allocate(n * n * n);
+  auto m = mask_3d<Accessor>(buffer.get(), n, n, n);
+  fill_occupancy(m, 0.3, 1234);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m.data());
+    auto count = stdex::mask_count(m);
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(n * n * n * state.iterations());
+  state.SetBytesProcessed(mask_storage<Accessor>::bytes(n * n * n) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_Count, bitpacked_512, bit_accessor(), 512);
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_Count, bool_512, bool_accessor(), 512);
+
+template <class Accessor>
+void BM_MDSpan_Mask_All(benchmark::State& state, Accessor, size_t n) {
+  // all set, so mask_all has to look at every cell
+  auto buffer = mask_storage<Accessor>::allocate(n * n * n);
+  auto m = mask_3d<Accessor>(buffer.get(), n, n, n);
+  fill_occupancy(m, 1.0, 1234);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(m.data());
+    bool all = stdex::mask_all(m);
+    benchmark::DoNotOptimize(all);
+  }
+  state.SetItemsProcessed(n * n * n * state.iterations());
+  state.SetBytesProcessed(mask_storage<Accessor>::bytes(n * n * n) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_All, bitpacked_512, bit_accessor(), 512);
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_All, bool_512, bool_accessor(), 512);
+
+template <class Accessor>
+void BM_MDSpan_Mask_And(benchmark::State& state, Accessor, size_t n) {
+  auto buffer_a = mask_storage<Accessor>::allocate(n * n * n);
+  auto buffer_b = mask_storage<Accessor>::allocate(n * n * n);
+  auto buffer_o = mask_storage<Accessor>::allocate(n * n * n);
+  auto a = mask_3d<Accessor>(buffer_a.get(), n, n, n);
+  auto b = mask_3d<Accessor>(buffer_b.get(), n, n, n);
+  auto o = mask_3d<Accessor>(buffer_o.get(), n, n, n);
+  fill_occupancy(a, 0.3, 1234);
+  fill_occupancy(b, 0.5, 4321);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    benchmark::DoNotOptimize(b.data());
+    stdex::mask_and(a, b, o);
+    benchmark::DoNotOptimize(o.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(n * n * n * state.iterations());
+  state.SetBytesProcessed(3 * mask_storage<Accessor>::bytes(n * n * n) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_And, bitpacked_512, bit_accessor(), 512);
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_And, bool_512, bool_accessor(), 512);
+
+// Element-wise writes: mark the cells inside a sphere, through the bit proxy
+// for the bit-packed mask
+template <class Accessor>
+void BM_MDSpan_Mask_Sphere(benchmark::State& state, Accessor, size_t n) {
+  auto buffer = mask_storage<Accessor>::allocate(n * n * n);
+  auto m = mask_3d<Accessor>(buffer.get(), n, n, n);
+  long c = long(n / 2), r2 = c * c;
+  for (auto _ : state) {
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        for(size_t k = 0; k < n; ++k) {
+          long di = long(i) - c, dj = long(j) - c, dk = long(k) - c;
+          m(i, j, k) = di * di + dj * dj + dk * dk <= r2;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(m.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(n * n * n * state.iterations());
+  state.SetBytesProcessed(mask_storage<Accessor>::bytes(n * n * n) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_Sphere, bitpacked_512, bit_accessor(), 512);
+BENCHMARK_CAPTURE(BM_MDSpan_Mask_Sphere, bool_512, bool_accessor(), 512);
+
+//================================================================================
+
+void BM_Raw_Bool_Count(benchmark::State& state, size_t n) {
+  auto buffer = std::make_unique<bool[]>(n * n * n);
+  fill_occupancy(mask_3d<bool_accessor>(buffer.get(), n, n, n), 0.3, 1234);
+  bool const* p = buffer.get();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p);
+    size_t count = 0;
+    for(size_t i = 0; i < n * n * n; ++i) {
+      count += p[i];
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(n * n * n * state.iterations());
+  state.SetBytesProcessed(n * n * n * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Raw_Bool_Count, bool_512, 512);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,310 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "fill.hpp"
+
+//================================================================================
+
+// Emulates ScaLAPACK-style PDGEMM (C += A * B) over a P x Q grid of worker
+// processes on a single node.  Every process keeps its block-cyclic local
+// parts of A, B, and C in one shared anonymous mapping, so "communication" of
+// the A and B panels is just reading another process's local storage through
+// the owner's layout_block_cyclic mapping.  No network or MPI is needed.
+
+static constexpr size_t block_size = 32;
+
+using layout_bc = stdex::layout_block_cyclic<block_size, block_size>;
+using bc_mapping = layout_bc::mapping<stdex::dextents<2>>;
+template <class T>
+using bc_mdspan = stdex::mdspan<T, stdex::dextents<2>, layout_bc>;
+
+struct shared_control {
+  pthread_barrier_t start;
+  pthread_barrier_t done;
+  bool shutdown;
+};
+
+template <class T>
+class block_cyclic_gemm_fixture {
+public:
+
+  block_cyclic_gemm_fixture(size_t nprow, size_t npcol, size_t n)
+    : nprow_(nprow), npcol_(npcol), exts_(n, n)
+  {
+    size_t nprocs = nprow * npcol;
+    size_t offset = 0;
+    for(size_t p = 0; p < nprow; ++p) {
+      for(size_t q = 0; q < npcol; ++q) {
+        auto map = bc_mapping(exts_, {{nprow, npcol}}, {{p, q}});
+        local_offsets_.push_back(offset);
+        offset += map.required_span_size();
+      }
+    }
+    elements_per_matrix_ = offset;
+    bytes_ = sizeof(shared_control) + 3 * elements_per_matrix_ * sizeof(T);
+    void* seg = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(seg == MAP_FAILED) throw std::runtime_error("mmap of the shared segment failed");
+    segment_ = static_cast<char*>(seg);
+
+    control_ = new (segment_) shared_control{};
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&control_->start, &attr, unsigned(nprocs + 1));
+    pthread_barrier_init(&control_->done, &attr, unsigned(nprocs + 1));
+    pthread_barrierattr_destroy(&attr);
+
+    // Fill through the block-cyclic views so that the data is
+    // independent of the process grid
+    for(size_t p = 0; p < nprow; ++p) {
+      for(size_t q = 0; q < npcol; ++q) {
+        auto a = local_A(p, q), b = local_B(p, q), c = local_C(p, q);
+        auto map = a.mapping();
+        auto lexts = map.local_extents();
+        for(size_t lj = 0; lj < lexts.extent(1); ++lj) {
+          for(size_t li = 0; li < lexts.extent(0); ++li) {
+            auto g = map.global_index(li, lj);
+            a(g[0], g[1]) = T((g[0] + 2 * g[1]) % 7) / T(7);
+            b(g[0], g[1]) = T((3 * g[0] + g[1]) % 5) / T(5);
+            c(g[0], g[1]) = T(0);
+          }
+        }
+      }
+    }
+  }
+
+  ~block_cyclic_gemm_fixture() {
+    if(!workers_.empty()) {
+      control_->shutdown = true;
+      pthread_barrier_wait(&control_->start);
+      for(auto pid : workers_) waitpid(pid, nullptr, 0);
+    }
+    pthread_barrier_destroy(&control_->start);
+    pthread_barrier_destroy(&control_->done);
+    munmap(segment_, bytes_);
+  }
+
+  bc_mapping local_mapping(size_t p, size_t q) const {
+    return bc_mapping(exts_, {{nprow_, npcol_}}, {{p, q}});
+  }
+
+  T* local_data(size_t matrix, size_t p, size_t q) const {
+    T* base = reinterpret_cast<T*>(segment_ + sizeof(shared_control));
+    return base + matrix * elements_per_matrix_ + local_offsets_[p * npcol_ + q];
+  }
+
+  bc_mdspan<T> local_A(size_t p, size_t q) const { return { local_data(0, p, q), local_mapping(p, q) }; }
+  bc_mdspan<T> local_B(size_t p, size_t q) const { return { local_data(1, p, q), local_mapping(p, q) }; }
+  bc_mdspan<T> local_C(size_t p, size_t q) const { return { local_data(2, p, q), local_mapping(p, q) }; }
+
+  size_t extent() const { return exts_.extent(0); }
+
+  template <class Kernel>
+  void launch(Kernel kernel) {
+    for(size_t p = 0; p < nprow_; ++p) {
+      for(size_t q = 0; q < npcol_; ++q) {
+        pid_t pid = fork();
+        if(pid < 0) throw std::runtime_error("fork failed");
+        if(pid == 0) {
+          while(true) {
+            pthread_barrier_wait(&control_->start);
+            if(control_->shutdown) _exit(0);
+            kernel(*this, p, q);
+            pthread_barrier_wait(&control_->done);
+          }
+        }
+        workers_.push_back(pid);
+      }
+    }
+  }
+
+  void run_once() {
+    pthread_barrier_wait(&control_->start);
+    pthread_barrier_wait(&control_->done);
+  }
+
+private:
+  size_t nprow_, npcol_;
+  stdex::dextents<2> exts_;
+  std::vector<size_t> local_offsets_;
+  size_t elements_per_matrix_ = 0;
+  size_t bytes_ = 0;
+  char* segment_ = nullptr;
+  shared_control* control_ = nullptr;
+  std::vector<pid_t> workers_;
+};
+
+//================================================================================
+
+// Local update on process (p, q): for every k-panel, read A(:, k-panel) from
+// process (p, kb % Q) and B(k-panel, :) from process (kb % P, q), and
+// accumulate into the locally owned blocks of C.
+template <class T>
+void mdspan_local_gemm_update(block_cyclic_gemm_fixture<T> const& f, size_t p, size_t q) {
+  auto C = f.local_C(p, q);
+  auto grid = C.mapping().grid_shape();
+  size_t n = f.extent();
+  size_t num_k_blocks = (n + block_size - 1) / block_size;
+  for(size_t kb = 0; kb < num_k_blocks; ++kb) {
+    auto A = f.local_A(p, kb % grid[1]);
+    auto B = f.local_B(kb % grid[0], q);
+    size_t k_end = std::min(n, (kb + 1) * block_size);
+    for(size_t jb = q; jb * block_size < n; jb += grid[1]) {
+      size_t j_end = std::min(n, (jb + 1) * block_size);
+      for(size_t ib = p; ib * block_size < n; ib += grid[0]) {
+        size_t i_end = std::min(n, (ib + 1) * block_size);
+        for(size_t j = jb * block_size; j < j_end; ++j) {
+          for(size_t k = kb * block_size; k < k_end; ++k) {
+            T b_kj = B(k, j);
+            for(size_t i = ib * block_size; i < i_end; ++i) {
+              C(i, j) += A(i, k) * b_kj;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Same algorithm with the global-to-local index arithmetic written out by hand
+template <class T>
+void raw_local_gemm_update(block_cyclic_gemm_fixture<T> const& f, size_t p, size_t q) {
+  auto c_map = f.local_mapping(p, q);
+  auto grid = c_map.grid_shape();
+  size_t n = f.extent();
+  size_t ldc = c_map.local_extents().extent(0);
+  T* C = f.local_data(2, p, q);
+  size_t num_k_blocks = (n + block_size - 1) / block_size;
+  for(size_t kb = 0; kb < num_k_blocks; ++kb) {
+    size_t a_q = kb % grid[1];
+    size_t b_p = kb % grid[0];
+    T const* A = f.local_data(0, p, a_q);
+    T const* B = f.local_data(1, b_p, q);
+    size_t lda = f.local_mapping(p, a_q).local_extents().extent(0);
+    size_t ldb = f.local_mapping(b_p, q).local_extents().extent(0);
+    size_t k_len = std::min(n, (kb + 1) * block_size) - kb * block_size;
+    // local block-column of the k panel in A and local block-row in B
+    size_t a_col0 = (kb / grid[1]) * block_size;
+    size_t b_row0 = (kb / grid[0]) * block_size;
+    for(size_t jb = q, ljb = 0; jb * block_size < n; jb += grid[1], ++ljb) {
+      size_t j_len = std::min(n, (jb + 1) * block_size) - jb * block_size;
+      for(size_t ib = p, lib = 0; ib * block_size < n; ib += grid[0], ++lib) {
+        size_t i_len = std::min(n, (ib + 1) * block_size) - ib * block_size;
+        for(size_t j = 0; j < j_len; ++j) {
+          size_t lj = ljb * block_size + j;
+          for(size_t k = 0; k < k_len; ++k) {
+            T b_kj = B[(b_row0 + k) + lj * ldb];
+            T const* a_col = A + lib * block_size + (a_col0 + k) * lda;
+            T* c_col = C + lib * block_size + lj * ldc;
+            for(size_t i = 0; i < i_len; ++i) {
+              c_col[i] += a_col[i] * b_kj;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+//================================================================================
+
+template <class T>
+void BM_MDSpan_BlockCyclic_GEMM(benchmark::State& state, T, size_t nprow, size_t npcol, size_t n) {
+  block_cyclic_gemm_fixture<T> f(nprow, npcol, n);
+  f.launch([](block_cyclic_gemm_fixture<T> const& fx, size_t p, size_t q) {
+    mdspan_local_gemm_update(fx, p, q);
+  });
+  for (auto _ : state) {
+    f.run_once();
+  }
+  state.counters["processes"] = double(nprow * npcol);
+  state.counters["FLOPS"] = benchmark::Counter(
+    2.0 * double(n) * double(n) * double(n),
+    benchmark::Counter::kIsIterationInvariantRate
+  );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_BlockCyclic_GEMM, grid_1x1_512, double(), 1, 1, 512)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_BlockCyclic_GEMM, grid_2x1_512, double(), 2, 1, 512)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_BlockCyclic_GEMM, grid_2x2_512, double(), 2, 2, 512)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_BlockCyclic_GEMM, grid_2x4_512, double(), 2, 4, 512)->UseRealTime();
+
+//================================================================================
+
+template <class T>
+void BM_Raw_BlockCyclic_GEMM(benchmark::State& state, T, size_t nprow, size_t npcol, size_t n) {
+  block_cyclic_gemm_fixture<T> f(nprow, npcol, n);
+  f.launch([](block_cyclic_gemm_fixture<T> const& fx, size_t p, size_t q) {
+    raw_local_gemm_update(fx, p, q);
+  });
+  for (auto _ : state) {
+    f.run_once();
+  }
+  state.counters["processes"] = double(nprow * npcol);
+  state.counters["FLOPS"] = benchmark::Counter(
+    2.0 * double(n) * double(n) * double(n),
+    benchmark::Counter::kIsIterationInvariantRate
+  );
+}
+BENCHMARK_CAPTURE(BM_Raw_BlockCyclic_GEMM, grid_1x1_512, double(), 1, 1, 512)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Raw_BlockCyclic_GEMM, grid_2x1_512, double(), 2, 1, 512)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Raw_BlockCyclic_GEMM, grid_2x2_512, double(), 2, 2, 512)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Raw_BlockCyclic_GEMM, grid_2x4_512, double(), 2, 4, 512)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
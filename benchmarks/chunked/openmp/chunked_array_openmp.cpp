@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "fill.hpp"
+#include "temp_file.hpp"
+
+//================================================================================
+// Writing and reading a 256^3 float field as 32^3 chunks, in slabs of 64
+// planes, against writing and reading the raw bytes.  Throughput is reported
+// against the raw size; "ratio" is the raw size over the stored size.
+
+using field_extents = stdex::dextents<3>;
+using field_mdspan = stdex::mdspan<float, field_extents>;
+
+constexpr size_t field_size = 256;
+constexpr size_t slab_size = 64;
+constexpr std::array<size_t, 3> chunk_extents = {{32, 32, 32}};
+
+// A smooth field stored with 8 fractional bits, like a quantized checkpoint
+std::unique_ptr<float[]> make_field() {
+  auto buffer = std::make_unique<float[]>(field_size * field_size * field_size);
+  field_mdspan s(buffer.get(), field_size, field_size, field_size);
+  #pragma omp parallel for
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      for(size_t k = 0; k < s.extent(2); ++k) {
+        s(i, j, k) = std::round(256.f * std::sin(0.05f * float(i)) * std::cos(0.03f * float(j + k))) / 256.f;
+      }
+    }
+  }
+  return buffer;
+}
+
+template <class Policy>
+size_t write_chunked(Policy policy, std::string const& path, field_mdspan s, stdex::chunk_codec codec) {
+  stdex::chunked_array_writer<float, 3> writer(path.c_str(), s.extents(), chunk_extents, codec);
+  for(size_t first = 0; first < s.extent(0); first += slab_size) {
+    auto slab = stdex::submdspan(s, std::make_pair(first, first + slab_size), stdex::full_extent, stdex::full_extent);
+    writer.write_slab(policy, slab, first);
+  }
+  writer.close();
+  return writer.stored_bytes();
+}
+
+//================================================================================
+
+template <class Policy>
+void BM_MDSpan_OpenMP_Chunked_Write(benchmark::State& state, Policy policy, stdex::chunk_codec codec) {
+  auto buffer = make_field();
+  field_mdspan s(buffer.get(), field_size, field_size, field_size);
+  auto path = mdspan_benchmark::temp_path("write.chunked");
+  size_t stored = 0;
+  for (auto _ : state) {
+    stored = write_chunked(policy, path, s, codec);
+  }
+  state.SetBytesProcessed(s.size() * sizeof(float) * state.iterations());
+  state.counters["ratio"] = double(s.size() * sizeof(float)) / double(stored);
+  std::remove(path.c_str());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Write, seq_shuffle_rle, stdex::execution::seq, stdex::chunk_codec::shuffle_rle)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Write, par_shuffle_rle, stdex::execution::par, stdex::chunk_codec::shuffle_rle)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Write, par_none, stdex::execution::par, stdex::chunk_codec::none)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+template <class Policy>
+void BM_MDSpan_OpenMP_Chunked_Read(benchmark::State& state, Policy policy, stdex::chunk_codec codec, bool cold) {
+  auto buffer = make_field();
+  field_mdspan s(buffer.get(), field_size, field_size, field_size);
+  auto path = mdspan_benchmark::temp_path("read.chunked");
+  size_t stored = write_chunked(stdex::execution::par, path, s, codec);
+  auto out_buffer = std::make_unique<float[]>(s.size());
+  field_mdspan out(out_buffer.get(), field_size, field_size, field_size);
+  for (auto _ : state) {
+    if(cold) {
+      state.PauseTiming();
+      mdspan_benchmark::evict(path);
+      state.ResumeTiming();
+    }
+    stdex::chunked_array_reader<float, 3> reader(path.c_str());
+    for(size_t first = 0; first < out.extent(0); first += slab_size) {
+      auto slab = stdex::submdspan(out, std::make_pair(first, first + slab_size), stdex::full_extent, stdex::full_extent);
+      reader.read_slab(policy, slab, first);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(float) * state.iterations());
+  state.counters["ratio"] = double(s.size() * sizeof(float)) / double(stored);
+  std::remove(path.c_str());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Read, seq_shuffle_rle, stdex::execution::seq, stdex::chunk_codec::shuffle_rle, false)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Read, par_shuffle_rle, stdex::execution::par, stdex::chunk_codec::shuffle_rle, false)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Read, par_shuffle_rle_cold, stdex::execution::par, stdex::chunk_codec::shuffle_rle, true)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Chunked_Read, par_none_cold, stdex::execution::par, stdex::chunk_codec::none, true)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+void BM_Raw_Write(benchmark::State& state) {
+  auto buffer = make_field();
+  size_t bytes = field_size * field_size * field_size * sizeof(float);
+  auto path = mdspan_benchmark::temp_path("write.raw");
+  for (auto _ : state) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    size_t written = std::fwrite(buffer.get(), 1, bytes, f);
+    std::fclose(f);
+    benchmark::DoNotOptimize(written);
+  }
+  state.SetBytesProcessed(bytes * state.iterations());
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_Raw_Write)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_Raw_Read(benchmark::State& state, bool cold) {
+  auto buffer = make_field();
+  size_t bytes = field_size * field_size * field_size * sizeof(float);
+  auto path = mdspan_benchmark::temp_path("read.raw");
+  std::FILE* f = std::fopen(path.c_str(), "wb");
+  std::fwrite(buffer.get(), 1, bytes, f);
+  std::fclose(f);
+  for (auto _ : state) {
+    if(cold) {
+      state.PauseTiming();
+      mdspan_benchmark::evict(path);
+      state.ResumeTiming();
+    }
+    f = std::fopen(path.c_str(), "rb");
+    size_t read = std::fread(buffer.get(), 1, bytes, f);
+    std::fclose(f);
+    benchmark::DoNotOptimize(read);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(bytes * state.iterations());
+  std::remove(path.c_str());
+}
+BENCHMARK_CAPTURE(BM_Raw_Read, warm, false)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Raw_Read, cold, true)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
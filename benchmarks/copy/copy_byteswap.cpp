@@ -0,0 +1,166 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "fill.hpp"
+
+//================================================================================
+// A 4096 x 4096 float array stored with the opposite byte order, as read
+// from a big-endian file, either viewed in place through byteswap_accessor
+// or converted to native order first.
+
+constexpr size_t n = 4096;
+
+using native_view = stdex::mdspan<float, stdex::dextents<2>>;
+using swapped_view = stdex::mdspan<float const, stdex::dextents<2>, stdex::layout_right, stdex::byteswap_accessor<float const>>;
+
+std::unique_ptr<float[]> make_swapped() {
+  auto data = std::make_unique<float[]>(n * n);
+  mdspan_benchmark::fill_random(native_view(data.get(), n, n));
+  for(size_t i = 0; i < n * n; ++i) {
+    uint32_t u;
+    std::memcpy(&u, &data[i], 4);
+    u = __builtin_bswap32(u);
+    std::memcpy(&data[i], &u, 4);
+  }
+  return data;
+}
+
+template <class MDSpan>
+float sum_2d(MDSpan s) {
+  float sum = 0;
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      sum += s(i, j);
+    }
+  }
+  return sum;
+}
+
+// The element loop the bulk copy replaces
+void swap_scalar(float const* src, float* dst, size_t count) {
+  for(size_t i = 0; i < count; ++i) {
+    uint32_t u;
+    std::memcpy(&u, &src[i], 4);
+    u = __builtin_bswap32(u);
+    std::memcpy(&dst[i], &u, 4);
+  }
+}
+
+//================================================================================
+
+void BM_MDSpan_Byteswap_Sum(benchmark::State& state) {
+  auto swapped = make_swapped();
+  swapped_view s(swapped.get(), n, n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swapped.get());
+    benchmark::DoNotOptimize(sum_2d(s));
+  }
+  state.SetBytesProcessed(n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_MDSpan_Byteswap_Sum);
+
+void BM_Raw_SwapThenView_Sum(benchmark::State& state) {
+  auto swapped = make_swapped();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swapped.get());
+    auto native = std::make_unique<float[]>(n * n);
+    swap_scalar(swapped.get(), native.get(), n * n);
+    benchmark::DoNotOptimize(sum_2d(native_view(native.get(), n, n)));
+  }
+  state.SetBytesProcessed(n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_Raw_SwapThenView_Sum);
+
+void BM_MDSpan_Byteswap_CopyThenView_Sum(benchmark::State& state) {
+  auto swapped = make_swapped();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swapped.get());
+    auto native = std::make_unique<float[]>(n * n);
+    native_view dst(native.get(), n, n);
+    stdex::copy(swapped_view(swapped.get(), n, n), dst);
+    benchmark::DoNotOptimize(sum_2d(dst));
+  }
+  state.SetBytesProcessed(n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_MDSpan_Byteswap_CopyThenView_Sum);
+
+//================================================================================
+
+void BM_MDSpan_Byteswap_Copy(benchmark::State& state) {
+  auto swapped = make_swapped();
+  auto native = std::make_unique<float[]>(n * n);
+  native_view dst(native.get(), n, n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swapped.get());
+    stdex::copy(swapped_view(swapped.get(), n, n), dst);
+    benchmark::DoNotOptimize(native.get());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_MDSpan_Byteswap_Copy);
+
+void BM_Raw_Byteswap_Copy_Scalar(benchmark::State& state) {
+  auto swapped = make_swapped();
+  auto native = std::make_unique<float[]>(n * n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swapped.get());
+    swap_scalar(swapped.get(), native.get(), n * n);
+    benchmark::DoNotOptimize(native.get());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_Raw_Byteswap_Copy_Scalar);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -41,10 +41,14 @@
 //@HEADER
 */
 
-#include <experimental/mdspan>
+#include <experimental/mdspan_ext>
 
 #include <benchmark/benchmark.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "fill.hpp"
 
 namespace stdex = std::experimental;
@@ -83,6 +87,56 @@ BENCHMARK_CAPTURE(
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_right, size_dyn_dyn, stdex::mdspan<int, stdex::dextents<2>>(), 100, 100
 );
+// Much larger than the last level cache
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_right, size_4096d_4096d, stdex::mdspan<int, stdex::dextents<2>>(), 4096, 4096
+);
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_right, double_size_4096d_4096d, stdex::mdspan<double, stdex::dextents<2>>(), 4096, 4096
+);
+
+//================================================================================
+
+// As BM_MDSpan_Copy_2D_right, writing the destination with streaming stores
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Copy_2D_right_nontemporal(benchmark::State& state, MDSpan, DynSizes... dyn) {
+  using value_type = typename MDSpan::value_type;
+  using dest_type = stdex::mdspan<value_type, typename MDSpan::extents_type, stdex::layout_right,
+    stdex::nontemporal_accessor<value_type>>;
+  auto buffer = std::make_unique<value_type[]>(
+    MDSpan{nullptr, dyn...}.mapping().required_span_size()
+  );
+  auto buffer2 = std::make_unique<value_type[]>(
+    MDSpan{nullptr, dyn...}.mapping().required_span_size()
+  );
+  auto s = MDSpan{buffer.get(), dyn...};
+  mdspan_benchmark::fill_random(s);
+  auto dest = dest_type{buffer2.get(), dyn...};
+  for (auto _ : state) {
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+          dest(i, j) = s(i, j);
+      }
+    }
+    dest.accessor().flush();
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+}
+
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_right_nontemporal, size_100_100, stdex::mdspan<int, stdex::extents<100, 100>>()
+);
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_right_nontemporal, size_dyn_dyn, stdex::mdspan<int, stdex::dextents<2>>(), 100, 100
+);
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_right_nontemporal, size_4096d_4096d, stdex::mdspan<int, stdex::dextents<2>>(), 4096, 4096
+);
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_right_nontemporal, double_size_4096d_4096d, stdex::mdspan<double, stdex::dextents<2>>(), 4096, 4096
+);
 
 //================================================================================
 
@@ -113,112 +167,38 @@ void BM_MDSpan_Copy_2D_stride(benchmark::State& state, MDSpan, LayoutMapping map
 
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride, size_100_100,
-  stdex::mdspan<int, stdex::extents<100, 100>, stdex::layout_stride<dyn, dyn>>(),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<100, 100>>(
+  stdex::mdspan<int, stdex::extents<100, 100>, stdex::layout_stride>(),
+  stdex::layout_stride::mapping<stdex::extents<100, 100>>(
     stdex::extents<100, 100>{},
     // layout right
-    std::array<size_t, 2>{100, 1}
+    stdex::dextents<2>{100, 1}
   )
 );
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride, size_100_100d,
-  stdex::mdspan<int, stdex::extents<100, dyn>, stdex::layout_stride<dyn, dyn>>(),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<100, dyn>>(
+  stdex::mdspan<int, stdex::extents<100, dyn>, stdex::layout_stride>(),
+  stdex::layout_stride::mapping<stdex::extents<100, dyn>>(
     stdex::extents<100, dyn>{100},
     // layout right
-    std::array<size_t, 2>{100, 1}
+    stdex::dextents<2>{100, 1}
   )
 );
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride, size_100d_100,
-  stdex::mdspan<int, stdex::extents<dyn, 100>, stdex::layout_stride<dyn, dyn>>(),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, 100>>(
+  stdex::mdspan<int, stdex::extents<dyn, 100>, stdex::layout_stride>(),
+  stdex::layout_stride::mapping<stdex::extents<dyn, 100>>(
     stdex::extents<dyn, 100>{100},
     // layout right
-    std::array<size_t, 2>{100, 1}
+    stdex::dextents<2>{100, 1}
   )
 );
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride, size_100d_100d,
-  stdex::mdspan<int, stdex::extents<dyn, dyn>, stdex::layout_stride<dyn, dyn>>(),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::mdspan<int, stdex::extents<dyn, dyn>, stdex::layout_stride>(),
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{100, 1}
-  )
-);
-
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_fixed_dyn_100_100,
-  stdex::mdspan<int, stdex::extents<100, 100>, stdex::layout_stride<100, dyn>>(),
-  stdex::layout_stride<100, dyn>::template mapping<stdex::extents<100, 100>>(
-    stdex::extents<100, 100>{},
-    // layout right
-    std::array<size_t, 1>{1}
-  )
-);
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_fixed_dyn_100_100d,
-  stdex::mdspan<int, stdex::extents<100, dyn>, stdex::layout_stride<100, dyn>>(),
-  stdex::layout_stride<100, dyn>::template mapping<stdex::extents<100, dyn>>(
-    stdex::extents<100, dyn>{100},
-    // layout right
-    std::array<size_t, 1>{1}
-  )
-);
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_fixed_dyn_100d_100,
-  stdex::mdspan<int, stdex::extents<dyn, 100>, stdex::layout_stride<100, dyn>>(),
-  stdex::layout_stride<100, dyn>::template mapping<stdex::extents<dyn, 100>>(
-    stdex::extents<dyn, 100>{100},
-    // layout right
-    std::array<size_t, 1>{1}
-  )
-);
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_dyn_fixed_100d_100d,
-  stdex::mdspan<int, stdex::extents<dyn, dyn>, stdex::layout_stride<100, dyn>>(),
-  stdex::layout_stride<100, dyn>::template mapping<stdex::extents<dyn, dyn>>(
-    stdex::extents<dyn, dyn>{100, 100},
-    // layout right
-    std::array<size_t, 1>{1}
-  )
-);
-
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_dyn_fixed_100_100,
-  stdex::mdspan<int, stdex::extents<100, 100>, stdex::layout_stride<dyn, 1>>(),
-  stdex::layout_stride<dyn, 1>::template mapping<stdex::extents<100, 100>>(
-    stdex::extents<100, 100>{},
-    // layout right
-    std::array<size_t, 1>{100}
-  )
-);
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_dyn_fixed_100_100d,
-  stdex::mdspan<int, stdex::extents<100, dyn>, stdex::layout_stride<dyn, 1>>(),
-  stdex::layout_stride<dyn, 1>::template mapping<stdex::extents<100, dyn>>(
-    stdex::extents<100, dyn>{100},
-    // layout right
-    std::array<size_t, 1>{100}
-  )
-);
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_dyn_fixed_100d_100,
-  stdex::mdspan<int, stdex::extents<dyn, 100>, stdex::layout_stride<dyn, 1>>(),
-  stdex::layout_stride<dyn, 1>::template mapping<stdex::extents<dyn, 100>>(
-    stdex::extents<dyn, 100>{100},
-    // layout right
-    std::array<size_t, 1>{100}
-  )
-);
-BENCHMARK_CAPTURE(
-  BM_MDSpan_Copy_2D_stride, size_dyn_fixed_100d_100d,
-  stdex::mdspan<int, stdex::extents<dyn, dyn>, stdex::layout_stride<dyn, 1>>(),
-  stdex::layout_stride<dyn, 1>::template mapping<stdex::extents<dyn, dyn>>(
-    stdex::extents<dyn, dyn>{100, 100},
-    // layout right
-    std::array<size_t, 1>{100}
+    stdex::dextents<2>{100, 1}
   )
 );
 
@@ -235,7 +215,7 @@ void BM_MDSpan_Copy_2D_stride_diff_map(benchmark::State& state,
   auto buff_dest = std::make_unique<value_type[]>(
     map_dest.required_span_size()
   );
-  using map_stride_dyn = stdex::layout_stride<dyn, dyn>;
+  using map_stride_dyn = stdex::layout_stride;
   using mdspan_type = stdex::mdspan<T, Extents, map_stride_dyn>;
   auto src = mdspan_type{buff_src.get(), map_src};
   mdspan_benchmark::fill_random(src);
@@ -255,45 +235,45 @@ void BM_MDSpan_Copy_2D_stride_diff_map(benchmark::State& state,
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride_diff_map, size_100d_100d_bcast_0, int(),
   stdex::extents<dyn, dyn>{100, 100},
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{0, 1}
+    stdex::dextents<2>{0, 1}
   ),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{100, 1}
+    stdex::dextents<2>{100, 1}
   )
 );
 
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride_diff_map, size_100d_100d_bcast_1, int(),
   stdex::extents<dyn, dyn>{100, 100},
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{1, 0}
+    stdex::dextents<2>{1, 0}
   ),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{100, 1}
+    stdex::dextents<2>{100, 1}
   )
 );
 
 BENCHMARK_CAPTURE(
   BM_MDSpan_Copy_2D_stride_diff_map, size_100d_100d_bcast_both, int(),
   stdex::extents<dyn, dyn>{100, 100},
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{0, 0}
+    stdex::dextents<2>{0, 0}
   ),
-  stdex::layout_stride<dyn, dyn>::template mapping<stdex::extents<dyn, dyn>>(
+  stdex::layout_stride::mapping<stdex::extents<dyn, dyn>>(
     stdex::extents<dyn, dyn>{100, 100},
     // layout right
-    std::array<size_t, 2>{100, 1}
+    stdex::dextents<2>{100, 1}
   )
 );
 
@@ -358,5 +338,93 @@ BENCHMARK_CAPTURE(
 );
 
 //================================================================================
+// Gathers down the columns of a layout_right matrix that is too large for the
+// caches.  Every access is to a new page, so the hardware prefetchers do not
+// help and prefetching_accessor can.
+
+constexpr size_t gather_size = 4096;
+
+auto transposed_mapping(size_t n) {
+  return stdex::layout_stride::mapping<stdex::dextents<2>>(
+    stdex::dextents<2>{n, n},
+    // columns of a layout right matrix
+    stdex::dextents<2>{1, n}
+  );
+}
 
-BENCHMARK_MAIN();
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_stride, size_4096d_4096d_columns,
+  stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride>(),
+  transposed_mapping(gather_size)
+);
+
+// The prefetch distance (in strides of the traversed dimension) is the
+// benchmark argument; see main() for the report of the best one
+template <class T>
+void BM_MDSpan_Copy_2D_stride_prefetch(benchmark::State& state, T, size_t n) {
+  using mdspan_type = stdex::mdspan<T, stdex::dextents<2>, stdex::layout_stride>;
+  auto map = transposed_mapping(n);
+  auto buffer = std::make_unique<T[]>(map.required_span_size());
+  auto buffer2 = std::make_unique<T[]>(map.required_span_size());
+  auto s_plain = mdspan_type{buffer.get(), map};
+  mdspan_benchmark::fill_random(s_plain);
+  auto distance = size_t(state.range(0));
+  auto s = stdex::prefetched(s_plain, 1, distance);
+  auto dest = stdex::prefetched(mdspan_type{buffer2.get(), map}, 1, distance);
+  for (auto _ : state) {
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+        dest(i, j) = s(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(dest.data());
+  }
+  state.SetBytesProcessed(s.size() * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(
+  BM_MDSpan_Copy_2D_stride_prefetch, size_4096d_4096d_columns, int(), gather_size
+)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Arg(24)->Arg(32)->Arg(64);
+
+//================================================================================
+
+// Console output as usual, plus the prefetch distance with the highest
+// throughput in the sweep above
+class prefetch_sweep_reporter : public benchmark::ConsoleReporter {
+public:
+  void ReportRuns(std::vector<Run> const& runs) override {
+    benchmark::ConsoleReporter::ReportRuns(runs);
+    for(auto const& run : runs) {
+      auto name = run.benchmark_name();
+      auto slash = name.rfind('/');
+      if(name.find("BM_MDSpan_Copy_2D_stride_prefetch") != 0 || slash == std::string::npos
+        || run.run_type != Run::RT_Iteration || run.error_occurred) continue;
+      double time = run.GetAdjustedRealTime();
+      if(best_distance.empty() || time < best_time) {
+        best_time = time;
+        best_distance = name.substr(slash + 1);
+      }
+    }
+  }
+
+  void Finalize() override {
+    benchmark::ConsoleReporter::Finalize();
+    if(!best_distance.empty()) {
+      GetOutputStream() << "Best prefetch distance on this machine: " << best_distance
+        << " strides" << std::endl;
+    }
+  }
+
+private:
+  std::string best_distance;
+  double best_time = 0;
+};
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if(benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  prefetch_sweep_reporter reporter;
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,151 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "fill.hpp"
+
+//================================================================================
+// B = transpose(A) for square float arrays, where either A or B is always
+// walked across rows; blocking keeps the lines of both in cache.
+
+using matrix_view = stdex::mdspan<float, stdex::dextents<2>>;
+
+template <size_t TileSize>
+using tile_size_t = std::integral_constant<size_t, TileSize>;
+
+void BM_MDSpan_Transpose_2D_Loops(benchmark::State& state, size_t n) {
+  auto a_buffer = std::make_unique<float[]>(n * n);
+  auto b_buffer = std::make_unique<float[]>(n * n);
+  matrix_view a(a_buffer.get(), n, n), b(b_buffer.get(), n, n);
+  mdspan_benchmark::fill_random(a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        b(j, i) = a(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(b.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Loops, size_4096, 4096);
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Loops, size_4100, 4100);
+
+// Tiles cut with submdspan and pairs of indices, so with dynamic extents
+template <size_t TileSize>
+void BM_MDSpan_Transpose_2D_Submdspan(benchmark::State& state, tile_size_t<TileSize>, size_t n) {
+  auto a_buffer = std::make_unique<float[]>(n * n);
+  auto b_buffer = std::make_unique<float[]>(n * n);
+  matrix_view a(a_buffer.get(), n, n), b(b_buffer.get(), n, n);
+  mdspan_benchmark::fill_random(a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    for(size_t i0 = 0; i0 < n; i0 += TileSize) {
+      size_t i1 = std::min(i0 + TileSize, n);
+      for(size_t j0 = 0; j0 < n; j0 += TileSize) {
+        size_t j1 = std::min(j0 + TileSize, n);
+        auto ta = stdex::submdspan(a, std::make_pair(i0, i1), std::make_pair(j0, j1));
+        auto tb = stdex::submdspan(b, std::make_pair(j0, j1), std::make_pair(i0, i1));
+        for(size_t i = 0; i < ta.extent(0); ++i) {
+          for(size_t j = 0; j < ta.extent(1); ++j) {
+            tb(j, i) = ta(i, j);
+          }
+        }
+      }
+    }
+    benchmark::DoNotOptimize(b.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Submdspan, tile_32_size_4096, tile_size_t<32>{}, 4096);
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Submdspan, tile_32_size_4100, tile_size_t<32>{}, 4100);
+
+// Tiles from stdex::tiles: full tiles have static extents, so the loops
+// over them have constant trip counts
+template <size_t TileSize>
+void BM_MDSpan_Transpose_2D_Tiles(benchmark::State& state, tile_size_t<TileSize>, size_t n) {
+  auto a_buffer = std::make_unique<float[]>(n * n);
+  auto b_buffer = std::make_unique<float[]>(n * n);
+  matrix_view a(a_buffer.get(), n, n), b(b_buffer.get(), n, n);
+  mdspan_benchmark::fill_random(a);
+  auto a_tiles = stdex::tiles(a, stdex::tile_extents<TileSize, TileSize>{});
+  auto b_tiles = stdex::tiles(b, stdex::tile_extents<TileSize, TileSize>{});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    a_tiles.for_each([&](auto ta, std::array<size_t, 2> o) {
+      std::array<size_t, 2> ob = {{o[1], o[0]}};
+      auto transpose_into = [&](auto tb) {
+        for(size_t i = 0; i < ta.extent(0); ++i) {
+          for(size_t j = 0; j < ta.extent(1); ++j) {
+            tb(j, i) = ta(i, j);
+          }
+        }
+      };
+      // the tile of B is full exactly when the tile of A is (A and B are square)
+      if(b_tiles.is_full(ob)) transpose_into(b_tiles.full_tile(ob));
+      else transpose_into(b_tiles.partial_tile(ob));
+    });
+    benchmark::DoNotOptimize(b.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * n * n * sizeof(float) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Tiles, tile_16_size_4096, tile_size_t<16>{}, 4096);
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Tiles, tile_32_size_4096, tile_size_t<32>{}, 4096);
+BENCHMARK_CAPTURE(BM_MDSpan_Transpose_2D_Tiles, tile_32_size_4100, tile_size_t<32>{}, 4100);
+
+//================================================================================
+
+BENCHMARK_MAIN();
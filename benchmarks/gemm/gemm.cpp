@@ -0,0 +1,101 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <memory>
+
+#include "gemm_common.hpp"
+
+//================================================================================
+
+// roofline: FLOPS against roof_FLOPS, the lower of the peak multiply-add
+// rate and memory bandwidth times intensity, both measured on this machine
+
+#define MDSPAN_BENCHMARK_GEMM_LAYOUTS(T, N) \
+  BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, T##_right_right_right_##N, stdex::execution::seq, T(), stdex::layout_right{}, stdex::layout_right{}, stdex::layout_right{}, N); \
+  BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, T##_left_left_left_##N, stdex::execution::seq, T(), stdex::layout_left{}, stdex::layout_left{}, stdex::layout_left{}, N); \
+  BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, T##_left_right_left_##N, stdex::execution::seq, T(), stdex::layout_left{}, stdex::layout_right{}, stdex::layout_left{}, N); \
+  BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct_Strided, T##_##N##_in_##N##_plus_8, stdex::execution::seq, T(), N, N + 8)
+
+MDSPAN_BENCHMARK_GEMM_LAYOUTS(double, 128);
+MDSPAN_BENCHMARK_GEMM_LAYOUTS(double, 512);
+MDSPAN_BENCHMARK_GEMM_LAYOUTS(double, 1024);
+MDSPAN_BENCHMARK_GEMM_LAYOUTS(float, 512);
+MDSPAN_BENCHMARK_GEMM_LAYOUTS(float, 1024);
+
+//================================================================================
+
+// The textbook loop, in i-k-j order so that the innermost loop is
+// unit-stride over B and C
+template <class T>
+void BM_Raw_MatrixProduct_ikj(benchmark::State& state, T, size_t n) {
+  auto buffer_A = std::make_unique<T[]>(n * n);
+  auto buffer_B = std::make_unique<T[]>(n * n);
+  auto buffer_C = std::make_unique<T[]>(n * n);
+  mdspan_benchmark::fill_random(dmatrix<T, stdex::layout_right>(buffer_A.get(), n, n));
+  mdspan_benchmark::fill_random(dmatrix<T, stdex::layout_right>(buffer_B.get(), n, n));
+  T const* a = buffer_A.get();
+  T const* b = buffer_B.get();
+  T* c = buffer_C.get();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    for(size_t i = 0; i < n * n; ++i) c[i] = 0;
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t p = 0; p < n; ++p) {
+        T a_ip = a[i * n + p];
+        for(size_t j = 0; j < n; ++j) c[i * n + j] += a_ip * b[p * n + j];
+      }
+    }
+    benchmark::DoNotOptimize(c);
+    benchmark::ClobberMemory();
+  }
+  mdspan_benchmark::set_gemm_counters<T>(state, n, n, n);
+}
+BENCHMARK_CAPTURE(BM_Raw_MatrixProduct_ikj, double_128, double(), 128);
+BENCHMARK_CAPTURE(BM_Raw_MatrixProduct_ikj, double_512, double(), 512);
+BENCHMARK_CAPTURE(BM_Raw_MatrixProduct_ikj, double_1024, double(), 1024);
+BENCHMARK_CAPTURE(BM_Raw_MatrixProduct_ikj, float_1024, float(), 1024);
+
+//================================================================================
+
+BENCHMARK_MAIN();
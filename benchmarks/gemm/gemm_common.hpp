@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef MDSPAN_BENCHMARKS_GEMM_GEMM_COMMON_HPP
+#define MDSPAN_BENCHMARKS_GEMM_GEMM_COMMON_HPP
+
+#include <experimental/linalg>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "fill.hpp"
+
+namespace mdspan_benchmark {
+
+//==============================================================================
+// <editor-fold desc="Roofline"> {{{1
+
+// The two roofs of this machine for element type T, measured once per
+// process: the multiply-add rate with every operand in registers, and the
+// bandwidth of a STREAM-style triad over arrays much larger than the caches
+struct roofline {
+  double peak_flops;
+  double bytes_per_second;
+
+  // The highest flop rate a kernel doing `intensity` flops per byte of
+  // memory traffic can reach
+  double attainable(double intensity) const {
+    return std::min(peak_flops, intensity * bytes_per_second);
+  }
+};
+
+template <class T>
+double measure_peak_flops() {
+  // twelve vector registers' worth of independent chains: enough to cover
+  // the latency of the multiply and add units, few enough to stay in
+  // registers
+  constexpr size_t chains = 12 * stdex::detail::__gemm_blocking<T>::vector_size;
+  constexpr size_t iterations = 1 << 20;
+  T acc[chains];
+  for(size_t c = 0; c < chains; ++c) acc[c] = T(c);
+  T x = T(0.999), y = T(0.001);
+  benchmark::DoNotOptimize(x);
+  benchmark::DoNotOptimize(y);
+  auto start = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < iterations; ++i) {
+    for(size_t c = 0; c < chains; ++c) acc[c] = acc[c] * x + y;
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  for(size_t c = 0; c < chains; ++c) benchmark::DoNotOptimize(acc[c]);
+  return 2.0 * double(chains) * double(iterations) / seconds;
+}
+
+template <class T>
+double measure_triad_bandwidth() {
+  constexpr size_t n = size_t(1) << 24;
+  constexpr int repeats = 5;
+  std::vector<T> a(n, T(0)), b(n, T(1)), c(n, T(2));
+  T s = T(3);
+  benchmark::DoNotOptimize(s);
+  double best = 0;
+  for(int r = 0; r < repeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < n; ++i) a[i] = b[i] + s * c[i];
+    benchmark::DoNotOptimize(a.data());
+    benchmark::ClobberMemory();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    best = std::max(best, 3.0 * double(n) * sizeof(T) / seconds);
+  }
+  return best;
+}
+
+template <class T>
+roofline const& measured_roofline() {
+  static roofline const roofs = { measure_peak_flops<T>(), measure_triad_bandwidth<T>() };
+  return roofs;
+}
+
+// </editor-fold> end Roofline }}}1
+//==============================================================================
+
+// Reports the flop rate of an m x k by k x n product next to the roofline
+// at its arithmetic intensity, counting each operand read once and C read
+// and written once
+template <class T>
+void set_gemm_counters(benchmark::State& state, size_t m, size_t n, size_t k) {
+  double flops = 2.0 * double(m) * double(n) * double(k);
+  double bytes = double(m * k + k * n + 2 * m * n) * sizeof(T);
+  auto const& roofs = measured_roofline<T>();
+  state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["intensity"] = flops / bytes;
+  state.counters["roof_FLOPS"] = roofs.attainable(flops / bytes);
+}
+
+} // namespace mdspan_benchmark
+
+//================================================================================
+
+template <class T, class Layout>
+using dmatrix = stdex::mdspan<T, stdex::dextents<2>, Layout>;
+
+template <class ExecutionPolicy, class T, class LayoutA, class LayoutB, class LayoutC>
+void BM_MDSpan_MatrixProduct(benchmark::State& state, ExecutionPolicy policy, T, LayoutA, LayoutB, LayoutC, size_t n) {
+  auto buffer_A = std::make_unique<T[]>(n * n);
+  auto buffer_B = std::make_unique<T[]>(n * n);
+  auto buffer_C = std::make_unique<T[]>(n * n);
+  auto A = dmatrix<T, LayoutA>(buffer_A.get(), n, n);
+  auto B = dmatrix<T, LayoutB>(buffer_B.get(), n, n);
+  auto C = dmatrix<T, LayoutC>(buffer_C.get(), n, n);
+  mdspan_benchmark::fill_random(A);
+  mdspan_benchmark::fill_random(B);
+  stdex::matrix_product(policy, A, B, C);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(B.data());
+    stdex::matrix_product(policy, A, B, C);
+    benchmark::DoNotOptimize(C.data());
+    benchmark::ClobberMemory();
+  }
+  mdspan_benchmark::set_gemm_counters<T>(state, n, n, n);
+}
+
+// Operands that are n x n windows into larger matrices, i.e., layout_stride
+// views with a leading dimension other than n
+template <class ExecutionPolicy, class T>
+void BM_MDSpan_MatrixProduct_Strided(benchmark::State& state, ExecutionPolicy policy, T, size_t n, size_t ld) {
+  auto buffer_A = std::make_unique<T[]>(ld * ld);
+  auto buffer_B = std::make_unique<T[]>(ld * ld);
+  auto buffer_C = std::make_unique<T[]>(ld * ld);
+  auto full_A = dmatrix<T, stdex::layout_right>(buffer_A.get(), ld, ld);
+  auto full_B = dmatrix<T, stdex::layout_left>(buffer_B.get(), ld, ld);
+  auto full_C = dmatrix<T, stdex::layout_right>(buffer_C.get(), ld, ld);
+  mdspan_benchmark::fill_random(full_A);
+  mdspan_benchmark::fill_random(full_B);
+  auto window = std::make_pair(size_t(0), n);
+  auto A = stdex::submdspan(full_A, window, window);
+  auto B = stdex::submdspan(full_B, window, window);
+  auto C = stdex::submdspan(full_C, window, window);
+  stdex::matrix_product(policy, A, B, C);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(B.data());
+    stdex::matrix_product(policy, A, B, C);
+    benchmark::DoNotOptimize(C.data());
+    benchmark::ClobberMemory();
+  }
+  mdspan_benchmark::set_gemm_counters<T>(state, n, n, n);
+}
+
+#endif // MDSPAN_BENCHMARKS_GEMM_GEMM_COMMON_HPP
@@ -0,0 +1,60 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "gemm_common.hpp"
+
+//================================================================================
+
+// Every OpenMP thread computes its own block of C; compare with the seq
+// results of the gemm benchmark.  Rates are per wall-clock second, while
+// roof_FLOPS is still the roofline of a single thread.
+
+BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, double_right_right_right_2048, stdex::execution::par, double(), stdex::layout_right{}, stdex::layout_right{}, stdex::layout_right{}, 2048)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, double_left_left_left_2048, stdex::execution::par, double(), stdex::layout_left{}, stdex::layout_left{}, stdex::layout_left{}, 2048)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, float_right_right_right_2048, stdex::execution::par, float(), stdex::layout_right{}, stdex::layout_right{}, stdex::layout_right{}, 2048)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct_Strided, double_2048_in_2056, stdex::execution::par, double(), 2048, 2056)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_MatrixProduct, double_right_right_right_256, stdex::execution::par, double(), stdex::layout_right{}, stdex::layout_right{}, stdex::layout_right{}, 256)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,177 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+
+#include <benchmark/benchmark.h>
+
+#include <complex>
+#include <memory>
+
+#include "fill.hpp"
+
+//================================================================================
+
+// y = alpha * A^H * x, for an m x n matrix A.
+//
+// The MDSpan_Fused variant hands `scaled(alpha, conjugated(A))` straight to a
+// generic transposed matvec kernel; the MDSpan_Temporary variant does what
+// we would have to do without the accessors, forming alpha * conj(A) in a
+// temporary first.  Both use the same kernel.
+
+template <class T>
+using rmdspan = stdex::mdspan<T, stdex::dextents<2>, stdex::layout_right>;
+template <class T>
+using vector_mdspan = stdex::mdspan<T, stdex::dextents<1>>;
+
+// y = A^T * x, walking A in its (layout_right) storage order
+template <class MDSpanA, class MDSpanX, class MDSpanY>
+void matvec_transposed(MDSpanA A, MDSpanX x, MDSpanY y) {
+  for(size_t j = 0; j < A.extent(1); ++j) {
+    y(j) = 0;
+  }
+  for(size_t i = 0; i < A.extent(0); ++i) {
+    auto x_i = x(i);
+    for(size_t j = 0; j < A.extent(1); ++j) {
+      y(j) += A(i, j) * x_i;
+    }
+  }
+}
+
+//================================================================================
+
+template <class T>
+void BM_MDSpan_Fused_Scaled_Conjugated_MatVecH(benchmark::State& state, T, size_t m, size_t n) {
+  auto buffer_A = std::make_unique<T[]>(m * n);
+  auto buffer_x = std::make_unique<T[]>(m);
+  auto buffer_y = std::make_unique<T[]>(n);
+  auto A = rmdspan<T>(buffer_A.get(), m, n);
+  auto x = vector_mdspan<T>(buffer_x.get(), m);
+  auto y = vector_mdspan<T>(buffer_y.get(), n);
+  mdspan_benchmark::fill_random(A);
+  mdspan_benchmark::fill_random(x);
+  T alpha = T(3);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(x.data());
+    matvec_transposed(stdex::scaled(alpha, stdex::conjugated(A)), x, y);
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed((m * n + m + n) * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Fused_Scaled_Conjugated_MatVecH, double_2000_2000, double(), 2000, 2000);
+BENCHMARK_CAPTURE(BM_MDSpan_Fused_Scaled_Conjugated_MatVecH, complex_2000_2000, std::complex<double>(), 2000, 2000);
+
+//================================================================================
+
+template <class T>
+void BM_MDSpan_Temporary_Scaled_Conjugated_MatVecH(benchmark::State& state, T, size_t m, size_t n) {
+  auto buffer_A = std::make_unique<T[]>(m * n);
+  auto buffer_x = std::make_unique<T[]>(m);
+  auto buffer_y = std::make_unique<T[]>(n);
+  auto A = rmdspan<T>(buffer_A.get(), m, n);
+  auto x = vector_mdspan<T>(buffer_x.get(), m);
+  auto y = vector_mdspan<T>(buffer_y.get(), n);
+  mdspan_benchmark::fill_random(A);
+  mdspan_benchmark::fill_random(x);
+  T alpha = T(3);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(x.data());
+    auto buffer_tmp = std::make_unique<T[]>(m * n);
+    auto tmp = rmdspan<T>(buffer_tmp.get(), m, n);
+    for(size_t i = 0; i < m; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        tmp(i, j) = alpha * std::experimental::detail::__conj_if_needed(A(i, j));
+      }
+    }
+    matvec_transposed(tmp, x, y);
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed((m * n + m + n) * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Temporary_Scaled_Conjugated_MatVecH, double_2000_2000, double(), 2000, 2000);
+BENCHMARK_CAPTURE(BM_MDSpan_Temporary_Scaled_Conjugated_MatVecH, complex_2000_2000, std::complex<double>(), 2000, 2000);
+
+//================================================================================
+
+template <class T>
+void BM_Raw_Fused_Scaled_Conjugated_MatVecH(benchmark::State& state, T, size_t m, size_t n) {
+  auto buffer_A = std::make_unique<T[]>(m * n);
+  auto buffer_x = std::make_unique<T[]>(m);
+  auto buffer_y = std::make_unique<T[]>(n);
+  mdspan_benchmark::fill_random(rmdspan<T>(buffer_A.get(), m, n));
+  mdspan_benchmark::fill_random(vector_mdspan<T>(buffer_x.get(), m));
+  T alpha = T(3);
+
+  T const* p_A = buffer_A.get();
+  T const* p_x = buffer_x.get();
+  T* p_y = buffer_y.get();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_A);
+    benchmark::DoNotOptimize(p_x);
+    for(size_t j = 0; j < n; ++j) {
+      p_y[j] = 0;
+    }
+    for(size_t i = 0; i < m; ++i) {
+      T x_i = p_x[i];
+      for(size_t j = 0; j < n; ++j) {
+        p_y[j] += alpha * std::experimental::detail::__conj_if_needed(p_A[i * n + j]) * x_i;
+      }
+    }
+    benchmark::DoNotOptimize(p_y);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed((m * n + m + n) * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Raw_Fused_Scaled_Conjugated_MatVecH, double_2000_2000, double(), 2000, 2000);
+BENCHMARK_CAPTURE(BM_Raw_Fused_Scaled_Conjugated_MatVecH, complex_2000_2000, std::complex<double>(), 2000, 2000);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "fill.hpp"
+
+//================================================================================
+
+// y = A * x with A stored in reduced precision through converting_accessor /
+// quantized_accessor and x, y in float.  items_per_second counts matrix
+// entries, so that the precisions can be compared directly;
+// bytes_per_second counts the storage of A actually read.
+
+template <class T>
+using vector_mdspan = stdex::mdspan<T, stdex::dextents<1>>;
+
+template<class MDSpan>
+void OpenMP_first_touch_2D(MDSpan s) {
+  #pragma omp parallel for
+  for(size_t i = 0; i < s.extent(0); i ++) {
+    for(size_t j = 0; j < s.extent(1); j ++) {
+      s(i,j) = 0;
+    }
+  }
+}
+
+template<class MDSpan>
+void OpenMP_first_touch_1D(MDSpan s) {
+  #pragma omp parallel for
+  for(size_t i = 0; i < s.extent(0); i ++) {
+    s(i) = 0;
+  }
+}
+
+//================================================================================
+
+template <class Accessor>
+void BM_MDSpan_OpenMP_MatVec_Converting(benchmark::State& state, Accessor acc, size_t N, size_t M) {
+
+  using MDSpanMatrix = stdex::mdspan<typename Accessor::element_type, stdex::dextents<2>, stdex::layout_right, Accessor>;
+  using value_type = typename MDSpanMatrix::value_type;
+  using storage_type = std::remove_pointer_t<typename Accessor::pointer>;
+  auto map = typename MDSpanMatrix::mapping_type(stdex::dextents<2>(N, M));
+
+  auto buffer_A = std::make_unique<storage_type[]>(map.required_span_size());
+  auto A = MDSpanMatrix{buffer_A.get(), map, acc};
+  OpenMP_first_touch_2D(A);
+  mdspan_benchmark::fill_random(A);
+
+  auto buffer_x = std::make_unique<value_type[]>(M);
+  auto x = vector_mdspan<value_type>{buffer_x.get(), M};
+  OpenMP_first_touch_1D(x);
+  mdspan_benchmark::fill_random(x);
+
+  auto buffer_y = std::make_unique<value_type[]>(N);
+  auto y = vector_mdspan<value_type>{buffer_y.get(), N};
+  OpenMP_first_touch_1D(y);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x.data());
+    #pragma omp parallel for
+    for(size_t i = 0; i < A.extent(0); i ++) {
+      value_type y_i = 0;
+      for(size_t j = 0; j < A.extent(1); j ++) {
+        y_i += A(i,j) * x(j);
+      }
+      y(i) = y_i;
+    }
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(N * M * state.iterations());
+  state.SetBytesProcessed(N * M * sizeof(storage_type) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec_Converting, float, stdex::default_accessor<float>(), 20000, 5000);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec_Converting, float16, stdex::converting_accessor<stdex::float16_storage, float>(), 20000, 5000);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec_Converting, bfloat16, stdex::converting_accessor<stdex::bfloat16_storage, float>(), 20000, 5000);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec_Converting, int8, stdex::quantized_accessor<int8_t, float>(1.0f, -64), 20000, 5000);
+
+//================================================================================
+
+BENCHMARK_MAIN();
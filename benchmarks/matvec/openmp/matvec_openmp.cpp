@@ -42,6 +42,7 @@
 */
 
 #include <experimental/mdspan>
+#include <experimental/linalg>
 
 #include <memory>
 #include <random>
@@ -147,6 +148,51 @@ void BM_MDSpan_OpenMP_MatVec(benchmark::State& state, MDSpanMatrix, DynSizes...
 BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec, left, lmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
 BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatVec, right, rmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
 
+//================================================================================
+
+template <class MDSpanMatrix, class... DynSizes>
+void BM_MDSpan_OpenMP_MatrixVectorProduct(benchmark::State& state, MDSpanMatrix, DynSizes... dyn) {
+
+  using value_type = typename MDSpanMatrix::value_type;
+  using MDSpanVector = lmdspan<value_type,stdex::dynamic_extent>;
+
+  auto buffer_size_A = MDSpanMatrix{nullptr, dyn...}.mapping().required_span_size();
+  auto buffer_A = std::make_unique<value_type[]>(buffer_size_A);
+  auto A = MDSpanMatrix{buffer_A.get(), dyn...};
+  OpenMP_first_touch_2D(A);
+  mdspan_benchmark::fill_random(A);
+
+  auto buffer_size_x = MDSpanVector{nullptr, A.extent(1)}.mapping().required_span_size();
+  auto buffer_x = std::make_unique<value_type[]>(buffer_size_x);
+  auto x = MDSpanVector{buffer_x.get(), A.extent(1)};
+  OpenMP_first_touch_1D(x);
+  mdspan_benchmark::fill_random(x);
+
+  auto buffer_size_y = MDSpanVector{nullptr, A.extent(0)}.mapping().required_span_size();
+  auto buffer_y = std::make_unique<value_type[]>(buffer_size_y);
+  auto y = MDSpanVector{buffer_y.get(), A.extent(0)};
+  OpenMP_first_touch_1D(y);
+
+  stdex::matrix_vector_product(stdex::execution::par, A, x, y);
+
+  int R = 10;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.data());
+    benchmark::DoNotOptimize(y.data());
+    benchmark::DoNotOptimize(x.data());
+    for(int r=0; r<R; r++) {
+      stdex::matrix_vector_product(stdex::execution::par, A, x, y);
+    }
+    benchmark::ClobberMemory();
+  }
+  size_t num_elements = 2 * A.extent(0) * A.extent(1) + 2 * A.extent(0);
+  state.SetBytesProcessed( R * num_elements * sizeof(value_type) * state.iterations() * global_repeat);
+  state.counters["repeats"] = global_repeat;
+}
+
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatrixVectorProduct, left, lmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_MatrixVectorProduct, right, rmdspan<double,stdex::dynamic_extent,stdex::dynamic_extent>(), 100000, 5000);
+
 
 template <class MDSpanMatrix, class... DynSizes>
 void BM_MDSpan_OpenMP_MatVec_Raw_Left(benchmark::State& state, MDSpanMatrix, DynSizes... dyn) {
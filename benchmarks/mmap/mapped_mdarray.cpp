@@ -0,0 +1,169 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "fill.hpp"
+#include "temp_file.hpp"
+
+//================================================================================
+// A raw float volume on disk, read either through mapped_mdarray or into a
+// buffer with fread.  Every iteration starts with the file evicted from the
+// page cache, so that both pay for the I/O they actually do.
+
+using volume_extents = stdex::dextents<3>;
+using volume_mapping = stdex::layout_right::mapping<volume_extents>;
+
+constexpr size_t volume_size = 256;
+
+volume_mapping volume_map() {
+  return volume_mapping(volume_extents(volume_size, 2 * volume_size, 2 * volume_size));
+}
+
+mdspan_benchmark::temp_file const& volume_file() {
+  static mdspan_benchmark::temp_file file("volume.f32", [](std::string const& path) {
+    stdex::mapped_mdarray<float, volume_extents> volume(path.c_str(), volume_map(), stdex::mapped_file_mode::create);
+    mdspan_benchmark::fill_random(volume.view());
+    volume.sync();
+  });
+  return file;
+}
+
+template <class MDSpan>
+float sum_3d(MDSpan s) {
+  float sum = 0;
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      for(size_t k = 0; k < s.extent(2); ++k) {
+        sum += s(i, j, k);
+      }
+    }
+  }
+  return sum;
+}
+
+//================================================================================
+
+void BM_MDSpan_Mapped_First_Access(benchmark::State& state) {
+  auto const& path = volume_file().path;
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    stdex::mapped_mdarray<float const, volume_extents> volume(path.c_str(), volume_map());
+    auto v = volume.view();
+    benchmark::DoNotOptimize(v(v.extent(0) / 2, v.extent(1) / 2, v.extent(2) / 2));
+  }
+}
+BENCHMARK(BM_MDSpan_Mapped_First_Access)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_Raw_Fread_First_Access(benchmark::State& state) {
+  auto const& path = volume_file().path;
+  auto map = volume_map();
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    auto buffer = std::make_unique<float[]>(map.required_span_size());
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    size_t read = std::fread(buffer.get(), sizeof(float), map.required_span_size(), f);
+    std::fclose(f);
+    auto v = stdex::mdspan<float const, volume_extents>(buffer.get(), map);
+    benchmark::DoNotOptimize(read);
+    benchmark::DoNotOptimize(v(v.extent(0) / 2, v.extent(1) / 2, v.extent(2) / 2));
+  }
+}
+BENCHMARK(BM_Raw_Fread_First_Access)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+// Full traversal, with the paging hint for the traversal (sequential here)
+// or an explicit one
+void BM_MDSpan_Mapped_Sum_3D(benchmark::State& state, bool from_traversal, stdex::mapped_access access) {
+  auto const& path = volume_file().path;
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    stdex::mapped_mdarray<float const, volume_extents> volume(path.c_str(), volume_map());
+    if(from_traversal) volume.advise_traversal({{0, 1, 2}});
+    else volume.advise(access);
+    benchmark::DoNotOptimize(sum_3d(volume.view()));
+  }
+  state.SetBytesProcessed(volume_map().required_span_size() * sizeof(float) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Mapped_Sum_3D, normal, false, stdex::mapped_access::normal)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_Mapped_Sum_3D, traversal, true, stdex::mapped_access::normal)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_Mapped_Sum_3D, willneed, false, stdex::mapped_access::willneed)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_Raw_Fread_Sum_3D(benchmark::State& state) {
+  auto const& path = volume_file().path;
+  auto map = volume_map();
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    auto buffer = std::make_unique<float[]>(map.required_span_size());
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    size_t read = std::fread(buffer.get(), sizeof(float), map.required_span_size(), f);
+    std::fclose(f);
+    benchmark::DoNotOptimize(read);
+    benchmark::DoNotOptimize(sum_3d(stdex::mdspan<float const, volume_extents>(buffer.get(), map)));
+  }
+  state.SetBytesProcessed(map.required_span_size() * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_Raw_Fread_Sum_3D)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "fill.hpp"
+#include "temp_file.hpp"
+
+//================================================================================
+// Loading a 4096 x 4096 double .npy file, from the page cache (warm) or with
+// the file evicted from it before every iteration (cold)
+
+using matrix_extents = stdex::dextents<2>;
+
+constexpr size_t matrix_size = 4096;
+
+std::string const& npy_path() {
+  static mdspan_benchmark::temp_file file("matrix.npy", [](std::string const& path) {
+    auto buffer = std::make_unique<double[]>(matrix_size * matrix_size);
+    stdex::mdspan<double, matrix_extents> m(buffer.get(), matrix_size, matrix_size);
+    mdspan_benchmark::fill_random(m);
+    stdex::save_npy(path.c_str(), m);
+  });
+  return file.path;
+}
+
+template <class MDSpan>
+double sum_2d(MDSpan s) {
+  double sum = 0;
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      sum += s(i, j);
+    }
+  }
+  return sum;
+}
+
+void evict_untimed(benchmark::State& state, std::string const& path) {
+  state.PauseTiming();
+  mdspan_benchmark::evict(path);
+  state.ResumeTiming();
+}
+
+//================================================================================
+
+void BM_MDSpan_Load_Npy(benchmark::State& state, bool cold) {
+  auto const& path = npy_path();
+  for (auto _ : state) {
+    if(cold) evict_untimed(state, path);
+    auto h = stdex::read_npy_header(path.c_str());
+    auto map = stdex::npy_mapping<double, matrix_extents, stdex::layout_right>(h, path.c_str());
+    auto buffer = std::make_unique<double[]>(map.required_span_size());
+    stdex::mdspan<double, matrix_extents> m(buffer.get(), map);
+    stdex::load_npy(path.c_str(), m);
+    benchmark::DoNotOptimize(sum_2d(m));
+  }
+  state.SetBytesProcessed(matrix_size * matrix_size * sizeof(double) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Load_Npy, warm, false)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_Load_Npy, cold, true)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_MDSpan_Map_Npy(benchmark::State& state, bool cold) {
+  auto const& path = npy_path();
+  for (auto _ : state) {
+    if(cold) evict_untimed(state, path);
+    auto a = stdex::map_npy<double const, matrix_extents>(path.c_str());
+    a.advise(stdex::mapped_access::sequential);
+    benchmark::DoNotOptimize(sum_2d(a.view()));
+  }
+  state.SetBytesProcessed(matrix_size * matrix_size * sizeof(double) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Map_Npy, warm, false)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_Map_Npy, cold, true)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The data is known to start after a 128 byte header
+void BM_Raw_Fread(benchmark::State& state, bool cold) {
+  auto const& path = npy_path();
+  size_t n = matrix_size * matrix_size;
+  for (auto _ : state) {
+    if(cold) evict_untimed(state, path);
+    auto buffer = std::make_unique<double[]>(n);
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    std::fseek(f, 128, SEEK_SET);
+    size_t read = std::fread(buffer.get(), sizeof(double), n, f);
+    std::fclose(f);
+    benchmark::DoNotOptimize(read);
+    benchmark::DoNotOptimize(sum_2d(stdex::mdspan<double const, matrix_extents>(buffer.get(), matrix_size, matrix_size)));
+  }
+  state.SetBytesProcessed(n * sizeof(double) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Raw_Fread, warm, false)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Raw_Fread, cold, true)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,208 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "fill.hpp"
+#include "temp_file.hpp"
+
+//================================================================================
+// A float volume stored in 16 x 16 x 64 tiles on disk, summed through a
+// paged_accessor whose tile cache holds a quarter of it.  Every iteration
+// starts with the file evicted from the page cache and with an empty tile
+// cache, so that each sweep reads the whole volume from disk.
+
+using volume_extents = stdex::dextents<3>;
+using volume_layout = stdex::layout_tiled<16, 16, 64>;
+using volume_mapping = volume_layout::mapping<volume_extents>;
+using paged_volume = stdex::mdspan<float const, volume_extents, volume_layout, stdex::paged_accessor<float>>;
+
+constexpr size_t volume_size = 256;
+
+volume_mapping volume_map() {
+  return volume_mapping(volume_extents(volume_size, 2 * volume_size, 2 * volume_size));
+}
+
+size_t cache_budget_tiles() {
+  return volume_map().num_tiles() / 4;
+}
+
+mdspan_benchmark::temp_file const& volume_file() {
+  static mdspan_benchmark::temp_file file("volume.tiles", [](std::string const& path) {
+    stdex::mapped_mdarray<float, volume_extents, volume_layout> volume(path.c_str(), volume_map(), stdex::mapped_file_mode::create);
+    mdspan_benchmark::fill_random(stdex::mdspan<float, stdex::dextents<1>>(volume.data(), volume.size()));
+    volume.sync();
+  });
+  return file;
+}
+
+// Plain C-order sweep: one tile-row of the volume is live at a time
+template <class MDSpan>
+float sum_3d(MDSpan s) {
+  float sum = 0;
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      for(size_t k = 0; k < s.extent(2); ++k) {
+        sum += s(i, j, k);
+      }
+    }
+  }
+  return sum;
+}
+
+// Tile by tile in storage order, C order within each tile
+template <class MDSpan>
+float sum_3d_by_tile(MDSpan s) {
+  constexpr size_t t0 = 16, t1 = 16, t2 = 64;
+  float sum = 0;
+  for(size_t ti = 0; ti < s.extent(0); ti += t0) {
+    for(size_t tj = 0; tj < s.extent(1); tj += t1) {
+      for(size_t tk = 0; tk < s.extent(2); tk += t2) {
+        for(size_t i = ti; i < ti + t0 && i < s.extent(0); ++i) {
+          for(size_t j = tj; j < tj + t1 && j < s.extent(1); ++j) {
+            for(size_t k = tk; k < tk + t2 && k < s.extent(2); ++k) {
+              sum += s(i, j, k);
+            }
+          }
+        }
+      }
+    }
+  }
+  return sum;
+}
+
+void set_cache_counters(benchmark::State& state, stdex::tile_cache_stats const& stats) {
+  auto per_iteration = [&](size_t n) {
+    return benchmark::Counter(double(n), benchmark::Counter::kAvgIterations);
+  };
+  state.counters["hit_rate"] = stats.hit_rate();
+  state.counters["misses"] = per_iteration(stats.misses);
+  state.counters["prefetches"] = per_iteration(stats.prefetches);
+  state.counters["prefetch_hits"] = per_iteration(stats.prefetch_hits);
+  state.counters["waits"] = per_iteration(stats.waits);
+}
+
+//================================================================================
+
+template <class Sum>
+void BM_MDSpan_Paged_Sum_3D(benchmark::State& state, Sum sum) {
+  auto const& path = volume_file().path;
+  auto map = volume_map();
+  size_t prefetch_depth = size_t(state.range(0));
+  stdex::tile_cache_stats total;
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    stdex::tile_cache<float> cache(path.c_str(), map.tile_size(), cache_budget_tiles());
+    paged_volume v(0, map, stdex::paged_accessor<float>(cache, prefetch_depth));
+    benchmark::DoNotOptimize(sum(v));
+    auto stats = cache.stats();
+    total.hits += stats.hits;
+    total.misses += stats.misses;
+    total.prefetches += stats.prefetches;
+    total.prefetch_hits += stats.prefetch_hits;
+    total.waits += stats.waits;
+  }
+  state.SetBytesProcessed(map.required_span_size() * sizeof(float) * state.iterations());
+  set_cache_counters(state, total);
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Paged_Sum_3D, by_tile, [](paged_volume v) { return sum_3d_by_tile(v); })
+  ->ArgName("prefetch")->Arg(0)->Arg(2)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_Paged_Sum_3D, c_order, [](paged_volume v) { return sum_3d(v); })
+  ->ArgName("prefetch")->Arg(0)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The same sweeps with the kernel doing the paging, through mmap
+template <class Sum>
+void BM_MDSpan_Mapped_Tiled_Sum_3D(benchmark::State& state, Sum sum) {
+  auto const& path = volume_file().path;
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    stdex::mapped_mdarray<float const, volume_extents, volume_layout> volume(path.c_str(), volume_map());
+    benchmark::DoNotOptimize(sum(volume.view()));
+  }
+  state.SetBytesProcessed(volume_map().required_span_size() * sizeof(float) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Mapped_Tiled_Sum_3D, by_tile,
+  [](stdex::mdspan<float const, volume_extents, volume_layout> v) { return sum_3d_by_tile(v); })
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_Mapped_Tiled_Sum_3D, c_order,
+  [](stdex::mdspan<float const, volume_extents, volume_layout> v) { return sum_3d(v); })
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Lower bound: the whole file read sequentially, one tile per pread
+void BM_Raw_Pread_Sum(benchmark::State& state) {
+  auto const& path = volume_file().path;
+  auto map = volume_map();
+  auto tile = std::make_unique<float[]>(map.tile_size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    float sum = 0;
+    for(size_t t = 0; t < map.num_tiles(); ++t) {
+      ssize_t r = ::pread(fd, tile.get(), map.tile_size() * sizeof(float), off_t(t * map.tile_size() * sizeof(float)));
+      benchmark::DoNotOptimize(r);
+      for(size_t e = 0; e < map.tile_size(); ++e) sum += tile[e];
+    }
+    ::close(fd);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(map.required_span_size() * sizeof(float) * state.iterations());
+}
+BENCHMARK(BM_Raw_Pread_Sum)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,197 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "fill.hpp"
+
+//================================================================================
+
+template <class T>
+using vector_mdspan = stdex::mdspan<T, stdex::dextents<1>>;
+
+// Per-row counts, e.g., particles per cell or neighbours per particle,
+// uniformly distributed in [0, 2 * mean_count]
+std::vector<int> make_counts(size_t num_rows, int mean_count) {
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> dist(0, 2 * mean_count);
+  std::vector<int> counts(num_rows);
+  for(auto& c : counts) c = dist(gen);
+  return counts;
+}
+
+template <class T>
+void OpenMP_first_touch_1D(vector_mdspan<T> s) {
+  #pragma omp parallel for
+  for(size_t i = 0; i < s.extent(0); i ++) {
+    s(i) = 0;
+  }
+}
+
+//================================================================================
+
+template <class T>
+void BM_MDSpan_OpenMP_Ragged_Construct(benchmark::State& state, T, size_t num_rows, int mean_count) {
+  auto counts_buffer = make_counts(num_rows, mean_count);
+  auto counts = vector_mdspan<int const>(counts_buffer.data(), counts_buffer.size());
+  size_t size = 0;
+  for (auto _ : state) {
+    stdex::ragged_array<T> a(stdex::execution::par, counts);
+    size = a.size();
+    benchmark::DoNotOptimize(a.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(size * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Ragged_Construct, int_1M_16, int(), 1000000, 16);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Ragged_Construct, int_1M_2, int(), 1000000, 2);
+
+template <class T>
+void BM_Raw_OpenMP_VectorOfVectors_Construct(benchmark::State& state, T, size_t num_rows, int mean_count) {
+  auto counts = make_counts(num_rows, mean_count);
+  size_t size = 0;
+  for (auto _ : state) {
+    std::vector<std::vector<T>> a(num_rows);
+    #pragma omp parallel for
+    for(size_t i = 0; i < num_rows; ++i) {
+      a[i].resize(counts[i]);
+    }
+    benchmark::DoNotOptimize(a.data());
+    benchmark::ClobberMemory();
+    size = 0;
+    for(auto c : counts) size += size_t(c);
+  }
+  state.SetBytesProcessed(size * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_VectorOfVectors_Construct, int_1M_16, int(), 1000000, 16);
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_VectorOfVectors_Construct, int_1M_2, int(), 1000000, 2);
+
+//================================================================================
+
+// Neighbour-list gather: y(i) = sum over the neighbours j of row i of x(j)
+
+template <class T>
+void BM_MDSpan_OpenMP_Ragged_Gather(benchmark::State& state, T, size_t num_rows, int mean_count) {
+  auto counts_buffer = make_counts(num_rows, mean_count);
+  stdex::ragged_array<int> neighbours(stdex::execution::par,
+    vector_mdspan<int const>(counts_buffer.data(), counts_buffer.size()));
+  auto nbr = neighbours.view();
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> idx_dist(0, int(num_rows) - 1);
+  for(size_t i = 0; i < num_rows; ++i) {
+    for(size_t j = 0; j < nbr.mapping().row_length(i); ++j) nbr(i, j) = idx_dist(gen);
+  }
+
+  std::vector<T> x_buffer(num_rows), y_buffer(num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), num_rows);
+  auto y = vector_mdspan<T>(y_buffer.data(), num_rows);
+  OpenMP_first_touch_1D(x);
+  OpenMP_first_touch_1D(y);
+  mdspan_benchmark::fill_random(x);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x.data());
+    #pragma omp parallel for
+    for(size_t i = 0; i < num_rows; ++i) {
+      T sum = 0;
+      size_t len = nbr.mapping().row_length(i);
+      for(size_t j = 0; j < len; ++j) {
+        sum += x(size_t(nbr(i, j)));
+      }
+      y(i) = sum;
+    }
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(neighbours.size() * (sizeof(int) + sizeof(T)) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Ragged_Gather, double_1M_16, double(), 1000000, 16);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Ragged_Gather, double_1M_2, double(), 1000000, 2);
+
+template <class T>
+void BM_Raw_OpenMP_VectorOfVectors_Gather(benchmark::State& state, T, size_t num_rows, int mean_count) {
+  auto counts = make_counts(num_rows, mean_count);
+  std::vector<std::vector<int>> nbr(num_rows);
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> idx_dist(0, int(num_rows) - 1);
+  size_t size = 0;
+  for(size_t i = 0; i < num_rows; ++i) {
+    nbr[i].resize(counts[i]);
+    for(auto& j : nbr[i]) j = idx_dist(gen);
+    size += nbr[i].size();
+  }
+
+  std::vector<T> x_buffer(num_rows), y_buffer(num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), num_rows);
+  OpenMP_first_touch_1D(x);
+  OpenMP_first_touch_1D(vector_mdspan<T>(y_buffer.data(), num_rows));
+  mdspan_benchmark::fill_random(x);
+  T const* p_x = x_buffer.data();
+  T* p_y = y_buffer.data();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_x);
+    #pragma omp parallel for
+    for(size_t i = 0; i < num_rows; ++i) {
+      T sum = 0;
+      for(int j : nbr[i]) {
+        sum += p_x[j];
+      }
+      p_y[i] = sum;
+    }
+    benchmark::DoNotOptimize(p_y);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(size * (sizeof(int) + sizeof(T)) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_VectorOfVectors_Gather, double_1M_16, double(), 1000000, 16);
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_VectorOfVectors_Gather, double_1M_2, double(), 1000000, 2);
+
+//================================================================================
+
+BENCHMARK_MAIN();
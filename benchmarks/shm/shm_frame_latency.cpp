@@ -0,0 +1,217 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "fill.hpp"
+
+//================================================================================
+// Frame latency between two processes: the producer hands an n^3 float frame
+// to a forked consumer, which sums it and sends the sum back.  One iteration
+// is one round trip, so the time per iteration is the latency of a frame
+// including the consumer's pass over it.  With shared_mdarray the frame never
+// moves and the hand-off is a generation counter; with a pipe every frame is
+// copied through the kernel, in chunks of the pipe buffer size.  The second
+// argument selects what the consumer does with a frame: 1 sums it, 0 only
+// reads its first and last elements, which isolates the cost of the hand-off.
+
+using frame_extents = stdex::dextents<3>;
+using ack_extents = stdex::extents<1>;
+
+namespace {
+
+std::string segment_name(char const* tag) {
+  return std::string("/mdspan_bench_") + tag + "_" + std::to_string(::getpid());
+}
+
+template <class MDSpan>
+double consume_frame(MDSpan f, bool sum_all) {
+  if(!sum_all) return double(f(0, 0, 0)) + double(f(f.extent(0) - 1, f.extent(1) - 1, f.extent(2) - 1));
+  double sum = 0;
+  for(size_t i = 0; i < f.extent(0); ++i)
+    for(size_t j = 0; j < f.extent(1); ++j)
+      for(size_t k = 0; k < f.extent(2); ++k)
+        sum += f(i, j, k);
+  return sum;
+}
+
+bool write_all(int fd, void const* p, size_t n) {
+  auto* c = static_cast<char const*>(p);
+  while(n > 0) {
+    auto w = ::write(fd, c, n);
+    if(w <= 0) return false;
+    c += w;
+    n -= size_t(w);
+  }
+  return true;
+}
+
+bool read_all(int fd, void* p, size_t n) {
+  auto* c = static_cast<char*>(p);
+  while(n > 0) {
+    auto r = ::read(fd, c, n);
+    if(r <= 0) return false;
+    c += r;
+    n -= size_t(r);
+  }
+  return true;
+}
+
+} // namespace
+
+//================================================================================
+
+void BM_MDSpan_Shm_Frame_Latency(benchmark::State& state) {
+  size_t n = size_t(state.range(0));
+  bool sum_all = state.range(1) != 0;
+  auto frame_name = segment_name("frame");
+  auto ack_name = segment_name("ack");
+  stdex::shared_mdarray<float, frame_extents> frame(frame_name.c_str(), stdex::layout_right::mapping<frame_extents>(frame_extents(n, n, n)));
+  stdex::shared_mdarray<double, ack_extents> ack(ack_name.c_str(), stdex::layout_right::mapping<ack_extents>());
+  mdspan_benchmark::fill_random(frame.view());
+  frame.view()(0, 0, 0) = 0;
+
+  pid_t child = ::fork();
+  if(child == 0) {
+    stdex::shared_mdarray<float const, frame_extents> in(frame_name.c_str());
+    stdex::shared_mdarray<double, ack_extents> out(ack_name.c_str());
+    uint64_t seen = 0;
+    for(;;) {
+      seen = in.wait_for_update(seen);
+      auto f = in.view();
+      // a negative first element ends the stream
+      if(f(0, 0, 0) < 0) ::_exit(0);
+      out.view()(0) = consume_frame(f, sum_all);
+      out.publish();
+    }
+  }
+  if(child < 0) {
+    state.SkipWithError("fork failed");
+    return;
+  }
+
+  uint64_t acked = 0;
+  float stamp = 0;
+  for (auto _ : state) {
+    frame.view()(0, 0, 0) = ++stamp;
+    frame.publish();
+    acked = ack.wait_for_update(acked);
+    benchmark::DoNotOptimize(ack.view()(0));
+  }
+  frame.view()(0, 0, 0) = -1;
+  frame.publish();
+  ::waitpid(child, nullptr, 0);
+  state.SetBytesProcessed(int64_t(frame.size_bytes()) * state.iterations());
+}
+BENCHMARK(BM_MDSpan_Shm_Frame_Latency)
+  ->Args({32, 0})->Args({64, 0})->Args({128, 0})
+  ->Args({32, 1})->Args({64, 1})->Args({128, 1})
+  ->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+//================================================================================
+
+void BM_Raw_Pipe_Frame_Latency(benchmark::State& state) {
+  size_t n = size_t(state.range(0));
+  bool sum_all = state.range(1) != 0;
+  std::vector<float> buffer(n * n * n);
+  auto frame = stdex::mdspan<float, frame_extents>(buffer.data(), n, n, n);
+  mdspan_benchmark::fill_random(frame);
+  size_t bytes = buffer.size() * sizeof(float);
+
+  int to_child[2], to_parent[2];
+  if(::pipe(to_child) != 0 || ::pipe(to_parent) != 0) {
+    state.SkipWithError("pipe failed");
+    return;
+  }
+  pid_t child = ::fork();
+  if(child == 0) {
+    ::close(to_child[1]);
+    ::close(to_parent[0]);
+    std::vector<float> in_buffer(buffer.size());
+    auto in = stdex::mdspan<float const, frame_extents>(in_buffer.data(), n, n, n);
+    // end of file on the frame pipe ends the stream
+    while(read_all(to_child[0], in_buffer.data(), bytes)) {
+      double sum = consume_frame(in, sum_all);
+      if(!write_all(to_parent[1], &sum, sizeof(sum))) break;
+    }
+    ::_exit(0);
+  }
+  ::close(to_child[0]);
+  ::close(to_parent[1]);
+  if(child < 0) {
+    state.SkipWithError("fork failed");
+    return;
+  }
+
+  float stamp = 0;
+  for (auto _ : state) {
+    frame(0, 0, 0) = ++stamp;
+    double sum = 0;
+    if(!write_all(to_child[1], buffer.data(), bytes) || !read_all(to_parent[0], &sum, sizeof(sum))) {
+      state.SkipWithError("pipe transfer failed");
+      break;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  ::close(to_child[1]);
+  ::close(to_parent[0]);
+  ::waitpid(child, nullptr, 0);
+  state.SetBytesProcessed(int64_t(bytes) * state.iterations());
+}
+BENCHMARK(BM_Raw_Pipe_Frame_Latency)
+  ->Args({32, 0})->Args({64, 0})->Args({128, 0})
+  ->Args({32, 1})->Args({64, 1})->Args({128, 1})
+  ->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,192 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "fill.hpp"
+#include "temp_file.hpp"
+
+//================================================================================
+// A 512 MB raw float volume streamed through a slab_reader in 8 MB slabs
+// with O_DIRECT, while each slab is reduced.  The device limit is the rate
+// of the same reads with nothing else to do, and the compute limit the rate
+// of the reduction on data in memory; a perfectly overlapped pipeline runs
+// at the lower of the two.
+
+using volume_extents = stdex::extents<stdex::dynamic_extent, 256, 256>;
+
+constexpr size_t volume_rows = 2048;
+constexpr size_t slab_rows = 32;
+constexpr size_t volume_bytes = volume_rows * 256 * 256 * sizeof(float);
+constexpr size_t slab_bytes = slab_rows * 256 * 256 * sizeof(float);
+
+mdspan_benchmark::temp_file const& volume_file() {
+  static mdspan_benchmark::temp_file file("slabs.f32", [](std::string const& path) {
+    using flat_extents = stdex::dextents<3>;
+    stdex::mapped_mdarray<float, flat_extents> volume(path.c_str(),
+      stdex::layout_right::mapping<flat_extents>(flat_extents(volume_rows, 256, 256)), stdex::mapped_file_mode::create);
+    mdspan_benchmark::fill_random(volume.view());
+    volume.sync();
+  });
+  return file;
+}
+
+template <class MDSpan>
+double sum_of_squares(MDSpan s) {
+  double sum = 0;
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      for(size_t k = 0; k < s.extent(2); ++k) {
+        double x = s(i, j, k);
+        sum += x * x;
+      }
+    }
+  }
+  return sum;
+}
+
+// Sequential O_DIRECT reads of one slab at a time, in bytes per second
+double read_volume_direct() {
+  auto const& path = volume_file().path;
+  void* buffer = nullptr;
+  if(::posix_memalign(&buffer, 4096, slab_bytes) != 0) return 0;
+  int fd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+  if(fd < 0) fd = ::open(path.c_str(), O_RDONLY);
+  auto start = std::chrono::steady_clock::now();
+  for(size_t offset = 0; offset < volume_bytes; offset += slab_bytes) {
+    benchmark::DoNotOptimize(::pread(fd, buffer, slab_bytes, off_t(offset)));
+  }
+  auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  ::close(fd);
+  std::free(buffer);
+  return double(volume_bytes) / seconds;
+}
+
+double device_bytes_per_second() {
+  static double rate = [] {
+    volume_file().evict();
+    read_volume_direct();
+    return read_volume_direct();
+  }();
+  return rate;
+}
+
+//================================================================================
+
+void BM_Raw_Read_Device(benchmark::State& state) {
+  volume_file();
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(read_volume_direct());
+  }
+  state.SetBytesProcessed(volume_bytes * state.iterations());
+}
+BENCHMARK(BM_Raw_Read_Device)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_Raw_Compute_Sum(benchmark::State& state) {
+  auto buffer = std::make_unique<float[]>(slab_rows * 256 * 256);
+  auto slab = stdex::mdspan<float, volume_extents>(buffer.get(), slab_rows);
+  mdspan_benchmark::fill_random(slab);
+  for (auto _ : state) {
+    double sum = 0;
+    for(size_t s = 0; s < volume_rows / slab_rows; ++s) {
+      benchmark::DoNotOptimize(buffer.get());
+      sum += sum_of_squares(stdex::mdspan<float const, volume_extents>(slab));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(volume_bytes * state.iterations());
+}
+BENCHMARK(BM_Raw_Compute_Sum)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_MDSpan_SlabReader_Sum(benchmark::State& state, stdex::slab_io_backend backend) {
+  auto const& path = volume_file().path;
+  double device = device_bytes_per_second();
+  stdex::slab_reader_options options;
+  options.backend = backend;
+  options.num_buffers = size_t(state.range(0));
+  options.direct_io = true;
+  stdex::slab_reader<float, volume_extents> reader(path.c_str(), volume_extents(volume_rows), slab_rows, options);
+  if(reader.backend() != backend) {
+    state.SkipWithError("backend unavailable");
+    return;
+  }
+  double seconds = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    volume_file().evict();
+    state.ResumeTiming();
+    auto start = std::chrono::steady_clock::now();
+    double sum = 0;
+    reader.for_each_slab([&](stdex::mdspan<float const, volume_extents> slab, size_t) {
+      sum += sum_of_squares(slab);
+    });
+    benchmark::DoNotOptimize(sum);
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  state.SetBytesProcessed(volume_bytes * state.iterations());
+  state.counters["device_GBps"] = device / 1e9;
+  // achieved rate as a fraction of the device limit
+  state.counters["of_device"] = double(volume_bytes) * double(state.iterations()) / seconds / device;
+  state.counters["direct_io"] = reader.direct_io();
+}
+BENCHMARK_CAPTURE(BM_MDSpan_SlabReader_Sum, io_uring, stdex::slab_io_backend::io_uring)
+  ->ArgName("buffers")->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_MDSpan_SlabReader_Sum, threads, stdex::slab_io_backend::threads)
+  ->ArgName("buffers")->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,232 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <omp.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "fill.hpp"
+#include "sparse_matrices.hpp"
+
+//================================================================================
+
+template <class T>
+using vector_mdspan = stdex::mdspan<T, stdex::dextents<1>>;
+
+enum class matrix_kind { banded_uniform, power_law_shuffled, power_law_sorted };
+
+static constexpr size_t global_num_rows = 1000000;
+
+// The matrices take a while to generate, so every kind is built once
+template <class T>
+mdspan_benchmark::csr_arrays<T> const& get_matrix(matrix_kind kind) {
+  static auto banded = mdspan_benchmark::make_banded_random_csr<T>(global_num_rows, 4, 12, 4096);
+  static auto shuffled = mdspan_benchmark::make_power_law_csr<T>(global_num_rows, 2.5, 2, 1 << 16, false);
+  static auto sorted = mdspan_benchmark::make_power_law_csr<T>(global_num_rows, 2.5, 2, 1 << 16, true);
+  switch(kind) {
+    case matrix_kind::banded_uniform: return banded;
+    case matrix_kind::power_law_shuffled: return shuffled;
+    default: return sorted;
+  }
+}
+
+template <class T>
+stdex::csr_matrix_view<T const> as_view(mdspan_benchmark::csr_arrays<T> const& A) {
+  return stdex::csr_matrix_view<T const>(A.num_cols,
+    vector_mdspan<size_t const>(A.row_ptr.data(), A.row_ptr.size()),
+    vector_mdspan<int const>(A.col_idx.data(), A.col_idx.size()),
+    vector_mdspan<T const>(A.values.data(), A.values.size())
+  );
+}
+
+template <class T>
+void OpenMP_first_touch_1D(vector_mdspan<T> s) {
+  #pragma omp parallel for
+  for(size_t i = 0; i < s.extent(0); i ++) {
+    s(i) = 0;
+  }
+}
+
+// Largest per-thread share of the stored entries relative to the average,
+// given the first row of every thread
+template <class T>
+double nnz_imbalance(mdspan_benchmark::csr_arrays<T> const& A, std::vector<size_t> const& splits) {
+  size_t max_nnz = 0;
+  for(size_t t = 0; t + 1 < splits.size(); ++t) {
+    max_nnz = std::max(max_nnz, A.row_ptr[splits[t + 1]] - A.row_ptr[splits[t]]);
+  }
+  return double(max_nnz) * double(splits.size() - 1) / double(A.nnz());
+}
+
+template <class T>
+void set_counters(benchmark::State& state, mdspan_benchmark::csr_arrays<T> const& A, double imbalance) {
+  size_t bytes = A.nnz() * (sizeof(T) + sizeof(int) + sizeof(T)) + A.num_rows * (sizeof(T) + sizeof(size_t));
+  state.SetBytesProcessed(bytes * state.iterations());
+  state.counters["imbalance"] = imbalance;
+  state.counters["threads"] = omp_get_max_threads();
+  state.counters["FLOPS"] = benchmark::Counter(
+    2.0 * double(A.nnz()), benchmark::Counter::kIsIterationInvariantRate
+  );
+}
+
+//================================================================================
+
+template <class T>
+void BM_MDSpan_OpenMP_CSR_SpMV(benchmark::State& state, T, matrix_kind kind) {
+  auto const& csr = get_matrix<T>(kind);
+  auto A = as_view(csr);
+
+  std::vector<T> x_buffer(csr.num_cols), y_buffer(csr.num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), x_buffer.size());
+  auto y = vector_mdspan<T>(y_buffer.data(), y_buffer.size());
+  OpenMP_first_touch_1D(x);
+  OpenMP_first_touch_1D(y);
+  mdspan_benchmark::fill_random(x);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x.data());
+    stdex::sparse_matrix_vector_product(stdex::execution::par, A, x, y);
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+
+  size_t num_threads = size_t(omp_get_max_threads());
+  std::vector<size_t> splits;
+  for(size_t t = 0; t <= num_threads; ++t) splits.push_back(A.balanced_row_split(t, num_threads));
+  set_counters(state, csr, nnz_imbalance(csr, splits));
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_CSR_SpMV, banded_uniform, double(), matrix_kind::banded_uniform);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_CSR_SpMV, power_law_shuffled, double(), matrix_kind::power_law_shuffled);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_CSR_SpMV, power_law_sorted, double(), matrix_kind::power_law_sorted);
+
+//================================================================================
+
+template <class T>
+void BM_Raw_OpenMP_CSR_SpMV_static(benchmark::State& state, T, matrix_kind kind) {
+  auto const& csr = get_matrix<T>(kind);
+
+  std::vector<T> x_buffer(csr.num_cols), y_buffer(csr.num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), x_buffer.size());
+  OpenMP_first_touch_1D(x);
+  OpenMP_first_touch_1D(vector_mdspan<T>(y_buffer.data(), y_buffer.size()));
+  mdspan_benchmark::fill_random(x);
+
+  size_t num_rows = csr.num_rows;
+  size_t const* row_ptr = csr.row_ptr.data();
+  int const* col_idx = csr.col_idx.data();
+  T const* values = csr.values.data();
+  T const* p_x = x_buffer.data();
+  T* p_y = y_buffer.data();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_x);
+    #pragma omp parallel for schedule(static)
+    for(size_t i = 0; i < num_rows; ++i) {
+      T sum = 0;
+      for(size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+        sum += values[k] * p_x[col_idx[k]];
+      }
+      p_y[i] = sum;
+    }
+    benchmark::DoNotOptimize(p_y);
+    benchmark::ClobberMemory();
+  }
+
+  // schedule(static) hands every thread one contiguous block of rows
+  size_t num_threads = size_t(omp_get_max_threads());
+  size_t block = (num_rows + num_threads - 1) / num_threads;
+  std::vector<size_t> splits;
+  for(size_t t = 0; t <= num_threads; ++t) splits.push_back(std::min(num_rows, t * block));
+  set_counters(state, csr, nnz_imbalance(csr, splits));
+}
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_CSR_SpMV_static, banded_uniform, double(), matrix_kind::banded_uniform);
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_CSR_SpMV_static, power_law_shuffled, double(), matrix_kind::power_law_shuffled);
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_CSR_SpMV_static, power_law_sorted, double(), matrix_kind::power_law_sorted);
+
+//================================================================================
+
+template <class T>
+void BM_Raw_OpenMP_CSR_SpMV_dynamic(benchmark::State& state, T, matrix_kind kind, int chunk) {
+  auto const& csr = get_matrix<T>(kind);
+
+  std::vector<T> x_buffer(csr.num_cols), y_buffer(csr.num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), x_buffer.size());
+  OpenMP_first_touch_1D(x);
+  OpenMP_first_touch_1D(vector_mdspan<T>(y_buffer.data(), y_buffer.size()));
+  mdspan_benchmark::fill_random(x);
+
+  size_t num_rows = csr.num_rows;
+  size_t const* row_ptr = csr.row_ptr.data();
+  int const* col_idx = csr.col_idx.data();
+  T const* values = csr.values.data();
+  T const* p_x = x_buffer.data();
+  T* p_y = y_buffer.data();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_x);
+    #pragma omp parallel for schedule(dynamic, chunk)
+    for(size_t i = 0; i < num_rows; ++i) {
+      T sum = 0;
+      for(size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+        sum += values[k] * p_x[col_idx[k]];
+      }
+      p_y[i] = sum;
+    }
+    benchmark::DoNotOptimize(p_y);
+    benchmark::ClobberMemory();
+  }
+  // assigned at run time; the imbalance is only known to be at most one chunk
+  set_counters(state, csr, 1.0);
+}
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_CSR_SpMV_dynamic, banded_uniform, double(), matrix_kind::banded_uniform, 256);
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_CSR_SpMV_dynamic, power_law_shuffled, double(), matrix_kind::power_law_shuffled, 256);
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_CSR_SpMV_dynamic, power_law_sorted, double(), matrix_kind::power_law_sorted, 256);
+
+//================================================================================
+
+BENCHMARK_MAIN();
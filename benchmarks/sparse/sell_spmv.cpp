@@ -0,0 +1,147 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "fill.hpp"
+#include "sparse_matrices.hpp"
+
+//================================================================================
+
+template <class T>
+using vector_mdspan = stdex::mdspan<T, stdex::dextents<1>>;
+
+template <class T, class IndexType>
+auto as_mdspans(mdspan_benchmark::csr_arrays<T, IndexType> const& A) {
+  return std::make_tuple(
+    vector_mdspan<size_t const>(A.row_ptr.data(), A.row_ptr.size()),
+    vector_mdspan<IndexType const>(A.col_idx.data(), A.col_idx.size()),
+    vector_mdspan<T const>(A.values.data(), A.values.size())
+  );
+}
+
+//================================================================================
+
+template <class T, size_t C>
+void BM_MDSpan_SELL_SpMV(benchmark::State& state, T, std::integral_constant<size_t, C>,
+  size_t num_rows, size_t min_len, size_t max_len, size_t sigma
+) {
+  auto csr = mdspan_benchmark::make_banded_random_csr<T>(num_rows, min_len, max_len, 4096);
+  auto arrays = as_mdspans(csr);
+  stdex::sell_matrix<T, C> A(
+    csr.num_cols, std::get<0>(arrays), std::get<1>(arrays), std::get<2>(arrays), sigma
+  );
+
+  std::vector<T> x_buffer(csr.num_cols), y_buffer(csr.num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), x_buffer.size());
+  auto y = vector_mdspan<T>(y_buffer.data(), y_buffer.size());
+  mdspan_benchmark::fill_random(x);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x.data());
+    stdex::sparse_matrix_vector_product(A, x, y);
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  // values, column indices and y, plus x once per stored entry
+  size_t bytes = A.num_stored() * (sizeof(T) + sizeof(int) + sizeof(T)) + csr.num_rows * sizeof(T);
+  state.SetBytesProcessed(bytes * state.iterations());
+  state.counters["padding"] = double(A.num_stored()) / double(csr.nnz());
+  state.counters["FLOPS"] = benchmark::Counter(
+    2.0 * double(csr.nnz()), benchmark::Counter::kIsIterationInvariantRate
+  );
+}
+BENCHMARK_CAPTURE(BM_MDSpan_SELL_SpMV, C4_sigma1,    double(), std::integral_constant<size_t, 4>{},  1000000, 4, 32, 1);
+BENCHMARK_CAPTURE(BM_MDSpan_SELL_SpMV, C8_sigma1,    double(), std::integral_constant<size_t, 8>{},  1000000, 4, 32, 1);
+BENCHMARK_CAPTURE(BM_MDSpan_SELL_SpMV, C8_sigma256,  double(), std::integral_constant<size_t, 8>{},  1000000, 4, 32, 256);
+BENCHMARK_CAPTURE(BM_MDSpan_SELL_SpMV, C16_sigma256, double(), std::integral_constant<size_t, 16>{}, 1000000, 4, 32, 256);
+BENCHMARK_CAPTURE(BM_MDSpan_SELL_SpMV, C32_sigma1024, double(), std::integral_constant<size_t, 32>{}, 1000000, 4, 32, 1024);
+BENCHMARK_CAPTURE(BM_MDSpan_SELL_SpMV, float_C16_sigma256, float(), std::integral_constant<size_t, 16>{}, 1000000, 4, 32, 256);
+
+//================================================================================
+
+template <class T>
+void BM_Raw_CSR_SpMV(benchmark::State& state, T, size_t num_rows, size_t min_len, size_t max_len) {
+  auto csr = mdspan_benchmark::make_banded_random_csr<T>(num_rows, min_len, max_len, 4096);
+
+  std::vector<T> x_buffer(csr.num_cols), y_buffer(csr.num_rows);
+  auto x = vector_mdspan<T>(x_buffer.data(), x_buffer.size());
+  mdspan_benchmark::fill_random(x);
+
+  size_t const* row_ptr = csr.row_ptr.data();
+  int const* col_idx = csr.col_idx.data();
+  T const* values = csr.values.data();
+  T const* p_x = x_buffer.data();
+  T* p_y = y_buffer.data();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_x);
+    for(size_t i = 0; i < num_rows; ++i) {
+      T sum = 0;
+      for(size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+        sum += values[k] * p_x[col_idx[k]];
+      }
+      p_y[i] = sum;
+    }
+    benchmark::DoNotOptimize(p_y);
+    benchmark::ClobberMemory();
+  }
+  size_t bytes = csr.nnz() * (sizeof(T) + sizeof(int) + sizeof(T)) + num_rows * (sizeof(T) + sizeof(size_t));
+  state.SetBytesProcessed(bytes * state.iterations());
+  state.counters["FLOPS"] = benchmark::Counter(
+    2.0 * double(csr.nnz()), benchmark::Counter::kIsIterationInvariantRate
+  );
+}
+BENCHMARK_CAPTURE(BM_Raw_CSR_SpMV, double, double(), 1000000, 4, 32);
+BENCHMARK_CAPTURE(BM_Raw_CSR_SpMV, float, float(), 1000000, 4, 32);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef MDSPAN_BENCHMARKS_SPARSE_SPARSE_MATRICES_HPP
+#define MDSPAN_BENCHMARKS_SPARSE_SPARSE_MATRICES_HPP
+
+#include <experimental/mdspan>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace mdspan_benchmark {
+
+// Plain compressed sparse row arrays, used both to generate the synthetic
+// test matrices and as the reference storage format
+template <class T, class IndexType = int>
+struct csr_arrays {
+  size_t num_rows = 0;
+  size_t num_cols = 0;
+  std::vector<size_t> row_ptr;
+  std::vector<IndexType> col_idx;
+  std::vector<T> values;
+
+  size_t nnz() const { return values.size(); }
+};
+
+// Rows of uniformly random length in [min_len, max_len], with sorted column
+// indices drawn from a band of width `bandwidth` around the diagonal
+template <class T, class IndexType = int>
+csr_arrays<T, IndexType> make_banded_random_csr(
+  size_t num_rows, size_t min_len, size_t max_len, size_t bandwidth, unsigned seed = 1234
+)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<size_t> len_dist(min_len, max_len);
+  std::uniform_int_distribution<int> val_dist(0, 127);
+  csr_arrays<T, IndexType> A;
+  A.num_rows = num_rows;
+  A.num_cols = num_rows;
+  A.row_ptr.reserve(num_rows + 1);
+  A.row_ptr.push_back(0);
+  std::vector<IndexType> row_cols;
+  for(size_t i = 0; i < num_rows; ++i) {
+    size_t first = i > bandwidth / 2 ? i - bandwidth / 2 : 0;
+    size_t last = std::min(num_rows, first + bandwidth);
+    size_t len = std::min(len_dist(gen), last - first);
+    std::uniform_int_distribution<size_t> col_dist(first, last - 1);
+    row_cols.clear();
+    while(row_cols.size() < len) {
+      auto j = IndexType(col_dist(gen));
+      if(std::find(row_cols.begin(), row_cols.end(), j) == row_cols.end()) row_cols.push_back(j);
+    }
+    std::sort(row_cols.begin(), row_cols.end());
+    for(auto j : row_cols) {
+      A.col_idx.push_back(j);
+      A.values.push_back(T(val_dist(gen)));
+    }
+    A.row_ptr.push_back(A.col_idx.size());
+  }
+  return A;
+}
+
+// Row lengths drawn from a Pareto distribution with exponent `alpha` and
+// minimum `min_len` (truncated at `max_len`), as in the degree distribution of
+// many real-world graphs.  Column indices are uniformly random over all
+// columns.  With `heavy_rows_first`, rows are ordered by decreasing length,
+// like a graph whose vertices are numbered by degree, which is the worst case
+// for static row partitioning.
+template <class T, class IndexType = int>
+csr_arrays<T, IndexType> make_power_law_csr(
+  size_t num_rows, double alpha, size_t min_len, size_t max_len,
+  bool heavy_rows_first, unsigned seed = 1234
+)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> u_dist(0.0, 1.0);
+  std::uniform_int_distribution<size_t> col_dist(0, num_rows - 1);
+  std::uniform_int_distribution<int> val_dist(0, 127);
+
+  std::vector<size_t> lengths(num_rows);
+  for(auto& len : lengths) {
+    double u = 1.0 - u_dist(gen); // in (0, 1]
+    double len_d = double(min_len) * std::pow(u, -1.0 / (alpha - 1.0));
+    len = len_d >= double(max_len) ? max_len : size_t(len_d);
+  }
+  if(heavy_rows_first) {
+    std::sort(lengths.begin(), lengths.end(), std::greater<size_t>());
+  }
+
+  csr_arrays<T, IndexType> A;
+  A.num_rows = num_rows;
+  A.num_cols = num_rows;
+  A.row_ptr.reserve(num_rows + 1);
+  A.row_ptr.push_back(0);
+  std::vector<IndexType> row_cols;
+  for(size_t i = 0; i < num_rows; ++i) {
+    // duplicates are dropped, so long rows come out slightly shorter
+    row_cols.resize(lengths[i]);
+    for(auto& j : row_cols) j = IndexType(col_dist(gen));
+    std::sort(row_cols.begin(), row_cols.end());
+    row_cols.erase(std::unique(row_cols.begin(), row_cols.end()), row_cols.end());
+    for(auto j : row_cols) {
+      A.col_idx.push_back(j);
+      A.values.push_back(T(val_dist(gen)));
+    }
+    A.row_ptr.push_back(A.col_idx.size());
+  }
+  return A;
+}
+
+} // namespace mdspan_benchmark
+
+#endif // MDSPAN_BENCHMARKS_SPARSE_SPARSE_MATRICES_HPP
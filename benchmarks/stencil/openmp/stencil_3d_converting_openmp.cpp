@@ -0,0 +1,171 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "fill.hpp"
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+//================================================================================
+
+// The 3D stencil of stencil_3d_openmp.cpp on fields stored in reduced
+// precision through converting_accessor / quantized_accessor, computing in
+// float.  items_per_second counts output points, so that the precisions can
+// be compared directly; bytes_per_second counts the storage actually read
+// and written.
+
+static constexpr int global_delta = 1;
+
+template <class MDSpan>
+void OpenMP_first_touch_3D(MDSpan s) {
+  #pragma omp parallel for
+  for(size_t i = 0; i < s.extent(0); i ++) {
+    for(size_t j = 0; j < s.extent(1); j ++) {
+      for(size_t k = 0; k < s.extent(2); k ++) {
+        s(i,j,k) = 0;
+      }
+    }
+  }
+}
+
+//================================================================================
+
+template <class Accessor>
+void BM_MDSpan_OpenMP_Stencil_3D_Converting(benchmark::State& state, Accessor acc, size_t x, size_t y, size_t z) {
+
+  using MDSpan = stdex::mdspan<typename Accessor::element_type, stdex::dextents<3>, stdex::layout_right, Accessor>;
+  using value_type = typename MDSpan::value_type;
+  using storage_type = std::remove_pointer_t<typename Accessor::pointer>;
+  auto map = typename MDSpan::mapping_type(stdex::dextents<3>(x, y, z));
+
+  auto buffer_s = std::make_unique<storage_type[]>(map.required_span_size());
+  auto s = MDSpan{buffer_s.get(), map, acc};
+  OpenMP_first_touch_3D(s);
+  mdspan_benchmark::fill_random(s);
+
+  auto buffer_o = std::make_unique<storage_type[]>(map.required_span_size());
+  auto o = MDSpan{buffer_o.get(), map, acc};
+  OpenMP_first_touch_3D(o);
+
+  int d = global_delta;
+
+  for (auto _ : state) {
+    #pragma omp parallel for
+    for(size_t i = d; i < s.extent(0)-d; i ++) {
+      for(size_t j = d; j < s.extent(1)-d; j ++) {
+        for(size_t k = d; k < s.extent(2)-d; k ++) {
+          value_type sum_local = 0;
+          for(size_t di = i-d; di < i+d+1; di++) {
+          for(size_t dj = j-d; dj < j+d+1; dj++) {
+          for(size_t dk = k-d; dk < k+d+1; dk++) {
+            sum_local += s(di, dj, dk);
+          }}}
+          o(i,j,k) = sum_local * value_type(1.0 / 27.0);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(o.data());
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (s.extent(0)-2*d) * (s.extent(1)-2*d) * (s.extent(2)-2*d);
+  state.SetItemsProcessed(num_inner_elements * state.iterations());
+  state.SetBytesProcessed(2 * num_inner_elements * sizeof(storage_type) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Stencil_3D_Converting, float, stdex::default_accessor<float>(), 256, 256, 256);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Stencil_3D_Converting, float16, stdex::converting_accessor<stdex::float16_storage, float>(), 256, 256, 256);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Stencil_3D_Converting, bfloat16, stdex::converting_accessor<stdex::bfloat16_storage, float>(), 256, 256, 256);
+BENCHMARK_CAPTURE(BM_MDSpan_OpenMP_Stencil_3D_Converting, int8, stdex::quantized_accessor<int8_t, float>(1.0f, -64), 256, 256, 256);
+
+//================================================================================
+
+template <class T>
+void BM_Raw_OpenMP_Stencil_3D_Float(benchmark::State& state, T, size_t x, size_t y, size_t z) {
+
+  using MDSpan = stdex::mdspan<T, stdex::dextents<3>>;
+  auto buffer_size = x * y * z;
+
+  auto buffer_s = std::make_unique<T[]>(buffer_size);
+  auto s = MDSpan{buffer_s.get(), x,y,z};
+  OpenMP_first_touch_3D(s);
+  mdspan_benchmark::fill_random(s);
+  T* s_ptr = s.data();
+
+  auto buffer_o = std::make_unique<T[]>(buffer_size);
+  auto o = MDSpan{buffer_o.get(), x,y,z};
+  OpenMP_first_touch_3D(o);
+  T* o_ptr = o.data();
+
+  int d = global_delta;
+
+  for (auto _ : state) {
+    #pragma omp parallel for
+    for(size_t i = d; i < x-d; i ++) {
+      for(size_t j = d; j < y-d; j ++) {
+        for(size_t k = d; k < z-d; k ++) {
+          T sum_local = 0;
+          for(size_t di = i-d; di < i+d+1; di++) {
+          for(size_t dj = j-d; dj < j+d+1; dj++) {
+          for(size_t dk = k-d; dk < k+d+1; dk++) {
+            sum_local += s_ptr[dk + dj*z + di*z*y];
+          }}}
+          o_ptr[k + j*z + i*z*y] = sum_local * T(1.0 / 27.0);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(o_ptr);
+    benchmark::ClobberMemory();
+  }
+  size_t num_inner_elements = (x-2*d) * (y-2*d) * (z-2*d);
+  state.SetItemsProcessed(num_inner_elements * state.iterations());
+  state.SetBytesProcessed(2 * num_inner_elements * sizeof(T) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Raw_OpenMP_Stencil_3D_Float, float, float(), 256, 256, 256);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "fill.hpp"
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <utility>
+
+//================================================================================
+
+template <class T, class Layout>
+using grid_mdspan = stdex::mdspan<T, stdex::dextents<3>, Layout>;
+
+// Explicit 7-point heat equation step
+struct heat_kernel {
+  template <class S>
+  double operator()(S const& s) const {
+    return 0.4 * s(0, 0, 0) + 0.1 * (s(-1, 0, 0) + s(1, 0, 0) + s(0, -1, 0) + s(0, 1, 0) + s(0, 0, -1) + s(0, 0, 1));
+  }
+};
+
+// `updates` is the rate of point updates.  The bytes processed are those a
+// pass has to move to and from memory, i.e., reading and writing the grid
+// once, so `bytes_per_update` falls as 1 / time_steps.
+template <class T>
+void set_stencil_counters(benchmark::State& state, size_t num_points, size_t time_steps) {
+  state.SetBytesProcessed(2 * num_points * sizeof(T) * state.iterations());
+  state.counters["updates"] = benchmark::Counter(
+    double(num_points * time_steps), benchmark::Counter::kIsIterationInvariantRate
+  );
+  state.counters["bytes_per_update"] = double(2 * sizeof(T)) / double(time_steps);
+}
+
+//================================================================================
+
+template <class Layout>
+void BM_MDSpan_Stencil_3D_TemporalBlocking(benchmark::State& state, Layout, size_t n, size_t time_steps) {
+  auto buffer_a = std::make_unique<double[]>(n * n * n);
+  auto buffer_b = std::make_unique<double[]>(n * n * n);
+  grid_mdspan<double, Layout> a(buffer_a.get(), n, n, n), b(buffer_b.get(), n, n, n);
+  mdspan_benchmark::fill_random(a);
+  mdspan_benchmark::fill_random(b);
+
+  for (auto _ : state) {
+    stdex::apply_stencil(a, b, 1, time_steps, heat_kernel());
+    std::swap(a, b);
+    benchmark::ClobberMemory();
+  }
+  set_stencil_counters<double>(state, n * n * n, time_steps);
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_TemporalBlocking, right_400_T1, stdex::layout_right(), 400, 1);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_TemporalBlocking, right_400_T2, stdex::layout_right(), 400, 2);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_TemporalBlocking, right_400_T4, stdex::layout_right(), 400, 4);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_TemporalBlocking, right_400_T8, stdex::layout_right(), 400, 8);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_TemporalBlocking, left_400_T1, stdex::layout_left(), 400, 1);
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_TemporalBlocking, left_400_T4, stdex::layout_left(), 400, 4);
+
+//================================================================================
+
+// One sweep over the whole grid per time step, as in stencil_3d.cpp
+template <class Layout>
+void BM_MDSpan_Stencil_3D_SweepPerStep(benchmark::State& state, Layout, size_t n) {
+  auto buffer_a = std::make_unique<double[]>(n * n * n);
+  auto buffer_b = std::make_unique<double[]>(n * n * n);
+  grid_mdspan<double, Layout> a(buffer_a.get(), n, n, n), b(buffer_b.get(), n, n, n);
+  mdspan_benchmark::fill_random(a);
+  mdspan_benchmark::fill_random(b);
+
+  for (auto _ : state) {
+    for(size_t i = 1; i < n - 1; ++i) {
+      for(size_t j = 1; j < n - 1; ++j) {
+        for(size_t k = 1; k < n - 1; ++k) {
+          b(i, j, k) = 0.4 * a(i, j, k) + 0.1 * (a(i - 1, j, k) + a(i + 1, j, k)
+            + a(i, j - 1, k) + a(i, j + 1, k) + a(i, j, k - 1) + a(i, j, k + 1));
+        }
+      }
+    }
+    std::swap(a, b);
+    benchmark::ClobberMemory();
+  }
+  set_stencil_counters<double>(state, n * n * n, 1);
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Stencil_3D_SweepPerStep, right_400, stdex::layout_right(), 400);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <type_traits>
+
+#include "../fill.hpp"
+
+//================================================================================
+
+template <size_t Axis>
+using axis_t = std::integral_constant<size_t, Axis>;
+
+template <class T, class Layout>
+using dmdspan_3d = stdex::mdspan<T, stdex::dextents<3>, Layout>;
+
+template <size_t Axis, class T, class Layout>
+void BM_MDSpan_ReduceAxis_3D(benchmark::State& state, axis_t<Axis>, T, Layout, size_t x, size_t y, size_t z) {
+  auto buffer = std::make_unique<T[]>(x * y * z);
+  auto s = dmdspan_3d<T, Layout>(buffer.get(), x, y, z);
+  mdspan_benchmark::fill_random(s);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    auto r = stdex::reduce_axis<Axis>(s);
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(s.size() * sizeof(T) * state.iterations());
+}
+
+// The obvious loop: for every result element, a sum over the reduced
+// dimension, with the remaining dimensions in index order
+template <size_t Axis, class T, class Layout>
+void BM_Naive_ReduceAxis_3D(benchmark::State& state, axis_t<Axis>, T, Layout, size_t x, size_t y, size_t z) {
+  auto buffer = std::make_unique<T[]>(x * y * z);
+  auto s = dmdspan_3d<T, Layout>(buffer.get(), x, y, z);
+  mdspan_benchmark::fill_random(s);
+  constexpr size_t d0 = Axis == 0 ? 1 : 0, d1 = Axis == 2 ? 1 : 2;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    stdex::mdarray<T, stdex::dextents<2>> r(s.extent(d0), s.extent(d1));
+    std::array<size_t, 3> idx = { };
+    for(idx[d0] = 0; idx[d0] < s.extent(d0); ++idx[d0]) {
+      for(idx[d1] = 0; idx[d1] < s.extent(d1); ++idx[d1]) {
+        T sum = 0;
+        for(idx[Axis] = 0; idx[Axis] < s.extent(Axis); ++idx[Axis]) {
+          sum += s(idx);
+        }
+        r(idx[d0], idx[d1]) = sum;
+      }
+    }
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(s.size() * sizeof(T) * state.iterations());
+}
+
+#define MDSPAN_BENCHMARK_EVERY_AXIS(bench, T, layout, X, Y, Z) \
+  BENCHMARK_CAPTURE(bench, layout##_axis0_##X##_##Y##_##Z, axis_t<0>{}, T(), stdex::layout{}, X, Y, Z); \
+  BENCHMARK_CAPTURE(bench, layout##_axis1_##X##_##Y##_##Z, axis_t<1>{}, T(), stdex::layout{}, X, Y, Z); \
+  BENCHMARK_CAPTURE(bench, layout##_axis2_##X##_##Y##_##Z, axis_t<2>{}, T(), stdex::layout{}, X, Y, Z)
+
+MDSPAN_BENCHMARK_EVERY_AXIS(BM_MDSpan_ReduceAxis_3D, float, layout_right, 200, 200, 200);
+MDSPAN_BENCHMARK_EVERY_AXIS(BM_MDSpan_ReduceAxis_3D, float, layout_left, 200, 200, 200);
+MDSPAN_BENCHMARK_EVERY_AXIS(BM_Naive_ReduceAxis_3D, float, layout_right, 200, 200, 200);
+MDSPAN_BENCHMARK_EVERY_AXIS(BM_Naive_ReduceAxis_3D, float, layout_left, 200, 200, 200);
+
+MDSPAN_BENCHMARK_EVERY_AXIS(BM_MDSpan_ReduceAxis_3D, float, layout_right, 20, 20, 20);
+MDSPAN_BENCHMARK_EVERY_AXIS(BM_Naive_ReduceAxis_3D, float, layout_right, 20, 20, 20);
+
+//================================================================================
+
+BENCHMARK_MAIN();
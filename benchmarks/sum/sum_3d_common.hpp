@@ -44,6 +44,8 @@
 #ifndef MDSPAN_BENCHMARKS_SUM_SUM_3D_COMMON_HPP
 #define MDSPAN_BENCHMARKS_SUM_SUM_3D_COMMON_HPP
 
+#include <experimental/mdspan_ext>
+
 #include <benchmark/benchmark.h>
 
 #include "fill.hpp"
@@ -259,5 +261,24 @@ void BM_Raw_Static_Sum_3D_right_iter_left(benchmark::State& state, T,
   state.SetBytesProcessed(x * y * z * sizeof(T) * state.iterations());
 }
 
+//================================================================================
+
+// The sum through stdex::reduce, which walks every layout in storage order
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Reduce_3D(benchmark::State& state, MDSpan, DynSizes... dyn) {
+  using value_type = typename MDSpan::value_type;
+  auto buffer = std::make_unique<value_type[]>(
+    MDSpan{nullptr, dyn...}.mapping().required_span_size()
+  );
+  auto s = MDSpan{buffer.get(), dyn...};
+  mdspan_benchmark::fill_random(s);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    value_type sum = stdex::reduce(stdex::execution::seq, s, value_type(0));
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+}
 
 #endif // MDSPAN_BENCHMARKS_SUM_SUM_3D_COMMON_HPP
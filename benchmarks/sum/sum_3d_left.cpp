@@ -87,6 +87,13 @@ MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_left, right_, rmdspan, 200, 200, 200);
 
 //================================================================================
 
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Reduce_3D, left_, lmdspan, 20, 20, 20);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Reduce_3D, left_, lmdspan, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Reduce_3D, float_left_dyn_d200_d200_d200, lmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>{}, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_Raw_Sum_1D, float_size_8000000, float(), 8000000);
+
+//================================================================================
+
 BENCHMARK_CAPTURE(
   BM_Raw_Sum_1D, size_8000, int(), 8000
 );
@@ -0,0 +1,170 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <memory>
+#include <new>
+
+#include "sum_3d_common.hpp"
+
+//================================================================================
+// Cost of offset_ptr_accessor relative to default_accessor: the same sums
+// through a local view, through a view stored in (and read back from) the
+// buffer it points into, and through a submdspan per row, which exercises
+// offset() and the rebasing copies of the pointer.
+
+template <class T, size_t... Es>
+using rmdspan = stdex::mdspan<T, stdex::extents<Es...>, stdex::layout_right>;
+template <class T, size_t... Es>
+using offset_rmdspan = stdex::mdspan<T, stdex::extents<Es...>, stdex::layout_right, stdex::offset_ptr_accessor<T>>;
+
+constexpr auto dyn = stdex::dynamic_extent;
+
+//================================================================================
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_right(benchmark::State& state, MDSpan, DynSizes... dyn_sizes) {
+  using value_type = typename MDSpan::value_type;
+  auto buffer = std::make_unique<value_type[]>(
+    MDSpan{nullptr, dyn_sizes...}.mapping().required_span_size()
+  );
+  auto s = MDSpan{buffer.get(), dyn_sizes...};
+  mdspan_benchmark::fill_random(s);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s);
+    value_type sum = 0;
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+        for (size_t k = 0; k < s.extent(2); ++k) {
+          sum += s(i, j, k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, default_fixed_200_200_200, rmdspan<int, 200, 200, 200>{});
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, offset_ptr_fixed_200_200_200, offset_rmdspan<int, 200, 200, 200>{});
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, default_dyn_d200_d200_d200, rmdspan<int, dyn, dyn, dyn>{}, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, offset_ptr_dyn_d200_d200_d200, offset_rmdspan<int, dyn, dyn, dyn>{}, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, default_dyn_d20_d20_d20, rmdspan<int, dyn, dyn, dyn>{}, 20, 20, 20);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right, offset_ptr_dyn_d20_d20_d20, offset_rmdspan<int, dyn, dyn, dyn>{}, 20, 20, 20);
+
+//================================================================================
+
+// The view is placement-constructed at the start of its own buffer, ahead of
+// the elements, as it would be in a shared segment, and only reached through
+// a pointer
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_3D_right_stored(benchmark::State& state, MDSpan, DynSizes... dyn_sizes) {
+  using value_type = typename MDSpan::value_type;
+  constexpr size_t header = (sizeof(MDSpan) + 63) / 64 * 64;
+  size_t span = MDSpan{nullptr, dyn_sizes...}.mapping().required_span_size();
+  auto buffer = std::make_unique<char[]>(header + span * sizeof(value_type) + 64);
+  char* base = buffer.get() + (64 - reinterpret_cast<uintptr_t>(buffer.get()) % 64);
+  auto* elements = reinterpret_cast<value_type*>(base + header);
+  MDSpan const* stored = ::new (base) MDSpan{elements, dyn_sizes...};
+  mdspan_benchmark::fill_random(MDSpan{elements, dyn_sizes...});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stored);
+    auto const& s = *stored;
+    value_type sum = 0;
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+        for (size_t k = 0; k < s.extent(2); ++k) {
+          sum += s(i, j, k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(span * sizeof(value_type) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right_stored, default_dyn_d200_d200_d200, rmdspan<int, dyn, dyn, dyn>{}, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_right_stored, offset_ptr_dyn_d200_d200_d200, offset_rmdspan<int, dyn, dyn, dyn>{}, 200, 200, 200);
+
+//================================================================================
+
+template <class MDSpan, class... DynSizes>
+void BM_MDSpan_Sum_Subspan_3D_right(benchmark::State& state, MDSpan, DynSizes... dyn_sizes) {
+  using value_type = typename MDSpan::value_type;
+  auto buffer = std::make_unique<value_type[]>(
+    MDSpan{nullptr, dyn_sizes...}.mapping().required_span_size()
+  );
+  auto s = MDSpan{buffer.get(), dyn_sizes...};
+  mdspan_benchmark::fill_random(s);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s);
+    value_type sum = 0;
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for (size_t j = 0; j < s.extent(1); ++j) {
+        auto row = stdex::submdspan(s, i, j, stdex::full_extent);
+        for (size_t k = 0; k < row.extent(0); ++k) {
+          sum += row(k);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(s.size() * sizeof(value_type) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_Subspan_3D_right, default_dyn_d200_d200_d200, rmdspan<int, dyn, dyn, dyn>{}, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_Subspan_3D_right, offset_ptr_dyn_d200_d200_d200, offset_rmdspan<int, dyn, dyn, dyn>{}, 200, 200, 200);
+
+//================================================================================
+
+BENCHMARK_CAPTURE(
+  BM_Raw_Sum_3D_right, size_200_200_200, int(), size_t(200), size_t(200), size_t(200)
+);
+
+//================================================================================
+
+BENCHMARK_MAIN();
@@ -92,6 +92,13 @@ MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Sum_3D_right, left_, lmdspan, 200, 200, 200);
 
 //================================================================================
 
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Reduce_3D, right_, rmdspan, 20, 20, 20);
+MDSPAN_BENCHMARK_ALL_3D(BM_MDSpan_Reduce_3D, right_, rmdspan, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Reduce_3D, float_right_dyn_d200_d200_d200, rmdspan<float, stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent>{}, 200, 200, 200);
+BENCHMARK_CAPTURE(BM_Raw_Sum_1D, float_size_8000000, float(), 8000000);
+
+//================================================================================
+
 BENCHMARK_CAPTURE(
   BM_Raw_Sum_3D_right, size_20_20_20, int(), size_t(20), size_t(20), size_t(20)
 );
@@ -0,0 +1,138 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../fill.hpp"
+
+//================================================================================
+// Sum of a 3D layout_right int array, visited tile by tile.  The 203^3 case
+// leaves partial tiles along every dimension.
+
+using array_3d = stdex::mdspan<int, stdex::dextents<3>>;
+
+template <size_t E0, size_t E1, size_t E2>
+using tile_t = stdex::tile_extents<E0, E1, E2>;
+
+template <class MDSpan>
+int sum_3d(MDSpan s) {
+  int sum = 0;
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      for(size_t k = 0; k < s.extent(2); ++k) {
+        sum += s(i, j, k);
+      }
+    }
+  }
+  return sum;
+}
+
+void BM_MDSpan_Sum_3D_Loops(benchmark::State& state, size_t n) {
+  auto buffer = std::make_unique<int[]>(n * n * n);
+  array_3d s(buffer.get(), n, n, n);
+  mdspan_benchmark::fill_random(s);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(sum_3d(s));
+  }
+  state.SetBytesProcessed(s.size() * sizeof(int) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Loops, size_200, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Loops, size_203, 203);
+
+// Tiles cut with submdspan and pairs of indices, so with dynamic extents
+template <size_t E0, size_t E1, size_t E2>
+void BM_MDSpan_Sum_3D_Submdspan(benchmark::State& state, tile_t<E0, E1, E2>, size_t n) {
+  auto buffer = std::make_unique<int[]>(n * n * n);
+  array_3d s(buffer.get(), n, n, n);
+  mdspan_benchmark::fill_random(s);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    int sum = 0;
+    for(size_t i = 0; i < n; i += E0) {
+      for(size_t j = 0; j < n; j += E1) {
+        for(size_t k = 0; k < n; k += E2) {
+          sum += sum_3d(stdex::submdspan(s,
+            std::make_pair(i, std::min(i + E0, n)),
+            std::make_pair(j, std::min(j + E1, n)),
+            std::make_pair(k, std::min(k + E2, n))
+          ));
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(s.size() * sizeof(int) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Submdspan, tile_4_16_64_size_200, tile_t<4, 16, 64>{}, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Submdspan, tile_4_16_64_size_203, tile_t<4, 16, 64>{}, 203);
+
+template <size_t E0, size_t E1, size_t E2>
+void BM_MDSpan_Sum_3D_Tiles(benchmark::State& state, tile_t<E0, E1, E2> te, size_t n) {
+  auto buffer = std::make_unique<int[]>(n * n * n);
+  array_3d s(buffer.get(), n, n, n);
+  mdspan_benchmark::fill_random(s);
+  auto s_tiles = stdex::tiles(s, te);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    int sum = 0;
+    s_tiles.for_each([&](auto t, std::array<size_t, 3>) { sum += sum_3d(t); });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(s.size() * sizeof(int) * state.iterations());
+}
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Tiles, tile_4_16_64_size_200, tile_t<4, 16, 64>{}, 200);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Tiles, tile_4_16_64_size_203, tile_t<4, 16, 64>{}, 203);
+BENCHMARK_CAPTURE(BM_MDSpan_Sum_3D_Tiles, tile_8_8_32_size_200, tile_t<8, 8, 32>{}, 200);
+
+//================================================================================
+
+BENCHMARK_MAIN();
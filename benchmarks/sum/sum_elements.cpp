@@ -0,0 +1,171 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <type_traits>
+
+#include "../fill.hpp"
+
+//================================================================================
+// Sums of rank 3 to 6 int arrays of 2^18 elements, with nested loops over
+// operator(), with a range-for over stdex::elements, and with
+// stdex::elements(...).for_each.  The strided cases
+// view a layout_right array padded by one element in the last dimension
+// through layout_stride.
+
+using contiguous_t = std::false_type;
+using strided_t = std::true_type;
+
+template <size_t Rank>
+using right_mdspan = stdex::mdspan<int, stdex::dextents<Rank>>;
+template <size_t Rank>
+using stride_mdspan = stdex::mdspan<int, stdex::dextents<Rank>, stdex::layout_stride>;
+
+template <class... Sizes>
+struct test_array {
+  static constexpr size_t rank = sizeof...(Sizes);
+
+  explicit test_array(Sizes... sizes) : extents{{size_t(sizes)...}} {
+    size_t padded_size = 1;
+    for(size_t r = rank; r-- > 0; ) {
+      strides[r] = padded_size;
+      padded_size *= extents[r] + (r == rank - 1 ? 1 : 0);
+    }
+    buffer = std::make_unique<int[]>(padded_size);
+    mdspan_benchmark::fill_random(right_mdspan<rank>(buffer.get(), sizes...));
+  }
+
+  right_mdspan<rank> view(contiguous_t) const {
+    return right_mdspan<rank>(buffer.get(), extents);
+  }
+  stride_mdspan<rank> view(strided_t) const {
+    using mapping_type = stdex::layout_stride::mapping<stdex::dextents<rank>>;
+    return stride_mdspan<rank>(buffer.get(), mapping_type(
+      stdex::dextents<rank>(extents), stdex::dextents<rank>(strides)
+    ));
+  }
+
+  std::array<size_t, rank> extents;
+  std::array<size_t, rank> strides;
+  std::unique_ptr<int[]> buffer;
+};
+
+namespace _impl {
+
+template <class MDSpan, class... Indices>
+inline std::enable_if_t<sizeof...(Indices) == MDSpan::rank()>
+sum_nested(MDSpan const& s, int& sum, Indices... idx) {
+  sum += s(idx...);
+}
+
+template <class MDSpan, class... Indices>
+inline std::enable_if_t<(sizeof...(Indices) < MDSpan::rank())>
+sum_nested(MDSpan const& s, int& sum, Indices... idx) {
+  for(size_t i = 0; i < s.extent(sizeof...(Indices)); ++i) {
+    _impl::sum_nested(s, sum, idx..., i);
+  }
+}
+
+} // end namespace _impl
+
+template <class Strided, class... Sizes>
+void BM_MDSpan_Sum_Nested_Loops(benchmark::State& state, Strided strided, Sizes... sizes) {
+  test_array<Sizes...> a(sizes...);
+  auto s = a.view(strided);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    int sum = 0;
+    _impl::sum_nested(s, sum);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(s.size() * sizeof(int) * state.iterations());
+}
+
+template <class Strided, class... Sizes>
+void BM_MDSpan_Sum_Elements(benchmark::State& state, Strided strided, Sizes... sizes) {
+  test_array<Sizes...> a(sizes...);
+  auto s = a.view(strided);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    int sum = 0;
+    for(int x : stdex::elements(s)) sum += x;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(s.size() * sizeof(int) * state.iterations());
+}
+
+template <class Strided, class... Sizes>
+void BM_MDSpan_Sum_Elements_ForEach(benchmark::State& state, Strided strided, Sizes... sizes) {
+  test_array<Sizes...> a(sizes...);
+  auto s = a.view(strided);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.data());
+    int sum = 0;
+    stdex::elements(s).for_each([&](int x) { sum += x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(s.size() * sizeof(int) * state.iterations());
+}
+
+#define MDSPAN_BENCHMARK_ELEMENTS(name, ...) \
+  BENCHMARK_CAPTURE(BM_MDSpan_Sum_Nested_Loops, name, __VA_ARGS__); \
+  BENCHMARK_CAPTURE(BM_MDSpan_Sum_Elements, name, __VA_ARGS__); \
+  BENCHMARK_CAPTURE(BM_MDSpan_Sum_Elements_ForEach, name, __VA_ARGS__)
+
+MDSPAN_BENCHMARK_ELEMENTS(rank3_contiguous, contiguous_t{}, 64, 64, 64);
+MDSPAN_BENCHMARK_ELEMENTS(rank3_strided, strided_t{}, 64, 64, 64);
+MDSPAN_BENCHMARK_ELEMENTS(rank4_contiguous, contiguous_t{}, 16, 16, 32, 32);
+MDSPAN_BENCHMARK_ELEMENTS(rank4_strided, strided_t{}, 16, 16, 32, 32);
+MDSPAN_BENCHMARK_ELEMENTS(rank5_contiguous, contiguous_t{}, 8, 8, 16, 16, 16);
+MDSPAN_BENCHMARK_ELEMENTS(rank5_strided, strided_t{}, 8, 8, 16, 16, 16);
+MDSPAN_BENCHMARK_ELEMENTS(rank6_contiguous, contiguous_t{}, 8, 8, 8, 8, 8, 8);
+MDSPAN_BENCHMARK_ELEMENTS(rank6_strided, strided_t{}, 8, 8, 8, 8, 8, 8);
+
+//================================================================================
+
+BENCHMARK_MAIN();
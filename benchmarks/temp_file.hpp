@@ -0,0 +1,93 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef MDSPAN_BENCHMARKS_TEMP_FILE_HPP
+#define MDSPAN_BENCHMARKS_TEMP_FILE_HPP
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mdspan_benchmark {
+
+// $TMPDIR/mdspan_benchmark_<name>, or the same under /tmp
+inline std::string temp_path(char const* name) {
+  char const* dir = std::getenv("TMPDIR");
+  return std::string(dir ? dir : "/tmp") + "/mdspan_benchmark_" + name;
+}
+
+// Drops the pages of the file at `path` from the page cache, so that the
+// next read of it goes to the device
+inline void evict(std::string const& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0) throw std::system_error(errno, std::generic_category(), "evict " + path);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+// A file under temp_path(name), written by `create(path)` on construction
+// and removed on destruction.  Benchmarks keep their input in a
+// function-local static one, so that it is created on first use and
+// removed when the program exits.
+struct temp_file {
+  std::string path;
+
+  template <class Create>
+  temp_file(char const* name, Create&& create) : path(temp_path(name)) {
+    create(path);
+  }
+  temp_file(temp_file const&) = delete;
+  temp_file& operator=(temp_file const&) = delete;
+  ~temp_file() { std::remove(path.c_str()); }
+
+  void evict() const { mdspan_benchmark::evict(path); }
+};
+
+} // namespace mdspan_benchmark
+
+#endif // MDSPAN_BENCHMARKS_TEMP_FILE_HPP
@@ -0,0 +1,244 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "fill.hpp"
+
+//================================================================================
+
+template <class T, size_t N, class Layout>
+using batch_mdspan = stdex::mdspan<T, stdex::extents<stdex::dynamic_extent, N, N>, Layout>;
+
+template <class T, size_t N, class Layout>
+batch_mdspan<T, N, Layout> make_batch(std::vector<T>& storage, size_t batch) {
+  using mapping_type = typename batch_mdspan<T, N, Layout>::mapping_type;
+  auto map = mapping_type(typename mapping_type::extents_type(batch));
+  storage.assign(map.required_span_size(), T(0));
+  return batch_mdspan<T, N, Layout>(storage.data(), map);
+}
+
+// Symmetric and diagonally dominant, so that every matrix is invertible and
+// has real eigenvalues
+template <class MDSpan>
+void fill_symmetric(MDSpan m, unsigned seed = 1234) {
+  using value_type = typename MDSpan::value_type;
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-8, 8);
+  for(size_t b = 0; b < m.extent(0); ++b) {
+    for(size_t i = 0; i < m.extent(1); ++i) {
+      m(b, i, i) = value_type(dist(gen) + 64);
+      for(size_t j = 0; j < i; ++j) m(b, i, j) = m(b, j, i) = value_type(dist(gen));
+    }
+  }
+}
+
+// (name, value type, N, layout) for every layout
+#define MDSPAN_BENCHMARK_BATCHED(bench, N, batch) \
+  BENCHMARK_CAPTURE(bench, right_##N##x##N, double(), std::integral_constant<size_t, N>{}, stdex::layout_right{}, batch); \
+  BENCHMARK_CAPTURE(bench, left_##N##x##N, double(), std::integral_constant<size_t, N>{}, stdex::layout_left{}, batch); \
+  BENCHMARK_CAPTURE(bench, aosoa8_##N##x##N, double(), std::integral_constant<size_t, N>{}, stdex::layout_aosoa<8>{}, batch)
+
+//================================================================================
+
+template <class T, size_t N, class Layout>
+void BM_MDSpan_Batched_MatrixProduct(benchmark::State& state, T, std::integral_constant<size_t, N>, Layout, size_t batch) {
+  std::vector<T> a, b, c;
+  auto A = make_batch<T, N, Layout>(a, batch);
+  auto B = make_batch<T, N, Layout>(b, batch);
+  auto C = make_batch<T, N, Layout>(c, batch);
+  fill_symmetric(A, 1);
+  fill_symmetric(B, 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    benchmark::DoNotOptimize(b.data());
+    stdex::batched_matrix_product(A, B, C);
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(3 * batch * N * N * sizeof(T) * state.iterations());
+  state.counters["matrices"] = benchmark::Counter(double(batch), benchmark::Counter::kIsIterationInvariantRate);
+}
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_MatrixProduct, 3, 1000000);
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_MatrixProduct, 4, 1000000);
+
+template <class T, size_t N, class Layout>
+void BM_MDSpan_Batched_Determinant(benchmark::State& state, T, std::integral_constant<size_t, N>, Layout, size_t batch) {
+  std::vector<T> a, d(batch);
+  auto A = make_batch<T, N, Layout>(a, batch);
+  auto D = stdex::mdspan<T, stdex::dextents<1>>(d.data(), batch);
+  fill_symmetric(A);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    stdex::batched_determinant(A, D);
+    benchmark::DoNotOptimize(d.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(batch * (N * N + 1) * sizeof(T) * state.iterations());
+  state.counters["matrices"] = benchmark::Counter(double(batch), benchmark::Counter::kIsIterationInvariantRate);
+}
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_Determinant, 3, 1000000);
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_Determinant, 4, 1000000);
+
+template <class T, size_t N, class Layout>
+void BM_MDSpan_Batched_Inverse(benchmark::State& state, T, std::integral_constant<size_t, N>, Layout, size_t batch) {
+  std::vector<T> a, x;
+  auto A = make_batch<T, N, Layout>(a, batch);
+  auto X = make_batch<T, N, Layout>(x, batch);
+  fill_symmetric(A);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    stdex::batched_inverse(A, X);
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * batch * N * N * sizeof(T) * state.iterations());
+  state.counters["matrices"] = benchmark::Counter(double(batch), benchmark::Counter::kIsIterationInvariantRate);
+}
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_Inverse, 3, 1000000);
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_Inverse, 4, 1000000);
+
+template <class T, size_t N, class Layout>
+void BM_MDSpan_Batched_SymmetricEigen(benchmark::State& state, T, std::integral_constant<size_t, N>, Layout, size_t batch) {
+  std::vector<T> a, v, w;
+  auto A = make_batch<T, N, Layout>(a, batch);
+  auto V = make_batch<T, N, Layout>(v, batch);
+  using w_mdspan = stdex::mdspan<T, stdex::extents<stdex::dynamic_extent, N>, Layout>;
+  auto w_map = typename w_mdspan::mapping_type(typename w_mdspan::extents_type(batch));
+  w.resize(w_map.required_span_size());
+  auto W = w_mdspan(w.data(), w_map);
+  fill_symmetric(A);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.data());
+    stdex::batched_symmetric_eigen(A, W, V);
+    benchmark::DoNotOptimize(v.data());
+    benchmark::DoNotOptimize(w.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(batch * (2 * N * N + N) * sizeof(T) * state.iterations());
+  state.counters["matrices"] = benchmark::Counter(double(batch), benchmark::Counter::kIsIterationInvariantRate);
+}
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_SymmetricEigen, 3, 1000000);
+MDSPAN_BENCHMARK_BATCHED(BM_MDSpan_Batched_SymmetricEigen, 4, 1000000);
+
+//================================================================================
+
+// One matrix at a time, with the same arithmetic as the batched kernels, on
+// layout_right storage
+template <class T, size_t N>
+void BM_Raw_MatrixProduct_PerMatrix(benchmark::State& state, T, std::integral_constant<size_t, N>, size_t batch) {
+  std::vector<T> a, b, c;
+  fill_symmetric(make_batch<T, N, stdex::layout_right>(a, batch), 1);
+  fill_symmetric(make_batch<T, N, stdex::layout_right>(b, batch), 2);
+  make_batch<T, N, stdex::layout_right>(c, batch);
+  T const* p_a = a.data();
+  T const* p_b = b.data();
+  T* p_c = c.data();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_a);
+    benchmark::DoNotOptimize(p_b);
+    for(size_t m = 0; m < batch; ++m) {
+      T const* am = p_a + m * N * N;
+      T const* bm = p_b + m * N * N;
+      T* cm = p_c + m * N * N;
+      for(size_t i = 0; i < N; ++i) {
+        for(size_t j = 0; j < N; ++j) {
+          T sum = am[i * N] * bm[j];
+          for(size_t k = 1; k < N; ++k) sum += am[i * N + k] * bm[k * N + j];
+          cm[i * N + j] = sum;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(p_c);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(3 * batch * N * N * sizeof(T) * state.iterations());
+  state.counters["matrices"] = benchmark::Counter(double(batch), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_CAPTURE(BM_Raw_MatrixProduct_PerMatrix, 3x3, double(), std::integral_constant<size_t, 3>{}, 1000000);
+BENCHMARK_CAPTURE(BM_Raw_MatrixProduct_PerMatrix, 4x4, double(), std::integral_constant<size_t, 4>{}, 1000000);
+
+template <class T>
+void BM_Raw_Inverse3x3_PerMatrix(benchmark::State& state, T, size_t batch) {
+  std::vector<T> a, x;
+  fill_symmetric(make_batch<T, 3, stdex::layout_right>(a, batch));
+  make_batch<T, 3, stdex::layout_right>(x, batch);
+  T const* p_a = a.data();
+  T* p_x = x.data();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p_a);
+    for(size_t m = 0; m < batch; ++m) {
+      T const* am = p_a + m * 9;
+      T* xm = p_x + m * 9;
+      T b00 = am[4] * am[8] - am[5] * am[7];
+      T b10 = am[5] * am[6] - am[3] * am[8];
+      T b20 = am[3] * am[7] - am[4] * am[6];
+      T r = T(1) / (am[0] * b00 + am[1] * b10 + am[2] * b20);
+      xm[0] = b00 * r;
+      xm[1] = (am[2] * am[7] - am[1] * am[8]) * r;
+      xm[2] = (am[1] * am[5] - am[2] * am[4]) * r;
+      xm[3] = b10 * r;
+      xm[4] = (am[0] * am[8] - am[2] * am[6]) * r;
+      xm[5] = (am[2] * am[3] - am[0] * am[5]) * r;
+      xm[6] = b20 * r;
+      xm[7] = (am[1] * am[6] - am[0] * am[7]) * r;
+      xm[8] = (am[0] * am[4] - am[1] * am[3]) * r;
+    }
+    benchmark::DoNotOptimize(p_x);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(2 * batch * 9 * sizeof(T) * state.iterations());
+  state.counters["matrices"] = benchmark::Counter(double(batch), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_CAPTURE(BM_Raw_Inverse3x3_PerMatrix, 3x3, double(), 1000000);
+
+//================================================================================
+
+BENCHMARK_MAIN();
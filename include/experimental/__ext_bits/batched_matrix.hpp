@@ -0,0 +1,728 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "layout_aosoa.hpp"
+#include "execution_policy.hpp"
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Largest number of objects of a batch processed together.  Each kernel
+// reads element (i, j) of all the objects of a tile from one array (the
+// operand itself where its batch dimension has unit stride, a copy
+// otherwise) and writes its results to arrays on the stack that are copied
+// out afterwards.  Working on one element of all objects at a time, with
+// outputs that cannot alias the inputs, lets the kernels vectorize across
+// the batch.
+_MDSPAN_INLINE_VARIABLE constexpr size_t __batch_tile = 64;
+
+// Maximum number of Jacobi sweeps in batched_symmetric_eigen; convergence is
+// quadratic, so this is only reached for inputs with NaNs or infinities
+_MDSPAN_INLINE_VARIABLE constexpr size_t __jacobi_max_sweeps = 16;
+
+template <class T, size_t N, size_t M>
+using __batch_tile_type = T[N][M][__batch_tile];
+
+// Element (i, j) of the objects of a tile: e[i][j][w] for the w-th object
+template <class T, size_t N, size_t M>
+struct __batch_input {
+  T const* e[N][M];
+};
+
+// f(b), f(b, i) or f(b, i, j), for a batch of scalars, vectors or matrices
+template <class F>
+inline auto __batch_call(F const& f, size_t b, size_t, size_t, integral_constant<size_t, 1>) -> decltype(f(b)) {
+  return f(b);
+}
+
+template <class F>
+inline auto __batch_call(F const& f, size_t b, size_t i, size_t, integral_constant<size_t, 2>) -> decltype(f(b, i)) {
+  return f(b, i);
+}
+
+template <class F>
+inline auto __batch_call(F const& f, size_t b, size_t i, size_t j, integral_constant<size_t, 3>) -> decltype(f(b, i, j)) {
+  return f(b, i, j);
+}
+
+// Whether the elements of an mdspan can be read in place as T
+template <class T, class MDSpan>
+using __is_direct_batch = integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, typename MDSpan::accessor_type, default_accessor<typename MDSpan::element_type>) &&
+  _MDSPAN_TRAIT(is_same, remove_cv_t<typename MDSpan::element_type>, T)
+>;
+
+// Access to element (i, j) of objects [b0, b0 + n) of a batch:
+// `load` and `store` copy it to and from an array, and `view` returns it
+// in place when it is an array of T already, and a copy in `scratch`
+// otherwise.  `tile_length()` is the number of objects per tile that keeps
+// views in place.
+template <
+  class MDSpan,
+  class Layout = typename MDSpan::layout_type,
+  bool Strided = MDSpan::mapping_type::is_always_strided()
+>
+struct __batch_operand {
+  static constexpr size_t tile_length() noexcept { return __batch_tile; }
+
+  explicit __batch_operand(MDSpan const& m) : m(m) { }
+
+  template <class T>
+  void load(size_t b0, size_t n, size_t i, size_t j, T* t) const {
+    for(size_t w = 0; w < n; ++w) t[w] = T(__batch_call(m, b0 + w, i, j, __rank()));
+  }
+
+  template <class T>
+  void store(size_t b0, size_t n, size_t i, size_t j, T const* t) const {
+    for(size_t w = 0; w < n; ++w) __batch_call(m, b0 + w, i, j, __rank()) = t[w];
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch) const {
+    load(b0, n, i, j, scratch);
+    return scratch;
+  }
+
+  using __rank = integral_constant<size_t, MDSpan::rank()>;
+  MDSpan m;
+};
+
+template <class MDSpan, class Layout>
+struct __batch_operand<MDSpan, Layout, true> {
+  static constexpr size_t tile_length() noexcept { return __batch_tile; }
+
+  explicit __batch_operand(MDSpan const& m)
+    : acc(m.accessor()), p(m.data()),
+      s0(size_t(m.stride(0))),
+      s1(MDSpan::rank() > 1 ? size_t(m.stride(1 % MDSpan::rank())) : 0),
+      s2(MDSpan::rank() > 2 ? size_t(m.stride(2 % MDSpan::rank())) : 0)
+  { }
+
+  template <class T>
+  void load(size_t b0, size_t n, size_t i, size_t j, T* t) const {
+    size_t o = b0 * s0 + i * s1 + j * s2;
+    if(s0 == 1) for(size_t w = 0; w < n; ++w) t[w] = T(acc.access(p, o + w));
+    else for(size_t w = 0; w < n; ++w) t[w] = T(acc.access(p, o + w * s0));
+  }
+
+  template <class T>
+  void store(size_t b0, size_t n, size_t i, size_t j, T const* t) const {
+    size_t o = b0 * s0 + i * s1 + j * s2;
+    if(s0 == 1) for(size_t w = 0; w < n; ++w) acc.access(p, o + w) = t[w];
+    else for(size_t w = 0; w < n; ++w) acc.access(p, o + w * s0) = t[w];
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch) const {
+    return view(b0, n, i, j, scratch, __is_direct_batch<T, MDSpan>());
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch, true_type /* direct */) const {
+    if(s0 == 1) return p + (b0 + i * s1 + j * s2);
+    return view(b0, n, i, j, scratch, false_type());
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch, false_type /* direct */) const {
+    load(b0, n, i, j, scratch);
+    return scratch;
+  }
+
+  typename MDSpan::accessor_type acc;
+  typename MDSpan::pointer p;
+  size_t s0, s1, s2;
+};
+
+template <class MDSpan, size_t VectorLength>
+struct __batch_operand<MDSpan, layout_aosoa<VectorLength>, false> {
+  // one block per tile, as long as it fits
+  static constexpr size_t tile_length() noexcept { return VectorLength < __batch_tile ? VectorLength : __batch_tile; }
+
+  explicit __batch_operand(MDSpan const& m) : acc(m.accessor()), p(m.data()), map(m.mapping()) { }
+
+  // calls f(w, offset, length) for each unit-stride run of objects
+  // [b0 + w, b0 + w + length), i.e., for each block
+  template <class F>
+  void for_each_run(size_t b0, size_t n, size_t i, size_t j, F const& f) const {
+    for(size_t w = 0; w < n; ) {
+      size_t len = std::min(n - w, VectorLength - (b0 + w) % VectorLength);
+      f(w, __batch_call(map, b0 + w, i, j, __rank()), len);
+      w += len;
+    }
+  }
+
+  template <class T>
+  void load(size_t b0, size_t n, size_t i, size_t j, T* t) const {
+    for_each_run(b0, n, i, j, [&](size_t w, size_t o, size_t len) {
+      for(size_t l = 0; l < len; ++l) t[w + l] = T(acc.access(p, o + l));
+    });
+  }
+
+  template <class T>
+  void store(size_t b0, size_t n, size_t i, size_t j, T const* t) const {
+    for_each_run(b0, n, i, j, [&](size_t w, size_t o, size_t len) {
+      for(size_t l = 0; l < len; ++l) acc.access(p, o + l) = t[w + l];
+    });
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch) const {
+    return view(b0, n, i, j, scratch, __is_direct_batch<T, MDSpan>());
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch, true_type /* direct */) const {
+    if(b0 % VectorLength + n <= VectorLength) return p + __batch_call(map, b0, i, j, __rank());
+    return view(b0, n, i, j, scratch, false_type());
+  }
+
+  template <class T>
+  T const* view(size_t b0, size_t n, size_t i, size_t j, T* scratch, false_type /* direct */) const {
+    load(b0, n, i, j, scratch);
+    return scratch;
+  }
+
+  using __rank = integral_constant<size_t, MDSpan::rank()>;
+  typename MDSpan::accessor_type acc;
+  typename MDSpan::pointer p;
+  typename MDSpan::mapping_type map;
+};
+
+template <size_t N, size_t M, class Operand, class T>
+void __store_batch_tile(Operand const& op, size_t b0, size_t n, __batch_tile_type<T, N, M> const& t) {
+  for(size_t i = 0; i < N; ++i)
+    for(size_t j = 0; j < M; ++j) op.store(b0, n, i, j, t[i][j]);
+}
+
+template <size_t N, size_t M, class Operand, class T>
+__batch_input<T, N, M> __view_batch_tile(Operand const& op, size_t b0, size_t n, __batch_tile_type<T, N, M>& scratch) {
+  __batch_input<T, N, M> in;
+  for(size_t i = 0; i < N; ++i)
+    for(size_t j = 0; j < M; ++j) in.e[i][j] = op.view(b0, n, i, j, scratch[i][j]);
+  return in;
+}
+
+// Calls f(b0, n) for consecutive tiles [b0, b0 + n) of at most `length`
+// objects of a batch, split over the threads of the policy
+template <class ExecutionPolicy, class F>
+void __for_each_batch_tile(ExecutionPolicy policy, size_t batch, size_t length, F const& f) {
+  size_t num_tiles = (batch + length - 1) / length;
+  __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+    for(size_t tile = num_tiles * t / num_threads; tile < num_tiles * (t + 1) / num_threads; ++tile) {
+      size_t b0 = tile * length;
+      f(b0, std::min(length, batch - b0));
+    }
+  });
+}
+
+template <class Extents>
+constexpr bool __has_static_object_extents() {
+  return Extents::rank() < 2 || (Extents::static_extent(1 % Extents::rank()) != dynamic_extent
+    && (Extents::rank() < 3 || Extents::static_extent(2 % Extents::rank()) != dynamic_extent));
+}
+
+//------------------------------------------------------------------------------
+// Kernels on one object at a time, written out for static sizes so that,
+// inlined into a loop over a tile, they become straight-line vector code.
+
+template <class T>
+inline T __small_determinant(T const (&a)[1][1]) { return a[0][0]; }
+
+template <class T>
+inline T __small_determinant(T const (&a)[2][2]) { return a[0][0] * a[1][1] - a[0][1] * a[1][0]; }
+
+template <class T>
+inline T __small_determinant(T const (&a)[3][3]) {
+  return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+    + a[0][1] * (a[1][2] * a[2][0] - a[1][0] * a[2][2])
+    + a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+}
+
+// The 2x2 minors of the top two and bottom two rows, shared by the
+// determinant and the inverse of a 4x4 matrix
+template <class T>
+struct __minors_4x4 {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  explicit __minors_4x4(T const (&a)[4][4])
+    : s0(a[0][0] * a[1][1] - a[1][0] * a[0][1]),
+      s1(a[0][0] * a[1][2] - a[1][0] * a[0][2]),
+      s2(a[0][0] * a[1][3] - a[1][0] * a[0][3]),
+      s3(a[0][1] * a[1][2] - a[1][1] * a[0][2]),
+      s4(a[0][1] * a[1][3] - a[1][1] * a[0][3]),
+      s5(a[0][2] * a[1][3] - a[1][2] * a[0][3]),
+      c0(a[2][0] * a[3][1] - a[3][0] * a[2][1]),
+      c1(a[2][0] * a[3][2] - a[3][0] * a[2][2]),
+      c2(a[2][0] * a[3][3] - a[3][0] * a[2][3]),
+      c3(a[2][1] * a[3][2] - a[3][1] * a[2][2]),
+      c4(a[2][1] * a[3][3] - a[3][1] * a[2][3]),
+      c5(a[2][2] * a[3][3] - a[3][2] * a[2][3])
+  { }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  T determinant() const { return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0; }
+  T s0, s1, s2, s3, s4, s5, c0, c1, c2, c3, c4, c5;
+};
+
+template <class T>
+inline T __small_determinant(T const (&a)[4][4]) { return __minors_4x4<T>(a).determinant(); }
+
+// x = inverse(a), through the adjugate; singular matrices give infinities
+// or NaNs
+template <class T>
+inline void __small_inverse(T const (&a)[1][1], T (&x)[1][1]) { x[0][0] = T(1) / a[0][0]; }
+
+template <class T>
+inline void __small_inverse(T const (&a)[2][2], T (&x)[2][2]) {
+  T r = T(1) / __small_determinant(a);
+  x[0][0] = a[1][1] * r;  x[0][1] = -a[0][1] * r;
+  x[1][0] = -a[1][0] * r; x[1][1] = a[0][0] * r;
+}
+
+template <class T>
+inline void __small_inverse(T const (&a)[3][3], T (&x)[3][3]) {
+  T b00 = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+  T b10 = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+  T b20 = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+  T r = T(1) / (a[0][0] * b00 + a[0][1] * b10 + a[0][2] * b20);
+  x[0][0] = b00 * r;
+  x[0][1] = (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * r;
+  x[0][2] = (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * r;
+  x[1][0] = b10 * r;
+  x[1][1] = (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * r;
+  x[1][2] = (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * r;
+  x[2][0] = b20 * r;
+  x[2][1] = (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * r;
+  x[2][2] = (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * r;
+}
+
+template <class T>
+inline void __small_inverse(T const (&a)[4][4], T (&x)[4][4]) {
+  __minors_4x4<T> m(a);
+  T r = T(1) / m.determinant();
+  x[0][0] = ( a[1][1] * m.c5 - a[1][2] * m.c4 + a[1][3] * m.c3) * r;
+  x[0][1] = (-a[0][1] * m.c5 + a[0][2] * m.c4 - a[0][3] * m.c3) * r;
+  x[0][2] = ( a[3][1] * m.s5 - a[3][2] * m.s4 + a[3][3] * m.s3) * r;
+  x[0][3] = (-a[2][1] * m.s5 + a[2][2] * m.s4 - a[2][3] * m.s3) * r;
+  x[1][0] = (-a[1][0] * m.c5 + a[1][2] * m.c2 - a[1][3] * m.c1) * r;
+  x[1][1] = ( a[0][0] * m.c5 - a[0][2] * m.c2 + a[0][3] * m.c1) * r;
+  x[1][2] = (-a[3][0] * m.s5 + a[3][2] * m.s2 - a[3][3] * m.s1) * r;
+  x[1][3] = ( a[2][0] * m.s5 - a[2][2] * m.s2 + a[2][3] * m.s1) * r;
+  x[2][0] = ( a[1][0] * m.c4 - a[1][1] * m.c2 + a[1][3] * m.c0) * r;
+  x[2][1] = (-a[0][0] * m.c4 + a[0][1] * m.c2 - a[0][3] * m.c0) * r;
+  x[2][2] = ( a[3][0] * m.s4 - a[3][1] * m.s2 + a[3][3] * m.s0) * r;
+  x[2][3] = (-a[2][0] * m.s4 + a[2][1] * m.s2 - a[2][3] * m.s0) * r;
+  x[3][0] = (-a[1][0] * m.c3 + a[1][1] * m.c1 - a[1][2] * m.c0) * r;
+  x[3][1] = ( a[0][0] * m.c3 - a[0][1] * m.c1 + a[0][2] * m.c0) * r;
+  x[3][2] = (-a[3][0] * m.s3 + a[3][1] * m.s1 - a[3][2] * m.s0) * r;
+  x[3][3] = ( a[2][0] * m.s3 - a[2][1] * m.s1 + a[2][2] * m.s0) * r;
+}
+
+//------------------------------------------------------------------------------
+// Kernels on a tile, one element of all its objects at a time.  Results go
+// to an array local to the kernel, which nothing else can point to, before
+// being stored to the output operand.
+
+template <size_t N, size_t K, size_t M, class T, class OperandC>
+void __batched_product_tile(
+  size_t b0, size_t n, __batch_input<T, N, K> a, __batch_input<T, K, M> b, OperandC const& out
+) {
+  __batch_tile_type<T, N, M> c;
+  for(size_t i = 0; i < N; ++i) {
+    for(size_t j = 0; j < M; ++j) {
+      for(size_t w = 0; w < n; ++w) {
+        T sum = a.e[i][0][w] * b.e[0][j][w];
+        for(size_t k = 1; k < K; ++k) sum += a.e[i][k][w] * b.e[k][j][w];
+        c[i][j][w] = sum;
+      }
+    }
+  }
+  __store_batch_tile<N, M>(out, b0, n, c);
+}
+
+template <size_t N, class T, class OperandD>
+void __batched_determinant_tile(size_t b0, size_t n, __batch_input<T, N, N> a, OperandD const& out) {
+  __batch_tile_type<T, 1, 1> d;
+  for(size_t w = 0; w < n; ++w) {
+    T m[N][N];
+    for(size_t i = 0; i < N; ++i)
+      for(size_t j = 0; j < N; ++j) m[i][j] = a.e[i][j][w];
+    d[0][0][w] = __small_determinant(m);
+  }
+  __store_batch_tile<1, 1>(out, b0, n, d);
+}
+
+template <size_t N, class T, class OperandX>
+void __batched_inverse_tile(size_t b0, size_t n, __batch_input<T, N, N> a, OperandX const& out) {
+  __batch_tile_type<T, N, N> x;
+  for(size_t w = 0; w < n; ++w) {
+    T m[N][N], r[N][N];
+    for(size_t i = 0; i < N; ++i)
+      for(size_t j = 0; j < N; ++j) m[i][j] = a.e[i][j][w];
+    __small_inverse(m, r);
+    for(size_t i = 0; i < N; ++i)
+      for(size_t j = 0; j < N; ++j) x[i][j][w] = r[i][j];
+  }
+  __store_batch_tile<N, N>(out, b0, n, x);
+}
+
+// One cyclic Jacobi sweep over a tile of symmetric matrices: every
+// off-diagonal element is zeroed in turn by a rotation that is applied to the
+// matrix and accumulated in v.  The rotation angle is computed without
+// branches (a zero element gives the identity), so that all objects of the
+// tile take the same path.
+template <size_t N, class T>
+void __jacobi_sweep_tile(size_t n, __batch_tile_type<T, N, N>& a, __batch_tile_type<T, N, N>& v) {
+  T c[__batch_tile], s[__batch_tile];
+  for(size_t p = 0; p + 1 < N; ++p) {
+    for(size_t q = p + 1; q < N; ++q) {
+      for(size_t w = 0; w < n; ++w) {
+        T apq = a[p][q][w], apq2 = T(2) * apq;
+        T d = a[q][q][w] - a[p][p][w];
+        // the arguments of std::sqrt are sums of squares, but under the
+        // default -fmath-errno the compiler still keeps the errno path, so
+        // this loop stays scalar; only the rotations below vectorize
+        T denom = std::abs(d) + std::sqrt(d * d + apq2 * apq2);
+        T t = denom > T(0) ? apq2 * (d < T(0) ? T(-1) : T(1)) / denom : T(0);
+        c[w] = T(1) / std::sqrt(T(1) + t * t);
+        s[w] = t * c[w];
+        a[p][p][w] -= t * apq;
+        a[q][q][w] += t * apq;
+        a[p][q][w] = a[q][p][w] = T(0);
+      }
+      for(size_t r = 0; r < N; ++r) {
+        if(r == p || r == q) continue;
+        for(size_t w = 0; w < n; ++w) {
+          T arp = a[r][p][w], arq = a[r][q][w];
+          a[r][p][w] = a[p][r][w] = c[w] * arp - s[w] * arq;
+          a[r][q][w] = a[q][r][w] = s[w] * arp + c[w] * arq;
+        }
+      }
+      for(size_t r = 0; r < N; ++r) {
+        for(size_t w = 0; w < n; ++w) {
+          T vrp = v[r][p][w], vrq = v[r][q][w];
+          v[r][p][w] = c[w] * vrp - s[w] * vrq;
+          v[r][q][w] = s[w] * vrp + c[w] * vrq;
+        }
+      }
+    }
+  }
+}
+
+// Number of objects of the tile whose off-diagonal part is not yet
+// negligible relative to the diagonal
+template <size_t N, class T>
+size_t __jacobi_unconverged(size_t n, __batch_tile_type<T, N, N> const& a) {
+  T off[__batch_tile] = { }, diag[__batch_tile] = { };
+  for(size_t i = 0; i < N; ++i) {
+    for(size_t w = 0; w < n; ++w) diag[w] += a[i][i][w] * a[i][i][w];
+    for(size_t j = i + 1; j < N; ++j) {
+      for(size_t w = 0; w < n; ++w) off[w] += a[i][j][w] * a[i][j][w];
+    }
+  }
+  T tol = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+  size_t count = 0;
+  for(size_t w = 0; w < n; ++w) count += off[w] > tol * diag[w] ? 1 : 0;
+  return count;
+}
+
+// Sorts the eigenvalues on the diagonal of a in ascending order, along with
+// the columns of v, with a branch-free odd-even transposition sort
+template <size_t N, class T>
+void __sort_eigen_tile(size_t n, __batch_tile_type<T, N, N>& a, __batch_tile_type<T, N, N>& v) {
+  for(size_t pass = 0; pass < N; ++pass) {
+    for(size_t p = pass % 2; p + 1 < N; p += 2) {
+      for(size_t w = 0; w < n; ++w) {
+        bool swap = a[p + 1][p + 1][w] < a[p][p][w];
+        T lo = swap ? a[p + 1][p + 1][w] : a[p][p][w];
+        T hi = swap ? a[p][p][w] : a[p + 1][p + 1][w];
+        a[p][p][w] = lo;
+        a[p + 1][p + 1][w] = hi;
+        for(size_t r = 0; r < N; ++r) {
+          T vp = v[r][p][w], vq = v[r][p + 1][w];
+          v[r][p][w] = swap ? vq : vp;
+          v[r][p + 1][w] = swap ? vp : vq;
+        }
+      }
+    }
+  }
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Batched kernels over batches of small matrices, i.e., rank 3 mdspans whose
+// first extent is the (dynamic) batch size and whose other two extents are
+// static.  The static sizes let the kernels be written out in full for one
+// matrix; a tile of matrices is gathered into arrays holding the same
+// element of all of them, which the kernels traverse so that they vectorize
+// across the batch.  The gather and scatter are unit-stride loops for
+// layout_left and layout_aosoa operands (and for any strided layout whose
+// batch stride is 1), and go through the mapping otherwise.  With
+// execution::par, tiles are split over the OpenMP threads.  The batch
+// extents of all operands must be equal, and outputs must not overlap
+// inputs.
+
+// C[b] = A[b] * B[b] for N x K matrices A and K x M matrices B
+template <
+  class ExecutionPolicy,
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeB, class ExtentsB, class LayoutB, class AccessorB,
+  class ElementTypeC, class ExtentsC, class LayoutC, class AccessorC
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+batched_matrix_product(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeB, ExtentsB, LayoutB, AccessorB> B,
+  mdspan<ElementTypeC, ExtentsC, LayoutC, AccessorC> C
+)
+{
+  static_assert(ExtentsA::rank() == 3 && ExtentsB::rank() == 3 && ExtentsC::rank() == 3,
+    "std::experimental::batched_matrix_product requires rank 3 operands");
+  static_assert(detail::__has_static_object_extents<ExtentsA>() && detail::__has_static_object_extents<ExtentsB>()
+    && detail::__has_static_object_extents<ExtentsC>(),
+    "std::experimental::batched_matrix_product requires static matrix extents");
+  constexpr size_t N = ExtentsC::static_extent(1), M = ExtentsC::static_extent(2), K = ExtentsA::static_extent(2);
+  static_assert(ExtentsA::static_extent(1) == N && ExtentsB::static_extent(1) == K && ExtentsB::static_extent(2) == M,
+    "std::experimental::batched_matrix_product requires matching matrix extents");
+  using value_type = typename mdspan<ElementTypeC, ExtentsC, LayoutC, AccessorC>::value_type;
+  detail::__batch_operand<decltype(A)> a(A);
+  detail::__batch_operand<decltype(B)> b(B);
+  detail::__batch_operand<decltype(C)> c(C);
+  size_t length = std::min({a.tile_length(), b.tile_length(), c.tile_length()});
+  detail::__for_each_batch_tile(policy, C.extent(0), length, [&](size_t b0, size_t n) {
+    detail::__batch_tile_type<value_type, N, K> ta;
+    detail::__batch_tile_type<value_type, K, M> tb;
+    detail::__batched_product_tile<N, K, M>(b0, n,
+      detail::__view_batch_tile<N, K>(a, b0, n, ta), detail::__view_batch_tile<K, M>(b, b0, n, tb), c);
+  });
+}
+
+template <
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeB, class ExtentsB, class LayoutB, class AccessorB,
+  class ElementTypeC, class ExtentsC, class LayoutC, class AccessorC
+>
+void batched_matrix_product(
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeB, ExtentsB, LayoutB, AccessorB> B,
+  mdspan<ElementTypeC, ExtentsC, LayoutC, AccessorC> C
+)
+{
+  batched_matrix_product(execution::seq, A, B, C);
+}
+
+// d(b) = determinant(A[b]) for N x N matrices with N <= 4
+template <
+  class ExecutionPolicy,
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeD, class ExtentsD, class LayoutD, class AccessorD
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+batched_determinant(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeD, ExtentsD, LayoutD, AccessorD> d
+)
+{
+  static_assert(ExtentsA::rank() == 3 && ExtentsD::rank() == 1,
+    "std::experimental::batched_determinant requires a rank 3 A and a rank 1 d");
+  static_assert(detail::__has_static_object_extents<ExtentsA>(),
+    "std::experimental::batched_determinant requires static matrix extents");
+  constexpr size_t N = ExtentsA::static_extent(1);
+  static_assert(ExtentsA::static_extent(2) == N && N >= 1 && N <= 4,
+    "std::experimental::batched_determinant requires square matrices of at most 4 x 4");
+  using value_type = typename mdspan<ElementTypeD, ExtentsD, LayoutD, AccessorD>::value_type;
+  detail::__batch_operand<decltype(A)> a(A);
+  detail::__batch_operand<decltype(d)> out(d);
+  size_t length = std::min(a.tile_length(), out.tile_length());
+  detail::__for_each_batch_tile(policy, d.extent(0), length, [&](size_t b0, size_t n) {
+    detail::__batch_tile_type<value_type, N, N> ta;
+    detail::__batched_determinant_tile<N>(b0, n, detail::__view_batch_tile<N, N>(a, b0, n, ta), out);
+  });
+}
+
+template <
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeD, class ExtentsD, class LayoutD, class AccessorD
+>
+void batched_determinant(
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeD, ExtentsD, LayoutD, AccessorD> d
+)
+{
+  batched_determinant(execution::seq, A, d);
+}
+
+// X[b] = inverse(A[b]) for N x N matrices with N <= 4, through the
+// adjugate; singular matrices give infinities or NaNs
+template <
+  class ExecutionPolicy,
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeX, class ExtentsX, class LayoutX, class AccessorX
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+batched_inverse(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeX, ExtentsX, LayoutX, AccessorX> X
+)
+{
+  static_assert(ExtentsA::rank() == 3 && ExtentsX::rank() == 3,
+    "std::experimental::batched_inverse requires rank 3 operands");
+  static_assert(detail::__has_static_object_extents<ExtentsA>() && detail::__has_static_object_extents<ExtentsX>(),
+    "std::experimental::batched_inverse requires static matrix extents");
+  constexpr size_t N = ExtentsA::static_extent(1);
+  static_assert(ExtentsA::static_extent(2) == N && ExtentsX::static_extent(1) == N && ExtentsX::static_extent(2) == N
+    && N >= 1 && N <= 4,
+    "std::experimental::batched_inverse requires square matrices of at most 4 x 4");
+  using value_type = typename mdspan<ElementTypeX, ExtentsX, LayoutX, AccessorX>::value_type;
+  static_assert(_MDSPAN_TRAIT(is_floating_point, value_type),
+    "std::experimental::batched_inverse requires a floating-point result");
+  detail::__batch_operand<decltype(A)> a(A);
+  detail::__batch_operand<decltype(X)> x(X);
+  size_t length = std::min(a.tile_length(), x.tile_length());
+  detail::__for_each_batch_tile(policy, X.extent(0), length, [&](size_t b0, size_t n) {
+    detail::__batch_tile_type<value_type, N, N> ta;
+    detail::__batched_inverse_tile<N>(b0, n, detail::__view_batch_tile<N, N>(a, b0, n, ta), x);
+  });
+}
+
+template <
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeX, class ExtentsX, class LayoutX, class AccessorX
+>
+void batched_inverse(
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeX, ExtentsX, LayoutX, AccessorX> X
+)
+{
+  batched_inverse(execution::seq, A, X);
+}
+
+// Eigen-decomposition A[b] = V[b] * diag(w(b, :)) * V[b]^T of symmetric
+// N x N matrices (only the upper triangle of A is read), with the
+// eigenvalues in ascending order and orthonormal eigenvectors in the columns
+// of V.  Cyclic Jacobi sweeps run until the off-diagonal part of every
+// matrix of a tile is negligible.
+template <
+  class ExecutionPolicy,
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeW, class ExtentsW, class LayoutW, class AccessorW,
+  class ElementTypeV, class ExtentsV, class LayoutV, class AccessorV
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+batched_symmetric_eigen(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeW, ExtentsW, LayoutW, AccessorW> w,
+  mdspan<ElementTypeV, ExtentsV, LayoutV, AccessorV> V
+)
+{
+  static_assert(ExtentsA::rank() == 3 && ExtentsW::rank() == 2 && ExtentsV::rank() == 3,
+    "std::experimental::batched_symmetric_eigen requires a rank 3 A and V and a rank 2 w");
+  static_assert(detail::__has_static_object_extents<ExtentsA>() && detail::__has_static_object_extents<ExtentsW>()
+    && detail::__has_static_object_extents<ExtentsV>(),
+    "std::experimental::batched_symmetric_eigen requires static matrix extents");
+  constexpr size_t N = ExtentsA::static_extent(1);
+  static_assert(ExtentsA::static_extent(2) == N && ExtentsW::static_extent(1) == N
+    && ExtentsV::static_extent(1) == N && ExtentsV::static_extent(2) == N,
+    "std::experimental::batched_symmetric_eigen requires square matrices of matching sizes");
+  using value_type = typename mdspan<ElementTypeV, ExtentsV, LayoutV, AccessorV>::value_type;
+  static_assert(_MDSPAN_TRAIT(is_floating_point, value_type),
+    "std::experimental::batched_symmetric_eigen requires floating-point results");
+  detail::__batch_operand<decltype(A)> a(A);
+  detail::__batch_operand<decltype(w)> eigenvalues(w);
+  detail::__batch_operand<decltype(V)> v(V);
+  size_t length = std::min({a.tile_length(), eigenvalues.tile_length(), v.tile_length()});
+  detail::__for_each_batch_tile(policy, V.extent(0), length, [&](size_t b0, size_t n) {
+    detail::__batch_tile_type<value_type, N, N> ta, tv;
+    detail::__batch_tile_type<value_type, N, 1> tw;
+    for(size_t i = 0; i < N; ++i) {
+      for(size_t j = i; j < N; ++j) {
+        a.load(b0, n, i, j, ta[i][j]);
+        std::copy(ta[i][j], ta[i][j] + n, ta[j][i]);
+      }
+      for(size_t j = 0; j < N; ++j) std::fill(tv[i][j], tv[i][j] + n, value_type(i == j ? 1 : 0));
+    }
+    for(size_t sweep = 0; sweep < detail::__jacobi_max_sweeps; ++sweep) {
+      if(detail::__jacobi_unconverged<N>(n, ta) == 0) break;
+      detail::__jacobi_sweep_tile<N>(n, ta, tv);
+    }
+    detail::__sort_eigen_tile<N>(n, ta, tv);
+    for(size_t i = 0; i < N; ++i) std::copy(ta[i][i], ta[i][i] + n, tw[i][0]);
+    detail::__store_batch_tile<N, 1>(eigenvalues, b0, n, tw);
+    detail::__store_batch_tile<N, N>(v, b0, n, tv);
+  });
+}
+
+template <
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeW, class ExtentsW, class LayoutW, class AccessorW,
+  class ElementTypeV, class ExtentsV, class LayoutV, class AccessorV
+>
+void batched_symmetric_eigen(
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeW, ExtentsW, LayoutW, AccessorW> w,
+  mdspan<ElementTypeV, ExtentsV, LayoutV, AccessorV> V
+)
+{
+  batched_symmetric_eigen(execution::seq, A, w, V);
+}
+
+} // end namespace experimental
+} // end namespace std
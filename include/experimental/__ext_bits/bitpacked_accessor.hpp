@@ -0,0 +1,274 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Pointer to a single bit: the word holding it and the index of the bit
+// within that word (least significant bit first).
+template <class Word>
+struct bit_pointer {
+  Word* word = nullptr;
+  size_t bit = 0;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr bit_pointer() noexcept = default;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr bit_pointer(Word* w, size_t b) noexcept : word(w), bit(b) { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherWord,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherWord*, Word*)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr bit_pointer(bit_pointer<OtherWord> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : word(other.word), bit(other.bit)
+  { }
+};
+
+namespace detail {
+
+template <class Word>
+struct __bits_per_word : integral_constant<size_t, sizeof(Word) * CHAR_BIT> { };
+
+// Reference to one bit of a mutable word.  Writes are read-modify-write
+// operations on the whole word, so different threads must not write bits of
+// the same word concurrently.
+template <class Word>
+class __bit_reference {
+public:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr __bit_reference(Word* w, Word mask) noexcept : __word(w), __mask(mask) { }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED
+  constexpr __bit_reference(__bit_reference const&) noexcept = default;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr operator bool() const noexcept { return (*__word & __mask) != 0; } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __bit_reference const& operator=(bool v) const noexcept {
+    *__word = (*__word & ~__mask) | (v ? __mask : Word(0));
+    return *this;
+  }
+
+  // Assigns the referenced bit, like a built-in reference would
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __bit_reference const& operator=(__bit_reference const& other) const noexcept {
+    return *this = bool(other);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __bit_reference const& operator|=(bool v) const noexcept {
+    if(v) *__word |= __mask;
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __bit_reference const& operator&=(bool v) const noexcept {
+    if(!v) *__word &= ~__mask;
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __bit_reference const& operator^=(bool v) const noexcept {
+    if(v) *__word ^= __mask;
+    return *this;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 void flip() const noexcept { *__word ^= __mask; }
+
+private:
+
+  Word* __word;
+  Word __mask;
+
+};
+
+template <class Word>
+struct __bit_reference_type { using type = __bit_reference<Word>; };
+
+template <class Word>
+struct __bit_reference_type<Word const> { using type = bool; };
+
+template <class Word>
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr typename __bit_reference_type<Word>::type
+__access_bit(Word* w, size_t bit, true_type /* is_const */) noexcept {
+  return ((w[bit / __bits_per_word<Word>::value] >> (bit % __bits_per_word<Word>::value)) & 1u) != 0;
+}
+
+template <class Word>
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr typename __bit_reference_type<Word>::type
+__access_bit(Word* w, size_t bit, false_type /* is_const */) noexcept {
+  return __bit_reference<Word>(
+    w + bit / __bits_per_word<Word>::value,
+    Word(Word(1) << (bit % __bits_per_word<Word>::value))
+  );
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+template <class Word>
+class bitpacked_offset_accessor;
+
+// Accessor for boolean arrays stored one bit per element, least significant
+// bit first, in words of type Word (an unsigned integer type, const for
+// read-only data).  Element i of the codomain is bit i % bits of word
+// i / bits, where bits is the width of Word; allocate words_for(n) words
+// for a mapping with required_span_size() n.
+//
+// With a mutable Word, `reference` is a bit proxy; with a const Word it is
+// bool.  The data handle is a plain word pointer, so a view has to start at
+// a word boundary; submdspan switches to bitpacked_offset_accessor, whose
+// bit_pointer handles can start anywhere within a word.
+template <class Word = uint64_t>
+class bitpacked_accessor {
+public:
+
+  static_assert(is_unsigned<remove_const_t<Word>>::value,
+    "std::experimental::bitpacked_accessor requires an unsigned integer word type.");
+
+  using offset_policy = bitpacked_offset_accessor<Word>;
+  using element_type = conditional_t<is_const<Word>::value, bool const, bool>;
+  using pointer = Word*;
+  using reference = typename detail::__bit_reference_type<Word>::type;
+
+  MDSPAN_INLINE_FUNCTION static constexpr size_t bits_per_word() noexcept { return detail::__bits_per_word<Word>::value; }
+
+  // Number of words needed to store n bits
+  MDSPAN_INLINE_FUNCTION
+  static constexpr size_t words_for(size_t n) noexcept { return (n + bits_per_word() - 1) / bits_per_word(); }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr bitpacked_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherWord,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherWord*, Word*)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr bitpacked_accessor(bitpacked_accessor<OtherWord>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr typename offset_policy::pointer offset(pointer p, size_t i) const noexcept {
+    return typename offset_policy::pointer(p + i / bits_per_word(), i % bits_per_word());
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return detail::__access_bit(p, i, is_const<Word>{});
+  }
+
+};
+
+// Like bitpacked_accessor, but with a data handle that can point to any bit
+// of a word, as produced by submdspan.
+template <class Word = uint64_t>
+class bitpacked_offset_accessor {
+public:
+
+  static_assert(is_unsigned<remove_const_t<Word>>::value,
+    "std::experimental::bitpacked_offset_accessor requires an unsigned integer word type.");
+
+  using offset_policy = bitpacked_offset_accessor;
+  using element_type = conditional_t<is_const<Word>::value, bool const, bool>;
+  using pointer = bit_pointer<Word>;
+  using reference = typename detail::__bit_reference_type<Word>::type;
+
+  MDSPAN_INLINE_FUNCTION static constexpr size_t bits_per_word() noexcept { return detail::__bits_per_word<Word>::value; }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr bitpacked_offset_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherWord,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherWord*, Word*)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr bitpacked_offset_accessor(bitpacked_accessor<OtherWord>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherWord,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherWord*, Word*)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr bitpacked_offset_accessor(bitpacked_offset_accessor<OtherWord>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer offset(pointer p, size_t i) const noexcept {
+    return pointer(p.word + (p.bit + i) / bits_per_word(), (p.bit + i) % bits_per_word());
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return detail::__access_bit(p.word, p.bit + i, is_const<Word>{});
+  }
+
+};
+
+} // end namespace experimental
+} // end namespace std
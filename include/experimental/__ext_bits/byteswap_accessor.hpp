@@ -0,0 +1,337 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "converting_accessor.hpp"
+#include "mask_algorithms.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__SSE2__) || defined(__AVX2__)) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#endif
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+template <size_t Size> struct __byteswap_word;
+template <> struct __byteswap_word<2> { using type = uint16_t; };
+template <> struct __byteswap_word<4> { using type = uint32_t; };
+template <> struct __byteswap_word<8> { using type = uint64_t; };
+
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr uint8_t __bswap(uint8_t x) noexcept { return x; }
+
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr uint16_t __bswap(uint16_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap16(x);
+#else
+  return uint16_t((x << 8) | (x >> 8));
+#endif
+}
+
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr uint32_t __bswap(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(x);
+#else
+  return (x << 24) | ((x << 8) & 0x00ff0000u) | ((x >> 8) & 0x0000ff00u) | (x >> 24);
+#endif
+}
+
+MDSPAN_FORCE_INLINE_FUNCTION
+constexpr uint64_t __bswap(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(x);
+#else
+  return (uint64_t(__bswap(uint32_t(x))) << 32) | __bswap(uint32_t(x >> 32));
+#endif
+}
+
+// T with the order of its bytes reversed
+template <class T>
+MDSPAN_INLINE_FUNCTION
+T __byteswap(T v) noexcept {
+  static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+    "byte swapping is only defined for 1, 2, 4, and 8 byte types.");
+  using word_type = conditional_t<sizeof(T) == 1, uint8_t, typename __byteswap_word<sizeof(T) == 1 ? 2 : sizeof(T)>::type>;
+  word_type w;
+  std::memcpy(&w, &v, sizeof(T));
+  w = __bswap(w);
+  std::memcpy(&v, &w, sizeof(T));
+  return v;
+}
+
+template <class T>
+struct __byteswap_converter {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static T load(T s) noexcept { return __byteswap(s); }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static T store(T v) noexcept { return __byteswap(v); }
+};
+
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+
+// Reverses the bytes of each Size-byte element of a vector.  With SSSE3 (or
+// AVX2, for 32-byte vectors) this is one byte shuffle; plain SSE2 swaps the
+// 16-bit words with shuffles and the bytes within them with shifts.
+template <size_t Size>
+MDSPAN_INLINE_FUNCTION
+__m128i __bswap_vector(__m128i v) noexcept {
+#if defined(__SSSE3__)
+  __m128i const mask = Size == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                     : Size == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                     :             _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  return _mm_shuffle_epi8(v, mask);
+#else
+  if(Size == 4) {
+    v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+  }
+  else if(Size == 8) {
+    v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+  }
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+}
+
+#if defined(__AVX2__)
+template <size_t Size>
+MDSPAN_INLINE_FUNCTION
+__m256i __bswap_vector(__m256i v) noexcept {
+  // the shuffle works within 16-byte lanes, which hold whole elements
+  __m256i const mask = Size == 2 ? _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                                    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                     : Size == 4 ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                                    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                     :             _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  return _mm256_shuffle_epi8(v, mask);
+}
+#endif
+
+#endif // defined(__SSE2__) && !defined(__CUDA_ARCH__)
+
+// dst[i] = byte-swapped src[i] for i in [0, n); src and dst do not overlap
+// unless they are equal
+template <class T>
+void __byteswap_n(T const* src, T* dst, size_t n) noexcept {
+  if(sizeof(T) == 1) {
+    if(src != dst) std::memmove(dst, src, n);
+    return;
+  }
+  size_t i = 0;
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+  unsigned char const* s = reinterpret_cast<unsigned char const*>(src);
+  unsigned char* d = reinterpret_cast<unsigned char*>(dst);
+  size_t bytes = n * sizeof(T);
+  size_t b = 0;
+#if defined(__AVX2__)
+  for(; b + 32 <= bytes; b += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + b));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + b), __bswap_vector<sizeof(T)>(v));
+  }
+#endif
+  for(; b + 16 <= bytes; b += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + b));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + b), __bswap_vector<sizeof(T)>(v));
+  }
+  i = b / sizeof(T);
+#endif
+  for(; i < n; ++i) dst[i] = __byteswap(src[i]);
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Accessor for data stored with the opposite byte order of the host (e.g.,
+// big-endian data on x86), so that a file can be viewed, e.g. through
+// mapped_mdarray, without converting it first.  Every load and store swaps
+// the bytes of one element.  With a const ElementType, `reference` is a
+// value; otherwise it is a proxy that swaps back on assignment.
+//
+// For bulk conversion, copy() between a byte-swapped and a native mdspan
+// swaps whole vectors at a time when both are contiguous with the same
+// mapping.
+template <class ElementType>
+class byteswap_accessor {
+private:
+
+  using __value_type = remove_const_t<ElementType>;
+  using __converter_type = detail::__byteswap_converter<__value_type>;
+
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, __value_type) &&
+    (sizeof(__value_type) == 1 || sizeof(__value_type) == 2 || sizeof(__value_type) == 4 || sizeof(__value_type) == 8),
+    "std::experimental::byteswap_accessor requires a trivially copyable element type of 1, 2, 4, or 8 bytes.");
+
+public:
+
+  using offset_policy = byteswap_accessor;
+  using element_type = ElementType;
+  using pointer = ElementType*;
+  using reference = typename detail::__converting_reference_type<ElementType, __value_type, __converter_type>::type;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr byteswap_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr byteswap_accessor(byteswap_accessor<OtherElementType>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer offset(pointer p, size_t i) const noexcept {
+    return p + i;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference access(pointer p, size_t i) const noexcept {
+    return __access(p + i, is_const<ElementType>{});
+  }
+
+private:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference __access(pointer p, true_type /* is_const */) const noexcept {
+    return __converter_type::load(*p);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference __access(pointer p, false_type /* is_const */) const noexcept {
+    return reference(p, __converter_type());
+  }
+
+};
+
+namespace detail {
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+_MDSPAN_INLINE_VARIABLE constexpr bool __host_is_big_endian = true;
+#else
+_MDSPAN_INLINE_VARIABLE constexpr bool __host_is_big_endian = false;
+#endif
+
+// Whether both mappings put every element at the same offset of a
+// contiguous range
+template <class SrcMapping, class DstMapping>
+bool __same_contiguous_mapping(SrcMapping const& s, DstMapping const& d, true_type /* same layout */) {
+  return s.is_contiguous() && d.is_contiguous() && s == d;
+}
+
+template <class SrcMapping, class DstMapping>
+bool __same_contiguous_mapping(SrcMapping const&, DstMapping const&, false_type /* same layout */) {
+  return false;
+}
+
+template <class SrcET, class SrcE, class SrcL, class SrcA, class DstET, class DstE, class DstL, class DstA>
+void __byteswap_copy(
+  mdspan<SrcET, SrcE, SrcL, SrcA> const& src, mdspan<DstET, DstE, DstL, DstA> const& dst
+)
+{
+  static_assert(SrcE::rank() == DstE::rank(), "std::experimental::copy: rank mismatch.");
+  static_assert(is_same<remove_const_t<SrcET>, DstET>::value,
+    "std::experimental::copy: byte-swapping copies require equal element types.");
+  if(__same_contiguous_mapping(src.mapping(), dst.mapping(), is_same<SrcL, DstL>{})) {
+    __byteswap_n(src.data(), dst.data(), src.mapping().required_span_size());
+    return;
+  }
+  __for_each_index(dst.extents(), [&](array<size_t, DstE::rank()> const& idx) {
+    dst(idx) = src(idx);
+    return true;
+  });
+}
+
+} // end namespace detail
+
+// Accessor for big-endian data: byteswap_accessor on little-endian hosts,
+// default_accessor on big-endian ones
+template <class ElementType>
+using big_endian_accessor = conditional_t<detail::__host_is_big_endian,
+  default_accessor<ElementType>, byteswap_accessor<ElementType>>;
+
+//==============================================================================
+
+// dst = src, converting from byte-swapped storage.  Precondition: src and dst
+// have the same extents and do not overlap.
+template <
+  class SrcElementType, class SrcExtents, class SrcLayout,
+  class DstElementType, class DstExtents, class DstLayout
+>
+void copy(
+  mdspan<SrcElementType, SrcExtents, SrcLayout, byteswap_accessor<SrcElementType>> const& src,
+  mdspan<DstElementType, DstExtents, DstLayout, default_accessor<DstElementType>> const& dst
+)
+{
+  detail::__byteswap_copy(src, dst);
+}
+
+// dst = src, converting to byte-swapped storage; see above
+template <
+  class SrcElementType, class SrcExtents, class SrcLayout,
+  class DstElementType, class DstExtents, class DstLayout
+>
+void copy(
+  mdspan<SrcElementType, SrcExtents, SrcLayout, default_accessor<SrcElementType>> const& src,
+  mdspan<DstElementType, DstExtents, DstLayout, byteswap_accessor<DstElementType>> const& dst
+)
+{
+  detail::__byteswap_copy(src, dst);
+}
+
+} // end namespace experimental
+} // end namespace std
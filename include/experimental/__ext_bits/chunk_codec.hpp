@@ -0,0 +1,165 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+// Codecs for the chunks of a chunked array file
+enum class chunk_codec : uint32_t {
+  none = 0,
+  // The bytes of the elements are regrouped by position (all first bytes,
+  // then all second bytes, ...), which turns the sign and exponent bytes of
+  // smooth floating point fields and the high bytes of small integers into
+  // long runs, and the result is run-length encoded.
+  shuffle_rle = 1
+};
+
+namespace detail {
+
+// Run-length encoding with one control byte per run: c < 128 is followed by
+// c + 1 literal bytes, c >= 128 by one byte repeated c - 128 + 3 times.
+inline void __rle_flush_literals(unsigned char const* first, size_t count, std::vector<unsigned char>& out) {
+  while(count > 0) {
+    size_t k = count < 128 ? count : 128;
+    out.push_back((unsigned char)(k - 1));
+    out.insert(out.end(), first, first + k);
+    first += k;
+    count -= k;
+  }
+}
+
+inline void __rle_encode(unsigned char const* in, size_t n, std::vector<unsigned char>& out) {
+  size_t literal_start = 0, i = 0;
+  while(i < n) {
+    size_t run = 1;
+    while(i + run < n && run < 130 && in[i + run] == in[i]) ++run;
+    if(run >= 3) {
+      __rle_flush_literals(in + literal_start, i - literal_start, out);
+      out.push_back((unsigned char)(128 + run - 3));
+      out.push_back(in[i]);
+      literal_start = i + run;
+    }
+    i += run;
+  }
+  __rle_flush_literals(in + literal_start, n - literal_start, out);
+}
+
+// Returns false if `in` does not decode to exactly `n` bytes
+inline bool __rle_decode(unsigned char const* in, size_t in_size, unsigned char* out, size_t n) {
+  size_t i = 0, o = 0;
+  while(i < in_size) {
+    unsigned c = in[i++];
+    if(c < 128) {
+      size_t k = c + 1;
+      if(i + k > in_size || o + k > n) return false;
+      std::memcpy(out + o, in + i, k);
+      i += k;
+      o += k;
+    }
+    else {
+      size_t k = c - 128 + 3;
+      if(i >= in_size || o + k > n) return false;
+      std::memset(out + o, in[i++], k);
+      o += k;
+    }
+  }
+  return o == n;
+}
+
+// Encodes `num_elements` elements of `element_size` bytes each.  When the
+// encoding would not be smaller, `out` holds the raw bytes instead, which
+// the decoder recognizes by their size.
+inline void __chunk_encode(
+  chunk_codec codec, void const* in, size_t num_elements, size_t element_size,
+  std::vector<unsigned char>& out, std::vector<unsigned char>& scratch
+)
+{
+  auto bytes = static_cast<unsigned char const*>(in);
+  size_t n = num_elements * element_size;
+  out.clear();
+  if(codec == chunk_codec::shuffle_rle) {
+    scratch.resize(n);
+    for(size_t b = 0; b < element_size; ++b) {
+      unsigned char* plane = scratch.data() + b * num_elements;
+      for(size_t e = 0; e < num_elements; ++e) plane[e] = bytes[e * element_size + b];
+    }
+    __rle_encode(scratch.data(), n, out);
+    if(out.size() < n) return;
+    out.clear();
+  }
+  out.assign(bytes, bytes + n);
+}
+
+inline bool __chunk_decode(
+  chunk_codec codec, unsigned char const* in, size_t in_size,
+  void* out, size_t num_elements, size_t element_size,
+  std::vector<unsigned char>& scratch
+)
+{
+  auto bytes = static_cast<unsigned char*>(out);
+  size_t n = num_elements * element_size;
+  if(in_size == n) {
+    std::memcpy(bytes, in, n);
+    return true;
+  }
+  if(codec != chunk_codec::shuffle_rle) return false;
+  scratch.resize(n);
+  if(!__rle_decode(in, in_size, scratch.data(), n)) return false;
+  for(size_t b = 0; b < element_size; ++b) {
+    unsigned char const* plane = scratch.data() + b * num_elements;
+    for(size_t e = 0; e < num_elements; ++e) bytes[e * element_size + b] = plane[e];
+  }
+  return true;
+}
+
+} // end namespace detail
+
+} // end namespace experimental
+} // end namespace std
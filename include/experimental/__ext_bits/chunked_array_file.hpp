@@ -0,0 +1,459 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "chunk_codec.hpp"
+#include "execution_policy.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define _MDSPAN_HAS_PREAD 1
+#endif
+
+namespace std {
+namespace experimental {
+
+#if defined(_MDSPAN_HAS_PREAD)
+
+namespace detail {
+
+// Chunked array files are laid out as
+//
+//   "MDSPANCK", then uint32 version, rank, element size, codec
+//   uint64 extents[rank], uint64 chunk extents[rank]
+//   uint64 chunk offsets[number of chunks + 1]
+//   the chunks, back to back
+//
+// in native byte order.  Chunks are numbered in C order over the chunk
+// grid, and the elements of a chunk are stored in C order over the chunk's
+// extents, which are clipped at the upper edges of the array.
+_MDSPAN_INLINE_VARIABLE constexpr char __chunked_magic[8] = {'M', 'D', 'S', 'P', 'A', 'N', 'C', 'K'};
+_MDSPAN_INLINE_VARIABLE constexpr uint32_t __chunked_version = 1;
+
+template <size_t Rank>
+struct __chunk_grid {
+  array<size_t, Rank> extents = { };
+  array<size_t, Rank> chunk_extents = { };
+  array<size_t, Rank> grid = { };
+
+  __chunk_grid() = default;
+
+  __chunk_grid(array<size_t, Rank> const& e, array<size_t, Rank> const& ce)
+    : extents(e), chunk_extents(ce)
+  {
+    for(size_t r = 0; r < Rank; ++r) {
+      if(ce[r] == 0) throw std::invalid_argument("chunked array: chunk extents must be positive");
+      grid[r] = (e[r] + ce[r] - 1) / ce[r];
+    }
+  }
+
+  size_t num_chunks() const noexcept {
+    size_t n = 1;
+    for(auto g : grid) n *= g;
+    return n;
+  }
+
+  // Chunks per index of the chunk grid's first dimension
+  size_t chunks_per_slab() const noexcept {
+    size_t n = 1;
+    for(size_t r = 1; r < Rank; ++r) n *= grid[r];
+    return n;
+  }
+
+  array<size_t, Rank> origin(size_t c) const noexcept {
+    array<size_t, Rank> o = { };
+    for(size_t r = Rank; r-- > 0; ) {
+      o[r] = (c % grid[r]) * chunk_extents[r];
+      c /= grid[r];
+    }
+    return o;
+  }
+
+  array<size_t, Rank> local_extents(array<size_t, Rank> const& o) const noexcept {
+    array<size_t, Rank> l = { };
+    for(size_t r = 0; r < Rank; ++r) {
+      l[r] = extents[r] - o[r] < chunk_extents[r] ? extents[r] - o[r] : chunk_extents[r];
+    }
+    return l;
+  }
+};
+
+// Calls f(local, offset) for the first index `local` of every row (run of
+// the last index) of the extents `l`, in C order, where `offset` is the
+// position of `local` in that order
+template <size_t Rank, class F>
+void __for_each_chunk_row(array<size_t, Rank> const& l, F&& f) {
+  size_t num_rows = l[Rank - 1] == 0 ? 0 : 1;
+  for(size_t r = 0; r + 1 < Rank; ++r) num_rows *= l[r];
+  array<size_t, Rank> idx = { };
+  for(size_t k = 0; k < num_rows; ++k) {
+    f(const_cast<array<size_t, Rank> const&>(idx), k * l[Rank - 1]);
+    for(size_t r = Rank - 1; r-- > 0; ) {
+      if(++idx[r] < l[r]) break;
+      idx[r] = 0;
+    }
+  }
+}
+
+// Runs f(k) for k in [0, n), rethrowing the first exception on the calling
+// thread
+template <class F>
+void __for_each_chunk(execution::sequenced_policy, size_t n, F&& f) {
+  for(size_t k = 0; k < n; ++k) f(k);
+}
+
+template <class F>
+void __for_each_chunk(execution::parallel_policy, size_t n, F&& f) {
+#if defined(_OPENMP)
+  std::exception_ptr error;
+  #pragma omp parallel for schedule(dynamic)
+  for(long long k = 0; k < (long long)n; ++k) {
+    try { f(size_t(k)); }
+    catch(...) {
+      #pragma omp critical
+      if(!error) error = std::current_exception();
+    }
+  }
+  if(error) std::rethrow_exception(error);
+#else
+  __for_each_chunk(execution::seq, n, f);
+#endif
+}
+
+[[noreturn]] inline void __chunked_throw_errno(char const* what, std::string const& path) {
+  throw std::system_error(errno, std::generic_category(), std::string("chunked array: ") + what + " " + path);
+}
+
+inline void __pwrite_all(int fd, void const* p, size_t n, size_t offset, std::string const& path) {
+  auto bytes = static_cast<char const*>(p);
+  while(n > 0) {
+    auto k = ::pwrite(fd, bytes, n, off_t(offset));
+    if(k < 0 && errno == EINTR) continue;
+    if(k <= 0) __chunked_throw_errno("cannot write", path);
+    bytes += k; n -= size_t(k); offset += size_t(k);
+  }
+}
+
+inline void __pread_all(int fd, void* p, size_t n, size_t offset, std::string const& path) {
+  auto bytes = static_cast<char*>(p);
+  while(n > 0) {
+    auto k = ::pread(fd, bytes, n, off_t(offset));
+    if(k < 0 && errno == EINTR) continue;
+    if(k < 0) __chunked_throw_errno("cannot read", path);
+    if(k == 0) throw std::runtime_error("chunked array: " + path + ": truncated file");
+    bytes += k; n -= size_t(k); offset += size_t(k);
+  }
+}
+
+inline size_t __chunked_header_size(size_t rank, size_t num_chunks) noexcept {
+  return 8 + 4 * sizeof(uint32_t) + 2 * rank * sizeof(uint64_t) + (num_chunks + 1) * sizeof(uint64_t);
+}
+
+template <class E>
+array<size_t, E::rank()> __extents_array(E const& e) noexcept {
+  array<size_t, E::rank()> a = { };
+  for(size_t r = 0; r < E::rank(); ++r) a[r] = e.extent(r);
+  return a;
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Writes a chunked array file: the array is cut into chunks of (at most)
+// `chunk_extents` elements, which are compressed independently.  The array
+// is written as a sequence of slabs along the first dimension, in order, each
+// covering whole chunks in that dimension (except for the last).  The chunks
+// of a slab are compressed, and then written, in parallel with
+// execution::par.  Errors throw std::system_error for I/O, and
+// std::invalid_argument or std::runtime_error for misuse.
+template <class T, size_t Rank>
+class chunked_array_writer {
+public:
+
+  static_assert(Rank >= 1, "std::experimental::chunked_array_writer requires rank >= 1.");
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, T),
+    "std::experimental::chunked_array_writer requires a trivially copyable element type.");
+
+  using value_type = T;
+  using extents_type = dextents<Rank>;
+
+  template <class Extents>
+  chunked_array_writer(
+    char const* path, Extents const& e, array<size_t, Rank> const& chunk_extents,
+    chunk_codec codec = chunk_codec::shuffle_rle
+  ) : __path(path), __grid(detail::__extents_array(e), chunk_extents), __codec(codec),
+      __offsets(__grid.num_chunks() + 1, 0)
+  {
+    static_assert(Extents::rank() == Rank, "std::experimental::chunked_array_writer: rank mismatch.");
+    __fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(__fd < 0) detail::__chunked_throw_errno("cannot create", __path);
+    __end = detail::__chunked_header_size(Rank, __grid.num_chunks());
+    __offsets[0] = __end;
+  }
+
+  chunked_array_writer(chunked_array_writer const&) = delete;
+  chunked_array_writer& operator=(chunked_array_writer const&) = delete;
+
+  // Closes the file if close() was not called, leaving it incomplete
+  ~chunked_array_writer() {
+    if(__fd >= 0) ::close(__fd);
+  }
+
+  extents_type extents() const noexcept { return extents_type(__grid.extents); }
+  array<size_t, Rank> const& chunk_extents() const noexcept { return __grid.chunk_extents; }
+  size_t num_chunks() const noexcept { return __grid.num_chunks(); }
+  // Bytes of chunk data written so far
+  size_t stored_bytes() const noexcept { return __end - __offsets[0]; }
+
+  // Writes the elements [first, first + slab.extent(0)) of the first dimension
+  template <class ExecutionPolicy, class ET, class E, class L, class A>
+  void write_slab(ExecutionPolicy policy, mdspan<ET, E, L, A> const& slab, size_t first) {
+    static_assert(E::rank() == Rank, "std::experimental::chunked_array_writer::write_slab: rank mismatch.");
+    static_assert(_MDSPAN_TRAIT(is_same, remove_cv_t<ET>, T),
+      "std::experimental::chunked_array_writer::write_slab requires the file's element type.");
+    size_t last = first + slab.extent(0);
+    size_t ce0 = __grid.chunk_extents[0];
+    bool aligned = first == __next && last <= __grid.extents[0]
+      && (last % ce0 == 0 || last == __grid.extents[0]);
+    for(size_t r = 1; r < Rank; ++r) aligned = aligned && slab.extent(r) == __grid.extents[r];
+    if(!aligned) {
+      throw std::invalid_argument("chunked array: " + __path + ": slabs must be written in order and cover whole chunks");
+    }
+    if(first == last) return;
+
+    size_t first_chunk = first / ce0 * __grid.chunks_per_slab();
+    size_t count = (last + ce0 - 1) / ce0 * __grid.chunks_per_slab() - first_chunk;
+    std::vector<std::vector<unsigned char>> encoded(count);
+    detail::__for_each_chunk(policy, count, [&](size_t k) {
+      auto o = __grid.origin(first_chunk + k);
+      auto l = __grid.local_extents(o);
+      o[0] -= first;
+      size_t n = 1;
+      for(auto e : l) n *= e;
+      std::vector<T> raw(n);
+      detail::__for_each_chunk_row(l, [&](array<size_t, Rank> idx, size_t offset) {
+        for(size_t r = 0; r < Rank; ++r) idx[r] += o[r];
+        T* row = raw.data() + offset;
+        for(size_t j = 0; j < l[Rank - 1]; ++j, ++idx[Rank - 1]) row[j] = slab(idx);
+      });
+      std::vector<unsigned char> scratch;
+      detail::__chunk_encode(__codec, raw.data(), raw.size(), sizeof(T), encoded[k], scratch);
+    });
+    for(size_t k = 0; k < count; ++k) {
+      __offsets[first_chunk + k + 1] = __offsets[first_chunk + k] + encoded[k].size();
+    }
+    detail::__for_each_chunk(policy, count, [&](size_t k) {
+      detail::__pwrite_all(__fd, encoded[k].data(), encoded[k].size(), __offsets[first_chunk + k], __path);
+    });
+    __end = __offsets[first_chunk + count];
+    __next = last;
+  }
+
+  template <class ET, class E, class L, class A>
+  void write_slab(mdspan<ET, E, L, A> const& slab, size_t first) {
+    write_slab(execution::seq, slab, first);
+  }
+
+  // Writes the header and the chunk index; throws if not all of the array
+  // was written
+  void close() {
+    if(__fd < 0) return;
+    if(__next != __grid.extents[0]) {
+      throw std::runtime_error("chunked array: " + __path + ": closed before all slabs were written");
+    }
+    std::vector<unsigned char> header(__offsets[0]);
+    unsigned char* p = header.data();
+    auto put = [&](void const* v, size_t n) { std::memcpy(p, v, n); p += n; };
+    uint32_t fields[4] = { detail::__chunked_version, uint32_t(Rank), uint32_t(sizeof(T)), uint32_t(__codec) };
+    put(detail::__chunked_magic, 8);
+    put(fields, sizeof(fields));
+    for(auto e : __grid.extents) { uint64_t v = e; put(&v, 8); }
+    for(auto e : __grid.chunk_extents) { uint64_t v = e; put(&v, 8); }
+    for(auto e : __offsets) { uint64_t v = e; put(&v, 8); }
+    detail::__pwrite_all(__fd, header.data(), header.size(), 0, __path);
+    int fd = __fd;
+    __fd = -1;
+    if(::close(fd) != 0) detail::__chunked_throw_errno("cannot write", __path);
+  }
+
+private:
+
+  std::string __path;
+  detail::__chunk_grid<Rank> __grid;
+  chunk_codec __codec;
+  std::vector<size_t> __offsets;
+  int __fd = -1;
+  size_t __end = 0;
+  size_t __next = 0;
+
+};
+
+//==============================================================================
+
+// Reads a file written by chunked_array_writer.  Slabs along the first
+// dimension can start and end anywhere; the chunks they touch are read with
+// pread and decompressed in parallel with execution::par.
+template <class T, size_t Rank>
+class chunked_array_reader {
+public:
+
+  static_assert(Rank >= 1, "std::experimental::chunked_array_reader requires rank >= 1.");
+
+  using value_type = T;
+  using extents_type = dextents<Rank>;
+
+  explicit chunked_array_reader(char const* path) : __path(path) {
+    __fd = ::open(path, O_RDONLY);
+    if(__fd < 0) detail::__chunked_throw_errno("cannot open", __path);
+    try { __read_header(); }
+    catch(...) { ::close(__fd); throw; }
+  }
+
+  chunked_array_reader(chunked_array_reader const&) = delete;
+  chunked_array_reader& operator=(chunked_array_reader const&) = delete;
+
+  ~chunked_array_reader() { ::close(__fd); }
+
+  extents_type extents() const noexcept { return extents_type(__grid.extents); }
+  array<size_t, Rank> const& chunk_extents() const noexcept { return __grid.chunk_extents; }
+  chunk_codec codec() const noexcept { return __codec; }
+  size_t num_chunks() const noexcept { return __grid.num_chunks(); }
+  // Bytes of (compressed) chunk data in the file
+  size_t stored_bytes() const noexcept { return __offsets.back() - __offsets.front(); }
+
+  // Reads the elements [first, first + out.extent(0)) of the first dimension
+  // into `out`, whose other extents must match the file's
+  template <class ExecutionPolicy, class ET, class E, class L, class A>
+  void read_slab(ExecutionPolicy policy, mdspan<ET, E, L, A> const& out, size_t first) const {
+    static_assert(E::rank() == Rank, "std::experimental::chunked_array_reader::read_slab: rank mismatch.");
+    size_t last = first + out.extent(0);
+    bool valid = last <= __grid.extents[0];
+    for(size_t r = 1; r < Rank; ++r) valid = valid && out.extent(r) == __grid.extents[r];
+    if(!valid) throw std::invalid_argument("chunked array: " + __path + ": slab out of range");
+    if(first == last) return;
+
+    size_t ce0 = __grid.chunk_extents[0];
+    size_t first_chunk = first / ce0 * __grid.chunks_per_slab();
+    size_t count = (last + ce0 - 1) / ce0 * __grid.chunks_per_slab() - first_chunk;
+    detail::__for_each_chunk(policy, count, [&](size_t k) {
+      size_t c = first_chunk + k;
+      std::vector<unsigned char> encoded(__offsets[c + 1] - __offsets[c]), scratch;
+      detail::__pread_all(__fd, encoded.data(), encoded.size(), __offsets[c], __path);
+      auto o = __grid.origin(c);
+      auto l = __grid.local_extents(o);
+      size_t n = 1;
+      for(auto e : l) n *= e;
+      std::vector<T> raw(n);
+      if(!detail::__chunk_decode(__codec, encoded.data(), encoded.size(), raw.data(), n, sizeof(T), scratch)) {
+        throw std::runtime_error("chunked array: " + __path + ": corrupt chunk");
+      }
+      detail::__for_each_chunk_row(l, [&](array<size_t, Rank> idx, size_t offset) {
+        idx[0] += o[0];
+        if(idx[0] < first || idx[0] >= last) return;
+        idx[0] -= first;
+        for(size_t r = 1; r < Rank; ++r) idx[r] += o[r];
+        T const* row = raw.data() + offset;
+        for(size_t j = 0; j < l[Rank - 1]; ++j, ++idx[Rank - 1]) out(idx) = row[j];
+      });
+    });
+  }
+
+  template <class ET, class E, class L, class A>
+  void read_slab(mdspan<ET, E, L, A> const& out, size_t first) const {
+    read_slab(execution::seq, out, first);
+  }
+
+private:
+
+  void __read_header() {
+    char magic[8];
+    uint32_t fields[4];
+    detail::__pread_all(__fd, magic, 8, 0, __path);
+    detail::__pread_all(__fd, fields, sizeof(fields), 8, __path);
+    if(std::memcmp(magic, detail::__chunked_magic, 8) != 0 || fields[0] != detail::__chunked_version) {
+      throw std::runtime_error("chunked array: " + __path + ": not a chunked array file");
+    }
+    if(fields[1] != Rank || fields[2] != sizeof(T)) {
+      throw std::runtime_error("chunked array: " + __path + ": rank or element size mismatch");
+    }
+    __codec = chunk_codec(fields[3]);
+    uint64_t dims[2 * Rank];
+    detail::__pread_all(__fd, dims, sizeof(dims), 8 + sizeof(fields), __path);
+    array<size_t, Rank> e, ce;
+    for(size_t r = 0; r < Rank; ++r) { e[r] = size_t(dims[r]); ce[r] = size_t(dims[Rank + r]); }
+    __grid = detail::__chunk_grid<Rank>(e, ce);
+    std::vector<uint64_t> offsets(__grid.num_chunks() + 1);
+    detail::__pread_all(__fd, offsets.data(), offsets.size() * sizeof(uint64_t), 8 + sizeof(fields) + sizeof(dims), __path);
+    __offsets.assign(offsets.begin(), offsets.end());
+  }
+
+  std::string __path;
+  int __fd = -1;
+  detail::__chunk_grid<Rank> __grid;
+  chunk_codec __codec = chunk_codec::none;
+  std::vector<size_t> __offsets;
+
+};
+
+#endif // _MDSPAN_HAS_PREAD
+
+} // end namespace experimental
+} // end namespace std
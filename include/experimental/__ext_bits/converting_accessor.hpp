@@ -0,0 +1,271 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "reduced_precision.hpp"
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Proxy reference to one stored element: converts to ComputeT on read and
+// converts (and rounds) back to StorageT on write.  `Converter` provides
+// `load` and `store`.
+template <class StorageT, class ComputeT, class Converter>
+class __converting_reference {
+public:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr __converting_reference(StorageT* p, Converter const& c) noexcept
+    : __ptr(p), __converter(c)
+  { }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED
+  constexpr __converting_reference(__converting_reference const&) noexcept = default;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr operator ComputeT() const noexcept { return __converter.load(*__ptr); } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __converting_reference const& operator=(ComputeT v) const noexcept {
+    *__ptr = __converter.store(v);
+    return *this;
+  }
+
+  // Assigns the referenced value, like a built-in reference would
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __converting_reference const& operator=(__converting_reference const& other) const noexcept {
+    return *this = ComputeT(other);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __converting_reference const& operator+=(ComputeT v) const noexcept { return *this = ComputeT(*this) + v; }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __converting_reference const& operator-=(ComputeT v) const noexcept { return *this = ComputeT(*this) - v; }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __converting_reference const& operator*=(ComputeT v) const noexcept { return *this = ComputeT(*this) * v; }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 __converting_reference const& operator/=(ComputeT v) const noexcept { return *this = ComputeT(*this) / v; }
+
+private:
+
+  StorageT* __ptr;
+  Converter __converter;
+
+};
+
+template <class StorageT, class ComputeT, class Converter>
+struct __converting_reference_type {
+  using type = __converting_reference<StorageT, ComputeT, Converter>;
+};
+
+// Read-only storage needs no proxy
+template <class StorageT, class ComputeT, class Converter>
+struct __converting_reference_type<StorageT const, ComputeT, Converter> {
+  using type = ComputeT;
+};
+
+} // end namespace detail
+
+//==============================================================================
+
+// Accessor for data stored as StorageT (e.g., float16_storage or
+// bfloat16_storage) and computed with as ComputeT (e.g., float), converting
+// with conversion_traits<StorageT, ComputeT> on every access.  With a const
+// StorageT, `reference` is a ComputeT value; otherwise it is a proxy that
+// also rounds on assignment.
+template <class StorageT, class ComputeT>
+class converting_accessor {
+private:
+
+  using __converter_type = conversion_traits<remove_const_t<StorageT>, ComputeT>;
+
+public:
+
+  using offset_policy = converting_accessor;
+  using element_type = conditional_t<is_const<StorageT>::value, ComputeT const, ComputeT>;
+  using pointer = StorageT*;
+  using reference = typename detail::__converting_reference_type<StorageT, ComputeT, __converter_type>::type;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr converting_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherStorageT,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherStorageT(*)[], StorageT(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr converting_accessor(converting_accessor<OtherStorageT, ComputeT>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer offset(pointer p, size_t i) const noexcept {
+    return p + i;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return __access(p + i, is_const<StorageT>{});
+  }
+
+private:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference __access(pointer p, true_type /* is_const */) const noexcept {
+    return __converter_type::load(*p);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference __access(pointer p, false_type /* is_const */) const noexcept {
+    return reference(p, __converter_type());
+  }
+
+};
+
+//==============================================================================
+
+namespace detail {
+
+template <class StorageT, class ComputeT>
+struct __quantized_converter {
+  ComputeT scale;
+  ComputeT inverse_scale;
+  int32_t zero_point;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  ComputeT load(StorageT q) const noexcept {
+    return scale * ComputeT(int32_t(q) - zero_point);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  StorageT store(ComputeT v) const noexcept {
+    // round to nearest, saturate to the range of StorageT; NaN, which has no
+    // integer conversion, is stored as zero
+    ComputeT q = std::isnan(v) ? ComputeT(zero_point) : std::nearbyint(v * inverse_scale) + ComputeT(zero_point);
+    constexpr auto lo = ComputeT(numeric_limits<StorageT>::min());
+    constexpr auto hi = ComputeT(numeric_limits<StorageT>::max());
+    return StorageT(q < lo ? lo : (q > hi ? hi : q));
+  }
+};
+
+} // end namespace detail
+
+// Accessor for linearly quantized integer data: a stored value q stands for
+// scale * (q - zero_point), with one scale and zero point for the whole
+// array.  Assignment rounds to the nearest representable value and
+// saturates, and stores NaN as zero.
+template <class StorageT = int8_t, class ComputeT = float>
+class quantized_accessor {
+private:
+
+  static_assert(is_integral<remove_const_t<StorageT>>::value,
+    "std::experimental::quantized_accessor requires an integral storage type.");
+
+  using __converter_type = detail::__quantized_converter<remove_const_t<StorageT>, ComputeT>;
+
+public:
+
+  using offset_policy = quantized_accessor;
+  using element_type = conditional_t<is_const<StorageT>::value, ComputeT const, ComputeT>;
+  using pointer = StorageT*;
+  using reference = typename detail::__converting_reference_type<StorageT, ComputeT, __converter_type>::type;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr quantized_accessor() noexcept = default;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr quantized_accessor(ComputeT scale, int32_t zero_point) noexcept
+    : __converter{scale, ComputeT(1) / scale, zero_point}
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherStorageT,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherStorageT(*)[], StorageT(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr quantized_accessor(quantized_accessor<OtherStorageT, ComputeT> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : quantized_accessor(other.scale(), other.zero_point())
+  { }
+
+  MDSPAN_INLINE_FUNCTION constexpr ComputeT scale() const noexcept { return __converter.scale; }
+  MDSPAN_INLINE_FUNCTION constexpr int32_t zero_point() const noexcept { return __converter.zero_point; }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer offset(pointer p, size_t i) const noexcept {
+    return p + i;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return __access(p + i, is_const<StorageT>{});
+  }
+
+private:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference __access(pointer p, true_type /* is_const */) const noexcept {
+    return __converter.load(*p);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference __access(pointer p, false_type /* is_const */) const noexcept {
+    return reference(p, __converter);
+  }
+
+  __converter_type __converter = { ComputeT(1), ComputeT(1), 0 };
+
+};
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,261 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "execution_policy.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Non-owning compressed sparse row matrix.
+//
+// The three CSR arrays are rank 1 mdspans: row i holds the entries
+// [row_ptr(i), row_ptr(i + 1)) of `column_indices()` and `values()`.  The
+// offsets do not have to start at zero, so that a view can refer to a band
+// of rows of a larger matrix without copying its row pointers.
+template <class ElementType, class IndexType = int, class OffsetType = size_t>
+class csr_matrix_view {
+public:
+
+  using element_type = ElementType;
+  using value_type = remove_cv_t<ElementType>;
+  using index_type = IndexType;
+  using offset_type = OffsetType;
+  using size_type = size_t;
+
+  using row_ptr_type = mdspan<offset_type const, dextents<1>>;
+  using column_indices_type = mdspan<index_type const, dextents<1>>;
+  using values_type = mdspan<element_type, dextents<1>>;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr csr_matrix_view() noexcept = default;
+
+  // `row_ptr` has one more entry than the matrix has rows
+  MDSPAN_INLINE_FUNCTION
+  constexpr csr_matrix_view(
+    size_type num_cols,
+    row_ptr_type row_ptr,
+    column_indices_type col_idx,
+    values_type values
+  ) noexcept
+    : __num_cols(num_cols), __row_ptr(row_ptr), __col_idx(col_idx), __values(values)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], element_type(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr csr_matrix_view(csr_matrix_view<OtherElementType, index_type, offset_type> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : __num_cols(other.num_cols()), __row_ptr(other.row_ptr()), __col_idx(other.column_indices()),
+      __values(other.values().data(), other.values().extent(0))
+  { }
+
+  //--------------------------------------------------------------------------------
+
+  MDSPAN_INLINE_FUNCTION constexpr size_type num_rows() const noexcept {
+    return __row_ptr.extent(0) == 0 ? 0 : __row_ptr.extent(0) - 1;
+  }
+  MDSPAN_INLINE_FUNCTION constexpr size_type num_cols() const noexcept { return __num_cols; }
+  MDSPAN_INLINE_FUNCTION constexpr size_type nnz() const noexcept {
+    return num_rows() == 0 ? 0 : size_type(__row_ptr(num_rows()) - __row_ptr(0));
+  }
+
+  MDSPAN_INLINE_FUNCTION constexpr row_ptr_type row_ptr() const noexcept { return __row_ptr; }
+  MDSPAN_INLINE_FUNCTION constexpr column_indices_type column_indices() const noexcept { return __col_idx; }
+  MDSPAN_INLINE_FUNCTION constexpr values_type values() const noexcept { return __values; }
+
+  // The column indices and values of row i
+  MDSPAN_INLINE_FUNCTION
+  constexpr column_indices_type row_column_indices(size_type i) const noexcept {
+    return column_indices_type(__col_idx.data() + __row_ptr(i), size_type(__row_ptr(i + 1) - __row_ptr(i)));
+  }
+  MDSPAN_INLINE_FUNCTION
+  constexpr values_type row_values(size_type i) const noexcept {
+    return values_type(__values.data() + __row_ptr(i), size_type(__row_ptr(i + 1) - __row_ptr(i)));
+  }
+
+  // First row of part `part` when the rows are split into `num_parts`
+  // consecutive ranges of (roughly) equal cost, counting one unit per stored
+  // entry and one per row.  balanced_row_split(num_parts, num_parts) is
+  // num_rows().  Rows longer than the average part are not split, so a single
+  // very long row can still dominate its part.
+  _MDSPAN_CONSTEXPR_14 size_type balanced_row_split(size_type part, size_type num_parts) const noexcept {
+    size_type rows = num_rows();
+    if(part >= num_parts) return rows;
+    size_type total = nnz() + rows;
+    // target <= total, which fits easily in a double's mantissa for any
+    // realistic matrix; avoids overflowing part * total
+    size_type target = size_type(double(total) * double(part) / double(num_parts));
+    size_type first = 0, count = rows;
+    while(count > 0) {
+      size_type step = count / 2;
+      size_type mid = first + step;
+      if(size_type(__row_ptr(mid) - __row_ptr(0)) + mid < target) {
+        first = mid + 1;
+        count -= step + 1;
+      }
+      else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+private:
+
+  size_type __num_cols = 0;
+  row_ptr_type __row_ptr;
+  column_indices_type __col_idx;
+  values_type __values;
+
+};
+
+//==============================================================================
+
+namespace detail {
+
+template <
+  class ElementType, class IndexType, class OffsetType,
+  class XElementType, class XExtents, class XLayout, class XAccessor,
+  class YElementType, class YExtents, class YLayout, class YAccessor
+>
+void __csr_matrix_vector_product_rows(
+  csr_matrix_view<ElementType, IndexType, OffsetType> const& A,
+  mdspan<XElementType, XExtents, XLayout, XAccessor> const& x,
+  mdspan<YElementType, YExtents, YLayout, YAccessor> const& y,
+  size_t first_row, size_t last_row
+)
+{
+  using sum_type = typename mdspan<YElementType, YExtents, YLayout, YAccessor>::value_type;
+  auto row_ptr = A.row_ptr();
+  auto cols = A.column_indices();
+  auto vals = A.values();
+  for(size_t i = first_row; i < last_row; ++i) {
+    sum_type sum = 0;
+    for(size_t k = size_t(row_ptr(i)); k < size_t(row_ptr(i + 1)); ++k) {
+      sum += vals(k) * x(size_t(cols(k)));
+    }
+    y(i) = sum;
+  }
+}
+
+} // end namespace detail
+
+// y = A * x
+template <
+  class ElementType, class IndexType, class OffsetType,
+  class XElementType, class XExtents, class XLayout, class XAccessor,
+  class YElementType, class YExtents, class YLayout, class YAccessor
+>
+void sparse_matrix_vector_product(
+  execution::sequenced_policy,
+  csr_matrix_view<ElementType, IndexType, OffsetType> const& A,
+  mdspan<XElementType, XExtents, XLayout, XAccessor> x,
+  mdspan<YElementType, YExtents, YLayout, YAccessor> y
+)
+{
+  static_assert(XExtents::rank() == 1 && YExtents::rank() == 1,
+    "sparse_matrix_vector_product requires rank 1 x and y");
+  detail::__csr_matrix_vector_product_rows(A, x, y, 0, A.num_rows());
+}
+
+// y = A * x, with every thread taking a range of rows holding about the same
+// number of stored entries (see csr_matrix_view::balanced_row_split) rather
+// than the same number of rows.  Static row chunks leave most threads idle
+// on matrices whose row lengths follow a power law; dynamic scheduling
+// balances them but pays for it in scheduling overhead and in rows landing on
+// a different thread (and cache) on every call.
+template <
+  class ElementType, class IndexType, class OffsetType,
+  class XElementType, class XExtents, class XLayout, class XAccessor,
+  class YElementType, class YExtents, class YLayout, class YAccessor
+>
+void sparse_matrix_vector_product(
+  execution::parallel_policy,
+  csr_matrix_view<ElementType, IndexType, OffsetType> const& A,
+  mdspan<XElementType, XExtents, XLayout, XAccessor> x,
+  mdspan<YElementType, YExtents, YLayout, YAccessor> y
+)
+{
+  static_assert(XExtents::rank() == 1 && YExtents::rank() == 1,
+    "sparse_matrix_vector_product requires rank 1 x and y");
+#if defined(_OPENMP)
+  #pragma omp parallel
+#endif
+  {
+    size_t num_threads = size_t(detail::__parallel_num_threads());
+    size_t thread = size_t(detail::__parallel_thread_num());
+    detail::__csr_matrix_vector_product_rows(A, x, y,
+      A.balanced_row_split(thread, num_threads),
+      A.balanced_row_split(thread + 1, num_threads)
+    );
+  }
+}
+
+template <
+  class ElementType, class IndexType, class OffsetType,
+  class XElementType, class XExtents, class XLayout, class XAccessor,
+  class YElementType, class YExtents, class YLayout, class YAccessor
+>
+void sparse_matrix_vector_product(
+  csr_matrix_view<ElementType, IndexType, OffsetType> const& A,
+  mdspan<XElementType, XExtents, XLayout, XAccessor> x,
+  mdspan<YElementType, YExtents, YLayout, YAccessor> y
+)
+{
+  sparse_matrix_vector_product(execution::seq, A, x, y);
+}
+
+} // end namespace experimental
+} // end namespace std
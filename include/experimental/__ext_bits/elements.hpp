@@ -0,0 +1,240 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "reduce.hpp"
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// The elements of a strided mdspan as a forward range.
+//
+// The elements are visited with the index of the first dimension varying
+// fastest for layout_left, and of the last dimension otherwise (the order of
+// `tiles` for layout_left and layout_right).  Rather than evaluating the mapping at every step, the iterator
+// keeps one data handle per rank, pointing at the element with the current
+// indices of that rank and the slower ones and zero for the faster ones:
+// incrementing advances the innermost handle by the innermost stride, and a
+// carry into rank k advances rank k's handle by its stride and copies it into
+// the faster ranks.  Handles are only moved forward with `accessor.offset`, so this
+// works for any accessor, and never past the last element.
+template <class MDSpan>
+class element_range;
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+class element_range<mdspan<ElementType, Extents, Layout, Accessor>> {
+public:
+
+  using mdspan_type = mdspan<ElementType, Extents, Layout, Accessor>;
+  using size_type = size_t;
+  using accessor_type = typename Accessor::offset_policy;
+  using pointer = typename accessor_type::pointer;
+  using reference = typename accessor_type::reference;
+  using value_type = remove_cv_t<ElementType>;
+  using index_type = array<size_t, Extents::rank()>;
+
+  static_assert(mdspan_type::mapping_type::is_always_strided(),
+    "std::experimental::elements requires a strided layout");
+
+  class iterator {
+  public:
+
+    using iterator_concept = forward_iterator_tag;
+    // Proxy references (e.g. from byteswap_accessor) only meet the
+    // requirements of a legacy input iterator
+    using iterator_category = conditional_t<
+      is_reference<typename accessor_type::reference>::value, forward_iterator_tag, input_iterator_tag
+    >;
+    using value_type = remove_cv_t<ElementType>;
+    using difference_type = ptrdiff_t;
+    using reference = typename accessor_type::reference;
+    using pointer = void;
+
+    iterator() = default;
+
+    MDSPAN_FORCE_INLINE_FUNCTION
+    reference operator*() const {
+      return __acc.access(__cur, 0);
+    }
+
+    MDSPAN_FORCE_INLINE_FUNCTION
+    iterator& operator++() {
+      ++__n;
+      if(++__i0 < __ext[0]) {
+        __cur = __acc.offset(__cur, __stride[0]);
+      }
+      else {
+        __i0 = 0;
+        __carry();
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    // The multidimensional index of the current element
+    index_type index() const noexcept {
+      index_type result;
+      for(size_t k = 0; k < Extents::rank(); ++k) result[__dim(k)] = k == 0 ? __i0 : __idx[k];
+      return result;
+    }
+
+    friend bool operator==(iterator const& lhs, iterator const& rhs) noexcept { return lhs.__n == rhs.__n; }
+    friend bool operator!=(iterator const& lhs, iterator const& rhs) noexcept { return lhs.__n != rhs.__n; }
+
+  private:
+
+    friend class element_range;
+
+    // Moves to the start of the next innermost row, returning false if there
+    // is none.  Kept apart from operator++ (rather than handling the innermost
+    // rank in the same loop) so that __cur and __i0, which are all that
+    // changes on most increments, can stay in registers.
+    bool __carry() {
+      for(size_t k = 1; k < __num_ranks; ++k) {
+        if(++__idx[k] < __ext[k]) {
+          __p[k] = __acc.offset(__p[k], __stride[k]);
+          for(size_t j = 1; j < k; ++j) __p[j] = __p[k];
+          __cur = __p[k];
+          return true;
+        }
+        __idx[k] = 0;
+      }
+      return false;
+    }
+
+    // Arrays are indexed by rank in visiting order, fastest first, and the
+    // entries of __p and __idx for the innermost rank are unused (__cur and
+    // __i0 take their place); a rank 0 mdspan is treated as having one rank
+    // of extent 1
+    static constexpr size_t __num_ranks = Extents::rank() == 0 ? 1 : Extents::rank();
+    typename accessor_type::pointer __cur = { };
+    size_t __i0 = 0;
+    array<typename accessor_type::pointer, __num_ranks> __p = { };
+    array<size_t, __num_ranks> __idx = { };
+    array<size_t, __num_ranks> __ext = { };
+    array<size_t, __num_ranks> __stride = { };
+    size_t __n = 0;
+    accessor_type __acc = { };
+  };
+
+  explicit element_range(mdspan_type const& m) : __m(m) { }
+
+  iterator begin() const {
+    iterator it;
+    it.__acc = accessor_type(__m.accessor());
+    // the mapping need not take the origin to offset 0
+    it.__cur = __m.accessor().offset(__m.data(),
+      empty() ? size_t(0) : detail::__offset_of_origin(__m.mapping(), make_index_sequence<Extents::rank()>()));
+    it.__p.fill(it.__cur);
+    it.__ext.fill(1);
+    for(size_t k = 0; k < Extents::rank(); ++k) {
+      it.__ext[k] = size_t(__m.extent(__dim(k)));
+      it.__stride[k] = size_t(__m.stride(__dim(k)));
+    }
+    return it;
+  }
+
+  iterator end() const {
+    iterator it;
+    it.__n = size();
+    return it;
+  }
+
+  // Calls f(element) for every element, in the same order as the iterators
+  // but with the innermost rank as a counted loop, which the compiler can
+  // vectorize
+  template <class F>
+  void for_each(F&& f) const {
+    if(empty()) return;
+    iterator it = begin();
+    size_t const inner_extent = it.__ext[0];
+    size_t const inner_stride = it.__stride[0];
+    if(inner_stride == 1) {
+      do {
+        for(size_t i = 0; i < inner_extent; ++i) f(it.__acc.access(it.__cur, i));
+      } while(it.__carry());
+    }
+    else {
+      do {
+        for(size_t i = 0; i < inner_extent; ++i) f(it.__acc.access(it.__cur, i * inner_stride));
+      } while(it.__carry());
+    }
+  }
+
+  size_type size() const noexcept { return size_type(__m.size()); }
+  bool empty() const noexcept { return size() == 0; }
+
+private:
+
+  // Dimension of the mdspan visited k-th fastest
+  static constexpr size_t __dim(size_t k) noexcept {
+    return _MDSPAN_TRAIT(is_same, Layout, layout_left) ? k : Extents::rank() - 1 - k;
+  }
+
+  mdspan_type __m;
+};
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+element_range<mdspan<ElementType, Extents, Layout, Accessor>>
+elements(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return element_range<mdspan<ElementType, Extents, Layout, Accessor>>(m);
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,150 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace std {
+namespace experimental {
+namespace execution {
+
+//==============================================================================
+
+// Execution policies for the algorithms in this directory.
+//
+// `par` runs on the OpenMP threads of the calling context when the including
+// translation unit is compiled with OpenMP enabled, and falls back to
+// sequential execution otherwise.  So that translation units compiled with
+// and without OpenMP can be linked together, parallel_policy is declared in
+// an inline namespace that depends on _OPENMP: every function or template
+// specialization taking it then has a different name in each kind of
+// translation unit, instead of two definitions the linker may mix up.
+struct sequenced_policy { explicit sequenced_policy() = default; };
+
+#if defined(_OPENMP)
+inline namespace __openmp {
+#else
+inline namespace __sequential {
+#endif
+
+struct parallel_policy { explicit parallel_policy() = default; };
+
+_MDSPAN_INLINE_VARIABLE constexpr auto par = parallel_policy{ };
+
+} // end inline namespace
+
+_MDSPAN_INLINE_VARIABLE constexpr auto seq = sequenced_policy{ };
+
+template <class T>
+struct is_execution_policy : false_type { };
+template <>
+struct is_execution_policy<sequenced_policy> : true_type { };
+template <>
+struct is_execution_policy<parallel_policy> : true_type { };
+
+} // end namespace execution
+
+namespace detail {
+
+// These take no policy, so they go in the same kind of inline namespace
+#if defined(_OPENMP)
+inline namespace __openmp {
+#else
+inline namespace __sequential {
+#endif
+
+inline int __parallel_num_threads() noexcept {
+#if defined(_OPENMP)
+  return omp_in_parallel() ? omp_get_num_threads() : omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+inline int __parallel_thread_num() noexcept {
+#if defined(_OPENMP)
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+} // end inline namespace
+
+inline size_t __max_threads(execution::sequenced_policy) noexcept { return 1; }
+inline size_t __max_threads(execution::parallel_policy) noexcept { return size_t(__parallel_num_threads()); }
+
+// Calls f(thread, num_threads) on every thread of the policy.  The team has
+// at most __max_threads(policy) threads, as counted by the caller before the
+// call, so per-thread storage sized with it can be indexed by `thread` even
+// when the call comes from a parallel region with nested parallelism enabled.
+template <class F>
+void __on_each_thread(execution::sequenced_policy, F&& f) {
+  f(size_t(0), size_t(1));
+}
+
+template <class F>
+void __on_each_thread(execution::parallel_policy policy, F&& f) {
+#if defined(_OPENMP)
+  int const max_threads = int(__max_threads(policy));
+  #pragma omp parallel num_threads(max_threads)
+#else
+  (void)policy;
+#endif
+  {
+    f(size_t(__parallel_thread_num()), size_t(__parallel_num_threads()));
+  }
+}
+
+} // end namespace detail
+
+} // end namespace experimental
+} // end namespace std
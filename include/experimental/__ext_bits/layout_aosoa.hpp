@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Array-of-structs-of-arrays layout for batches of small objects.
+//
+// The first index selects an object of the batch (e.g. one matrix of a batch
+// of matrices), and the others an element of that object.  Objects are
+// grouped into blocks of `VectorLength` consecutive ones; each block stores
+// its elements one after the other in C order, and each element as
+// `VectorLength` consecutive values, one per object of the block.  The same
+// element of neighbouring objects is therefore contiguous, so that a loop
+// over the objects of a block vectorizes, while all the elements of one
+// object stay within `VectorLength * element count` values.  The last block
+// is padded to the full length.  The mapping is unique, and contiguous only
+// when the batch extent is a multiple of `VectorLength`.
+template <size_t VectorLength>
+struct layout_aosoa {
+
+  static_assert(VectorLength != dynamic_extent && VectorLength > 0,
+    "std::experimental::layout_aosoa requires a static, positive vector length.");
+
+  template <class Extents>
+  class mapping {
+  public:
+
+    static_assert(detail::__is_extents_v<Extents>, "std::experimental::layout_aosoa::mapping must be instantiated with a specialization of std::experimental::extents.");
+    static_assert(Extents::rank() >= 1, "std::experimental::layout_aosoa::mapping requires a batch dimension.");
+
+    using extents_type = Extents;
+    using layout = layout_aosoa;
+    using size_type = size_t;
+
+    MDSPAN_INLINE_FUNCTION static constexpr size_type vector_length() noexcept { return VectorLength; }
+
+  private:
+
+    extents_type __exts = { };
+
+    template <class>
+    friend class mapping;
+
+  public:
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping() noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED ~mapping() noexcept = default;
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr mapping(extents_type const& __e) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__e)
+    { }
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class OtherExtents,
+      /* requires */ (
+        _MDSPAN_TRAIT(is_convertible, OtherExtents, Extents)
+      )
+    )
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    mapping(mapping<OtherExtents> const& __other) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__other.__exts)
+    { }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __exts; }
+
+    // Number of elements of one object of the batch
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type element_count() const noexcept {
+      size_type n = 1;
+      for(size_type r = 1; r < extents_type::rank(); ++r) n *= __exts.extent(r);
+      return n;
+    }
+
+    // Number of values stored per block of `vector_length()` objects
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type block_size() const noexcept {
+      return VectorLength * element_count();
+    }
+
+    MDSPAN_INLINE_FUNCTION constexpr size_type num_blocks() const noexcept {
+      return (__exts.extent(0) + VectorLength - 1) / VectorLength;
+    }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class... Indices,
+      /* requires */ (
+        sizeof...(Indices) == extents_type::rank() &&
+        _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, Indices, size_type) /* && ... */)
+      )
+    )
+    MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type operator()(Indices... idxs) const noexcept {
+      size_type const i[] = {size_type(idxs)...};
+      size_type element = 0;
+      for(size_type r = 1; r < extents_type::rank(); ++r) {
+        element = element * __exts.extent(r) + i[r];
+      }
+      return (i[0] / VectorLength) * block_size() + element * VectorLength + i[0] % VectorLength;
+    }
+
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type required_span_size() const noexcept {
+      return num_blocks() * block_size();
+    }
+
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() noexcept { return true; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() noexcept { return false; }
+
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_unique() noexcept { return true; }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_contiguous() const noexcept {
+      return __exts.extent(0) % VectorLength == 0;
+    }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_strided() noexcept { return false; }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator==(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return lhs.extents() == rhs.extents();
+    }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator!=(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  };
+};
+
+} // end namespace experimental
+} // end namespace std
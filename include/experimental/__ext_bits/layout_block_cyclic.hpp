@@ -0,0 +1,264 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// ScaLAPACK-style two-dimensional block-cyclic distribution.
+//
+// The mapping's domain is the *global* index space of the distributed matrix,
+// and its codomain is the local (column-major, like ScaLAPACK's local arrays)
+// storage of one process of a `grid_shape()[0] x grid_shape()[1]` process
+// grid.  Block (bi, bj) of the global matrix lives on process
+// (bi % nprow, bj % npcol).  Evaluating the mapping at an index that is not
+// owned by `grid_coord()` is a precondition violation; use `owner()` or
+// `is_local()` to find out who stores a given element.
+template <size_t RowBlock, size_t ColBlock>
+struct layout_block_cyclic {
+
+  static_assert(RowBlock != dynamic_extent && ColBlock != dynamic_extent,
+    "std::experimental::layout_block_cyclic requires static block sizes.");
+  static_assert(RowBlock > 0 && ColBlock > 0,
+    "std::experimental::layout_block_cyclic block sizes must be positive.");
+
+  template <class Extents>
+  class mapping {
+  public:
+
+    static_assert(detail::__is_extents_v<Extents>, "std::experimental::layout_block_cyclic::mapping must be instantiated with a specialization of std::experimental::extents.");
+    static_assert(Extents::rank() == 2, "std::experimental::layout_block_cyclic::mapping is only defined for rank 2 extents.");
+
+    using extents_type = Extents;
+    using layout = layout_block_cyclic;
+    using size_type = size_t;
+    using grid_index_type = array<size_t, 2>;
+    using local_extents_type = dextents<2>;
+
+    MDSPAN_INLINE_FUNCTION static constexpr size_type row_block_size() noexcept { return RowBlock; }
+    MDSPAN_INLINE_FUNCTION static constexpr size_type col_block_size() noexcept { return ColBlock; }
+
+  private:
+
+    extents_type __exts = { };
+    grid_index_type __grid_shape = {{1, 1}};
+    grid_index_type __grid_coord = {{0, 0}};
+    // local leading dimension (the number of rows stored on this process)
+    size_type __lld = 0;
+    size_type __local_cols = 0;
+
+    template <class>
+    friend class mapping;
+
+  public: // (but not really)
+
+    // Number of rows (or columns) of an n-element dimension that end up on
+    // process `iproc` out of `nprocs` when distributed in blocks of `nb`;
+    // this is ScaLAPACK's NUMROC with the source process fixed to 0.
+    MDSPAN_INLINE_FUNCTION
+    static constexpr size_type
+    __numroc(size_type n, size_type nb, size_type iproc, size_type nprocs) noexcept {
+      return ((n / nb) / nprocs) * nb + (
+        iproc < (n / nb) % nprocs ? nb
+          : (iproc == (n / nb) % nprocs ? n % nb : 0)
+      );
+    }
+
+    MDSPAN_FORCE_INLINE_FUNCTION
+    static constexpr size_type
+    __global_to_local(size_type i, size_type nb, size_type nprocs) noexcept {
+      return (i / (nb * nprocs)) * nb + i % nb;
+    }
+
+    MDSPAN_FORCE_INLINE_FUNCTION
+    static constexpr size_type
+    __local_to_global(size_type li, size_type nb, size_type iproc, size_type nprocs) noexcept {
+      return ((li / nb) * nprocs + iproc) * nb + li % nb;
+    }
+
+  public:
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping() noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED ~mapping() noexcept = default;
+
+    // A single-process grid; equivalent to (a more expensive) layout_left
+    MDSPAN_INLINE_FUNCTION
+    constexpr mapping(extents_type const& __e) noexcept
+      : mapping(__e, grid_index_type{{1, 1}}, grid_index_type{{0, 0}})
+    { }
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr mapping(
+      extents_type const& __e,
+      grid_index_type const& __shape,
+      grid_index_type const& __coord
+    ) noexcept
+      : __exts(__e),
+        __grid_shape(__shape),
+        __grid_coord(__coord),
+        __lld(__numroc(__e.extent(0), RowBlock, __coord[0], __shape[0])),
+        __local_cols(__numroc(__e.extent(1), ColBlock, __coord[1], __shape[1]))
+    { }
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class OtherExtents,
+      /* requires */ (
+        _MDSPAN_TRAIT(is_convertible, OtherExtents, Extents)
+      )
+    )
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    mapping(mapping<OtherExtents> const& __other) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__other.__exts),
+        __grid_shape(__other.__grid_shape),
+        __grid_coord(__other.__grid_coord),
+        __lld(__other.__lld),
+        __local_cols(__other.__local_cols)
+    { }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __exts; }
+    MDSPAN_INLINE_FUNCTION constexpr grid_index_type grid_shape() const noexcept { return __grid_shape; }
+    MDSPAN_INLINE_FUNCTION constexpr grid_index_type grid_coord() const noexcept { return __grid_coord; }
+
+    // Extents of the part of the matrix stored on `grid_coord()`
+    MDSPAN_INLINE_FUNCTION constexpr local_extents_type local_extents() const noexcept {
+      return local_extents_type(__lld, __local_cols);
+    }
+
+    // The process grid coordinate that owns global element (i, j)
+    MDSPAN_INLINE_FUNCTION
+    constexpr grid_index_type owner(size_type i, size_type j) const noexcept {
+      return grid_index_type{{(i / RowBlock) % __grid_shape[0], (j / ColBlock) % __grid_shape[1]}};
+    }
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr bool is_local(size_type i, size_type j) const noexcept {
+      return (i / RowBlock) % __grid_shape[0] == __grid_coord[0]
+        && (j / ColBlock) % __grid_shape[1] == __grid_coord[1];
+    }
+
+    // Inverse of the mapping restricted to this process: the global index of
+    // local element (li, lj)
+    MDSPAN_INLINE_FUNCTION
+    constexpr grid_index_type global_index(size_type li, size_type lj) const noexcept {
+      return grid_index_type{{
+        __local_to_global(li, RowBlock, __grid_coord[0], __grid_shape[0]),
+        __local_to_global(lj, ColBlock, __grid_coord[1], __grid_shape[1])
+      }};
+    }
+
+    //--------------------------------------------------------------------------------
+
+    // Precondition: is_local(i, j)
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type operator()(size_type i, size_type j) const noexcept {
+      return __global_to_local(i, RowBlock, __grid_shape[0])
+        + __global_to_local(j, ColBlock, __grid_shape[1]) * __lld;
+    }
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr size_type required_span_size() const noexcept {
+      return __lld * __local_cols;
+    }
+
+    // Elements owned by other processes alias local storage, so only the
+    // trivial 1x1 grid is unique, contiguous, and strided over the full domain.
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() noexcept { return false; }
+
+    MDSPAN_INLINE_FUNCTION constexpr bool is_unique() const noexcept {
+      return __grid_shape[0] == 1 && __grid_shape[1] == 1;
+    }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_contiguous() const noexcept {
+      return __grid_shape[0] == 1 && __grid_shape[1] == 1;
+    }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_strided() const noexcept {
+      return __grid_shape[0] == 1 && __grid_shape[1] == 1;
+    }
+
+    // Precondition: is_strided()
+    MDSPAN_INLINE_FUNCTION
+    constexpr size_type stride(size_t r) const noexcept {
+      return r == 0 ? 1 : __lld;
+    }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator==(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return lhs.extents() == rhs.extents()
+        && lhs.__grid_shape[0] == rhs.__grid_shape[0]
+        && lhs.__grid_shape[1] == rhs.__grid_shape[1]
+        && lhs.__grid_coord[0] == rhs.__grid_coord[0]
+        && lhs.__grid_coord[1] == rhs.__grid_coord[1];
+    }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator!=(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  };
+};
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,166 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Ragged (jagged) 2D layout: row i has its own length and is stored at
+// [offsets[i], offsets[i + 1]) of one contiguous buffer, i.e., (i, j) maps to
+// offsets[i] + j.  The extents are (number of rows, longest row); indices
+// past the length of a row are outside the row and must not be accessed.
+//
+// The mapping does not own the offsets; `offsets` must point to
+// `extents().extent(0) + 1` non-decreasing offsets starting at zero (the last
+// being the total number of elements) that outlive the mapping.  See
+// ragged_array for a container that computes them from per-row counts.
+struct layout_ragged {
+
+  template <class Extents>
+  class mapping {
+  public:
+
+    static_assert(detail::__is_extents_v<Extents>, "std::experimental::layout_ragged::mapping must be instantiated with a specialization of std::experimental::extents.");
+    static_assert(Extents::rank() == 2, "std::experimental::layout_ragged::mapping is only defined for rank 2 extents.");
+
+    using extents_type = Extents;
+    using layout = layout_ragged;
+    using size_type = size_t;
+
+  private:
+
+    extents_type __exts = { };
+    size_type const* __offsets = nullptr;
+
+    template <class>
+    friend class mapping;
+
+  public:
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping() noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED ~mapping() noexcept = default;
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr mapping(extents_type const& __e, size_type const* __offsets_) noexcept
+      : __exts(__e), __offsets(__offsets_)
+    { }
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class OtherExtents,
+      /* requires */ (
+        _MDSPAN_TRAIT(is_convertible, OtherExtents, Extents)
+      )
+    )
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    mapping(mapping<OtherExtents> const& __other) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__other.__exts), __offsets(__other.__offsets)
+    { }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __exts; }
+
+    MDSPAN_INLINE_FUNCTION constexpr size_type const* offsets() const noexcept { return __offsets; }
+
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type row_offset(size_type i) const noexcept { return __offsets[i]; }
+
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type row_length(size_type i) const noexcept { return __offsets[i + 1] - __offsets[i]; }
+
+    //--------------------------------------------------------------------------------
+
+    // Precondition: j < row_length(i)
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type operator()(size_type i, size_type j) const noexcept {
+      return __offsets[i] + j;
+    }
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr size_type required_span_size() const noexcept {
+      return __offsets == nullptr ? 0 : __offsets[__exts.extent(0)];
+    }
+
+    // Indices past the length of a row alias the following row, so the
+    // mapping is only unique (and contiguous) over the valid entries.
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() noexcept { return false; }
+
+    MDSPAN_INLINE_FUNCTION constexpr bool is_unique() const noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_contiguous() const noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_strided() const noexcept { return false; }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator==(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return lhs.extents() == rhs.extents() && lhs.__offsets == rhs.__offsets;
+    }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator!=(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  };
+};
+
+} // end namespace experimental
+} // end namespace std
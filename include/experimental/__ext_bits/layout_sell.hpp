@@ -0,0 +1,189 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Sliced ELLPACK (SELL-C-sigma) storage for sparse matrices.
+//
+// Rows are grouped into chunks of `ChunkHeight` consecutive (sorted) rows.
+// Each chunk is padded to the length of its longest row and stored
+// column-major, i.e., as a `ChunkHeight x chunk_width` layout_left block, so
+// that the k-th entries of all rows in a chunk are contiguous.  The mapping's
+// domain is (row slot, entry within row), with extents
+// (number of chunks * ChunkHeight, widest chunk); indices past the width of
+// a row's chunk are outside the storage and must not be accessed.
+//
+// The mapping does not own the chunk offsets; `chunk_offsets` must point to
+// `number of chunks + 1` increasing offsets (the last being the total storage
+// size) that outlive the mapping.
+template <size_t ChunkHeight>
+struct layout_sell {
+
+  static_assert(ChunkHeight != dynamic_extent && ChunkHeight > 0,
+    "std::experimental::layout_sell requires a static, positive chunk height.");
+
+  template <class Extents>
+  class mapping {
+  public:
+
+    static_assert(detail::__is_extents_v<Extents>, "std::experimental::layout_sell::mapping must be instantiated with a specialization of std::experimental::extents.");
+    static_assert(Extents::rank() == 2, "std::experimental::layout_sell::mapping is only defined for rank 2 extents.");
+
+    using extents_type = Extents;
+    using layout = layout_sell;
+    using size_type = size_t;
+
+    MDSPAN_INLINE_FUNCTION static constexpr size_type chunk_height() noexcept { return ChunkHeight; }
+
+  private:
+
+    extents_type __exts = { };
+    size_type const* __chunk_offsets = nullptr;
+
+    template <class>
+    friend class mapping;
+
+  public:
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping() noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED ~mapping() noexcept = default;
+
+    // Precondition: extents().extent(0) is a multiple of ChunkHeight
+    MDSPAN_INLINE_FUNCTION
+    constexpr mapping(extents_type const& __e, size_type const* __offsets) noexcept
+      : __exts(__e), __chunk_offsets(__offsets)
+    { }
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class OtherExtents,
+      /* requires */ (
+        _MDSPAN_TRAIT(is_convertible, OtherExtents, Extents)
+      )
+    )
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    mapping(mapping<OtherExtents> const& __other) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__other.__exts), __chunk_offsets(__other.__chunk_offsets)
+    { }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __exts; }
+
+    MDSPAN_INLINE_FUNCTION constexpr size_type num_chunks() const noexcept {
+      return __exts.extent(0) / ChunkHeight;
+    }
+
+    MDSPAN_INLINE_FUNCTION constexpr size_type const* chunk_offsets() const noexcept {
+      return __chunk_offsets;
+    }
+
+    // Offset of the first stored entry of chunk c
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type chunk_offset(size_type c) const noexcept {
+      return __chunk_offsets[c];
+    }
+
+    // Number of (padded) entries stored for every row of chunk c
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type chunk_width(size_type c) const noexcept {
+      return (__chunk_offsets[c + 1] - __chunk_offsets[c]) / ChunkHeight;
+    }
+
+    //--------------------------------------------------------------------------------
+
+    // Precondition: k < chunk_width(row / ChunkHeight)
+    MDSPAN_FORCE_INLINE_FUNCTION
+    constexpr size_type operator()(size_type row, size_type k) const noexcept {
+      return __chunk_offsets[row / ChunkHeight] + k * ChunkHeight + row % ChunkHeight;
+    }
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr size_type required_span_size() const noexcept {
+      return __chunk_offsets == nullptr ? 0 : __chunk_offsets[num_chunks()];
+    }
+
+    // Indices past the width of a chunk alias the following chunk, so the
+    // mapping is only unique (and contiguous) over the valid entries.
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() noexcept { return false; }
+
+    MDSPAN_INLINE_FUNCTION constexpr bool is_unique() const noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_contiguous() const noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION constexpr bool is_strided() const noexcept { return false; }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator==(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return lhs.extents() == rhs.extents() && lhs.__chunk_offsets == rhs.__chunk_offsets;
+    }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator!=(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  };
+};
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,215 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Tiled layout: the domain is cut into tiles of the static extents
+// TileExtents..., which are numbered in C order over the tile grid and stored
+// back to back, each one `tile_size()` elements long and itself in C order.
+// Tiles at the upper edges of the domain are padded to the full tile size,
+// so that every tile starts at a multiple of `tile_size()` and
+// `offset / tile_size()` is the tile holding an element; this is what lets a
+// tile-granular accessor (e.g. paged_accessor) or file format address whole
+// tiles.  The mapping is unique, and contiguous only when every extent is a
+// multiple of its tile extent.
+template <size_t... TileExtents>
+struct layout_tiled {
+
+  static_assert(sizeof...(TileExtents) >= 1,
+    "std::experimental::layout_tiled requires at least one tile extent.");
+  static_assert(_MDSPAN_FOLD_AND((TileExtents != dynamic_extent && TileExtents > 0) /* && ... */),
+    "std::experimental::layout_tiled requires static, positive tile extents.");
+
+  template <class Extents>
+  class mapping {
+  public:
+
+    static_assert(detail::__is_extents_v<Extents>, "std::experimental::layout_tiled::mapping must be instantiated with a specialization of std::experimental::extents.");
+    static_assert(Extents::rank() == sizeof...(TileExtents), "std::experimental::layout_tiled::mapping requires one tile extent per dimension.");
+
+    using extents_type = Extents;
+    using layout = layout_tiled;
+    using size_type = size_t;
+
+    MDSPAN_INLINE_FUNCTION static constexpr size_type tile_extent(size_type r) noexcept {
+      return __tile_extents[r];
+    }
+
+    MDSPAN_INLINE_FUNCTION static constexpr size_type tile_size() noexcept {
+      return __product(TileExtents...);
+    }
+
+  private:
+
+    static constexpr size_type __tile_extents[sizeof...(TileExtents)] = {TileExtents...};
+
+    MDSPAN_INLINE_FUNCTION static constexpr size_type __product() noexcept { return 1; }
+
+    template <class... Sizes>
+    MDSPAN_INLINE_FUNCTION static constexpr size_type __product(size_type t, Sizes... ts) noexcept {
+      return t * __product(ts...);
+    }
+
+    extents_type __exts = { };
+
+    template <class>
+    friend class mapping;
+
+  public:
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping() noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr mapping(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping const&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED _MDSPAN_CONSTEXPR_14_DEFAULTED mapping& operator=(mapping&&) noexcept = default;
+    MDSPAN_INLINE_FUNCTION_DEFAULTED ~mapping() noexcept = default;
+
+    MDSPAN_INLINE_FUNCTION
+    constexpr mapping(extents_type const& __e) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__e)
+    { }
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class OtherExtents,
+      /* requires */ (
+        _MDSPAN_TRAIT(is_convertible, OtherExtents, Extents)
+      )
+    )
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    mapping(mapping<OtherExtents> const& __other) noexcept // NOLINT(google-explicit-constructor)
+      : __exts(__other.__exts)
+    { }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_INLINE_FUNCTION constexpr extents_type extents() const noexcept { return __exts; }
+
+    // Number of tiles along dimension r
+    MDSPAN_INLINE_FUNCTION
+    constexpr size_type tile_grid_extent(size_type r) const noexcept {
+      return (__exts.extent(r) + tile_extent(r) - 1) / tile_extent(r);
+    }
+
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type num_tiles() const noexcept {
+      size_type n = 1;
+      for(size_type r = 0; r < extents_type::rank(); ++r) n *= tile_grid_extent(r);
+      return n;
+    }
+
+    //--------------------------------------------------------------------------------
+
+    MDSPAN_TEMPLATE_REQUIRES(
+      class... Indices,
+      /* requires */ (
+        sizeof...(Indices) == extents_type::rank() &&
+        _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, Indices, size_type) /* && ... */)
+      )
+    )
+    MDSPAN_FORCE_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type operator()(Indices... idxs) const noexcept {
+      size_type const i[] = {size_type(idxs)...};
+      size_type tile = 0, local = 0;
+      for(size_type r = 0; r < extents_type::rank(); ++r) {
+        tile = tile * tile_grid_extent(r) + i[r] / tile_extent(r);
+        local = local * tile_extent(r) + i[r] % tile_extent(r);
+      }
+      return tile * tile_size() + local;
+    }
+
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14
+    size_type required_span_size() const noexcept {
+      for(size_type r = 0; r < extents_type::rank(); ++r) {
+        if(__exts.extent(r) == 0) return 0;
+      }
+      return num_tiles() * tile_size();
+    }
+
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_unique() noexcept { return true; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_contiguous() noexcept { return false; }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_always_strided() noexcept { return false; }
+
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_unique() noexcept { return true; }
+    MDSPAN_INLINE_FUNCTION _MDSPAN_CONSTEXPR_14 bool is_contiguous() const noexcept {
+      for(size_type r = 0; r < extents_type::rank(); ++r) {
+        if(__exts.extent(r) % tile_extent(r) != 0) return false;
+      }
+      return true;
+    }
+    MDSPAN_INLINE_FUNCTION static constexpr bool is_strided() noexcept { return false; }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator==(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return lhs.extents() == rhs.extents();
+    }
+
+    template <class OtherExtents>
+    MDSPAN_INLINE_FUNCTION
+    friend constexpr bool operator!=(mapping const& lhs, mapping<OtherExtents> const& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+
+  };
+};
+
+template <size_t... TileExtents>
+template <class Extents>
+constexpr size_t layout_tiled<TileExtents...>::mapping<Extents>::__tile_extents[sizeof...(TileExtents)];
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,297 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/extents.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define _MDSPAN_HAS_MMAP 1
+#endif
+
+namespace std {
+namespace experimental {
+
+// How the elements of a memory-mapped array will be accessed, passed on to
+// the kernel as a paging hint
+enum class mapped_access {
+  normal,     // default read-ahead
+  sequential, // aggressive read-ahead, pages behind the access can be dropped
+  random,     // no read-ahead
+  willneed    // start reading the whole range in now
+};
+
+enum class mapped_file_mode {
+  open_existing, // the file must hold at least the mapped range
+  create         // create the file if needed and resize it to end with the
+                 // mapped range, keeping the bytes before it
+};
+
+namespace detail {
+
+// The hint matching a traversal whose loops run over the dimensions in
+// `loop_order`, outermost first.  Walking the dimensions by decreasing
+// stride visits memory in order; otherwise the traversal jumps, and jumps of
+// at least a page defeat read-ahead entirely.
+template <class Mapping, size_t Rank>
+mapped_access __traversal_access(Mapping const& m, std::array<size_t, Rank> const& loop_order, size_t element_size, size_t page_size) {
+  bool in_order = true;
+  for(size_t r = 1; r < Rank; ++r) {
+    in_order = in_order && m.stride(loop_order[r - 1]) >= m.stride(loop_order[r]);
+  }
+  if(in_order) return mapped_access::sequential;
+  size_t innermost_stride = m.stride(loop_order[Rank - 1]) * element_size;
+  return innermost_stride >= page_size ? mapped_access::random : mapped_access::normal;
+}
+
+template <class Mapping>
+mapped_access __traversal_access(Mapping const&, std::array<size_t, 0> const&, size_t, size_t) {
+  return mapped_access::sequential;
+}
+
+} // end namespace detail
+
+#if defined(_MDSPAN_HAS_MMAP)
+
+//==============================================================================
+
+// Owning array whose elements live in a memory-mapped file, for datasets that
+// should not be read into (or do not fit in) memory up front.  `view()` is an
+// mdspan directly over the mapping; pages are read on first access and can be
+// evicted again by the kernel.
+//
+// With a const ElementType the file is opened and mapped read-only; otherwise
+// it is mapped shared and read-write, so that stores reach the file (call
+// `sync()` to wait for them).  The mapped range starts `file_offset` bytes
+// into the file, which need not be page aligned, and is
+// `mapping.required_span_size() * sizeof(ElementType)` bytes long.  Failures
+// to open or map the file throw std::system_error.  The array is move-only.
+template <class ElementType, class Extents, class LayoutPolicy = layout_right>
+class mapped_mdarray {
+public:
+
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, ElementType),
+    "std::experimental::mapped_mdarray requires a trivially copyable element type.");
+
+  using element_type = ElementType;
+  using value_type = remove_cv_t<ElementType>;
+  using size_type = size_t;
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+
+  using mdspan_type = mdspan<element_type, extents_type, layout_type>;
+  using const_mdspan_type = mdspan<element_type const, extents_type, layout_type>;
+
+  mapped_mdarray() = default;
+
+  mapped_mdarray(
+    char const* path, mapping_type const& m,
+    mapped_file_mode mode = mapped_file_mode::open_existing, size_type file_offset = 0
+  ) : __mapping(m)
+  {
+    constexpr bool read_only = is_const<element_type>::value;
+    if(read_only && mode == mapped_file_mode::create) {
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+        "std::experimental::mapped_mdarray: cannot create a file for a read-only array");
+    }
+    size_type bytes = size_type(m.required_span_size()) * sizeof(element_type);
+    int flags = read_only ? O_RDONLY : O_RDWR;
+    if(mode == mapped_file_mode::create) flags |= O_CREAT;
+    int fd = ::open(path, flags, 0644);
+    if(fd < 0) __throw_errno("open");
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      __throw_errno("stat", err);
+    }
+    if(mode == mapped_file_mode::create) {
+      if(::ftruncate(fd, off_t(file_offset + bytes)) != 0) {
+        int err = errno;
+        ::close(fd);
+        __throw_errno("ftruncate", err);
+      }
+    }
+    else if(size_type(st.st_size) < file_offset + bytes) {
+      ::close(fd);
+      throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+        "std::experimental::mapped_mdarray: file is smaller than the mapped range");
+    }
+
+    // mmap needs a page aligned file offset
+    size_type page = __page_size();
+    size_type aligned_offset = file_offset / page * page;
+    __map_length = bytes + (file_offset - aligned_offset);
+    if(__map_length > 0) {
+      int prot = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+      void* base = ::mmap(nullptr, __map_length, prot, MAP_SHARED, fd, off_t(aligned_offset));
+      if(base == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        __throw_errno("mmap", err);
+      }
+      __base = static_cast<char*>(base);
+      __data = reinterpret_cast<element_type*>(__base + (file_offset - aligned_offset));
+    }
+    // the mapping keeps the file alive
+    ::close(fd);
+  }
+
+  mapped_mdarray(mapped_mdarray const&) = delete;
+  mapped_mdarray& operator=(mapped_mdarray const&) = delete;
+
+  mapped_mdarray(mapped_mdarray&& other) noexcept { __swap(other); }
+
+  mapped_mdarray& operator=(mapped_mdarray&& other) noexcept {
+    mapped_mdarray(std::move(other)).__swap(*this);
+    return *this;
+  }
+
+  ~mapped_mdarray() {
+    if(__base != nullptr) ::munmap(__base, __map_length);
+  }
+
+  //--------------------------------------------------------------------------------
+
+  mapping_type const& mapping() const noexcept { return __mapping; }
+  extents_type extents() const noexcept { return __mapping.extents(); }
+  size_type size() const noexcept { return size_type(__mapping.required_span_size()); }
+  size_type size_bytes() const noexcept { return size() * sizeof(element_type); }
+  bool is_mapped() const noexcept { return __base != nullptr; }
+
+  element_type* data() noexcept { return __data; }
+  element_type const* data() const noexcept { return __data; }
+
+  mdspan_type view() noexcept { return mdspan_type(__data, __mapping); }
+  const_mdspan_type view() const noexcept { return const_mdspan_type(__data, __mapping); }
+
+  //--------------------------------------------------------------------------------
+
+  // Applies the paging hint to the whole array
+  void advise(mapped_access a) const {
+    __advise(a, __base, __map_length);
+  }
+
+  // Applies the paging hint to the storage of the elements at offsets
+  // [first, last) of the codomain, e.g., to request the next slab of a
+  // layout_right array with mapped_access::willneed while working on the
+  // current one
+  void advise(mapped_access a, size_type first, size_type last) const {
+    if(first >= last) return;
+    size_type page = __page_size();
+    auto begin = reinterpret_cast<uintptr_t>(__data + first) / page * page;
+    auto end = reinterpret_cast<uintptr_t>(__data + last);
+    __advise(a, reinterpret_cast<char*>(begin), size_type(end - begin));
+  }
+
+  // Picks the hint for a traversal whose loops run over the dimensions in
+  // `loop_order`, outermost first, applies it, and returns it: sequential if
+  // the traversal follows the layout, random if its innermost loop jumps by
+  // a page or more, normal otherwise.
+  mapped_access advise_traversal(std::array<size_type, extents_type::rank()> const& loop_order) const {
+    auto a = detail::__traversal_access(__mapping, loop_order, sizeof(element_type), __page_size());
+    advise(a);
+    return a;
+  }
+
+  // Blocks until all stores to the array have been written to the file
+  void sync() const {
+    if(__base != nullptr && ::msync(__base, __map_length, MS_SYNC) != 0) __throw_errno("msync");
+  }
+
+private:
+
+  static size_type __page_size() noexcept { return size_type(::sysconf(_SC_PAGESIZE)); }
+
+  [[noreturn]] static void __throw_errno(char const* what, int err = errno) {
+    throw std::system_error(err, std::generic_category(), std::string("std::experimental::mapped_mdarray: ") + what);
+  }
+
+  static void __advise(mapped_access a, char* p, size_type length) {
+    if(p == nullptr || length == 0) return;
+    int advice = POSIX_MADV_NORMAL;
+    switch(a) {
+      case mapped_access::normal: advice = POSIX_MADV_NORMAL; break;
+      case mapped_access::sequential: advice = POSIX_MADV_SEQUENTIAL; break;
+      case mapped_access::random: advice = POSIX_MADV_RANDOM; break;
+      case mapped_access::willneed: advice = POSIX_MADV_WILLNEED; break;
+    }
+    int err = ::posix_madvise(p, length, advice);
+    if(err != 0) __throw_errno("posix_madvise", err);
+  }
+
+  void __swap(mapped_mdarray& other) noexcept {
+    std::swap(__mapping, other.__mapping);
+    std::swap(__base, other.__base);
+    std::swap(__map_length, other.__map_length);
+    std::swap(__data, other.__data);
+  }
+
+  mapping_type __mapping = { };
+  char* __base = nullptr;
+  size_type __map_length = 0;
+  element_type* __data = nullptr;
+
+};
+
+#endif // _MDSPAN_HAS_MMAP
+
+} // end namespace experimental
+} // end namespace std
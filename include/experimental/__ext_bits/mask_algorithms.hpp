@@ -0,0 +1,326 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "bitpacked_accessor.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
+#include <bit>
+#endif
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+template <class Word>
+MDSPAN_INLINE_FUNCTION
+size_t __popcount(Word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return size_t(__builtin_popcountll((unsigned long long)w));
+#elif defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
+  return size_t(std::popcount(w));
+#else
+  size_t count = 0;
+  for(; w != 0; w &= Word(w - 1)) ++count;
+  return count;
+#endif
+}
+
+template <class Accessor>
+struct __bitpacked_word_type { using type = void; };
+template <class Word>
+struct __bitpacked_word_type<bitpacked_accessor<Word>> { using type = Word; };
+template <class Word>
+struct __bitpacked_word_type<bitpacked_offset_accessor<Word>> { using type = Word; };
+
+template <class Accessor>
+using __is_bitpacked = integral_constant<bool,
+  !_MDSPAN_TRAIT(is_void, typename __bitpacked_word_type<Accessor>::type)
+>;
+
+// The first word and the bit within it of a bit-packed mdspan's codomain
+template <class Word>
+MDSPAN_INLINE_FUNCTION
+constexpr bit_pointer<Word> __first_bit(Word* p) noexcept { return bit_pointer<Word>(p, 0); }
+template <class Word>
+MDSPAN_INLINE_FUNCTION
+constexpr bit_pointer<Word> __first_bit(bit_pointer<Word> p) noexcept { return p; }
+
+// Calls f(k, mask) for every word k (counted from the word holding bit
+// `first`) that holds some of the bits [first, first + n), with `mask`
+// selecting those bits, until f returns false.
+template <class Word, class F>
+void __for_each_word(size_t first, size_t n, F&& f) {
+  constexpr size_t bits = __bits_per_word<Word>::value;
+  if(n == 0) return;
+  size_t last = first + n - 1;
+  size_t last_word = last / bits;
+  Word all = Word(~Word(0));
+  Word first_mask = Word(all << first);
+  Word last_mask = Word(all >> (bits - 1 - last % bits));
+  if(last_word == 0) {
+    f(size_t(0), Word(first_mask & last_mask));
+    return;
+  }
+  if(!f(size_t(0), first_mask)) return;
+  for(size_t k = 1; k < last_word; ++k) {
+    if(!f(k, all)) return;
+  }
+  f(last_word, last_mask);
+}
+
+// Calls f(index) for every multidimensional index of m, in layout_right
+// order, until f returns false
+template <size_t R, size_t Rank, class Extents, class F>
+enable_if_t<R == Rank, bool>
+__for_each_index(Extents const&, array<size_t, Rank>& idx, F& f) {
+  return f(const_cast<array<size_t, Rank> const&>(idx));
+}
+
+template <size_t R, size_t Rank, class Extents, class F>
+enable_if_t<R != Rank, bool>
+__for_each_index(Extents const& e, array<size_t, Rank>& idx, F& f) {
+  for(idx[R] = 0; idx[R] < e.extent(R); ++idx[R]) {
+    if(!__for_each_index<R + 1>(e, idx, f)) return false;
+  }
+  return true;
+}
+
+template <class Extents, class F>
+void __for_each_index(Extents const& e, F&& f) {
+  array<size_t, Extents::rank()> idx = { };
+  __for_each_index<0>(e, idx, f);
+}
+
+template <class ET, class E, class L, class A>
+bool __has_word_access(mdspan<ET, E, L, A> const& m, true_type /* is_bitpacked */) {
+  return m.mapping().is_contiguous();
+}
+
+template <class ET, class E, class L, class A>
+bool __has_word_access(mdspan<ET, E, L, A> const&, false_type /* is_bitpacked */) {
+  return false;
+}
+
+template <class ET, class E, class L, class A>
+size_t __mask_count_words(mdspan<ET, E, L, A> const& m, true_type /* is_bitpacked */) {
+  using word_type = remove_const_t<typename __bitpacked_word_type<A>::type>;
+  auto first = __first_bit(m.data());
+  size_t count = 0;
+  __for_each_word<word_type>(first.bit, m.mapping().required_span_size(), [&](size_t k, word_type mask) {
+    count += __popcount(word_type(first.word[k] & mask));
+    return true;
+  });
+  return count;
+}
+
+template <class ET, class E, class L, class A>
+size_t __mask_count_words(mdspan<ET, E, L, A> const&, false_type /* is_bitpacked */) {
+  return 0;
+}
+
+// found_value: whether to look for a set (true) or a clear (false) bit
+template <class ET, class E, class L, class A>
+bool __mask_find_words(mdspan<ET, E, L, A> const& m, bool found_value, true_type /* is_bitpacked */) {
+  using word_type = remove_const_t<typename __bitpacked_word_type<A>::type>;
+  auto first = __first_bit(m.data());
+  bool found = false;
+  __for_each_word<word_type>(first.bit, m.mapping().required_span_size(), [&](size_t k, word_type mask) {
+    word_type w = word_type(first.word[k] & mask);
+    found = found_value ? w != 0 : w != mask;
+    return !found;
+  });
+  return found;
+}
+
+template <class ET, class E, class L, class A>
+bool __mask_find_words(mdspan<ET, E, L, A> const&, bool, false_type /* is_bitpacked */) {
+  return false;
+}
+
+template <class ET, class E, class L, class A>
+bool __mask_find(mdspan<ET, E, L, A> const& m, bool found_value) {
+  if(__has_word_access(m, __is_bitpacked<A>{})) {
+    return __mask_find_words(m, found_value, __is_bitpacked<A>{});
+  }
+  bool found = false;
+  __for_each_index(m.extents(), [&](array<size_t, E::rank()> const& idx) {
+    found = bool(m(idx)) == found_value;
+    return !found;
+  });
+  return found;
+}
+
+template <class AET, class BET, class OutET, class E, class L, class AA, class BA, class OutA, class WordOp>
+bool __mask_binary_op_words(
+  mdspan<AET, E, L, AA> const& a, mdspan<BET, E, L, BA> const& b, mdspan<OutET, E, L, OutA> const& out,
+  WordOp op, true_type /* all bitpacked */
+)
+{
+  using word_type = remove_const_t<typename __bitpacked_word_type<OutA>::type>;
+  static_assert(is_same<word_type, remove_const_t<typename __bitpacked_word_type<AA>::type>>::value &&
+                is_same<word_type, remove_const_t<typename __bitpacked_word_type<BA>::type>>::value,
+                "bit-packed operands must use the same word type");
+  auto first_a = __first_bit(a.data());
+  auto first_b = __first_bit(b.data());
+  auto first_out = __first_bit(out.data());
+  if(!(a.mapping() == out.mapping() && b.mapping() == out.mapping()) ||
+     first_a.bit != first_out.bit || first_b.bit != first_out.bit ||
+     !out.mapping().is_contiguous()) {
+    return false;
+  }
+  __for_each_word<word_type>(first_out.bit, out.mapping().required_span_size(), [&](size_t k, word_type mask) {
+    word_type result = op(word_type(first_a.word[k]), word_type(first_b.word[k]));
+    first_out.word[k] = word_type((first_out.word[k] & ~mask) | (result & mask));
+    return true;
+  });
+  return true;
+}
+
+template <class AET, class BET, class OutET, class E, class L, class AA, class BA, class OutA, class WordOp>
+bool __mask_binary_op_words(
+  mdspan<AET, E, L, AA> const&, mdspan<BET, E, L, BA> const&, mdspan<OutET, E, L, OutA> const&,
+  WordOp, false_type /* all bitpacked */
+)
+{
+  return false;
+}
+
+template <class AET, class BET, class OutET, class E, class L, class AA, class BA, class OutA, class WordOp, class BoolOp>
+void __mask_binary_op(
+  mdspan<AET, E, L, AA> const& a, mdspan<BET, E, L, BA> const& b, mdspan<OutET, E, L, OutA> const& out,
+  WordOp word_op, BoolOp bool_op
+)
+{
+  using all_bitpacked = integral_constant<bool,
+    __is_bitpacked<AA>::value && __is_bitpacked<BA>::value && __is_bitpacked<OutA>::value
+  >;
+  if(__mask_binary_op_words(a, b, out, word_op, all_bitpacked{})) return;
+  __for_each_index(out.extents(), [&](array<size_t, E::rank()> const& idx) {
+    out(idx) = bool_op(bool(a(idx)), bool(b(idx)));
+    return true;
+  });
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Algorithms over boolean masks.  They accept any mdspan whose elements
+// convert to bool; for bit-packed masks (bitpacked_accessor or
+// bitpacked_offset_accessor) with a contiguous mapping they process a whole
+// word at a time, otherwise they visit every element.
+
+// Number of true elements
+template <class ElementType, class Extents, class Layout, class Accessor>
+size_t mask_count(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  using is_bitpacked = detail::__is_bitpacked<Accessor>;
+  if(detail::__has_word_access(m, is_bitpacked{})) {
+    return detail::__mask_count_words(m, is_bitpacked{});
+  }
+  size_t count = 0;
+  detail::__for_each_index(m.extents(), [&](array<size_t, Extents::rank()> const& idx) {
+    count += bool(m(idx)) ? 1 : 0;
+    return true;
+  });
+  return count;
+}
+
+// Whether any element is true
+template <class ElementType, class Extents, class Layout, class Accessor>
+bool mask_any(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return detail::__mask_find(m, true);
+}
+
+// Whether all elements are true (in particular, if there are none)
+template <class ElementType, class Extents, class Layout, class Accessor>
+bool mask_all(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return !detail::__mask_find(m, false);
+}
+
+// out = a & b, elementwise.  The word-at-a-time path is taken when all three
+// are bit-packed with equal mappings, start at the same bit within a word,
+// and are contiguous.
+template <
+  class AElementType, class BElementType, class OutElementType,
+  class Extents, class Layout, class AAccessor, class BAccessor, class OutAccessor
+>
+void mask_and(
+  mdspan<AElementType, Extents, Layout, AAccessor> const& a,
+  mdspan<BElementType, Extents, Layout, BAccessor> const& b,
+  mdspan<OutElementType, Extents, Layout, OutAccessor> const& out
+)
+{
+  detail::__mask_binary_op(a, b, out,
+    [](auto x, auto y) { return decltype(x)(x & y); },
+    [](bool x, bool y) { return x && y; }
+  );
+}
+
+// out = a | b, elementwise; see mask_and
+template <
+  class AElementType, class BElementType, class OutElementType,
+  class Extents, class Layout, class AAccessor, class BAccessor, class OutAccessor
+>
+void mask_or(
+  mdspan<AElementType, Extents, Layout, AAccessor> const& a,
+  mdspan<BElementType, Extents, Layout, BAccessor> const& b,
+  mdspan<OutElementType, Extents, Layout, OutAccessor> const& out
+)
+{
+  detail::__mask_binary_op(a, b, out,
+    [](auto x, auto y) { return decltype(x)(x | y); },
+    [](bool x, bool y) { return x || y; }
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
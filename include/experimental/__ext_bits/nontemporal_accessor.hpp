@@ -0,0 +1,242 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#endif
+
+#if defined(__has_builtin)
+#  if __has_builtin(__builtin_nontemporal_store)
+#    define _MDSPAN_HAS_BUILTIN_NONTEMPORAL_STORE 1
+#  endif
+#endif
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Whether the target has a streaming store for values of type T
+template <class T>
+struct __has_nontemporal_store : integral_constant<bool,
+#if defined(_MDSPAN_HAS_BUILTIN_NONTEMPORAL_STORE) && !defined(__CUDA_ARCH__)
+  _MDSPAN_TRAIT(is_arithmetic, T)
+#elif defined(__SSE2__) && !defined(__CUDA_ARCH__) && defined(__x86_64__)
+  _MDSPAN_TRAIT(is_trivially_copyable, T) && (sizeof(T) == 4 || sizeof(T) == 8)
+#elif defined(__SSE2__) && !defined(__CUDA_ARCH__)
+  _MDSPAN_TRAIT(is_trivially_copyable, T) && sizeof(T) == 4
+#else
+  false
+#endif
+> { };
+
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __nontemporal_store_impl(T* p, T const& v, false_type /* has_nontemporal_store */) noexcept {
+  *p = v;
+}
+
+#if defined(_MDSPAN_HAS_BUILTIN_NONTEMPORAL_STORE) && !defined(__CUDA_ARCH__)
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __nontemporal_store_impl(T* p, T const& v, true_type /* has_nontemporal_store */) noexcept {
+  __builtin_nontemporal_store(v, p);
+}
+#elif defined(__SSE2__) && !defined(__CUDA_ARCH__)
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __nontemporal_store_bits(T* p, T const& v, integral_constant<size_t, 4>) noexcept {
+  int bits;
+  std::memcpy(&bits, &v, 4);
+  _mm_stream_si32(reinterpret_cast<int*>(p), bits);
+}
+
+#  if defined(__x86_64__)
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __nontemporal_store_bits(T* p, T const& v, integral_constant<size_t, 8>) noexcept {
+  long long bits;
+  std::memcpy(&bits, &v, 8);
+  _mm_stream_si64(reinterpret_cast<long long*>(p), bits);
+}
+#  endif
+
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __nontemporal_store_impl(T* p, T const& v, true_type /* has_nontemporal_store */) noexcept {
+  __nontemporal_store_bits(p, v, integral_constant<size_t, sizeof(T)>{});
+}
+#endif
+
+// Stores `v` to `*p` bypassing the caches where the target has a streaming
+// store for values of that type, and with a regular store otherwise
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __nontemporal_store(T* p, T const& v) noexcept {
+  __nontemporal_store_impl(p, v, __has_nontemporal_store<T>{});
+}
+
+// Proxy reference that writes with streaming stores.  Reads are regular
+// loads, so reading back an element before the accessor is flushed is
+// allowed but defeats the purpose.
+template <class ElementType>
+class __nontemporal_reference {
+public:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr explicit __nontemporal_reference(ElementType* p) noexcept : __ptr(p) { }
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED
+  constexpr __nontemporal_reference(__nontemporal_reference const&) noexcept = default;
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr operator ElementType() const noexcept { return *__ptr; } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  __nontemporal_reference const& operator=(ElementType const& v) const noexcept {
+    __nontemporal_store(__ptr, v);
+    return *this;
+  }
+
+  // Assigns the referenced value, like a built-in reference would
+  MDSPAN_FORCE_INLINE_FUNCTION
+  __nontemporal_reference const& operator=(__nontemporal_reference const& other) const noexcept {
+    return *this = ElementType(other);
+  }
+
+private:
+  ElementType* __ptr;
+};
+
+template <class ElementType>
+struct __nontemporal_reference_type {
+  using type = __nontemporal_reference<ElementType>;
+};
+
+// Read-only views have nothing to stream
+template <class ElementType>
+struct __nontemporal_reference_type<ElementType const> {
+  using type = ElementType const&;
+};
+
+} // end namespace detail
+
+//==============================================================================
+
+// Accessor for outputs that are written once and not read again soon, whose
+// reference writes with streaming (non-temporal) stores.  These skip the
+// read-for-ownership of the destination cache line and do not evict useful
+// data, which pays off for arrays much larger than the last level cache and
+// costs for arrays that fit in it.
+//
+// Streaming stores are weakly ordered: call `flush()` after the last write
+// and before any other thread (or a synchronization point) reads the data.
+// Elements without a streaming store of their size are stored normally.
+template <class ElementType>
+class nontemporal_accessor {
+public:
+
+  using offset_policy = nontemporal_accessor;
+  using element_type = ElementType;
+  using pointer = ElementType*;
+  using reference = typename detail::__nontemporal_reference_type<ElementType>::type;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr nontemporal_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr nontemporal_accessor(nontemporal_accessor<OtherElementType>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr pointer offset(pointer p, size_t i) const noexcept {
+    return p + i;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return __access(p + i, is_const<ElementType>{});
+  }
+
+  // Orders all preceding streaming stores of the calling thread before its
+  // later stores
+  MDSPAN_INLINE_FUNCTION
+  void flush() const noexcept {
+#if defined(__SSE2__) && !defined(__CUDA_ARCH__)
+    _mm_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+  }
+
+private:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference __access(pointer p, true_type /* is_const */) const noexcept {
+    return *p;
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference __access(pointer p, false_type /* is_const */) const noexcept {
+    return reference(p);
+  }
+
+};
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,443 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "mapped_mdarray.hpp"
+#include "reduced_precision.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+// The header of a NumPy .npy file: the array is stored at `data_offset`
+// bytes into the file, as prod(shape) elements of type `descr` in C order,
+// or in Fortran order if `fortran_order` is set.
+struct npy_header {
+  std::string descr;
+  bool fortran_order = false;
+  std::vector<size_t> shape;
+  size_t data_offset = 0;
+
+  size_t size() const noexcept {
+    size_t n = 1;
+    for(auto e : shape) n *= e;
+    return n;
+  }
+};
+
+namespace detail {
+
+// Whether T has an npy type string
+template <class T, class U = remove_cv_t<T>>
+struct __has_npy_descr : integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, U, bool) || _MDSPAN_TRAIT(is_same, U, float16_storage) ||
+  _MDSPAN_TRAIT(is_same, U, std::complex<float>) || _MDSPAN_TRAIT(is_same, U, std::complex<double>) ||
+  _MDSPAN_TRAIT(is_floating_point, U) || _MDSPAN_TRAIT(is_integral, U)
+> { };
+
+// The npy type string of T in native byte order, e.g. "<f8" for double on
+// little endian targets; empty for types without one
+template <class T>
+std::string __npy_descr() {
+  using type = remove_cv_t<T>;
+  if(!__has_npy_descr<T>::value) return std::string();
+  char kind =
+    _MDSPAN_TRAIT(is_same, type, bool) ? 'b' :
+    _MDSPAN_TRAIT(is_same, type, float16_storage) ? 'f' :
+    _MDSPAN_TRAIT(is_same, type, std::complex<float>) || _MDSPAN_TRAIT(is_same, type, std::complex<double>) ? 'c' :
+    _MDSPAN_TRAIT(is_floating_point, type) ? 'f' :
+    _MDSPAN_TRAIT(is_integral, type) ? (_MDSPAN_TRAIT(is_signed, type) ? 'i' : 'u') :
+    '\0';
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  char order = sizeof(type) == 1 ? '|' : '>';
+#else
+  char order = sizeof(type) == 1 ? '|' : '<';
+#endif
+  return std::string(1, order) + kind + std::to_string(sizeof(type));
+}
+
+// '=' (native) and, for single byte types, '<' and '>' are equivalent to the
+// byte order __npy_descr writes
+template <class T>
+bool __npy_descr_matches(std::string descr) {
+  auto expected = __npy_descr<T>();
+  if(descr.size() < 2 || expected.empty()) return false;
+  if(descr[0] == '=' || (sizeof(T) == 1 && (descr[0] == '<' || descr[0] == '>'))) {
+    descr[0] = expected[0];
+  }
+  return descr == expected;
+}
+
+template <class Layout>
+struct __npy_layout_order { };
+template <>
+struct __npy_layout_order<layout_right> : integral_constant<bool, false> { };
+template <>
+struct __npy_layout_order<layout_left> : integral_constant<bool, true> { };
+
+template <class Layout>
+using __is_npy_layout = integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, Layout, layout_left) || _MDSPAN_TRAIT(is_same, Layout, layout_right)
+>;
+
+[[noreturn]] inline void __npy_throw_errno(char const* what, char const* path) {
+  throw std::system_error(errno, std::generic_category(), std::string(what) + " " + path);
+}
+
+[[noreturn]] inline void __npy_throw_format(char const* what, char const* path) {
+  throw std::runtime_error(std::string("npy: ") + path + ": " + what);
+}
+
+struct __npy_file_closer {
+  void operator()(std::FILE* f) const noexcept { std::fclose(f); }
+};
+using __npy_file = std::unique_ptr<std::FILE, __npy_file_closer>;
+
+// Returns the text following `'key':` in the header dictionary, with leading
+// spaces removed
+inline char const* __npy_dict_value(std::string const& dict, char const* key) {
+  auto pos = dict.find(std::string("'") + key + "'");
+  if(pos == std::string::npos) return nullptr;
+  pos = dict.find(':', pos);
+  if(pos == std::string::npos) return nullptr;
+  pos = dict.find_first_not_of(' ', pos + 1);
+  return pos == std::string::npos ? nullptr : dict.c_str() + pos;
+}
+
+inline npy_header __read_npy_header(std::FILE* f, char const* path) {
+  unsigned char preamble[10];
+  if(std::fread(preamble, 1, 10, f) != 10 || std::memcmp(preamble, "\x93NUMPY", 6) != 0) {
+    __npy_throw_format("not an npy file", path);
+  }
+  size_t header_length = size_t(preamble[8]) | size_t(preamble[9]) << 8;
+  size_t preamble_length = 10;
+  if(preamble[6] >= 2) {
+    unsigned char more[2];
+    if(std::fread(more, 1, 2, f) != 2) __npy_throw_format("truncated header", path);
+    header_length |= size_t(more[0]) << 16 | size_t(more[1]) << 24;
+    preamble_length = 12;
+  }
+  std::string dict(header_length, '\0');
+  if(std::fread(&dict[0], 1, header_length, f) != header_length) {
+    __npy_throw_format("truncated header", path);
+  }
+
+  npy_header h;
+  h.data_offset = preamble_length + header_length;
+  char const* descr = __npy_dict_value(dict, "descr");
+  char const* fortran_order = __npy_dict_value(dict, "fortran_order");
+  char const* shape = __npy_dict_value(dict, "shape");
+  if(descr == nullptr || fortran_order == nullptr || shape == nullptr || *descr != '\'' || *shape != '(') {
+    __npy_throw_format("malformed header", path);
+  }
+  char const* descr_end = std::strchr(descr + 1, '\'');
+  if(descr_end == nullptr) __npy_throw_format("malformed header", path);
+  h.descr.assign(descr + 1, descr_end);
+  h.fortran_order = std::strncmp(fortran_order, "True", 4) == 0;
+  for(char const* p = shape + 1; *p != ')'; ) {
+    if(*p == ' ' || *p == ',') { ++p; continue; }
+    char* end = nullptr;
+    unsigned long long e = std::strtoull(p, &end, 10);
+    if(end == p) __npy_throw_format("malformed shape", path);
+    h.shape.push_back(size_t(e));
+    p = end;
+  }
+  return h;
+}
+
+// Calls f(idx) for every multidimensional index of `e`, with the last index
+// varying fastest (C order) or the first (Fortran order)
+template <class Extents, class F>
+void __npy_for_each_index(Extents const& e, bool fortran_order, F&& f) {
+  constexpr size_t rank = Extents::rank();
+  size_t n = 1;
+  for(size_t r = 0; r < rank; ++r) n *= e.extent(r);
+  array<size_t, rank> idx = { };
+  for(size_t k = 0; k < n; ++k) {
+    f(const_cast<array<size_t, rank> const&>(idx));
+    for(size_t d = 0; d < rank; ++d) {
+      size_t r = fortran_order ? d : rank - 1 - d;
+      if(++idx[r] < e.extent(r)) break;
+      idx[r] = 0;
+    }
+  }
+}
+
+// Whether the elements of `x` are contiguous, at x.data(), in the given order
+template <class ET, class E, class L, class A>
+bool __npy_is_contiguous_in_order(mdspan<ET, E, L, A> const&, bool fortran_order) {
+  return _MDSPAN_TRAIT(is_same, A, default_accessor<ET>)
+    && (E::rank() <= 1 || (fortran_order ? _MDSPAN_TRAIT(is_same, L, layout_left) : _MDSPAN_TRAIT(is_same, L, layout_right)))
+    && __is_npy_layout<L>::value;
+}
+
+template <class Extents>
+Extents __npy_extents(npy_header const& h, char const* path) {
+  if(h.shape.size() != Extents::rank()) __npy_throw_format("rank mismatch", path);
+  array<size_t, Extents::rank_dynamic()> dyn = { };
+  size_t d = 0;
+  for(size_t r = 0; r < Extents::rank(); ++r) {
+    if(Extents::static_extent(r) == dynamic_extent) dyn[d++] = h.shape[r];
+    else if(Extents::static_extent(r) != h.shape[r]) __npy_throw_format("extent mismatch", path);
+  }
+  return Extents(dyn);
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+inline npy_header read_npy_header(char const* path) {
+  detail::__npy_file f(std::fopen(path, "rb"));
+  if(!f) detail::__npy_throw_errno("npy: cannot open", path);
+  return detail::__read_npy_header(f.get(), path);
+}
+
+// The layout_left (for Fortran order) or layout_right (for C order) mapping
+// of the array in an npy file.  Throws std::runtime_error if the element
+// type, the rank, a static extent, or the storage order does not match.
+template <class ElementType, class Extents, class Layout>
+typename Layout::template mapping<Extents> npy_mapping(npy_header const& h, char const* path = "") {
+  static_assert(detail::__is_npy_layout<Layout>::value,
+    "std::experimental::npy_mapping requires layout_left or layout_right.");
+  if(!detail::__npy_descr_matches<ElementType>(h.descr)) detail::__npy_throw_format("element type mismatch", path);
+  if(Extents::rank() > 1 && h.fortran_order != detail::__npy_layout_order<Layout>::value) {
+    detail::__npy_throw_format("storage order mismatch", path);
+  }
+  return typename Layout::template mapping<Extents>(detail::__npy_extents<Extents>(h, path));
+}
+
+//==============================================================================
+
+// Writes an npy file from one or more chunks, appended in file order, without
+// holding the whole array in memory.  A chunk that is itself contiguous in
+// file order (a default_accessor layout_right chunk for C order files, or
+// layout_left for Fortran order) is written straight from its memory; other
+// chunks are gathered through a small staging buffer.  close() checks that
+// exactly the number of elements announced in the header was written.
+template <class T>
+class npy_writer {
+public:
+
+  using value_type = T;
+
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, T),
+    "std::experimental::npy_writer requires a trivially copyable element type.");
+  // checked here rather than in the constructor, which would already have
+  // created the file
+  static_assert(detail::__has_npy_descr<T>::value,
+    "std::experimental::npy_writer requires an element type with an npy dtype.");
+
+  template <class Extents>
+  npy_writer(char const* path, Extents const& shape, bool fortran_order = false)
+    : __path(path), __fortran_order(fortran_order), __file(std::fopen(path, "wb"))
+  {
+    auto descr = detail::__npy_descr<T>();
+    if(!__file) detail::__npy_throw_errno("npy: cannot create", path);
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': " + (fortran_order ? "True" : "False") + ", 'shape': (";
+    __size = 1;
+    for(size_t r = 0; r < Extents::rank(); ++r) {
+      dict += std::to_string(shape.extent(r)) + (Extents::rank() == 1 ? ",)" : (r + 1 == Extents::rank() ? ")" : ", "));
+      __size *= shape.extent(r);
+    }
+    if(Extents::rank() == 0) dict += ")";
+    dict += ", }";
+    // version 1.0 unless the header length does not fit in 16 bits; the
+    // data starts at a multiple of 64 bytes
+    size_t preamble_length = dict.size() + 11 < 65536 ? 10 : 12;
+    size_t total = (preamble_length + dict.size() + 1 + 63) / 64 * 64;
+    dict.append(total - preamble_length - dict.size() - 1, ' ');
+    dict += '\n';
+    size_t header_length = dict.size();
+    unsigned char preamble[12] = { 0x93, 'N', 'U', 'M', 'P', 'Y', (unsigned char)(preamble_length == 10 ? 1 : 2), 0,
+      (unsigned char)(header_length), (unsigned char)(header_length >> 8),
+      (unsigned char)(header_length >> 16), (unsigned char)(header_length >> 24) };
+    __write(preamble, preamble_length);
+    __write(dict.data(), dict.size());
+  }
+
+  npy_writer(npy_writer const&) = delete;
+  npy_writer& operator=(npy_writer const&) = delete;
+
+  // Closes the file if close() was not called, without checking the size
+  ~npy_writer() = default;
+
+  size_t size() const noexcept { return __size; }
+  size_t written() const noexcept { return __written; }
+
+  // Appends the elements of `chunk` in the order of the file (C or Fortran
+  // order over the chunk's own indices), e.g. the next rows of a C order
+  // array
+  template <class ET, class E, class L, class A>
+  void append(mdspan<ET, E, L, A> const& chunk) {
+    static_assert(_MDSPAN_TRAIT(is_same, remove_cv_t<ET>, T),
+      "std::experimental::npy_writer::append requires chunks of the file's element type.");
+    size_t n = 1;
+    for(size_t r = 0; r < E::rank(); ++r) n *= chunk.extent(r);
+    if(__written + n > __size) detail::__npy_throw_format("more elements appended than announced", __path.c_str());
+    if(detail::__npy_is_contiguous_in_order(chunk, __fortran_order)) {
+      __write(chunk.data(), n * sizeof(T));
+    }
+    else {
+      constexpr size_t staging_size = (size_t(1) << 16) / sizeof(T) + 1;
+      std::unique_ptr<T[]> staging(new T[staging_size]);
+      size_t filled = 0;
+      detail::__npy_for_each_index(chunk.extents(), __fortran_order, [&](array<size_t, E::rank()> const& idx) {
+        staging[filled++] = chunk(idx);
+        if(filled == staging_size) {
+          __write(staging.get(), filled * sizeof(T));
+          filled = 0;
+        }
+      });
+      __write(staging.get(), filled * sizeof(T));
+    }
+    __written += n;
+  }
+
+  void close() {
+    if(!__file) return;
+    auto f = __file.release();
+    if(std::fclose(f) != 0) detail::__npy_throw_errno("npy: cannot write", __path.c_str());
+    if(__written != __size) detail::__npy_throw_format("fewer elements appended than announced", __path.c_str());
+  }
+
+private:
+
+  void __write(void const* p, size_t bytes) {
+    if(bytes != 0 && std::fwrite(p, 1, bytes, __file.get()) != bytes) {
+      detail::__npy_throw_errno("npy: cannot write", __path.c_str());
+    }
+  }
+
+  std::string __path;
+  bool __fortran_order = false;
+  detail::__npy_file __file;
+  size_t __size = 0;
+  size_t __written = 0;
+
+};
+
+// Writes `x` to an npy file: in Fortran order for layout_left, and in C order
+// for all other layouts
+template <class ET, class E, class L, class A>
+void save_npy(char const* path, mdspan<ET, E, L, A> const& x) {
+  npy_writer<remove_cv_t<ET>> writer(path, x.extents(), _MDSPAN_TRAIT(is_same, L, layout_left));
+  writer.append(x);
+  writer.close();
+}
+
+//==============================================================================
+
+// Reads the array in an npy file into `x`, which must have the file's element
+// type and extents, in any layout.  If `x` is contiguous in the file's order
+// the data is read straight into it; otherwise it is scattered from a small
+// staging buffer.
+template <class ET, class E, class L, class A>
+void load_npy(char const* path, mdspan<ET, E, L, A> const& x) {
+  using value_type = remove_cv_t<ET>;
+  detail::__npy_file f(std::fopen(path, "rb"));
+  if(!f) detail::__npy_throw_errno("npy: cannot open", path);
+  auto h = detail::__read_npy_header(f.get(), path);
+  if(!detail::__npy_descr_matches<value_type>(h.descr)) detail::__npy_throw_format("element type mismatch", path);
+  if(h.shape.size() != E::rank()) detail::__npy_throw_format("rank mismatch", path);
+  for(size_t r = 0; r < E::rank(); ++r) {
+    if(h.shape[r] != x.extent(r)) detail::__npy_throw_format("extent mismatch", path);
+  }
+  size_t n = h.size();
+  if(detail::__npy_is_contiguous_in_order(x, h.fortran_order)) {
+    if(std::fread(x.data(), sizeof(value_type), n, f.get()) != n) detail::__npy_throw_format("truncated data", path);
+    return;
+  }
+  constexpr size_t staging_size = (size_t(1) << 16) / sizeof(value_type) + 1;
+  std::unique_ptr<value_type[]> staging(new value_type[staging_size]);
+  size_t available = 0, next = 0, remaining = n;
+  detail::__npy_for_each_index(x.extents(), h.fortran_order, [&](array<size_t, E::rank()> const& idx) {
+    if(next == available) {
+      available = std::min(staging_size, remaining);
+      if(std::fread(staging.get(), sizeof(value_type), available, f.get()) != available) {
+        detail::__npy_throw_format("truncated data", path);
+      }
+      remaining -= available;
+      next = 0;
+    }
+    x(idx) = staging[next++];
+  });
+}
+
+#if defined(_MDSPAN_HAS_MMAP)
+
+// Maps the array in an npy file without copying it.  The layout must match
+// the file's storage order (layout_right for C order, layout_left for
+// Fortran order); a non-const ElementType maps the file read-write.
+template <class ElementType, class Extents, class Layout = layout_right>
+mapped_mdarray<ElementType, Extents, Layout> map_npy(char const* path) {
+  auto h = read_npy_header(path);
+  auto m = npy_mapping<remove_cv_t<ElementType>, Extents, Layout>(h, path);
+  return mapped_mdarray<ElementType, Extents, Layout>(path, m, mapped_file_mode::open_existing, h.data_offset);
+}
+
+#endif // _MDSPAN_HAS_MMAP
+
+} // end namespace experimental
+} // end namespace std
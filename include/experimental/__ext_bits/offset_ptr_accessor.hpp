@@ -0,0 +1,204 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Pointer that stores the distance from its own address to its target, so
+// that it stays valid when the memory holding both is mapped at a different
+// address, e.g., in another process or after remapping a file (like
+// boost::interprocess::offset_ptr).  Copies recompute the distance from their
+// own address.  The distance 1 -- never a valid one, since an offset_ptr
+// cannot point into itself -- represents the null pointer.
+//
+// Only pointers to objects in the same mapping as the offset_ptr survive a
+// remapping; a pointer to anything else is only meaningful in the address
+// space that stored it.
+template <class T>
+class offset_ptr {
+public:
+
+  using element_type = T;
+  using difference_type = ptrdiff_t;
+
+  MDSPAN_INLINE_FUNCTION
+  offset_ptr() noexcept : __offset(1) { }
+
+  MDSPAN_INLINE_FUNCTION
+  offset_ptr(nullptr_t) noexcept : __offset(1) { } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  offset_ptr(T* p) noexcept { __set(p); } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  offset_ptr(offset_ptr const& other) noexcept { __set(other.get()); }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class U,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, U(*)[], T(*)[])
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  offset_ptr(offset_ptr<U> const& other) noexcept { __set(other.get()); } // NOLINT(google-explicit-constructor)
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  offset_ptr& operator=(offset_ptr const& other) noexcept { __set(other.get()); return *this; }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  offset_ptr& operator=(T* p) noexcept { __set(p); return *this; }
+
+  //--------------------------------------------------------------------------------
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  T* get() const noexcept {
+    return __offset == 1 ? nullptr
+      : reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + uintptr_t(__offset));
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION T& operator*() const noexcept { return *get(); }
+  MDSPAN_FORCE_INLINE_FUNCTION T* operator->() const noexcept { return get(); }
+  MDSPAN_FORCE_INLINE_FUNCTION T& operator[](ptrdiff_t i) const noexcept { return get()[i]; }
+
+  MDSPAN_INLINE_FUNCTION explicit operator bool() const noexcept { return __offset != 1; }
+
+  MDSPAN_INLINE_FUNCTION
+  friend offset_ptr operator+(offset_ptr const& p, ptrdiff_t i) noexcept { return offset_ptr(p.get() + i); }
+
+  MDSPAN_INLINE_FUNCTION
+  friend offset_ptr operator-(offset_ptr const& p, ptrdiff_t i) noexcept { return offset_ptr(p.get() - i); }
+
+  MDSPAN_INLINE_FUNCTION
+  friend ptrdiff_t operator-(offset_ptr const& lhs, offset_ptr const& rhs) noexcept { return lhs.get() - rhs.get(); }
+
+  MDSPAN_INLINE_FUNCTION
+  friend bool operator==(offset_ptr const& lhs, offset_ptr const& rhs) noexcept { return lhs.get() == rhs.get(); }
+
+  MDSPAN_INLINE_FUNCTION
+  friend bool operator!=(offset_ptr const& lhs, offset_ptr const& rhs) noexcept { return lhs.get() != rhs.get(); }
+
+  MDSPAN_INLINE_FUNCTION
+  friend bool operator==(offset_ptr const& lhs, T const* rhs) noexcept { return lhs.get() == rhs; }
+
+  MDSPAN_INLINE_FUNCTION
+  friend bool operator!=(offset_ptr const& lhs, T const* rhs) noexcept { return lhs.get() != rhs; }
+
+private:
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  void __set(T* p) noexcept {
+    __offset = p == nullptr ? 1
+      : ptrdiff_t(reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(this));
+  }
+
+  ptrdiff_t __offset;
+
+};
+
+//==============================================================================
+
+// Accessor whose pointer is an offset_ptr, so that an mdspan (or any
+// structure holding one) can be stored inside a memory-mapped file or a
+// shared memory segment together with its elements and used from every
+// process that maps it, without fixing up pointers.  Element access costs an
+// addition over default_accessor, which the compiler hoists out of loops
+// over a local mdspan.
+//
+// `offset()` and `access()` take the pointer by reference: a copy of an
+// offset_ptr has to rebase it to the copy's address.
+template <class ElementType>
+class offset_ptr_accessor {
+public:
+
+  using offset_policy = offset_ptr_accessor;
+  using element_type = ElementType;
+  using pointer = offset_ptr<ElementType>;
+  using reference = ElementType&;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr offset_ptr_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr offset_ptr_accessor(offset_ptr_accessor<OtherElementType>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  // Views over plain pointers convert, with the pointer stored as an offset
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherElementType,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherElementType(*)[], ElementType(*)[])
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr offset_ptr_accessor(default_accessor<OtherElementType>) noexcept {} // NOLINT(google-explicit-constructor)
+
+  MDSPAN_INLINE_FUNCTION
+  pointer offset(pointer const& p, size_t i) const noexcept {
+    return pointer(p.get() + i);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference access(pointer const& p, size_t i) const noexcept {
+    return p.get()[i];
+  }
+
+};
+
+} // end namespace experimental
+} // end namespace std
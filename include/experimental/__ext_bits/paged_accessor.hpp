@@ -0,0 +1,486 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef _MDSPAN_HAS_PREAD
+#define _MDSPAN_HAS_PREAD 1
+#endif
+#endif
+
+// Keeps a cold path out of the caller's loop, so that it does not cost the
+// hot path registers
+#ifndef _MDSPAN_NOINLINE
+#  if defined(__GNUC__) || defined(__clang__)
+#    define _MDSPAN_NOINLINE __attribute__((noinline))
+#  elif defined(_MSC_VER)
+#    define _MDSPAN_NOINLINE __declspec(noinline)
+#  else
+#    define _MDSPAN_NOINLINE
+#  endif
+#endif
+
+namespace std {
+namespace experimental {
+
+#if defined(_MDSPAN_HAS_PREAD)
+
+//==============================================================================
+
+// Counters of a tile_cache since construction or the last reset_stats()
+struct tile_cache_stats {
+  // pins of a resident tile (including ones that waited for a load in flight)
+  size_t hits = 0;
+  // pins that had to load the tile themselves
+  size_t misses = 0;
+  // hits on a tile loaded by the prefetcher that had not been pinned before
+  size_t prefetch_hits = 0;
+  // pins that found their tile still being loaded and waited for it
+  size_t waits = 0;
+  // tiles loaded by the prefetcher
+  size_t prefetches = 0;
+  // resident tiles dropped to make room for another one
+  size_t evictions = 0;
+
+  double hit_rate() const noexcept {
+    return hits + misses == 0 ? 0.0 : double(hits) / double(hits + misses);
+  }
+};
+
+// Cache of fixed-size tiles of a file, for arrays that do not fit in memory.
+//
+// Tile t is the `tile_size() * sizeof(T)` bytes at
+// `file_offset + t * tile_size() * sizeof(T)`; the file holds `num_tiles()`
+// of them (a partial last tile is not addressable).  At most `capacity()`
+// tiles are resident at a time; `pin(t)` returns the elements of tile t,
+// reading it with pread if it is not resident, and keeps it resident until
+// the matching `unpin(t)`.  When a tile has to be loaded, the least recently
+// pinned tile that is not pinned is evicted; if every tile is pinned, pin()
+// throws std::runtime_error.
+//
+// `prefetch(t)` queues tile t for loading by a background thread and returns
+// immediately, so that reads overlap computation on the previous tiles.
+// Prefetch requests are dropped when the queue is full or no tile can be
+// evicted, and failed prefetches are silently discarded (the following pin()
+// reports the error).  Failures to open or read the file throw
+// std::system_error.  All member functions are thread safe; the cache is
+// neither copyable nor movable.
+template <class T>
+class tile_cache {
+public:
+
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, T),
+    "std::experimental::tile_cache requires a trivially copyable element type.");
+
+  using value_type = T;
+  using size_type = size_t;
+
+  tile_cache(
+    char const* path, size_type tile_size, size_type capacity,
+    size_type file_offset = 0
+  ) : __path(path), __tile_size(tile_size), __capacity(capacity),
+      __file_offset(file_offset), __slots(capacity)
+  {
+    if(tile_size == 0 || capacity == 0) {
+      throw std::invalid_argument("tile cache: tile size and capacity must be positive");
+    }
+    __fd = ::open(path, O_RDONLY);
+    if(__fd < 0) __throw_errno("cannot open", errno);
+    struct stat st;
+    if(::fstat(__fd, &st) != 0) {
+      int err = errno;
+      ::close(__fd);
+      __throw_errno("cannot stat", err);
+    }
+    size_type file_bytes = size_type(st.st_size);
+    __num_tiles = file_bytes <= file_offset ? 0 : (file_bytes - file_offset) / tile_bytes();
+    __storage.reset(new T[capacity * tile_size]);
+    for(size_type s = 0; s < capacity; ++s) {
+      __slots[s].lru = __lru.insert(__lru.end(), s);
+    }
+    __prefetcher = std::thread([this] { __prefetch_loop(); });
+  }
+
+  tile_cache(tile_cache const&) = delete;
+  tile_cache& operator=(tile_cache const&) = delete;
+
+  ~tile_cache() {
+    {
+      std::lock_guard<std::mutex> lock(__mutex);
+      __stop = true;
+    }
+    __work.notify_all();
+    __prefetcher.join();
+    ::close(__fd);
+  }
+
+  //--------------------------------------------------------------------------------
+
+  size_type tile_size() const noexcept { return __tile_size; }
+  size_type tile_bytes() const noexcept { return __tile_size * sizeof(T); }
+  size_type capacity() const noexcept { return __capacity; }
+  size_type num_tiles() const noexcept { return __num_tiles; }
+
+  tile_cache_stats stats() const {
+    std::lock_guard<std::mutex> lock(__mutex);
+    return __stats;
+  }
+
+  void reset_stats() {
+    std::lock_guard<std::mutex> lock(__mutex);
+    __stats = tile_cache_stats();
+  }
+
+  //--------------------------------------------------------------------------------
+
+  // Precondition: tile < num_tiles()
+  T const* pin(size_type tile) {
+    std::unique_lock<std::mutex> lock(__mutex);
+    bool waited = false;
+    for(;;) {
+      auto found = __resident.find(tile);
+      if(found == __resident.end()) break;
+      slot& s = __slots[found->second];
+      if(s.loading) {
+        if(!waited) ++__stats.waits;
+        waited = true;
+        __loaded.wait(lock);
+        continue;
+      }
+      ++__stats.hits;
+      if(s.prefetched) {
+        ++__stats.prefetch_hits;
+        s.prefetched = false;
+      }
+      ++s.pins;
+      __touch(found->second);
+      return __data(found->second);
+    }
+    size_type victim = __claim(tile);
+    if(victim == __capacity) {
+      throw std::runtime_error("tile cache: " + __path + ": every tile is pinned");
+    }
+    ++__stats.misses;
+    __slots[victim].pins = 1;
+    int err = __load(victim, tile, lock);
+    if(err != 0) __throw_errno("cannot read", err);
+    return __data(victim);
+  }
+
+  void unpin(size_type tile) {
+    std::lock_guard<std::mutex> lock(__mutex);
+    auto found = __resident.find(tile);
+    if(found != __resident.end() && __slots[found->second].pins > 0) {
+      --__slots[found->second].pins;
+    }
+  }
+
+  // Loads `tile` in the background unless it is resident, being loaded, or
+  // out of range
+  void prefetch(size_type tile) {
+    {
+      std::lock_guard<std::mutex> lock(__mutex);
+      if(tile >= __num_tiles || __resident.count(tile) != 0) return;
+      if(__queue.size() >= __capacity / 2 + 1) return;
+      __queue.push_back(tile);
+    }
+    __work.notify_one();
+  }
+
+private:
+
+  struct slot {
+    size_type tile = size_type(-1);
+    size_type pins = 0;
+    bool loading = false;
+    bool prefetched = false;
+    std::list<size_type>::iterator lru;
+  };
+
+  T* __data(size_type s) const noexcept { return __storage.get() + s * __tile_size; }
+
+  // Moves slot s to the front of the recency list
+  void __touch(size_type s) {
+    __lru.splice(__lru.begin(), __lru, __slots[s].lru);
+  }
+
+  // Assigns the least recently used unpinned slot to `tile`, or returns
+  // __capacity if there is none.  Caller holds the lock.
+  size_type __claim(size_type tile) {
+    for(auto it = __lru.rbegin(); it != __lru.rend(); ++it) {
+      slot& s = __slots[*it];
+      if(s.pins != 0 || s.loading) continue;
+      size_type victim = *it;
+      if(s.tile != size_type(-1)) {
+        __resident.erase(s.tile);
+        ++__stats.evictions;
+      }
+      s.tile = tile;
+      s.prefetched = false;
+      __resident[tile] = victim;
+      __touch(victim);
+      return victim;
+    }
+    return __capacity;
+  }
+
+  // Reads `tile` into slot s without holding the lock and returns 0 or the
+  // errno of the failed read, in which case the slot is released.  Caller
+  // holds `lock`.
+  int __load(size_type s, size_type tile, std::unique_lock<std::mutex>& lock) {
+    __slots[s].loading = true;
+    lock.unlock();
+    int err = __read_tile(tile, __data(s));
+    lock.lock();
+    slot& sl = __slots[s];
+    sl.loading = false;
+    if(err != 0) {
+      __resident.erase(tile);
+      sl.tile = size_type(-1);
+      sl.pins = 0;
+      sl.prefetched = false;
+      // failed slots are reused first
+      __lru.splice(__lru.end(), __lru, sl.lru);
+    }
+    __loaded.notify_all();
+    return err;
+  }
+
+  int __read_tile(size_type tile, T* out) const noexcept {
+    char* p = reinterpret_cast<char*>(out);
+    size_type n = tile_bytes();
+    off_t offset = off_t(__file_offset + tile * n);
+    while(n > 0) {
+      ssize_t r = ::pread(__fd, p, n, offset);
+      if(r < 0 && errno == EINTR) continue;
+      if(r < 0) return errno;
+      if(r == 0) return EIO;
+      p += r;
+      n -= size_type(r);
+      offset += r;
+    }
+    return 0;
+  }
+
+  void __prefetch_loop() {
+    std::unique_lock<std::mutex> lock(__mutex);
+    for(;;) {
+      __work.wait(lock, [this] { return __stop || !__queue.empty(); });
+      if(__stop) return;
+      size_type tile = __queue.front();
+      __queue.pop_front();
+      if(__resident.count(tile) != 0) continue;
+      size_type victim = __claim(tile);
+      if(victim == __capacity) continue;
+      if(__load(victim, tile, lock) == 0) {
+        __slots[victim].prefetched = true;
+        ++__stats.prefetches;
+      }
+    }
+  }
+
+  [[noreturn]] void __throw_errno(char const* what, int err) const {
+    throw std::system_error(err, std::generic_category(), std::string("tile cache: ") + what + " " + __path);
+  }
+
+  std::string __path;
+  size_type __tile_size = 0;
+  size_type __capacity = 0;
+  size_type __file_offset = 0;
+  size_type __num_tiles = 0;
+  int __fd = -1;
+
+  std::unique_ptr<T[]> __storage;
+  std::vector<slot> __slots;
+  // slots, most recently pinned first
+  std::list<size_type> __lru;
+  std::unordered_map<size_type, size_type> __resident;
+  tile_cache_stats __stats;
+
+  mutable std::mutex __mutex;
+  std::condition_variable __loaded;
+  std::condition_variable __work;
+  std::deque<size_type> __queue;
+  bool __stop = false;
+  std::thread __prefetcher;
+};
+
+//==============================================================================
+
+// Read-only accessor for arrays paged in from a file through a tile_cache.
+//
+// The data handle is an element offset into the file's tiles (a
+// `size_t`, 0 for the start of the file), so it pairs with a layout whose
+// offsets are tile-aligned such as layout_tiled with the cache's tile size:
+// element `offset` lives in tile `offset / tile_size()`.  Accessing an
+// element pins its tile; the accessor keeps the last tile pinned, so that
+// accesses within the same tile cost one compare, and unpins it on the next
+// tile change or on destruction.  Elements are returned by value.
+//
+// On each tile change the accessor looks at the step from the previous tile;
+// while consecutive steps agree, it keeps the cache prefetching the next
+// `prefetch_depth` tiles along that step, i.e., ahead of the traversal.
+//
+// Since it memoizes the pinned tile, an accessor must not be shared between
+// threads: give each thread its own copy (copies start with no tile pinned).
+template <class ElementType>
+class paged_accessor {
+public:
+  using offset_policy = paged_accessor;
+  using element_type = ElementType const;
+  using reference = ElementType;
+  using pointer = size_t;
+  using cache_type = tile_cache<ElementType>;
+
+  paged_accessor() noexcept = default;
+
+  explicit paged_accessor(cache_type& cache, size_t prefetch_depth = 2) noexcept
+    : __cache(&cache), __prefetch_depth(prefetch_depth)
+  { }
+
+  paged_accessor(paged_accessor const& other) noexcept
+    : __cache(other.__cache), __prefetch_depth(other.__prefetch_depth)
+  { }
+
+  paged_accessor& operator=(paged_accessor const& other) noexcept {
+    if(this != &other) {
+      __release();
+      __cache = other.__cache;
+      __prefetch_depth = other.__prefetch_depth;
+    }
+    return *this;
+  }
+
+  ~paged_accessor() { __release(); }
+
+  cache_type* cache() const noexcept { return __cache; }
+  size_t prefetch_depth() const noexcept { return __prefetch_depth; }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference access(pointer p, size_t i) const {
+    size_t d = p + i - __first;
+    if(d >= __tile_size) d = __switch_tile(p + i);
+    return __data[d];
+  }
+
+  MDSPAN_INLINE_FUNCTION
+  pointer offset(pointer p, size_t i) const noexcept {
+    return p + i;
+  }
+
+private:
+
+  static constexpr size_t __none = size_t(-1);
+
+  // Pins the tile holding element `off` and returns its position in the tile
+  _MDSPAN_NOINLINE size_t __switch_tile(size_t off) const {
+    size_t tile_size = __cache->tile_size();
+    size_t tile = off / tile_size;
+    size_t previous = __tile;
+    __release();
+    __data = __cache->pin(tile);
+    __tile = tile;
+    __first = tile * tile_size;
+    __tile_size = tile_size;
+    if(previous != __none && __prefetch_depth > 0) {
+      ptrdiff_t step = ptrdiff_t(tile - previous);
+      // a newly confirmed step requests the whole window ahead; after that,
+      // each step only needs the tile entering the window
+      if(step == __step) {
+        size_t first = __run_confirmed ? __prefetch_depth : 1;
+        for(size_t k = first; k <= __prefetch_depth; ++k) {
+          ptrdiff_t next = ptrdiff_t(tile) + ptrdiff_t(k) * step;
+          if(next < 0) break;
+          __cache->prefetch(size_t(next));
+        }
+      }
+      __run_confirmed = step == __step;
+      __step = step;
+    }
+    return off - __first;
+  }
+
+  void __release() const noexcept {
+    if(__tile != __none) __cache->unpin(__tile);
+    __tile = __none;
+    __first = 0;
+    __tile_size = 0;
+  }
+
+  cache_type* __cache = nullptr;
+  size_t __prefetch_depth = 0;
+  // the pinned tile: elements [__first, __first + __tile_size) at __data
+  mutable size_t __tile = __none;
+  mutable size_t __first = 0;
+  mutable size_t __tile_size = 0;
+  mutable ElementType const* __data = nullptr;
+  // step between the last two tiles, and whether it repeated the one before
+  mutable ptrdiff_t __step = 0;
+  mutable bool __run_confirmed = false;
+};
+
+#endif // defined(_MDSPAN_HAS_PREAD)
+
+} // end namespace experimental
+} // end namespace std
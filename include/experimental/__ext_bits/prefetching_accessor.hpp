@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Hints that the element `lookahead` elements past `p` will be accessed soon.
+// The address is formed without pointer arithmetic, since it may lie past the
+// end of the array; prefetches never fault.
+template <class T>
+MDSPAN_INLINE_FUNCTION
+void __prefetch(T* p, ptrdiff_t lookahead) noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDA_ARCH__)
+  auto address = reinterpret_cast<void const*>(
+    reinterpret_cast<uintptr_t>(p) + uintptr_t(lookahead * ptrdiff_t(sizeof(T)))
+  );
+  __builtin_prefetch(address, is_const<T>::value ? 0 : 1, 3);
+#else
+  (void)p; (void)lookahead;
+#endif
+}
+
+// Pointer types that are not plain pointers (e.g., bit_pointer) are not
+// prefetched
+template <class Pointer>
+MDSPAN_INLINE_FUNCTION
+void __prefetch(Pointer const&, ptrdiff_t) noexcept { }
+
+} // end namespace detail
+
+//==============================================================================
+
+// Accessor that issues a software prefetch for the element `Distance` strides
+// ahead of every element it accesses, then defers to `NestedAccessor`.
+//
+// Hardware prefetchers follow unit-stride and short constant-stride streams
+// well, but typically stop at page boundaries, so a traversal along a
+// dimension with a stride of a page or more (e.g., down a column of a large
+// layout_right matrix) misses on every access.  `stride` is the stride, in
+// elements, of the dimension being traversed, usually
+// `x.mapping().stride(dim)`; see prefetched() below.  With a
+// `Distance` of dynamic_extent, the distance is a constructor argument
+// instead, which is what the distance sweep in the benchmarks uses.
+//
+// Accessing an element near the end of the traversal prefetches an address
+// past it, which is harmless but wasted.
+template <class NestedAccessor, size_t Distance = dynamic_extent>
+class prefetching_accessor {
+public:
+
+  using element_type = typename NestedAccessor::element_type;
+  using reference = typename NestedAccessor::reference;
+  using pointer = typename NestedAccessor::pointer;
+  using offset_policy = prefetching_accessor<typename NestedAccessor::offset_policy, Distance>;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr prefetching_accessor() noexcept = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    size_t D = Distance,
+    /* requires */ (D != dynamic_extent)
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr explicit prefetching_accessor(size_t stride, NestedAccessor const& a = NestedAccessor()) noexcept
+    : __lookahead(ptrdiff_t(Distance * stride)), __nested_accessor(a)
+  { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    size_t D = Distance,
+    /* requires */ (D == dynamic_extent)
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr prefetching_accessor(size_t stride, size_t distance, NestedAccessor const& a = NestedAccessor()) noexcept
+    : __lookahead(ptrdiff_t(distance * stride)), __nested_accessor(a)
+  { }
+
+  // Needed for offset_policy, i.e., for submdspan of prefetching views.  The
+  // lookahead is kept in elements, so it is only meaningful if the
+  // traversed dimension keeps its stride.
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherNestedAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherNestedAccessor, NestedAccessor)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr prefetching_accessor(prefetching_accessor<OtherNestedAccessor, Distance> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : __lookahead(other.lookahead()), __nested_accessor(other.nested_accessor())
+  { }
+
+  // Distance to the prefetched element, in elements
+  MDSPAN_INLINE_FUNCTION constexpr ptrdiff_t lookahead() const noexcept { return __lookahead; }
+
+  MDSPAN_INLINE_FUNCTION constexpr NestedAccessor nested_accessor() const noexcept { return __nested_accessor; }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr typename offset_policy::pointer offset(pointer p, size_t i) const noexcept {
+    return __nested_accessor.offset(p, i);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  _MDSPAN_CONSTEXPR_14 reference access(pointer p, size_t i) const noexcept {
+    detail::__prefetch(__nested_accessor.offset(p, i), __lookahead);
+    return __nested_accessor.access(p, i);
+  }
+
+private:
+
+  ptrdiff_t __lookahead = 0;
+  NestedAccessor __nested_accessor = { };
+
+};
+
+//==============================================================================
+
+// A view of `x` that prefetches `Distance` strides of dimension `dim` ahead,
+// for traversals that walk along `dim` in the innermost loop
+template <size_t Distance, class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+mdspan<ElementType, Extents, Layout, prefetching_accessor<Accessor, Distance>>
+prefetched(mdspan<ElementType, Extents, Layout, Accessor> const& x, size_t dim)
+{
+  static_assert(Distance != dynamic_extent,
+    "std::experimental::prefetched with a dynamic distance takes the distance as an argument.");
+  using accessor_type = prefetching_accessor<Accessor, Distance>;
+  return mdspan<ElementType, Extents, Layout, accessor_type>(
+    x.data(), x.mapping(), accessor_type(x.mapping().stride(dim), x.accessor())
+  );
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+mdspan<ElementType, Extents, Layout, prefetching_accessor<Accessor>>
+prefetched(mdspan<ElementType, Extents, Layout, Accessor> const& x, size_t dim, size_t distance)
+{
+  using accessor_type = prefetching_accessor<Accessor>;
+  return mdspan<ElementType, Extents, Layout, accessor_type>(
+    x.data(), x.mapping(), accessor_type(x.mapping().stride(dim), distance, x.accessor())
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,229 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "execution_policy.hpp"
+#include "layout_ragged.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Writes the exclusive prefix sum of `counts` to `offsets`, which must have
+// one more entry than `counts`, and returns the largest count.
+template <class CountType>
+size_t ragged_offsets_from_counts(
+  execution::sequenced_policy,
+  mdspan<CountType, dextents<1>> counts,
+  mdspan<size_t, dextents<1>> offsets
+)
+{
+  size_t running = 0, longest = 0;
+  for(size_t i = 0; i < counts.extent(0); ++i) {
+    size_t count = size_t(counts(i));
+    offsets(i) = running;
+    running += count;
+    longest = std::max(longest, count);
+  }
+  offsets(counts.extent(0)) = running;
+  return longest;
+}
+
+// Parallel version: every thread sums a block of counts, the block sums are
+// scanned, and every thread then writes the offsets of its block, so that the
+// offsets are first touched by the thread that computes them.
+template <class CountType>
+size_t ragged_offsets_from_counts(
+  execution::parallel_policy,
+  mdspan<CountType, dextents<1>> counts,
+  mdspan<size_t, dextents<1>> offsets
+)
+{
+#if defined(_OPENMP)
+  size_t n = counts.extent(0);
+  size_t max_threads = size_t(detail::__parallel_num_threads());
+  std::vector<size_t> block_sums(max_threads + 1, 0);
+  std::vector<size_t> block_longest(max_threads, 0);
+  // the team is capped at max_threads, which it would exceed when called
+  // from a parallel region with nested parallelism enabled
+  #pragma omp parallel num_threads(int(max_threads))
+  {
+    size_t num_threads = size_t(detail::__parallel_num_threads());
+    size_t t = size_t(detail::__parallel_thread_num());
+    size_t first = n * t / num_threads, last = n * (t + 1) / num_threads;
+    size_t sum = 0, longest = 0;
+    for(size_t i = first; i < last; ++i) {
+      sum += size_t(counts(i));
+      longest = std::max(longest, size_t(counts(i)));
+    }
+    block_sums[t + 1] = sum;
+    block_longest[t] = longest;
+    #pragma omp barrier
+    #pragma omp single
+    for(size_t b = 0; b < num_threads; ++b) {
+      block_sums[b + 1] += block_sums[b];
+    }
+    size_t running = block_sums[t];
+    for(size_t i = first; i < last; ++i) {
+      offsets(i) = running;
+      running += size_t(counts(i));
+    }
+    if(t + 1 == num_threads) offsets(n) = running;
+  }
+  return *std::max_element(block_longest.begin(), block_longest.end());
+#else
+  return ragged_offsets_from_counts(execution::seq, counts, offsets);
+#endif
+}
+
+//==============================================================================
+
+// Owning ragged 2D array, stored as one contiguous buffer viewed through
+// layout_ragged.  Construction takes the length of every row, computes the
+// row offsets with ragged_offsets_from_counts, and value-initializes the
+// elements, all with the given execution policy; a parallel construction
+// first-touches every row from the thread that a static schedule over rows
+// would assign it to.  The array is move-only.
+template <class ElementType>
+class ragged_array {
+public:
+
+  using element_type = ElementType;
+  using value_type = ElementType;
+  using size_type = size_t;
+  using layout_type = layout_ragged;
+  using extents_type = dextents<2>;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+
+  using mdspan_type = mdspan<element_type, extents_type, layout_type>;
+  using const_mdspan_type = mdspan<element_type const, extents_type, layout_type>;
+  using row_type = mdspan<element_type, dextents<1>>;
+  using const_row_type = mdspan<element_type const, dextents<1>>;
+  using offsets_type = mdspan<size_type const, dextents<1>>;
+
+  ragged_array() = default;
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class ExecutionPolicy, class CountType,
+    /* requires */ (
+      execution::is_execution_policy<ExecutionPolicy>::value
+    )
+  )
+  ragged_array(ExecutionPolicy policy, mdspan<CountType, dextents<1>> counts)
+    : __num_rows(counts.extent(0)),
+      __offsets(new size_type[counts.extent(0) + 1])
+  {
+    __longest = ragged_offsets_from_counts(policy, counts,
+      mdspan<size_type, dextents<1>>(__offsets.get(), __num_rows + 1));
+    __data.reset(new element_type[size()]);
+    __value_initialize(policy);
+  }
+
+  template <class CountType>
+  explicit ragged_array(mdspan<CountType, dextents<1>> counts)
+    : ragged_array(execution::seq, counts)
+  { }
+
+  //--------------------------------------------------------------------------------
+
+  size_type num_rows() const noexcept { return __num_rows; }
+  size_type size() const noexcept { return __offsets ? __offsets[__num_rows] : 0; }
+  size_type longest_row() const noexcept { return __longest; }
+  size_type row_length(size_type i) const noexcept { return __offsets[i + 1] - __offsets[i]; }
+
+  element_type* data() noexcept { return __data.get(); }
+  element_type const* data() const noexcept { return __data.get(); }
+
+  offsets_type offsets() const noexcept { return offsets_type(__offsets.get(), __offsets ? __num_rows + 1 : 0); }
+
+  mapping_type mapping() const noexcept {
+    return mapping_type(extents_type(__num_rows, __longest), __offsets.get());
+  }
+
+  mdspan_type view() noexcept { return mdspan_type(__data.get(), mapping()); }
+  const_mdspan_type view() const noexcept { return const_mdspan_type(__data.get(), mapping()); }
+
+  row_type row(size_type i) noexcept { return row_type(__data.get() + __offsets[i], row_length(i)); }
+  const_row_type row(size_type i) const noexcept { return const_row_type(__data.get() + __offsets[i], row_length(i)); }
+
+private:
+
+  void __value_initialize(execution::sequenced_policy) {
+    std::fill(__data.get(), __data.get() + size(), element_type());
+  }
+
+  void __value_initialize(execution::parallel_policy) {
+#if defined(_OPENMP)
+    #pragma omp parallel
+    {
+      size_type num_threads = size_type(detail::__parallel_num_threads());
+      size_type t = size_type(detail::__parallel_thread_num());
+      size_type first = __offsets[__num_rows * t / num_threads];
+      size_type last = __offsets[__num_rows * (t + 1) / num_threads];
+      std::fill(__data.get() + first, __data.get() + last, element_type());
+    }
+#else
+    __value_initialize(execution::seq);
+#endif
+  }
+
+  size_type __num_rows = 0;
+  size_type __longest = 0;
+  std::unique_ptr<size_type[]> __offsets;
+  std::unique_ptr<element_type[]> __data;
+
+};
+
+} // end namespace experimental
+} // end namespace std
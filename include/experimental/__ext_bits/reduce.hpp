@@ -0,0 +1,521 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "execution_policy.hpp"
+#include "mask_algorithms.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/extents.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Value and multidimensional index of an element, as returned by minloc and
+// maxloc
+template <class T, size_t Rank>
+struct value_location {
+  T value;
+  array<size_t, Rank> index;
+};
+
+namespace detail {
+
+_MDSPAN_INLINE_VARIABLE constexpr size_t __cache_line_size = 64;
+
+// Independent accumulators in the innermost loop of a reduction, which
+// breaks the dependency chain through the accumulator and lets the compiler
+// keep them in one or two vector registers
+_MDSPAN_INLINE_VARIABLE constexpr size_t __reduce_lanes = 8;
+
+// The partial result of one thread, padded so that no two threads' partials
+// share a cache line
+template <class T>
+struct __padded_partial {
+  explicit __padded_partial(T const& v) : value(v) { }
+  T value;
+  bool valid = false;
+  char __pad[__cache_line_size];
+};
+
+//------------------------------------------------------------------------------
+
+// The loop nest that visits a strided mapping in storage order: dimensions
+// sorted by decreasing stride, so that the innermost loop has the smallest,
+// and dimensions that continue each other (the outer stride is the inner
+// extent times the inner stride) merged into one loop.  A contiguous
+// layout_right or layout_left mapping becomes a single loop over all
+// elements.  Dimensions of extent 1 get no loop.
+template <size_t Rank>
+struct __strided_loops {
+  static constexpr size_t __max_rank = Rank == 0 ? 1 : Rank;
+  size_t rank = 1;
+  size_t base = 0;
+  // the loops, outermost first
+  array<size_t, __max_rank> extents = { };
+  array<size_t, __max_rank> strides = { };
+  // for every dimension of the mapping: its extent, the loop it belongs to,
+  // and the product of the extents merged into that loop inside it
+  array<size_t, __max_rank> dim_extents = { };
+  array<size_t, __max_rank> loop_of = { };
+  array<size_t, __max_rank> divisor = { };
+
+  // Multidimensional index of the element at the given loop positions
+  array<size_t, Rank> index(array<size_t, __max_rank> const& pos) const noexcept {
+    array<size_t, Rank> idx = { };
+    for(size_t d = 0; d < Rank; ++d) {
+      idx[d] = pos[loop_of[d]] / divisor[d] % dim_extents[d];
+    }
+    return idx;
+  }
+};
+
+template <class Mapping, size_t... Idxs>
+size_t __offset_of_origin(Mapping const& m, index_sequence<Idxs...>) {
+  return size_t(m(((void)Idxs, size_t(0))...));
+}
+
+// Whether Mapping has stride(r); only those mappings can report is_strided()
+template <class Mapping>
+struct __has_stride {
+  template <class M> static auto __test(M const* m) -> decltype(m->stride(size_t(0)), true_type());
+  template <class M> static false_type __test(...);
+  static constexpr bool value = decltype(__test<Mapping>(nullptr))::value;
+};
+
+template <class Mapping>
+bool __is_strided(Mapping const& m, true_type /* has stride */) { return m.is_strided(); }
+
+template <class Mapping>
+bool __is_strided(Mapping const&, false_type /* has stride */) { return false; }
+
+// Precondition: m.is_strided() and no extent is 0
+template <class Mapping>
+__strided_loops<Mapping::extents_type::rank()> __make_strided_loops(Mapping const& m, true_type /* has stride */) {
+  constexpr size_t Rank = Mapping::extents_type::rank();
+  __strided_loops<Rank> l;
+  l.base = __offset_of_origin(m, make_index_sequence<Rank>());
+  l.extents[0] = 1;
+  l.strides[0] = 1;
+
+  // dimensions by decreasing stride; the sort is stable, so ties keep the
+  // layout_right order
+  array<size_t, __strided_loops<Rank>::__max_rank> dims = { };
+  size_t num_dims = 0;
+  for(size_t d = 0; d < Rank; ++d) {
+    l.dim_extents[d] = m.extents().extent(d);
+    l.divisor[d] = 1;
+    if(l.dim_extents[d] == 1) continue;
+    size_t j = num_dims++;
+    for(; j > 0 && m.stride(dims[j - 1]) < m.stride(d); --j) dims[j] = dims[j - 1];
+    dims[j] = d;
+  }
+  if(num_dims == 0) return l;
+
+  // merge from the innermost dimension outwards, numbering the loops from
+  // the inside, then flip the numbering
+  array<size_t, __strided_loops<Rank>::__max_rank> loop_extents = { }, loop_strides = { };
+  size_t num_loops = 0;
+  size_t d = dims[num_dims - 1];
+  loop_extents[0] = l.dim_extents[d];
+  loop_strides[0] = size_t(m.stride(d));
+  for(size_t i = num_dims - 1; i-- > 0; ) {
+    d = dims[i];
+    if(size_t(m.stride(d)) == loop_extents[num_loops] * loop_strides[num_loops]) {
+      l.divisor[d] = loop_extents[num_loops];
+      loop_extents[num_loops] *= l.dim_extents[d];
+    }
+    else {
+      ++num_loops;
+      loop_extents[num_loops] = l.dim_extents[d];
+      loop_strides[num_loops] = size_t(m.stride(d));
+    }
+    l.loop_of[d] = num_loops;
+  }
+  l.rank = num_loops + 1;
+  for(size_t k = 0; k < l.rank; ++k) {
+    l.extents[k] = loop_extents[num_loops - k];
+    l.strides[k] = loop_strides[num_loops - k];
+  }
+  for(size_t i = 0; i < num_dims; ++i) l.loop_of[dims[i]] = num_loops - l.loop_of[dims[i]];
+  return l;
+}
+
+template <class Mapping>
+__strided_loops<Mapping::extents_type::rank()> __make_strided_loops(Mapping const&, false_type /* has stride */) {
+  return { };
+}
+
+// One loop over the whole codomain of a unique, contiguous mapping that has
+// no strides
+template <class Mapping>
+__strided_loops<Mapping::extents_type::rank()> __make_flat_loop(Mapping const& m) {
+  __strided_loops<Mapping::extents_type::rank()> l;
+  l.extents[0] = size_t(m.required_span_size());
+  l.strides[0] = 1;
+  return l;
+}
+
+// Calls f(offset, n, stride, pos) for every run of the innermost loop of `l`
+// at the positions [first, last) of the outermost loop, where `pos` holds the
+// positions of all loops at the start of the run
+template <size_t Rank, class F>
+void __for_each_run(__strided_loops<Rank> const& l, size_t first, size_t last, F&& f) {
+  array<size_t, __strided_loops<Rank>::__max_rank> pos = { };
+  size_t inner = l.rank - 1;
+  if(inner == 0) {
+    if(first < last) {
+      pos[0] = first;
+      f(l.base + first * l.strides[0], last - first, l.strides[0], const_cast<decltype(pos) const&>(pos));
+    }
+    return;
+  }
+  for(pos[0] = first; pos[0] < last; ++pos[0]) {
+    size_t offset = l.base + pos[0] * l.strides[0];
+    for(;;) {
+      f(offset, l.extents[inner], l.strides[inner], const_cast<decltype(pos) const&>(pos));
+      size_t r = inner;
+      while(--r > 0) {
+        offset += l.strides[r];
+        if(++pos[r] < l.extents[r]) break;
+        offset -= pos[r] * l.strides[r];
+        pos[r] = 0;
+      }
+      if(r == 0) break;
+    }
+  }
+}
+
+// Calls f(index) for every multidimensional index of `e` whose first
+// component is in [first, last), in layout_right order.  The single index
+// of rank 0 extents counts as having first component 0.
+template <class Extents, class F>
+enable_if_t<Extents::rank() != 0>
+__for_each_index_in(Extents const& e, size_t first, size_t last, F& f) {
+  array<size_t, Extents::rank()> idx = { };
+  for(idx[0] = first; idx[0] < last; ++idx[0]) {
+    __for_each_index<1>(e, idx, f);
+  }
+}
+
+template <class Extents, class F>
+enable_if_t<Extents::rank() == 0>
+__for_each_index_in(Extents const&, size_t first, size_t last, F& f) {
+  if(first < last) f(array<size_t, 0>{ });
+}
+
+template <class Extents>
+size_t __outer_extent(Extents const&, true_type /* rank 0 */) noexcept { return 1; }
+
+template <class Extents>
+size_t __outer_extent(Extents const& e, false_type /* rank 0 */) noexcept { return e.extent(0); }
+
+// Splits the index space of m over the threads of the policy and calls
+// run(thread, offset, n, stride, pos, loops) for every run of a strided or
+// flattened loop nest, or element(thread, index) for every element of other
+// mappings
+template <class ExecutionPolicy, class Mapping, class RunF, class ElementF>
+void __for_each_partition(ExecutionPolicy policy, Mapping const& m, bool with_flat, RunF&& run, ElementF&& element) {
+  using extents_type = typename Mapping::extents_type;
+  using has_stride = integral_constant<bool, __has_stride<Mapping>::value>;
+  bool strided = __is_strided(m, has_stride());
+  if(strided || (with_flat && m.is_unique() && m.is_contiguous())) {
+    auto loops = strided ? __make_strided_loops(m, has_stride()) : __make_flat_loop(m);
+    __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+      size_t n0 = loops.extents[0];
+      __for_each_run(loops, n0 * t / num_threads, n0 * (t + 1) / num_threads,
+        [&](size_t offset, size_t n, size_t stride, array<size_t, __strided_loops<extents_type::rank()>::__max_rank> const& pos) {
+          run(t, offset, n, stride, pos, loops);
+        });
+    });
+  }
+  else {
+    __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+      auto f = [&](array<size_t, extents_type::rank()> const& idx) { element(t, idx); return true; };
+      size_t n0 = __outer_extent(m.extents(), integral_constant<bool, extents_type::rank() == 0>());
+      __for_each_index_in(m.extents(), n0 * t / num_threads, n0 * (t + 1) / num_threads, f);
+    });
+  }
+}
+
+//------------------------------------------------------------------------------
+
+template <class T, bool UnitStride, class Accessor, class ReduceOp, class TransformOp, size_t... Lanes>
+T __transform_reduce_run(
+  Accessor const& a, typename Accessor::pointer const& p, size_t offset, size_t n, size_t stride,
+  ReduceOp& op, TransformOp& f, index_sequence<Lanes...>
+) {
+  constexpr size_t lanes = sizeof...(Lanes);
+  size_t s = UnitStride ? 1 : stride;
+  if(n < 2 * lanes) {
+    T acc = T(f(a.access(p, offset)));
+    for(size_t i = 1; i < n; ++i) acc = op(acc, f(a.access(p, offset + i * s)));
+    return acc;
+  }
+  T part[lanes] = { T(f(a.access(p, offset + Lanes * s)))... };
+  size_t i = lanes;
+  for(; i + lanes <= n; i += lanes) {
+    for(size_t l = 0; l < lanes; ++l) {
+      part[l] = op(part[l], f(a.access(p, offset + (i + l) * s)));
+    }
+  }
+  for(; i < n; ++i) part[0] = op(part[0], f(a.access(p, offset + i * s)));
+  for(size_t w = lanes / 2; w > 0; w /= 2) {
+    for(size_t l = 0; l < w; ++l) part[l] = op(part[l], part[l + w]);
+  }
+  return part[0];
+}
+
+template <class T, class ReduceOp>
+void __accumulate(__padded_partial<T>& part, T const& x, ReduceOp& op) {
+  part.value = part.valid ? T(op(part.value, x)) : x;
+  part.valid = true;
+}
+
+template <class ExecutionPolicy, class T, class ET, class E, class L, class A, class ReduceOp, class TransformOp>
+T __transform_reduce(ExecutionPolicy policy, mdspan<ET, E, L, A> const& m, T init, ReduceOp& op, TransformOp& f) {
+  if(m.size() == 0) return init;
+  std::vector<__padded_partial<T>> partials(__max_threads(policy), __padded_partial<T>(init));
+  auto const a = m.accessor();
+  auto const p = m.data();
+  __for_each_partition(policy, m.mapping(), true,
+    [&](size_t t, size_t offset, size_t n, size_t stride, auto const&, auto const&) {
+      T x = stride == 1
+        ? __transform_reduce_run<T, true>(a, p, offset, n, stride, op, f, make_index_sequence<__reduce_lanes>())
+        : __transform_reduce_run<T, false>(a, p, offset, n, stride, op, f, make_index_sequence<__reduce_lanes>());
+      __accumulate(partials[t], x, op);
+    },
+    [&](size_t t, array<size_t, E::rank()> const& idx) {
+      __accumulate(partials[t], T(f(m(idx))), op);
+    });
+  for(auto const& part : partials) {
+    if(part.valid) init = op(init, part.value);
+  }
+  return init;
+}
+
+//------------------------------------------------------------------------------
+
+// Whether (v, idx) goes before (best, best_idx): a better value, or an equal
+// one at a lexicographically smaller index
+template <class T, size_t Rank, class Compare>
+bool __better_location(T const& v, array<size_t, Rank> const& idx, value_location<T, Rank> const& best, Compare& comp) {
+  if(comp(v, best.value)) return true;
+  return !comp(best.value, v) && idx < best.index;
+}
+
+template <class ExecutionPolicy, class ET, class E, class L, class A, class Compare>
+value_location<remove_cv_t<ET>, E::rank()>
+__locate(ExecutionPolicy policy, mdspan<ET, E, L, A> const& m, Compare comp) {
+  using value_type = remove_cv_t<ET>;
+  using location_type = value_location<value_type, E::rank()>;
+  if(m.size() == 0) return location_type{ value_type(), { } };
+  std::vector<__padded_partial<location_type>> partials(__max_threads(policy),
+    __padded_partial<location_type>(location_type{ value_type(), { } }));
+  auto const a = m.accessor();
+  auto const p = m.data();
+  auto offer = [&](size_t t, value_type const& v, array<size_t, E::rank()> const& idx) {
+    auto& part = partials[t];
+    if(!part.valid || __better_location(v, idx, part.value, comp)) {
+      part.value = location_type{ v, idx };
+      part.valid = true;
+    }
+  };
+  // The mapping must be strided (no flat loop), so that loop positions can
+  // be turned back into indices
+  __for_each_partition(policy, m.mapping(), false,
+    [&](size_t t, size_t offset, size_t n, size_t stride, auto const& pos, auto const& loops) {
+      // best of the run by value alone, then ties resolved by index
+      value_type best = a.access(p, offset);
+      size_t best_k = 0;
+      bool tie = false;
+      for(size_t k = 1; k < n; ++k) {
+        value_type v = a.access(p, offset + k * stride);
+        if(comp(v, best)) {
+          best = v;
+          best_k = k;
+          tie = false;
+        }
+        else if(!comp(best, v)) {
+          tie = true;
+        }
+      }
+      auto run_pos = pos;
+      if(!tie) {
+        run_pos[loops.rank - 1] += best_k;
+        offer(t, best, loops.index(run_pos));
+        return;
+      }
+      for(size_t k = best_k; k < n; ++k) {
+        value_type v = a.access(p, offset + k * stride);
+        if(!comp(best, v) && !comp(v, best)) {
+          run_pos[loops.rank - 1] = pos[loops.rank - 1] + k;
+          offer(t, v, loops.index(run_pos));
+        }
+      }
+    },
+    [&](size_t t, array<size_t, E::rank()> const& idx) {
+      offer(t, value_type(m(idx)), idx);
+    });
+  location_type result = { value_type(), { } };
+  bool valid = false;
+  for(auto const& part : partials) {
+    if(part.valid && (!valid || __better_location(part.value.value, part.value.index, result, comp))) {
+      result = part.value;
+      valid = true;
+    }
+  }
+  return result;
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Reductions over all elements of an mdspan, in an unspecified order and
+// grouping: `reduce_op` must be associative and commutative, as for
+// std::reduce.
+//
+// The traversal follows the mapping rather than the indices: strided
+// mappings are walked by decreasing stride, with dimensions that continue
+// each other merged, so that a contiguous layout_right or layout_left array
+// (and any other unique, contiguous mapping) is one flat loop over memory.
+// The innermost loop keeps several independent accumulators, which lets it
+// vectorize.  With execution::par the outermost loop is split over the
+// OpenMP threads, each reducing into its own cache line; the operations must
+// not throw then.  Other mappings are visited index by index.
+template <class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor, class T, class ReduceOp, class TransformOp>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value, T>
+transform_reduce(
+  ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m,
+  T init, ReduceOp reduce_op, TransformOp transform_op
+) {
+  return detail::__transform_reduce(policy, m, std::move(init), reduce_op, transform_op);
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor, class T, class ReduceOp, class TransformOp>
+T transform_reduce(
+  mdspan<ElementType, Extents, Layout, Accessor> const& m,
+  T init, ReduceOp reduce_op, TransformOp transform_op
+) {
+  return detail::__transform_reduce(execution::seq, m, std::move(init), reduce_op, transform_op);
+}
+
+template <class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor, class T, class ReduceOp>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value, T>
+reduce(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m, T init, ReduceOp reduce_op) {
+  auto identity = [](typename Accessor::reference x) -> T { return T(x); };
+  return detail::__transform_reduce(policy, m, std::move(init), reduce_op, identity);
+}
+
+template <class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor, class T>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value, T>
+reduce(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m, T init) {
+  return reduce(policy, m, std::move(init), std::plus<>());
+}
+
+template <class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value, remove_cv_t<ElementType>>
+reduce(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return reduce(policy, m, remove_cv_t<ElementType>(), std::plus<>());
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor, class T, class ReduceOp>
+T reduce(mdspan<ElementType, Extents, Layout, Accessor> const& m, T init, ReduceOp reduce_op) {
+  return reduce(execution::seq, m, std::move(init), reduce_op);
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor, class T>
+T reduce(mdspan<ElementType, Extents, Layout, Accessor> const& m, T init) {
+  return reduce(execution::seq, m, std::move(init), std::plus<>());
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+remove_cv_t<ElementType> reduce(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return reduce(execution::seq, m, remove_cv_t<ElementType>(), std::plus<>());
+}
+
+//------------------------------------------------------------------------------
+
+// The smallest (minloc) or largest (maxloc) element and its index; among
+// equal elements, the one with the lexicographically smallest index, so the
+// result does not depend on the layout or the number of threads.  Returns a
+// value-initialized location for an empty mdspan.  Layouts without strides
+// are visited index by index.
+template <class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value,
+  value_location<remove_cv_t<ElementType>, Extents::rank()>>
+minloc(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return detail::__locate(policy, m, std::less<>());
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+value_location<remove_cv_t<ElementType>, Extents::rank()>
+minloc(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return detail::__locate(execution::seq, m, std::less<>());
+}
+
+template <class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value,
+  value_location<remove_cv_t<ElementType>, Extents::rank()>>
+maxloc(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return detail::__locate(policy, m, std::greater<>());
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+value_location<remove_cv_t<ElementType>, Extents::rank()>
+maxloc(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return detail::__locate(execution::seq, m, std::greater<>());
+}
+
+} // end namespace experimental
+} // end namespace std
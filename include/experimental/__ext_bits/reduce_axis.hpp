@@ -0,0 +1,348 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "execution_policy.hpp"
+#include "reduce.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p1684_bits/mdarray.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Extents without dimension Axis, keeping the static extents of the others
+template <size_t Axis, class Extents, class Idxs = make_index_sequence<Extents::rank() - 1>>
+struct __remove_extent;
+
+template <size_t Axis, class Extents, size_t... Idxs>
+struct __remove_extent<Axis, Extents, index_sequence<Idxs...>> {
+  using type = extents<Extents::static_extent(Idxs < Axis ? Idxs : Idxs + 1)...>;
+};
+
+// The result keeps the storage order of a layout_left input, so that both
+// are traversed in the same direction; everything else gets layout_right
+template <class Layout>
+struct __axis_result_layout { using type = layout_right; };
+
+template <>
+struct __axis_result_layout<layout_left> { using type = layout_left; };
+
+// The loop nest of an axis reduction over a strided input: the dimensions of
+// the input sorted by decreasing stride, each with its stride in the input
+// and in the result (0 for the reduced dimension, which keeps its own loop),
+// and neighbours that continue each other in both merged.  Dimensions of
+// extent 1 other than the reduced one get no loop.
+template <size_t Rank>
+struct __axis_loops {
+  size_t rank = 0;
+  size_t axis = 0;
+  size_t in_base = 0;
+  array<size_t, Rank> extents = { };
+  array<size_t, Rank> in_strides = { };
+  array<size_t, Rank> out_strides = { };
+};
+
+template <size_t Axis, class InMapping, class OutMapping>
+__axis_loops<InMapping::extents_type::rank()> __make_axis_loops(InMapping const& in, OutMapping const& out) {
+  constexpr size_t Rank = InMapping::extents_type::rank();
+  __axis_loops<Rank> l;
+  l.in_base = __offset_of_origin(in, make_index_sequence<Rank>());
+  auto out_stride = [&](size_t d) -> size_t {
+    return d == Axis ? 0 : size_t(out.stride(d < Axis ? d : d - 1));
+  };
+
+  array<size_t, Rank> dims = { };
+  size_t num_dims = 0;
+  for(size_t d = 0; d < Rank; ++d) {
+    if(d != Axis && in.extents().extent(d) == 1) continue;
+    size_t j = num_dims++;
+    for(; j > 0 && in.stride(dims[j - 1]) < in.stride(d); --j) dims[j] = dims[j - 1];
+    dims[j] = d;
+  }
+
+  // merge from the innermost dimension outwards, then flip the order
+  array<size_t, Rank> ext = { }, is = { }, os = { };
+  array<bool, Rank> is_axis = { };
+  size_t n = 0;
+  for(size_t i = num_dims; i-- > 0; ) {
+    size_t d = dims[i];
+    size_t e = in.extents().extent(d), s = size_t(in.stride(d)), o = out_stride(d);
+    if(n > 0 && d != Axis && !is_axis[n - 1] && s == ext[n - 1] * is[n - 1] && o == ext[n - 1] * os[n - 1]) {
+      ext[n - 1] *= e;
+      continue;
+    }
+    ext[n] = e;
+    is[n] = s;
+    os[n] = o;
+    is_axis[n] = d == Axis;
+    ++n;
+  }
+  l.rank = n;
+  for(size_t k = 0; k < n; ++k) {
+    l.extents[k] = ext[n - 1 - k];
+    l.in_strides[k] = is[n - 1 - k];
+    l.out_strides[k] = os[n - 1 - k];
+    if(is_axis[n - 1 - k]) l.axis = k;
+  }
+  return l;
+}
+
+// Runs along the reduced dimension shorter than this are reduced with a
+// single accumulator
+_MDSPAN_INLINE_VARIABLE constexpr size_t __axis_short_run = 8 * __reduce_lanes;
+
+// Calls f(in_offset, out_offset, n, in_stride, out_stride) for every run of
+// the innermost loop of `l`, with every loop r restricted to
+// [first[r], last[r])
+template <size_t Rank, class F>
+void __for_each_axis_run(__axis_loops<Rank> const& l, array<size_t, Rank> const& first, array<size_t, Rank> const& last, F&& f) {
+  size_t inner = l.rank - 1;
+  array<size_t, Rank> pos = first;
+  size_t in_offset = l.in_base, out_offset = 0;
+  for(size_t r = 0; r < l.rank; ++r) {
+    if(first[r] >= last[r]) return;
+    in_offset += first[r] * l.in_strides[r];
+    out_offset += first[r] * l.out_strides[r];
+  }
+  for(;;) {
+    f(in_offset, out_offset, last[inner] - first[inner], l.in_strides[inner], l.out_strides[inner]);
+    size_t r = inner;
+    for(;;) {
+      if(r == 0) return;
+      --r;
+      in_offset += l.in_strides[r];
+      out_offset += l.out_strides[r];
+      if(++pos[r] < last[r]) break;
+      in_offset -= (pos[r] - first[r]) * l.in_strides[r];
+      out_offset -= (pos[r] - first[r]) * l.out_strides[r];
+      pos[r] = first[r];
+    }
+  }
+}
+
+// out[k * os] = in[k * is] (Combine == false) or op(out[k * os], in[k * is])
+template <bool UnitStrides, bool Combine, class T, class Accessor, class ReduceOp>
+void __axis_elementwise_run(
+  T* out, Accessor const& a, typename Accessor::pointer const& p, size_t in_offset,
+  size_t n, size_t in_stride, size_t out_stride, ReduceOp& op
+) {
+  size_t is = UnitStrides ? 1 : in_stride, os = UnitStrides ? 1 : out_stride;
+  for(size_t k = 0; k < n; ++k) {
+    T x = T(a.access(p, in_offset + k * is));
+    out[k * os] = Combine ? T(op(out[k * os], x)) : x;
+  }
+}
+
+template <size_t Axis, class ExecutionPolicy, class ET, class E, class L, class A, class Result, class ReduceOp>
+void __reduce_axis_strided(ExecutionPolicy policy, mdspan<ET, E, L, A> const& m, Result& result, ReduceOp& op) {
+  using value_type = typename Result::value_type;
+  constexpr size_t Rank = E::rank();
+  auto loops = __make_axis_loops<Axis>(m.mapping(), result.mapping());
+  auto const a = m.accessor();
+  auto const p = m.data();
+  value_type* out = result.data();
+  auto identity = [](typename A::reference x) -> value_type { return value_type(x); };
+
+  // the outermost loop other than the reduced one is split over the threads,
+  // so that every thread owns a disjoint part of the result
+  size_t split = loops.axis == 0 ? 1 : 0;
+  size_t n_axis = loops.extents[loops.axis];
+  __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+    array<size_t, Rank> first = { }, last = loops.extents;
+    if(split < loops.rank) {
+      first[split] = loops.extents[split] * t / num_threads;
+      last[split] = loops.extents[split] * (t + 1) / num_threads;
+    }
+    else if(t != 0) {
+      return;
+    }
+    if(loops.axis == loops.rank - 1) {
+      // reduced dimension innermost: every run is one result element
+      __for_each_axis_run(loops, first, last, [&](size_t in_offset, size_t out_offset, size_t n, size_t in_stride, size_t) {
+        // the set-up and final combine of the partial results dominate for
+        // runs of a few dozen elements, which are common here
+        if(n < __axis_short_run) {
+          value_type acc = value_type(a.access(p, in_offset));
+          for(size_t k = 1; k < n; ++k) acc = op(acc, value_type(a.access(p, in_offset + k * in_stride)));
+          out[out_offset] = acc;
+        }
+        else {
+          out[out_offset] = in_stride == 1
+            ? __transform_reduce_run<value_type, true>(a, p, in_offset, n, in_stride, op, identity, make_index_sequence<__reduce_lanes>())
+            : __transform_reduce_run<value_type, false>(a, p, in_offset, n, in_stride, op, identity, make_index_sequence<__reduce_lanes>());
+        }
+      });
+      return;
+    }
+    // otherwise whole runs of the result are combined with runs of the
+    // input: first copied from the first slice, then combined with the
+    // others
+    auto pass = [&](size_t axis_first, size_t axis_last, auto combine) {
+      first[loops.axis] = axis_first;
+      last[loops.axis] = axis_last;
+      __for_each_axis_run(loops, first, last, [&](size_t in_offset, size_t out_offset, size_t n, size_t in_stride, size_t out_stride) {
+        if(in_stride == 1 && out_stride == 1) {
+          __axis_elementwise_run<true, decltype(combine)::value>(out + out_offset, a, p, in_offset, n, in_stride, out_stride, op);
+        }
+        else {
+          __axis_elementwise_run<false, decltype(combine)::value>(out + out_offset, a, p, in_offset, n, in_stride, out_stride, op);
+        }
+      });
+    };
+    pass(0, 1, false_type());
+    pass(1, n_axis, true_type());
+  });
+}
+
+template <size_t Axis, class ExecutionPolicy, class ET, class E, class L, class A, class Result, class ReduceOp>
+void __reduce_axis_generic(ExecutionPolicy policy, mdspan<ET, E, L, A> const& m, Result& result, ReduceOp& op) {
+  using value_type = typename Result::value_type;
+  using out_extents_type = typename Result::extents_type;
+  constexpr size_t Rank = E::rank();
+  size_t n_axis = m.extent(Axis);
+  auto out = result.view();
+  __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+    auto f = [&](array<size_t, Rank - 1> const& idx) {
+      array<size_t, Rank> in_idx = { };
+      for(size_t d = 0; d < Rank - 1; ++d) in_idx[d < Axis ? d : d + 1] = idx[d];
+      value_type acc = value_type(m(in_idx));
+      for(in_idx[Axis] = 1; in_idx[Axis] < n_axis; ++in_idx[Axis]) acc = op(acc, value_type(m(in_idx)));
+      out(idx) = acc;
+      return true;
+    };
+    size_t n0 = __outer_extent(out.extents(), integral_constant<bool, out_extents_type::rank() == 0>());
+    __for_each_index_in(out.extents(), n0 * t / num_threads, n0 * (t + 1) / num_threads, f);
+  });
+}
+
+template <size_t Axis, class ExecutionPolicy, class ET, class E, class L, class A, class Result, class ReduceOp>
+void __reduce_axis(ExecutionPolicy policy, mdspan<ET, E, L, A> const& m, Result& result, ReduceOp& op, true_type /* has stride */) {
+  if(m.is_strided()) __reduce_axis_strided<Axis>(policy, m, result, op);
+  else __reduce_axis_generic<Axis>(policy, m, result, op);
+}
+
+template <size_t Axis, class ExecutionPolicy, class ET, class E, class L, class A, class Result, class ReduceOp>
+void __reduce_axis(ExecutionPolicy policy, mdspan<ET, E, L, A> const& m, Result& result, ReduceOp& op, false_type /* has stride */) {
+  __reduce_axis_generic<Axis>(policy, m, result, op);
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// The result of reducing an mdspan along dimension Axis: the remaining
+// dimensions, with their static extents, in layout_left order for a
+// layout_left input and in layout_right order otherwise
+template <size_t Axis, class ElementType, class Extents, class Layout>
+using reduce_axis_result_t = mdarray<
+  remove_cv_t<ElementType>,
+  typename detail::__remove_extent<Axis, Extents>::type,
+  typename detail::__axis_result_layout<Layout>::type
+>;
+
+// Reduces m along dimension Axis: result(i..., k...) is the reduction with
+// `reduce_op` of m(i..., a, k...) over all a.  As for reduce, the operation
+// must be associative and commutative.  Elements of the result are
+// value-initialized if the extent of Axis is 0.
+//
+// The traversal follows the input's layout rather than the dimension order:
+// the dimensions are walked by decreasing stride, so the input is read in
+// storage order whichever dimension is reduced.  When Axis has the smallest
+// stride, each result element is one vectorized reduction of a run;
+// otherwise the result is accumulated a run at a time, element by element,
+// from each slice along Axis.  With execution::par the outermost dimension
+// other than Axis is split over the OpenMP threads, each writing a disjoint
+// part of the result.  Layouts without strides are visited index by index.
+template <size_t Axis, class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor, class ReduceOp>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value,
+  reduce_axis_result_t<Axis, ElementType, Extents, Layout>>
+reduce_axis(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m, ReduceOp reduce_op) {
+  static_assert(Axis < Extents::rank(), "std::experimental::reduce_axis: Axis must be less than the rank.");
+  using result_type = reduce_axis_result_t<Axis, ElementType, Extents, Layout>;
+  array<size_t, Extents::rank() - 1> dyn = { };
+  size_t num_dynamic = 0;
+  for(size_t d = 0; d < Extents::rank(); ++d) {
+    if(d != Axis && Extents::static_extent(d) == dynamic_extent) dyn[num_dynamic++] = m.extent(d);
+  }
+  array<size_t, result_type::rank_dynamic()> out_dyn = { };
+  for(size_t d = 0; d < result_type::rank_dynamic(); ++d) out_dyn[d] = dyn[d];
+  result_type result{ typename result_type::extents_type(out_dyn) };
+  if(m.size() == 0) return result;
+  using has_stride = integral_constant<bool, detail::__has_stride<typename Layout::template mapping<Extents>>::value>;
+  detail::__reduce_axis<Axis>(policy, m, result, reduce_op, has_stride());
+  return result;
+}
+
+template <size_t Axis, class ExecutionPolicy, class ElementType, class Extents, class Layout, class Accessor>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value,
+  reduce_axis_result_t<Axis, ElementType, Extents, Layout>>
+reduce_axis(ExecutionPolicy policy, mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return reduce_axis<Axis>(policy, m, std::plus<>());
+}
+
+template <size_t Axis, class ElementType, class Extents, class Layout, class Accessor, class ReduceOp>
+reduce_axis_result_t<Axis, ElementType, Extents, Layout>
+reduce_axis(mdspan<ElementType, Extents, Layout, Accessor> const& m, ReduceOp reduce_op) {
+  return reduce_axis<Axis>(execution::seq, m, reduce_op);
+}
+
+template <size_t Axis, class ElementType, class Extents, class Layout, class Accessor>
+reduce_axis_result_t<Axis, ElementType, Extents, Layout>
+reduce_axis(mdspan<ElementType, Extents, Layout, Accessor> const& m) {
+  return reduce_axis<Axis>(execution::seq, m, std::plus<>());
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,197 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// 16-bit floating point storage types.  These only hold the bits of an IEEE
+// binary16 (float16_storage) or bfloat16 (bfloat16_storage) number; all
+// arithmetic is meant to happen in float after conversion, e.g., through
+// converting_accessor.
+struct float16_storage { uint16_t bits; };
+struct bfloat16_storage { uint16_t bits; };
+
+namespace detail {
+
+MDSPAN_INLINE_FUNCTION
+uint32_t __float_bits(float f) noexcept {
+  uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+MDSPAN_INLINE_FUNCTION
+float __bits_float(uint32_t u) noexcept {
+  float f;
+  std::memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+// Conversions round to nearest even and handle subnormals, infinities, and
+// NaNs.  The software versions only use integer and float operations that
+// compilers vectorize, so loops over converting accessors still vectorize
+// when no conversion instructions are available.
+
+MDSPAN_INLINE_FUNCTION
+float __float16_to_float(float16_storage h) noexcept {
+#if defined(__AVX512FP16__)
+  _Float16 f;
+  std::memcpy(&f, &h.bits, sizeof(f));
+  return float(f);
+#elif defined(__F16C__)
+  return _cvtsh_ss(h.bits);
+#else
+  constexpr uint32_t shifted_exp = 0x7c00u << 13;
+  uint32_t u = uint32_t(h.bits & 0x7fffu) << 13;
+  uint32_t exp = shifted_exp & u;
+  u += uint32_t(127 - 15) << 23;
+  if(exp == shifted_exp) {
+    // Inf or NaN
+    u += uint32_t(128 - 16) << 23;
+  }
+  else if(exp == 0) {
+    // zero or subnormal: renormalize through a float subtraction
+    u += 1u << 23;
+    u = __float_bits(__bits_float(u) - __bits_float(113u << 23));
+  }
+  return __bits_float(u | (uint32_t(h.bits & 0x8000u) << 16));
+#endif
+}
+
+MDSPAN_INLINE_FUNCTION
+float16_storage __float_to_float16(float f) noexcept {
+#if defined(__AVX512FP16__)
+  _Float16 h = _Float16(f);
+  float16_storage result;
+  std::memcpy(&result.bits, &h, sizeof(h));
+  return result;
+#elif defined(__F16C__)
+  return float16_storage{ uint16_t(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT)) };
+#else
+  constexpr uint32_t f32_inf = 255u << 23;
+  constexpr uint32_t f16_max = (127u + 16u) << 23;
+  constexpr uint32_t denorm_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+  uint32_t u = __float_bits(f);
+  uint32_t sign = u & 0x80000000u;
+  u ^= sign;
+  uint16_t result;
+  if(u >= f16_max) {
+    // overflow to Inf, NaN stays (quiet) NaN
+    result = u > f32_inf ? 0x7e00 : 0x7c00;
+  }
+  else if(u < (113u << 23)) {
+    // subnormal or zero: let the float addition do the rounding
+    result = uint16_t(__float_bits(__bits_float(u) + __bits_float(denorm_magic)) - denorm_magic);
+  }
+  else {
+    uint32_t mant_odd = (u >> 13) & 1u;
+    u += (uint32_t(15 - 127) << 23) + 0xfffu;
+    u += mant_odd;
+    result = uint16_t(u >> 13);
+  }
+  return float16_storage{ uint16_t(result | (sign >> 16)) };
+#endif
+}
+
+MDSPAN_INLINE_FUNCTION
+float __bfloat16_to_float(bfloat16_storage b) noexcept {
+  return __bits_float(uint32_t(b.bits) << 16);
+}
+
+MDSPAN_INLINE_FUNCTION
+bfloat16_storage __float_to_bfloat16(float f) noexcept {
+  uint32_t u = __float_bits(f);
+  if((u & 0x7fffffffu) > 0x7f800000u) {
+    // NaN: truncate, but keep it quiet so it does not turn into Inf
+    return bfloat16_storage{ uint16_t((u >> 16) | 0x40u) };
+  }
+  u += 0x7fffu + ((u >> 16) & 1u);
+  return bfloat16_storage{ uint16_t(u >> 16) };
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Conversion between a storage type and the type computations are done in,
+// used by converting_accessor.  Specialize it to store values in other
+// formats.  The primary template converts with static_cast.
+template <class StorageT, class ComputeT>
+struct conversion_traits {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static constexpr ComputeT load(StorageT s) noexcept { return static_cast<ComputeT>(s); }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static constexpr StorageT store(ComputeT c) noexcept { return static_cast<StorageT>(c); }
+};
+
+template <class ComputeT>
+struct conversion_traits<float16_storage, ComputeT> {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static ComputeT load(float16_storage s) noexcept { return ComputeT(detail::__float16_to_float(s)); }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static float16_storage store(ComputeT c) noexcept { return detail::__float_to_float16(float(c)); }
+};
+
+template <class ComputeT>
+struct conversion_traits<bfloat16_storage, ComputeT> {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static ComputeT load(bfloat16_storage s) noexcept { return ComputeT(detail::__bfloat16_to_float(s)); }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  static bfloat16_storage store(ComputeT c) noexcept { return detail::__float_to_bfloat16(float(c)); }
+};
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,242 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "layout_sell.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Owning SELL-C-sigma sparse matrix.
+//
+// Rows are sorted by decreasing length within windows of `sigma` rows before
+// being cut into chunks of `ChunkHeight` rows, which keeps the padding per
+// chunk small without destroying the locality of the original row order.
+// `row_permutation()(slot)` gives the original row stored in a row slot;
+// slots past the last row (in the final, partially filled chunk) hold
+// indices >= num_rows().  Padding entries have value zero and repeat the
+// last column index of their row.
+template <class ValueType, size_t ChunkHeight, class IndexType = int>
+class sell_matrix {
+public:
+
+  using value_type = ValueType;
+  using index_type = IndexType;
+  using size_type = size_t;
+  using layout_type = layout_sell<ChunkHeight>;
+  using extents_type = dextents<2>;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+
+  using values_type = mdspan<value_type, extents_type, layout_type>;
+  using const_values_type = mdspan<value_type const, extents_type, layout_type>;
+  using column_indices_type = mdspan<index_type, extents_type, layout_type>;
+  using const_column_indices_type = mdspan<index_type const, extents_type, layout_type>;
+  using row_permutation_type = mdspan<index_type const, dextents<1>>;
+
+  // One chunk as a dense ChunkHeight x width column-major block
+  using chunk_values_type = mdspan<value_type const, extents<ChunkHeight, dynamic_extent>, layout_left>;
+  using chunk_column_indices_type = mdspan<index_type const, extents<ChunkHeight, dynamic_extent>, layout_left>;
+
+  static constexpr size_type chunk_height() noexcept { return ChunkHeight; }
+
+  sell_matrix() = default;
+
+  // Converts a compressed sparse row matrix with `row_ptr.extent(0) - 1` rows
+  // and `num_cols` columns.
+  template <class OffsetType, class ColIdxType, class InValueType>
+  sell_matrix(
+    size_type num_cols,
+    mdspan<OffsetType, dextents<1>> row_ptr,
+    mdspan<ColIdxType, dextents<1>> col_idx,
+    mdspan<InValueType, dextents<1>> values,
+    size_type sigma = 1
+  ) : __num_rows(row_ptr.extent(0) == 0 ? 0 : row_ptr.extent(0) - 1),
+      __num_cols(num_cols)
+  {
+    size_type num_chunks = (__num_rows + ChunkHeight - 1) / ChunkHeight;
+    size_type num_slots = num_chunks * ChunkHeight;
+    sigma = sigma == 0 ? 1 : sigma;
+
+    auto row_length = [&](size_type row) -> size_type {
+      return row < __num_rows ? size_type(row_ptr(row + 1) - row_ptr(row)) : 0;
+    };
+
+    __perm.resize(num_slots);
+    std::iota(__perm.begin(), __perm.end(), index_type(0));
+    for(size_type w = 0; w < __num_rows; w += sigma) {
+      auto first = __perm.begin() + w;
+      auto last = __perm.begin() + std::min(w + sigma, __num_rows);
+      std::stable_sort(first, last, [&](index_type a, index_type b) {
+        return row_length(size_type(a)) > row_length(size_type(b));
+      });
+    }
+
+    __chunk_offsets.resize(num_chunks + 1);
+    __chunk_offsets[0] = 0;
+    size_type max_width = 0;
+    for(size_type c = 0; c < num_chunks; ++c) {
+      size_type width = 0;
+      for(size_type r = 0; r < ChunkHeight; ++r) {
+        width = std::max(width, row_length(size_type(__perm[c * ChunkHeight + r])));
+      }
+      max_width = std::max(max_width, width);
+      __chunk_offsets[c + 1] = __chunk_offsets[c] + width * ChunkHeight;
+    }
+    __max_width = max_width;
+
+    __values.assign(__chunk_offsets[num_chunks], value_type(0));
+    __col_idx.assign(__chunk_offsets[num_chunks], index_type(0));
+    auto vals = this->values();
+    auto cols = this->column_indices();
+    for(size_type slot = 0; slot < num_slots; ++slot) {
+      size_type row = size_type(__perm[slot]);
+      size_type len = row_length(row);
+      size_type width = vals.mapping().chunk_width(slot / ChunkHeight);
+      index_type last_col = 0;
+      for(size_type k = 0; k < len; ++k) {
+        vals(slot, k) = value_type(values(row_ptr(row) + k));
+        cols(slot, k) = last_col = index_type(col_idx(row_ptr(row) + k));
+      }
+      for(size_type k = len; k < width; ++k) {
+        cols(slot, k) = last_col;
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+
+  size_type num_rows() const noexcept { return __num_rows; }
+  size_type num_cols() const noexcept { return __num_cols; }
+  size_type num_chunks() const noexcept { return __chunk_offsets.empty() ? 0 : __chunk_offsets.size() - 1; }
+  // Number of stored entries, including padding
+  size_type num_stored() const noexcept { return __values.size(); }
+
+  mapping_type mapping() const noexcept {
+    return mapping_type(extents_type(num_chunks() * ChunkHeight, __max_width), __chunk_offsets.data());
+  }
+
+  values_type values() noexcept { return values_type(__values.data(), mapping()); }
+  const_values_type values() const noexcept { return const_values_type(__values.data(), mapping()); }
+
+  column_indices_type column_indices() noexcept { return column_indices_type(__col_idx.data(), mapping()); }
+  const_column_indices_type column_indices() const noexcept { return const_column_indices_type(__col_idx.data(), mapping()); }
+
+  row_permutation_type row_permutation() const noexcept {
+    return row_permutation_type(__perm.data(), __perm.size());
+  }
+
+  chunk_values_type chunk_values(size_type c) const noexcept {
+    return chunk_values_type(__values.data() + __chunk_offsets[c], mapping().chunk_width(c));
+  }
+
+  chunk_column_indices_type chunk_column_indices(size_type c) const noexcept {
+    return chunk_column_indices_type(__col_idx.data() + __chunk_offsets[c], mapping().chunk_width(c));
+  }
+
+private:
+
+  size_type __num_rows = 0;
+  size_type __num_cols = 0;
+  size_type __max_width = 0;
+  std::vector<size_type> __chunk_offsets;
+  std::vector<value_type> __values;
+  std::vector<index_type> __col_idx;
+  std::vector<index_type> __perm;
+
+};
+
+//==============================================================================
+
+// y = A * x
+//
+// Each chunk is processed as a dense ChunkHeight x width block: the inner
+// loop runs over the ChunkHeight rows of a chunk, which are contiguous in
+// memory for both values and column indices, so that it vectorizes (with a
+// gather of x where the target supports one) instead of working through one
+// short, irregular row at a time.
+template <
+  class ValueType, size_t ChunkHeight, class IndexType,
+  class XElementType, class XExtents, class XLayout, class XAccessor,
+  class YElementType, class YExtents, class YLayout, class YAccessor
+>
+void sparse_matrix_vector_product(
+  sell_matrix<ValueType, ChunkHeight, IndexType> const& A,
+  mdspan<XElementType, XExtents, XLayout, XAccessor> x,
+  mdspan<YElementType, YExtents, YLayout, YAccessor> y
+)
+{
+  static_assert(XExtents::rank() == 1 && YExtents::rank() == 1,
+    "sparse_matrix_vector_product requires rank 1 x and y");
+  using sum_type = typename mdspan<YElementType, YExtents, YLayout, YAccessor>::value_type;
+  auto perm = A.row_permutation();
+  size_t num_rows = A.num_rows();
+  for(size_t c = 0; c < A.num_chunks(); ++c) {
+    auto vals = A.chunk_values(c);
+    auto cols = A.chunk_column_indices(c);
+    sum_type sum[ChunkHeight] = { };
+    for(size_t k = 0; k < vals.extent(1); ++k) {
+      for(size_t r = 0; r < ChunkHeight; ++r) {
+        sum[r] += vals(r, k) * x(size_t(cols(r, k)));
+      }
+    }
+    for(size_t r = 0; r < ChunkHeight; ++r) {
+      size_t row = size_t(perm(c * ChunkHeight + r));
+      if(row < num_rows) y(row) = sum[r];
+    }
+  }
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,393 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "mapped_mdarray.hpp"
+#include "npy.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+#include "../__p0009_bits/extents.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+
+#if defined(_MDSPAN_HAS_MMAP)
+
+namespace detail {
+
+_MDSPAN_INLINE_VARIABLE constexpr size_t __shared_max_rank = 8;
+_MDSPAN_INLINE_VARIABLE constexpr uint32_t __shared_version = 1;
+// Offset of the elements from the start of the segment: a multiple of the
+// cache line size, so the header never shares a line with the data
+_MDSPAN_INLINE_VARIABLE constexpr size_t __shared_data_offset = 256;
+
+// How the consumer rebuilds the mapping from the stored strides
+enum class __shared_layout_kind : uint32_t { right = 0, left = 1, stride = 2 };
+
+template <class Layout> struct __shared_layout;
+template <> struct __shared_layout<layout_right> {
+  static constexpr __shared_layout_kind kind = __shared_layout_kind::right;
+};
+template <> struct __shared_layout<layout_left> {
+  static constexpr __shared_layout_kind kind = __shared_layout_kind::left;
+};
+template <> struct __shared_layout<layout_stride> {
+  static constexpr __shared_layout_kind kind = __shared_layout_kind::stride;
+};
+
+// Start of a shared segment.  All fields except the generation counter are
+// written once by the creator, before the magic; the magic is stored last
+// with release ordering and loaded first with acquire ordering, so a
+// consumer that sees it also sees the whole header.
+struct __shared_header {
+  std::atomic<uint64_t> magic;
+  uint32_t version;
+  uint32_t rank;
+  char type[8];            // numpy type string of the element, e.g. "<f4"
+  uint32_t element_size;
+  uint32_t layout;         // __shared_layout_kind
+  uint64_t data_offset;    // bytes from the start of the segment
+  uint64_t data_bytes;
+  uint64_t extents[__shared_max_rank];
+  uint64_t strides[__shared_max_rank];
+  alignas(64) std::atomic<uint64_t> generation;
+};
+
+// "MDSPANSH" as a little endian integer
+_MDSPAN_INLINE_VARIABLE constexpr uint64_t __shared_magic = 0x48534e415053444dull;
+
+static_assert(sizeof(__shared_header) <= __shared_data_offset, "shared header does not fit in front of the data");
+#if defined(ATOMIC_LLONG_LOCK_FREE)
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the shared magic and generation counter must be lock-free to work across processes");
+#endif
+
+} // end namespace detail
+
+//==============================================================================
+
+// Owning array in a POSIX shared memory object, for handing frames between
+// processes without copying them.
+//
+// The segment named `name` (a string like "/frames", see shm_open(3)) holds a
+// small header -- element type, extents, strides, layout, and a generation
+// counter -- followed by the elements.  The producer creates it with
+// `shared_mdarray(name, mapping)`, which replaces any existing segment of the
+// same name and removes the name again when the array is destroyed.  A
+// consumer opens it with `shared_mdarray(name)`, which rebuilds the mapping
+// from the header and throws std::runtime_error if the element type, rank,
+// layout, or a static extent do not match; `view()` is then an mdspan
+// directly over the producer's elements.  With a const ElementType the
+// segment is mapped read-only.
+//
+// The generation counter orders hand-offs: the producer writes a frame and
+// calls `publish()`, and a consumer that saw generation g calls
+// `wait_for_update(g)` and can then read the frame.  Nothing keeps the
+// producer from overwriting a frame that is still being read; pipelines that
+// need that use a second array (or a ring of frames) to acknowledge.
+//
+// Only layout_right, layout_left and layout_stride of rank up to 8 and
+// element types with a numpy type string (the arithmetic types and
+// std::complex) can be shared.  System errors throw std::system_error.  The
+// array is move-only.  On older glibc, link with -lrt.
+template <class ElementType, class Extents, class LayoutPolicy = layout_right>
+class shared_mdarray {
+public:
+
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, ElementType),
+    "std::experimental::shared_mdarray requires a trivially copyable element type.");
+  static_assert(Extents::rank() <= detail::__shared_max_rank,
+    "std::experimental::shared_mdarray supports ranks up to 8.");
+
+  using element_type = ElementType;
+  using value_type = remove_cv_t<ElementType>;
+  using size_type = size_t;
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+
+  using mdspan_type = mdspan<element_type, extents_type, layout_type>;
+  using const_mdspan_type = mdspan<element_type const, extents_type, layout_type>;
+
+  shared_mdarray() = default;
+
+  // Creates the segment and maps it read-write; the elements start zeroed
+  // and the generation at 0
+  shared_mdarray(char const* name, mapping_type const& m)
+    : __mapping(m), __name(name), __owner(true)
+  {
+    static_assert(!is_const<element_type>::value,
+      "std::experimental::shared_mdarray: cannot create a segment for a read-only array");
+    std::string descr = detail::__npy_descr<value_type>();
+    if(descr.empty()) __throw_format("element type has no type tag");
+    size_type bytes = size_type(m.required_span_size()) * sizeof(element_type);
+    ::shm_unlink(name);
+    int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if(fd < 0) __throw_errno("shm_open");
+    __map_length = detail::__shared_data_offset + bytes;
+    if(::ftruncate(fd, off_t(__map_length)) != 0) {
+      int err = errno;
+      ::close(fd);
+      ::shm_unlink(name);
+      __throw_errno("ftruncate", err);
+    }
+    __map(fd, PROT_READ | PROT_WRITE);
+
+    auto* h = __header();
+    ::new (&h->magic) std::atomic<uint64_t>(0);
+    h->version = detail::__shared_version;
+    h->rank = uint32_t(extents_type::rank());
+    std::memcpy(h->type, descr.c_str(), descr.size() < sizeof(h->type) ? descr.size() : sizeof(h->type) - 1);
+    h->element_size = uint32_t(sizeof(element_type));
+    h->layout = uint32_t(detail::__shared_layout<layout_type>::kind);
+    h->data_offset = detail::__shared_data_offset;
+    h->data_bytes = bytes;
+    for(size_type r = 0; r < extents_type::rank(); ++r) {
+      h->extents[r] = m.extents().extent(r);
+      h->strides[r] = m.stride(r);
+    }
+    ::new (&h->generation) std::atomic<uint64_t>(0);
+    h->magic.store(detail::__shared_magic, std::memory_order_release);
+  }
+
+  // Opens and maps a segment created by another shared_mdarray
+  explicit shared_mdarray(char const* name)
+    : __name(name), __owner(false)
+  {
+    constexpr bool read_only = is_const<element_type>::value;
+    int fd = ::shm_open(name, read_only ? O_RDONLY : O_RDWR, 0);
+    if(fd < 0) __throw_errno("shm_open");
+    struct stat st;
+    if(::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      __throw_errno("fstat", err);
+    }
+    if(size_type(st.st_size) < detail::__shared_data_offset) {
+      ::close(fd);
+      __throw_format("segment is too small");
+    }
+    __map_length = size_type(st.st_size);
+    __map(fd, read_only ? PROT_READ : PROT_READ | PROT_WRITE);
+    try {
+      __validate();
+    }
+    catch(...) {
+      ::munmap(__base, __map_length);
+      throw;
+    }
+  }
+
+  shared_mdarray(shared_mdarray const&) = delete;
+  shared_mdarray& operator=(shared_mdarray const&) = delete;
+
+  shared_mdarray(shared_mdarray&& other) noexcept { __swap(other); }
+
+  shared_mdarray& operator=(shared_mdarray&& other) noexcept {
+    shared_mdarray(std::move(other)).__swap(*this);
+    return *this;
+  }
+
+  ~shared_mdarray() {
+    if(__base != nullptr) ::munmap(__base, __map_length);
+    if(__owner) ::shm_unlink(__name.c_str());
+  }
+
+  //--------------------------------------------------------------------------------
+
+  mapping_type const& mapping() const noexcept { return __mapping; }
+  extents_type extents() const noexcept { return __mapping.extents(); }
+  size_type size() const noexcept { return size_type(__mapping.required_span_size()); }
+  size_type size_bytes() const noexcept { return size() * sizeof(element_type); }
+  std::string const& name() const noexcept { return __name; }
+  // Whether this array created the segment (and removes its name on destruction)
+  bool is_owner() const noexcept { return __owner; }
+
+  element_type* data() noexcept { return __data; }
+  element_type const* data() const noexcept { return __data; }
+
+  mdspan_type view() noexcept { return mdspan_type(__data, __mapping); }
+  const_mdspan_type view() const noexcept { return const_mdspan_type(__data, __mapping); }
+
+  //--------------------------------------------------------------------------------
+
+  uint64_t generation() const noexcept {
+    return __header()->generation.load(std::memory_order_acquire);
+  }
+
+  // Makes all stores to the elements visible to consumers that see the new
+  // generation, which is returned
+  uint64_t publish() noexcept {
+    static_assert(!is_const<element_type>::value,
+      "std::experimental::shared_mdarray: cannot publish through a read-only array");
+    return __header()->generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+  }
+
+  // Waits until the generation differs from `seen` and returns it.  Spins
+  // briefly, then yields between polls.
+  uint64_t wait_for_update(uint64_t seen) const noexcept {
+    auto const& g = __header()->generation;
+    for(int spin = 0; spin < 1024; ++spin) {
+      uint64_t now = g.load(std::memory_order_acquire);
+      if(now != seen) return now;
+    }
+    for(;;) {
+      uint64_t now = g.load(std::memory_order_acquire);
+      if(now != seen) return now;
+      std::this_thread::yield();
+    }
+  }
+
+private:
+
+  using __header_type = conditional_t<is_const<element_type>::value,
+    detail::__shared_header const, detail::__shared_header>;
+
+  __header_type* __header() const noexcept {
+    return reinterpret_cast<__header_type*>(__base);
+  }
+
+  [[noreturn]] static void __throw_errno(char const* what, int err = errno) {
+    throw std::system_error(err, std::generic_category(), std::string("std::experimental::shared_mdarray: ") + what);
+  }
+
+  [[noreturn]] void __throw_format(char const* what) const {
+    throw std::runtime_error(std::string("std::experimental::shared_mdarray: ") + what + ": " + __name);
+  }
+
+  // Maps the whole segment and closes `fd`
+  void __map(int fd, int prot) {
+    void* base = ::mmap(nullptr, __map_length, prot, MAP_SHARED, fd, 0);
+    int err = errno;
+    ::close(fd);
+    if(base == MAP_FAILED) {
+      if(__owner) ::shm_unlink(__name.c_str());
+      __throw_errno("mmap", err);
+    }
+    __base = static_cast<char*>(base);
+    __data = reinterpret_cast<element_type*>(__base + detail::__shared_data_offset);
+  }
+
+  // Checks the header of an opened segment and rebuilds the mapping from it
+  void __validate() {
+    auto const* h = __header();
+    if(h->magic.load(std::memory_order_acquire) != detail::__shared_magic) __throw_format("bad magic or not yet initialized");
+    if(h->version != detail::__shared_version) __throw_format("unsupported version");
+    if(!detail::__npy_descr_matches<value_type>(std::string(h->type, strnlen(h->type, sizeof(h->type))))
+       || h->element_size != sizeof(element_type)) {
+      __throw_format("element type mismatch");
+    }
+    if(h->rank != extents_type::rank()) __throw_format("rank mismatch");
+    if(h->layout != uint32_t(detail::__shared_layout<layout_type>::kind)) __throw_format("layout mismatch");
+    if(h->data_offset != detail::__shared_data_offset || h->data_offset + h->data_bytes > __map_length) {
+      __throw_format("data does not fit in the segment");
+    }
+    __mapping = __make_mapping(*h);
+    if(size_type(__mapping.required_span_size()) * sizeof(element_type) != h->data_bytes) {
+      __throw_format("extents do not match the data size");
+    }
+  }
+
+  extents_type __make_extents(detail::__shared_header const& h) const {
+    array<size_t, extents_type::rank_dynamic()> dyn = { };
+    size_type d = 0;
+    for(size_type r = 0; r < extents_type::rank(); ++r) {
+      if(extents_type::static_extent(r) == dynamic_extent) dyn[d++] = size_t(h.extents[r]);
+      else if(extents_type::static_extent(r) != h.extents[r]) __throw_format("extent mismatch");
+    }
+    return extents_type(dyn);
+  }
+
+  mapping_type __make_mapping(detail::__shared_header const& h) const {
+    return __make_mapping(h, detail::__shared_layout<layout_type>{});
+  }
+
+  template <class Tag>
+  mapping_type __make_mapping(detail::__shared_header const& h, Tag) const {
+    return mapping_type(__make_extents(h));
+  }
+
+  mapping_type __make_mapping(detail::__shared_header const& h, detail::__shared_layout<layout_stride>) const {
+    array<size_t, extents_type::rank()> strides = { };
+    for(size_type r = 0; r < extents_type::rank(); ++r) strides[r] = size_t(h.strides[r]);
+    return mapping_type(__make_extents(h), dextents<extents_type::rank()>(strides));
+  }
+
+  void __swap(shared_mdarray& other) noexcept {
+    std::swap(__mapping, other.__mapping);
+    std::swap(__base, other.__base);
+    std::swap(__map_length, other.__map_length);
+    std::swap(__data, other.__data);
+    std::swap(__name, other.__name);
+    std::swap(__owner, other.__owner);
+  }
+
+  mapping_type __mapping = { };
+  char* __base = nullptr;
+  size_type __map_length = 0;
+  element_type* __data = nullptr;
+  std::string __name;
+  bool __owner = false;
+
+};
+
+#endif // _MDSPAN_HAS_MMAP
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,565 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/dynamic_extent.hpp"
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef _MDSPAN_HAS_PREAD
+#define _MDSPAN_HAS_PREAD 1
+#endif
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define _MDSPAN_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace std {
+namespace experimental {
+
+#if defined(_MDSPAN_HAS_PREAD)
+
+//==============================================================================
+
+// How a slab_reader issues its reads
+enum class slab_io_backend {
+  // io_uring where the kernel supports it, threads otherwise
+  automatic,
+  // reads submitted to an io_uring, completed by the kernel
+  io_uring,
+  // blocking preads on a background thread
+  threads
+};
+
+struct slab_reader_options {
+  // slabs in flight or being processed; 1 serializes reading and processing
+  size_t num_buffers = 2;
+  slab_io_backend backend = slab_io_backend::automatic;
+  // bypass the page cache with O_DIRECT where the file system allows it
+  bool direct_io = false;
+  // bytes before the first element
+  size_t file_offset = 0;
+};
+
+namespace detail {
+
+// Buffers are aligned (and O_DIRECT reads rounded) to this many bytes
+_MDSPAN_INLINE_VARIABLE constexpr size_t __slab_alignment = 4096;
+
+// Reads until at least `need` of the `want` bytes at `offset` are in `buf`.
+// Returns 0 or an errno value.
+inline int __slab_pread(int fd, unsigned char* buf, size_t want, size_t need, off_t offset) noexcept {
+  size_t got = 0;
+  while(got < need) {
+    ssize_t r = ::pread(fd, buf + got, want - got, offset + off_t(got));
+    if(r < 0 && errno == EINTR) continue;
+    if(r < 0) return errno;
+    if(r == 0) return EIO;
+    got += size_t(r);
+  }
+  return 0;
+}
+
+#if defined(_MDSPAN_HAS_IO_URING)
+
+// Minimal io_uring over the raw system calls: one READV per request, with
+// the request's tag as user_data.
+class __io_uring_queue {
+public:
+
+  __io_uring_queue() = default;
+  __io_uring_queue(__io_uring_queue const&) = delete;
+  __io_uring_queue& operator=(__io_uring_queue const&) = delete;
+
+  ~__io_uring_queue() { __close(); }
+
+  // Returns false if io_uring is unavailable (old kernel, seccomp, ...)
+  bool open(unsigned entries) noexcept {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    int fd = int(::syscall(__NR_io_uring_setup, entries, &p));
+    if(fd < 0) return false;
+    __fd = fd;
+    __sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    __cq_len = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if(single) __sq_len = __cq_len = __sq_len > __cq_len ? __sq_len : __cq_len;
+    __sq_ptr = ::mmap(nullptr, __sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if(__sq_ptr == MAP_FAILED) { __sq_ptr = nullptr; __close(); return false; }
+    if(single) {
+      __cq_ptr = __sq_ptr;
+    }
+    else {
+      __cq_ptr = ::mmap(nullptr, __cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+      if(__cq_ptr == MAP_FAILED) { __cq_ptr = nullptr; __close(); return false; }
+    }
+    __sqes_len = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, __sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if(sqes == MAP_FAILED) { __close(); return false; }
+    __sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(__sq_ptr);
+    __sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    __sq_mask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    __sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    char* cq = static_cast<char*>(__cq_ptr);
+    __cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    __cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    __cq_mask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    __cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    return true;
+  }
+
+  // Submits a read of iov into the file `fd` at `offset`.  Returns 0 or an
+  // errno value.  The caller keeps at most `entries` requests in flight.
+  int submit_readv(int fd, iovec const* iov, off_t offset, uint64_t tag) noexcept {
+    unsigned tail = *__sq_tail;
+    unsigned index = tail & __sq_mask;
+    io_uring_sqe& sqe = __sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = fd;
+    sqe.addr = uint64_t(reinterpret_cast<uintptr_t>(iov));
+    sqe.len = 1;
+    sqe.off = uint64_t(offset);
+    sqe.user_data = tag;
+    __sq_array[index] = index;
+    __atomic_store_n(__sq_tail, tail + 1, __ATOMIC_RELEASE);
+    for(;;) {
+      long r = ::syscall(__NR_io_uring_enter, __fd, 1u, 0u, 0u, nullptr, size_t(0));
+      if(r >= 0) return 0;
+      if(errno != EINTR) return errno;
+    }
+  }
+
+  // Waits for one completion; returns its tag and stores its result
+  // (bytes read or -errno) in `res`
+  uint64_t wait(int& res) noexcept {
+    for(;;) {
+      unsigned head = *__cq_head;
+      if(head != __atomic_load_n(__cq_tail, __ATOMIC_ACQUIRE)) {
+        io_uring_cqe const& cqe = __cqes[head & __cq_mask];
+        uint64_t tag = cqe.user_data;
+        res = cqe.res;
+        __atomic_store_n(__cq_head, head + 1, __ATOMIC_RELEASE);
+        return tag;
+      }
+      long r = ::syscall(__NR_io_uring_enter, __fd, 0u, 1u, unsigned(IORING_ENTER_GETEVENTS), nullptr, size_t(0));
+      if(r < 0 && errno != EINTR) {
+        res = -errno;
+        return uint64_t(-1);
+      }
+    }
+  }
+
+private:
+
+  void __close() noexcept {
+    if(__sqes != nullptr) ::munmap(__sqes, __sqes_len);
+    if(__cq_ptr != nullptr && __cq_ptr != __sq_ptr) ::munmap(__cq_ptr, __cq_len);
+    if(__sq_ptr != nullptr) ::munmap(__sq_ptr, __sq_len);
+    if(__fd >= 0) ::close(__fd);
+    __sqes = nullptr;
+    __cq_ptr = __sq_ptr = nullptr;
+    __fd = -1;
+  }
+
+  int __fd = -1;
+  void* __sq_ptr = nullptr;
+  void* __cq_ptr = nullptr;
+  size_t __sq_len = 0, __cq_len = 0, __sqes_len = 0;
+  io_uring_sqe* __sqes = nullptr;
+  unsigned* __sq_tail = nullptr;
+  unsigned* __sq_array = nullptr;
+  unsigned __sq_mask = 0;
+  unsigned* __cq_head = nullptr;
+  unsigned* __cq_tail = nullptr;
+  unsigned __cq_mask = 0;
+  io_uring_cqe* __cqes = nullptr;
+};
+
+#endif // defined(_MDSPAN_HAS_IO_URING)
+
+} // end namespace detail
+
+//==============================================================================
+
+// Pipelined reader for a raw, row-major file of `extents` elements of type T,
+// processed in slabs of `slab_rows` indices of the first dimension.
+//
+// `for_each_slab(f)` calls `f(slab, first_row)` for consecutive slabs in
+// order, where `slab` is an `mdspan<T const, Extents>` of extent
+// min(slab_rows, rows left) over the slab's rows, valid until `f` returns.
+// With `num_buffers` buffers, reads of the next `num_buffers - 1` slabs are
+// in flight while `f` processes one, so that processing overlaps I/O.  Reads
+// go through io_uring or, where it is unavailable, blocking preads on a
+// background thread.  Buffers are page aligned; with `direct_io` the file
+// is opened with O_DIRECT (when the file system accepts it) and reads are
+// widened to aligned blocks.
+//
+// Failures to open or read the file throw std::system_error from the
+// constructor or for_each_slab; an exception from `f` is rethrown after the
+// reads in flight have completed.
+template <class ElementType, class Extents>
+class slab_reader {
+public:
+
+  static_assert(detail::__is_extents_v<Extents> && Extents::rank() >= 1,
+    "std::experimental::slab_reader requires extents of rank >= 1.");
+  static_assert(Extents::static_extent(0) == dynamic_extent,
+    "std::experimental::slab_reader requires a dynamic first extent.");
+  static_assert(_MDSPAN_TRAIT(is_trivially_copyable, ElementType),
+    "std::experimental::slab_reader requires a trivially copyable element type.");
+
+  using element_type = ElementType const;
+  using value_type = remove_cv_t<ElementType>;
+  using extents_type = Extents;
+  using slab_type = mdspan<element_type, extents_type>;
+
+  slab_reader(
+    char const* path, extents_type const& exts, size_t slab_rows,
+    slab_reader_options const& options = slab_reader_options()
+  ) : __path(path), __extents(exts), __slab_rows(slab_rows), __file_offset(options.file_offset)
+  {
+    if(slab_rows == 0 || options.num_buffers == 0) {
+      throw std::invalid_argument("slab reader: slab rows and buffer count must be positive");
+    }
+    __row_elements = 1;
+    for(size_t r = 1; r < extents_type::rank(); ++r) __row_elements *= exts.extent(r);
+
+    __fd = -1;
+#if defined(O_DIRECT)
+    if(options.direct_io) {
+      __fd = ::open(path, O_RDONLY | O_DIRECT);
+      __direct = __fd >= 0;
+      if(__fd < 0 && errno != EINVAL) __throw_errno("cannot open", errno);
+    }
+#endif
+    if(__fd < 0) __fd = ::open(path, O_RDONLY);
+    if(__fd < 0) __throw_errno("cannot open", errno);
+    struct stat st;
+    if(::fstat(__fd, &st) != 0) {
+      int err = errno;
+      ::close(__fd);
+      __throw_errno("cannot stat", err);
+    }
+    if(size_t(st.st_size) < __file_offset + exts.extent(0) * __row_bytes()) {
+      ::close(__fd);
+      __throw_errno("file is smaller than the array in", EINVAL);
+    }
+
+    // room for a slab plus the widening of an O_DIRECT read on both sides
+    size_t alignment = __direct ? detail::__slab_alignment : 1;
+    size_t capacity = (slab_rows * __row_bytes() + 2 * alignment + detail::__slab_alignment - 1)
+      / detail::__slab_alignment * detail::__slab_alignment;
+    __buffers.resize(options.num_buffers);
+    for(auto& b : __buffers) {
+      b.data = static_cast<unsigned char*>(__aligned_alloc(capacity));
+      if(b.data == nullptr) {
+        __free_buffers();
+        ::close(__fd);
+        throw std::bad_alloc();
+      }
+    }
+
+    __backend = options.backend == slab_io_backend::automatic ? slab_io_backend::io_uring : options.backend;
+#if defined(_MDSPAN_HAS_IO_URING)
+    if(__backend == slab_io_backend::io_uring && !__ring.open(unsigned(__round_up_pow2(options.num_buffers)))) {
+      __backend = slab_io_backend::threads;
+    }
+#else
+    __backend = slab_io_backend::threads;
+#endif
+    if(__backend == slab_io_backend::threads) {
+      __io_thread = std::thread([this] { __thread_loop(); });
+    }
+  }
+
+  slab_reader(slab_reader const&) = delete;
+  slab_reader& operator=(slab_reader const&) = delete;
+
+  ~slab_reader() {
+    if(__io_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(__mutex);
+        __stop = true;
+      }
+      __cv.notify_all();
+      __io_thread.join();
+    }
+    __free_buffers();
+    ::close(__fd);
+  }
+
+  //--------------------------------------------------------------------------------
+
+  extents_type const& extents() const noexcept { return __extents; }
+  size_t slab_rows() const noexcept { return __slab_rows; }
+  size_t num_slabs() const noexcept { return (__extents.extent(0) + __slab_rows - 1) / __slab_rows; }
+  size_t num_buffers() const noexcept { return __buffers.size(); }
+  // The backend in use, never `automatic`
+  slab_io_backend backend() const noexcept { return __backend; }
+  // Whether the file is read with O_DIRECT
+  bool direct_io() const noexcept { return __direct; }
+
+  template <class F>
+  void for_each_slab(F&& f) {
+    size_t n = num_slabs();
+    size_t nb = __buffers.size();
+    size_t issued = 0;
+    try {
+      for(; issued < n && issued < nb; ++issued) __issue(issued, issued % nb);
+      for(size_t s = 0; s < n; ++s) {
+        size_t b = s % nb;
+        __complete(b);
+        auto& buf = __buffers[b];
+        f(slab_type(reinterpret_cast<element_type*>(buf.data + buf.lead), __slab_extents(buf.rows)), s * __slab_rows);
+        if(issued < n) __issue(issued++, b);
+      }
+    }
+    catch(...) {
+      // the buffers must not be reused while the kernel or the I/O thread
+      // may still write to them
+      for(size_t b = 0; b < nb; ++b) {
+        if(__buffers[b].in_flight) __complete(b, false);
+      }
+      throw;
+    }
+  }
+
+private:
+
+  enum __buffer_state { __idle, __pending, __done };
+
+  struct __buffer {
+    unsigned char* data = nullptr;
+    // the read: `want` bytes at `offset`, of which the slab's rows are the
+    // `need - lead` bytes from `lead` on
+    size_t rows = 0;
+    size_t lead = 0;
+    size_t need = 0;
+    size_t want = 0;
+    off_t offset = 0;
+    // owned by the I/O thread while `in_flight`, and guarded by the mutex
+    int state = __idle;
+    int error = 0;
+    // issued and not yet completed, as seen by the reading thread
+    bool in_flight = false;
+#if defined(_MDSPAN_HAS_IO_URING)
+    iovec iov;
+#endif
+  };
+
+  size_t __row_bytes() const noexcept { return __row_elements * sizeof(value_type); }
+
+  extents_type __slab_extents(size_t rows) const noexcept {
+    std::array<size_t, extents_type::rank_dynamic()> dyn = { };
+    size_t d = 0;
+    for(size_t r = 0; r < extents_type::rank(); ++r) {
+      if(extents_type::static_extent(r) == dynamic_extent) dyn[d++] = r == 0 ? rows : __extents.extent(r);
+    }
+    return extents_type(dyn);
+  }
+
+  static size_t __round_up_pow2(size_t n) noexcept {
+    size_t p = 1;
+    while(p < n) p *= 2;
+    return p;
+  }
+
+  static void* __aligned_alloc(size_t bytes) noexcept {
+    void* p = nullptr;
+    return ::posix_memalign(&p, detail::__slab_alignment, bytes) == 0 ? p : nullptr;
+  }
+
+  void __free_buffers() noexcept {
+    for(auto& b : __buffers) std::free(b.data);
+    __buffers.clear();
+  }
+
+  void __issue(size_t slab, size_t b) {
+    auto& buf = __buffers[b];
+    size_t first_row = slab * __slab_rows;
+    buf.rows = __extents.extent(0) - first_row < __slab_rows ? __extents.extent(0) - first_row : __slab_rows;
+    size_t begin = __file_offset + first_row * __row_bytes();
+    size_t alignment = __direct ? detail::__slab_alignment : 1;
+    size_t aligned_begin = begin / alignment * alignment;
+    buf.lead = begin - aligned_begin;
+    buf.need = buf.lead + buf.rows * __row_bytes();
+    buf.want = (buf.need + alignment - 1) / alignment * alignment;
+    buf.offset = off_t(aligned_begin);
+    buf.state = __pending;
+    buf.error = 0;
+    buf.in_flight = true;
+#if defined(_MDSPAN_HAS_IO_URING)
+    if(__backend == slab_io_backend::io_uring) {
+      buf.iov.iov_base = buf.data;
+      buf.iov.iov_len = buf.want;
+      int err = __ring.submit_readv(__fd, &buf.iov, buf.offset, b);
+      if(err != 0) {
+        buf.state = __idle;
+        buf.in_flight = false;
+        __throw_errno("cannot submit a read of", err);
+      }
+      return;
+    }
+#endif
+    {
+      std::lock_guard<std::mutex> lock(__mutex);
+      __queue.push_back(b);
+    }
+    __cv.notify_all();
+  }
+
+  // Waits until buffer b has been read
+  void __complete(size_t b, bool throw_on_error = true) {
+    auto& buf = __buffers[b];
+#if defined(_MDSPAN_HAS_IO_URING)
+    if(__backend == slab_io_backend::io_uring) {
+      while(buf.state == __pending) {
+        int res = 0;
+        uint64_t tag = __ring.wait(res);
+        if(tag >= __buffers.size()) {
+          // waiting itself failed; nothing more will complete
+          for(auto& other : __buffers) {
+            if(other.state == __pending) { other.state = __done; other.error = -res; }
+          }
+          break;
+        }
+        auto& done = __buffers[size_t(tag)];
+        done.state = __done;
+        if(res < 0) done.error = -res;
+        else if(size_t(res) < done.need) {
+          // short read: finish it synchronously
+          done.error = detail::__slab_pread(__fd, done.data + res, done.want - size_t(res),
+            done.need - size_t(res), done.offset + off_t(res));
+        }
+      }
+    }
+    else
+#endif
+    {
+      std::unique_lock<std::mutex> lock(__mutex);
+      __cv.wait(lock, [&] { return buf.state != __pending; });
+    }
+    buf.state = __idle;
+    buf.in_flight = false;
+    if(buf.error != 0 && throw_on_error) __throw_errno("cannot read", buf.error);
+  }
+
+  void __thread_loop() {
+    std::unique_lock<std::mutex> lock(__mutex);
+    for(;;) {
+      __cv.wait(lock, [this] { return __stop || !__queue.empty(); });
+      if(__stop) return;
+      size_t b = __queue.front();
+      __queue.pop_front();
+      auto& buf = __buffers[b];
+      lock.unlock();
+      int err = detail::__slab_pread(__fd, buf.data, buf.want, buf.need, buf.offset);
+      lock.lock();
+      buf.error = err;
+      buf.state = __done;
+      __cv.notify_all();
+    }
+  }
+
+  [[noreturn]] void __throw_errno(char const* what, int err) const {
+    throw std::system_error(err, std::generic_category(), std::string("slab reader: ") + what + " " + __path);
+  }
+
+  std::string __path;
+  extents_type __extents;
+  size_t __slab_rows = 0;
+  size_t __row_elements = 0;
+  size_t __file_offset = 0;
+  int __fd = -1;
+  bool __direct = false;
+  slab_io_backend __backend = slab_io_backend::threads;
+  std::vector<__buffer> __buffers;
+
+#if defined(_MDSPAN_HAS_IO_URING)
+  detail::__io_uring_queue __ring;
+#endif
+
+  std::mutex __mutex;
+  std::condition_variable __cv;
+  std::deque<size_t> __queue;
+  bool __stop = false;
+  std::thread __io_thread;
+};
+
+#endif // defined(_MDSPAN_HAS_PREAD)
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,344 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "execution_policy.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_left.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Tile extents for apply_stencil along the two dimensions that are not
+// streamed through: `inner` along the last dimension (the first for
+// layout_left) and `middle` along the second.  Zero lets apply_stencil pick
+// the extent.
+struct stencil_tiling {
+  size_t middle = 0;
+  size_t inner = 0;
+};
+
+namespace detail {
+
+// Budget for the planes one thread keeps for a tile
+_MDSPAN_INLINE_VARIABLE constexpr size_t __stencil_cache_bytes = 1024 * 1024;
+// Tiles cover whole rows up to this extent, which avoids recomputing halos
+// along the innermost dimension
+_MDSPAN_INLINE_VARIABLE constexpr size_t __stencil_max_inner_tile = 1024;
+
+// The dimensions in the order apply_stencil walks them: planes are streamed
+// along `stream`, and stored with `inner` contiguous
+template <class Layout>
+struct __stencil_dims {
+  static constexpr size_t stream = 0, middle = 1, inner = 2;
+};
+
+template <>
+struct __stencil_dims<layout_left> {
+  static constexpr size_t stream = 2, middle = 1, inner = 0;
+};
+
+// What a kernel sees of the previous time step: s(d0, d1, d2) is the value at
+// offset (d0, d1, d2) from the point being updated
+template <class T, class Dims>
+struct __stencil_neighborhood {
+  MDSPAN_FORCE_INLINE_FUNCTION
+  T operator()(ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2) const noexcept {
+    ptrdiff_t const d[] = {d0, d1, d2};
+    return planes[d[Dims::stream]][offset + d[Dims::middle] * row_stride + d[Dims::inner]];
+  }
+
+  // the rows of the point in planes -radius .. radius, from the first
+  // column of the tile
+  T const* const* planes;
+  ptrdiff_t offset;
+  ptrdiff_t row_stride;
+};
+
+template <class Dims, class MDSpan>
+typename MDSpan::reference __stencil_at(MDSpan const& m, size_t p, size_t row, size_t col) {
+  size_t idx[3];
+  idx[Dims::stream] = p;
+  idx[Dims::middle] = row;
+  idx[Dims::inner] = col;
+  return m(idx[0], idx[1], idx[2]);
+}
+
+// Whether a grid can be read (written) in place by __stencil_tile: through
+// plain pointers to T, given a unit stride along the inner dimension
+template <class T, class MDSpan>
+struct __stencil_direct
+  : integral_constant<bool,
+      MDSpan::mapping_type::is_always_strided() &&
+      (_MDSPAN_TRAIT(is_same, typename MDSpan::accessor_type, default_accessor<T>) ||
+       _MDSPAN_TRAIT(is_same, typename MDSpan::accessor_type, default_accessor<T const>))>
+{ };
+
+template <class Dims, class MDSpan>
+bool __stencil_unit_inner_stride(MDSpan const& m, true_type /* direct */) {
+  return m.stride(Dims::inner) == 1;
+}
+
+template <class Dims, class MDSpan>
+bool __stencil_unit_inner_stride(MDSpan const&, false_type /* direct */) {
+  return false;
+}
+
+template <class Dims, class T, class MDSpan>
+auto __stencil_pointer(MDSpan const& m, size_t p, size_t row, size_t col, true_type /* direct */) {
+  return &__stencil_at<Dims>(m, p, row, col);
+}
+
+template <class Dims, class T, class MDSpan>
+T* __stencil_pointer(MDSpan const&, size_t, size_t, size_t, false_type /* direct */) {
+  return nullptr;
+}
+
+// Rings of 2 * radius + 1 planes for time levels 0 .. time_steps - 1 of a
+// tile, plus a row of the last level on its way to the output
+template <class T>
+struct __stencil_workspace {
+  __stencil_workspace(size_t levels, size_t ring, size_t plane)
+    : ring_size(ring), plane_size(plane), planes(levels * ring * plane), row(plane), neighbors(ring)
+  { }
+
+  T* plane(size_t level, size_t p) noexcept {
+    return planes.data() + (level * ring_size + p % ring_size) * plane_size;
+  }
+
+  size_t ring_size, plane_size;
+  std::vector<T> planes;
+  std::vector<T> row;
+  std::vector<T const*> neighbors;
+};
+
+// The range [lo, hi) of a tile [t0, t1) grown by `halo` on each side, within
+// [0, n)
+struct __stencil_range {
+  __stencil_range(size_t t0, size_t t1, size_t halo, size_t n)
+    : lo(t0 > halo ? t0 - halo : 0), hi(std::min(t1 + halo, n))
+  { }
+  size_t lo, hi;
+};
+
+// Advances the tile [row0, row1) x [col0, col1) by time_steps steps.  The
+// planes are a wavefront: at each step, level t computes plane s - t * radius
+// from the planes of level t - 1 computed so far, so that every plane is read
+// from `in` and written to `out` once.  Level t covers the tile grown by
+// (time_steps - t) * radius, the part of it that the following levels need.
+// Level 0 is `in` itself and the last level is written straight to `out` when
+// they have a unit inner stride; otherwise they go through the rings.
+template <class Dims, class In, class Out, class Kernel, class T>
+void __stencil_tile(
+  In const& in, Out const& out, size_t radius, size_t time_steps, Kernel const& kernel,
+  size_t row0, size_t row1, size_t col0, size_t col1, __stencil_workspace<T>& ws)
+{
+  size_t const n_stream = in.extent(Dims::stream);
+  size_t const n_rows = in.extent(Dims::middle);
+  size_t const n_cols = in.extent(Dims::inner);
+  bool const in_direct = __stencil_unit_inner_stride<Dims>(in, __stencil_direct<T, In>());
+  bool const out_direct = __stencil_unit_inner_stride<Dims>(out, __stencil_direct<T, Out>());
+  __stencil_range const rows0(row0, row1, time_steps * radius, n_rows);
+  __stencil_range const cols0(col0, col1, time_steps * radius, n_cols);
+  size_t const ring_stride = cols0.hi - cols0.lo;
+  // columns [col_lo, col_hi) have all their neighbors
+  size_t const col_lo = radius, col_hi = n_cols > radius ? n_cols - radius : 0;
+
+  // row r of plane p of level t, from column cols0.lo
+  auto level_row = [&](size_t t, size_t p, size_t r) -> T const* {
+    if(t == 0 && in_direct) return __stencil_pointer<Dims, T>(in, p, r, cols0.lo, __stencil_direct<T, In>());
+    return ws.plane(t, p) + (r - rows0.lo) * ring_stride;
+  };
+
+  for(size_t s = 0; s < n_stream + time_steps * radius; ++s) {
+    for(size_t t = 0; t <= time_steps && t * radius <= s; ++t) {
+      size_t const p = s - t * radius;
+      if(p >= n_stream) continue;
+      __stencil_range const rows(row0, row1, (time_steps - t) * radius, n_rows);
+      __stencil_range const cols(col0, col1, (time_steps - t) * radius, n_cols);
+
+      if(t == 0) {
+        if(time_steps == 0) {
+          for(size_t r = rows.lo; r < rows.hi; ++r)
+            for(size_t c = cols.lo; c < cols.hi; ++c) __stencil_at<Dims>(out, p, r, c) = __stencil_at<Dims>(in, p, r, c);
+        }
+        else if(!in_direct) {
+          for(size_t r = rows.lo; r < rows.hi; ++r) {
+            T* dst = ws.plane(0, p) + (r - rows0.lo) * ring_stride;
+            for(size_t c = cols.lo; c < cols.hi; ++c) dst[c - cols0.lo] = T(__stencil_at<Dims>(in, p, r, c));
+          }
+        }
+        continue;
+      }
+
+      bool const fixed_plane = p < radius || p + radius >= n_stream;
+      __stencil_neighborhood<T, Dims> nb{ws.neighbors.data() + radius, 0,
+        t == 1 && in_direct ? ptrdiff_t(in.stride(Dims::middle)) : ptrdiff_t(ring_stride)};
+      size_t const k0 = cols.lo - cols0.lo, k1 = cols.hi - cols0.lo;
+      size_t const c_lo = std::min(std::max(cols.lo, col_lo), cols.hi);
+      size_t const c_hi = std::max(std::min(cols.hi, col_hi), c_lo);
+      size_t const kc0 = c_lo - cols0.lo, kc1 = c_hi - cols0.lo;
+
+      for(size_t r = rows.lo; r < rows.hi; ++r) {
+        T* dst = t < time_steps ? ws.plane(t, p) + (r - rows0.lo) * ring_stride
+          : out_direct ? __stencil_pointer<Dims, T>(out, p, r, cols0.lo, __stencil_direct<T, Out>()) : ws.row.data();
+        T const* src = level_row(t - 1, p, r);
+        if(fixed_plane || r < radius || r + radius >= n_rows) {
+          for(size_t k = k0; k < k1; ++k) dst[k] = src[k];
+        }
+        else {
+          for(size_t q = 0; q < ws.ring_size; ++q) ws.neighbors[q] = level_row(t - 1, p + q - radius, r);
+          for(size_t k = k0; k < kc0; ++k) dst[k] = src[k];
+          // a signed induction variable keeps the neighbor offsets affine,
+          // which the vectorizer needs
+          for(ptrdiff_t k = ptrdiff_t(kc0); k < ptrdiff_t(kc1); ++k) {
+            nb.offset = k;
+            dst[k] = T(kernel(nb));
+          }
+          for(size_t k = kc1; k < k1; ++k) dst[k] = src[k];
+        }
+        if(t == time_steps && !out_direct) {
+          for(size_t c = cols.lo; c < cols.hi; ++c) __stencil_at<Dims>(out, p, r, c) = dst[c - cols0.lo];
+        }
+      }
+    }
+  }
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// Advances a 3D grid by `time_steps` steps of a stencil: out = S^time_steps(in).
+//
+// `kernel(s)` returns the new value of a point, where s(d0, d1, d2) is the
+// value of the point at offset (d0, d1, d2) at the previous step, for offsets
+// of at most `radius` in each dimension.  The kernel should be a generic
+// lambda (or a function object with a templated call operator), since the type
+// of `s` is unspecified.  Points less than `radius` from an edge of the grid
+// keep their values.
+//
+// The grid is streamed through along its first dimension (its last for
+// layout_left) and cut into tiles along the other two.  Each tile is advanced
+// through all the time steps while its planes stream past: only
+// `2 * radius + 1` planes of each intermediate time level stay live, so they
+// remain in cache, and `in` and `out` are each traversed once however many
+// steps are taken.  Tiles overlap
+// by `time_steps * radius` points on each side, where values are computed
+// redundantly; `tiling` overrides the tile extents chosen from a cache budget.
+// With execution::par, the tiles are split over the OpenMP threads.  `in` and
+// `out` must have the same extents and must not overlap; for more steps,
+// call again with `in` and `out` swapped.
+template <
+  class ExecutionPolicy,
+  class ElementTypeIn, class ExtentsIn, class LayoutIn, class AccessorIn,
+  class ElementTypeOut, class ExtentsOut, class LayoutOut, class AccessorOut,
+  class Kernel
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+apply_stencil(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeIn, ExtentsIn, LayoutIn, AccessorIn> in,
+  mdspan<ElementTypeOut, ExtentsOut, LayoutOut, AccessorOut> out,
+  size_t radius, size_t time_steps, Kernel const& kernel, stencil_tiling tiling = { })
+{
+  static_assert(ExtentsIn::rank() == 3 && ExtentsOut::rank() == 3,
+    "std::experimental::apply_stencil requires rank 3 grids");
+  using value_type = typename mdspan<ElementTypeOut, ExtentsOut, LayoutOut, AccessorOut>::value_type;
+  using dims = detail::__stencil_dims<LayoutIn>;
+  size_t const n_rows = in.extent(dims::middle), n_cols = in.extent(dims::inner);
+  if(in.size() == 0) return;
+
+  size_t const halo = time_steps * radius;
+  size_t const ring = 2 * radius + 1;
+  size_t tile_cols = tiling.inner != 0 ? tiling.inner
+    : n_cols <= detail::__stencil_max_inner_tile ? n_cols : detail::__stencil_max_inner_tile / 2;
+  tile_cols = std::min(tile_cols, n_cols);
+  size_t tile_rows = tiling.middle;
+  if(tile_rows == 0) {
+    size_t plane_rows = detail::__stencil_cache_bytes
+      / (sizeof(value_type) * std::min(tile_cols + 2 * halo, n_cols) * std::max(time_steps, size_t(1)) * ring);
+    tile_rows = std::max({plane_rows > 2 * halo ? plane_rows - 2 * halo : 0, 2 * halo, size_t(8)});
+    // at least one tile per thread
+    size_t col_tiles = (n_cols + tile_cols - 1) / tile_cols;
+    size_t row_tiles = (detail::__max_threads(policy) + col_tiles - 1) / col_tiles;
+    tile_rows = std::min(tile_rows, std::max((n_rows + row_tiles - 1) / row_tiles, size_t(1)));
+  }
+  tile_rows = std::min(tile_rows, n_rows);
+  size_t const row_tiles = (n_rows + tile_rows - 1) / tile_rows;
+  size_t const col_tiles = (n_cols + tile_cols - 1) / tile_cols;
+  size_t const plane_size = std::min(tile_rows + 2 * halo, n_rows) * std::min(tile_cols + 2 * halo, n_cols);
+
+  detail::__on_each_thread(policy, [&](size_t thread, size_t num_threads) {
+    detail::__stencil_workspace<value_type> ws(std::max(time_steps, size_t(1)), ring, plane_size);
+    for(size_t tile = thread; tile < row_tiles * col_tiles; tile += num_threads) {
+      size_t const row0 = (tile / col_tiles) * tile_rows, col0 = (tile % col_tiles) * tile_cols;
+      detail::__stencil_tile<dims>(in, out, radius, time_steps, kernel,
+        row0, std::min(row0 + tile_rows, n_rows), col0, std::min(col0 + tile_cols, n_cols), ws);
+    }
+  });
+}
+
+template <
+  class ElementTypeIn, class ExtentsIn, class LayoutIn, class AccessorIn,
+  class ElementTypeOut, class ExtentsOut, class LayoutOut, class AccessorOut,
+  class Kernel
+>
+void apply_stencil(
+  mdspan<ElementTypeIn, ExtentsIn, LayoutIn, AccessorIn> in,
+  mdspan<ElementTypeOut, ExtentsOut, LayoutOut, AccessorOut> out,
+  size_t radius, size_t time_steps, Kernel const& kernel, stencil_tiling tiling = { })
+{
+  apply_stencil(execution::seq, in, out, radius, time_steps, kernel, tiling);
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,214 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "execution_policy.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_stride.hpp"
+#include "../__p0009_bits/extents.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Static extents of the tiles produced by `tiles`
+template <size_t... TileExtents>
+struct tile_extents {
+  static_assert(_MDSPAN_FOLD_AND((TileExtents != dynamic_extent && TileExtents > 0) /* && ... */),
+    "std::experimental::tile_extents requires static, positive extents");
+
+  using extents_type = extents<TileExtents...>;
+
+  MDSPAN_INLINE_FUNCTION static constexpr size_t rank() noexcept { return sizeof...(TileExtents); }
+};
+
+// The tiles of a strided mdspan, visited with `for_each`.
+//
+// Tiles start at multiples of the tile extents.  A full tile is passed to the
+// callback as an mdspan of `extents<TileExtents...>`, so loops over it have
+// static trip counts and unroll; a tile cut short by the end of a dimension
+// is passed with dynamic extents instead.  Both are layout_stride views of
+// the same elements as the parent.  The tiles are visited with the index of
+// the dimension with the smallest stride varying fastest, then that of the
+// dimension with the next smallest, and so on, as given by the parent's
+// strides at run time (so the first for layout_left and column-major
+// layout_stride views, and the last for layout_right); with execution::par
+// each OpenMP thread visits a contiguous run of them.
+template <class MDSpan, class TileExtents>
+class tile_range;
+
+template <class ElementType, class Extents, class Layout, class Accessor, size_t... TileExtents>
+class tile_range<mdspan<ElementType, Extents, Layout, Accessor>, tile_extents<TileExtents...>> {
+public:
+
+  using mdspan_type = mdspan<ElementType, Extents, Layout, Accessor>;
+  using size_type = size_t;
+  using origin_type = array<size_t, Extents::rank()>;
+  using full_tile_type = mdspan<ElementType, extents<TileExtents...>, layout_stride, typename Accessor::offset_policy>;
+  using partial_tile_type = mdspan<ElementType, dextents<Extents::rank()>, layout_stride, typename Accessor::offset_policy>;
+
+  static_assert(sizeof...(TileExtents) == Extents::rank(),
+    "std::experimental::tiles requires tile extents of the same rank as the mdspan");
+  static_assert(mdspan_type::mapping_type::is_always_strided(),
+    "std::experimental::tiles requires a strided layout");
+
+  explicit tile_range(mdspan_type const& m) : __m(m) { }
+
+  // Number of tiles along dimension r
+  size_type extent(size_t r) const noexcept {
+    return (size_t(__m.extent(r)) + __tile_extent(r) - 1) / __tile_extent(r);
+  }
+
+  size_type size() const noexcept {
+    size_type n = 1;
+    for(size_t r = 0; r < Extents::rank(); ++r) n *= extent(r);
+    return n;
+  }
+
+  // Calls f(tile, origin) for every tile, where `origin` is the index in the
+  // parent mdspan of the tile's first element
+  template <class F>
+  void for_each(F&& f) const {
+    __for_each(0, size(), f);
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class ExecutionPolicy, class F,
+    /* requires */ (
+      execution::is_execution_policy<ExecutionPolicy>::value
+    )
+  )
+  void for_each(ExecutionPolicy policy, F&& f) const {
+    size_type const n = size();
+    detail::__on_each_thread(policy, [&](size_t t, size_t nt) {
+      __for_each(n * t / nt, n * (t + 1) / nt, f);
+    });
+  }
+
+  bool is_full(origin_type const& origin) const noexcept {
+    for(size_t r = 0; r < Extents::rank(); ++r) {
+      if(origin[r] + __tile_extent(r) > size_t(__m.extent(r))) return false;
+    }
+    return true;
+  }
+
+  full_tile_type full_tile(origin_type const& origin) const {
+    return __full_tile(origin, make_index_sequence<Extents::rank()>());
+  }
+
+  partial_tile_type partial_tile(origin_type const& origin) const {
+    return __partial_tile(origin, make_index_sequence<Extents::rank()>());
+  }
+
+private:
+
+  static constexpr size_t __tile_extent(size_t r) noexcept {
+    return extents<TileExtents...>::static_extent(r);
+  }
+
+  // The dimensions in visiting order, fastest first: by increasing stride,
+  // ties going to the later dimension
+  array<size_t, Extents::rank()> __visiting_order() const {
+    array<size_t, Extents::rank()> order;
+    for(size_t i = 0; i < Extents::rank(); ++i) order[i] = Extents::rank() - 1 - i;
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return size_t(__m.stride(a)) < size_t(__m.stride(b));
+    });
+    return order;
+  }
+
+  template <class F>
+  void __for_each(size_type first, size_type last, F& f) const {
+    auto const order = __visiting_order();
+    for(size_type q = first; q < last; ++q) {
+      origin_type origin;
+      size_type rest = q;
+      for(size_t i = 0; i < Extents::rank(); ++i) {
+        size_t r = order[i];
+        origin[r] = (rest % extent(r)) * __tile_extent(r);
+        rest /= extent(r);
+      }
+      if(is_full(origin)) f(full_tile(origin), origin);
+      else f(partial_tile(origin), origin);
+    }
+  }
+
+  template <size_t... Idxs>
+  full_tile_type __full_tile(origin_type const& origin, index_sequence<Idxs...>) const {
+    return full_tile_type(
+      __m.accessor().offset(__m.data(), __m.mapping()(origin[Idxs]...)),
+      typename full_tile_type::mapping_type(extents<TileExtents...>(), dextents<Extents::rank()>(size_t(__m.stride(Idxs))...)),
+      typename full_tile_type::accessor_type(__m.accessor())
+    );
+  }
+
+  template <size_t... Idxs>
+  partial_tile_type __partial_tile(origin_type const& origin, index_sequence<Idxs...>) const {
+    return partial_tile_type(
+      __m.accessor().offset(__m.data(), __m.mapping()(origin[Idxs]...)),
+      typename partial_tile_type::mapping_type(
+        dextents<Extents::rank()>(std::min(__tile_extent(Idxs), size_t(__m.extent(Idxs)) - origin[Idxs])...),
+        dextents<Extents::rank()>(size_t(__m.stride(Idxs))...)),
+      typename partial_tile_type::accessor_type(__m.accessor())
+    );
+  }
+
+  mdspan_type __m;
+};
+
+template <class ElementType, class Extents, class Layout, class Accessor, size_t... TileExtents>
+tile_range<mdspan<ElementType, Extents, Layout, Accessor>, tile_extents<TileExtents...>>
+tiles(mdspan<ElementType, Extents, Layout, Accessor> const& m, tile_extents<TileExtents...>) {
+  return tile_range<mdspan<ElementType, Extents, Layout, Accessor>, tile_extents<TileExtents...>>(m);
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -156,7 +156,8 @@ public:
 
   MDSPAN_INLINE_FUNCTION
   constexpr size_t get_stride(size_t n) const noexcept {
-    return _MDSPAN_FOLD_TIMES_RIGHT(
+    // `n` is unused for rank 0
+    return (void)n, _MDSPAN_FOLD_TIMES_RIGHT(
       (IdxConditional{}(Idxs, n) ? __extents().template __extent<Idxs>() : 1),
         /* * ... * */ 1
     );
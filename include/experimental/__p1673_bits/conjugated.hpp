@@ -0,0 +1,174 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// std::conj of a real number returns a complex number, so only call it on
+// complex numbers
+template <class T>
+MDSPAN_INLINE_FUNCTION
+constexpr T __conj_if_needed(T const& t) noexcept { return t; }
+
+template <class T>
+MDSPAN_INLINE_FUNCTION
+_MDSPAN_CONSTEXPR_14 complex<T> __conj_if_needed(complex<T> const& t) noexcept { return complex<T>(t.real(), -t.imag()); }
+
+} // end namespace detail
+
+//==============================================================================
+
+// Accessor that returns the complex conjugate of every element read through
+// `NestedAccessor`
+template <class NestedAccessor>
+class conjugated_accessor {
+public:
+
+  using element_type = add_const_t<decltype(
+    detail::__conj_if_needed(declval<remove_cv_t<typename NestedAccessor::element_type>>())
+  )>;
+  using reference = remove_const_t<element_type>;
+  using pointer = typename NestedAccessor::pointer;
+  using offset_policy = conjugated_accessor<typename NestedAccessor::offset_policy>;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr conjugated_accessor() noexcept = default;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr explicit conjugated_accessor(NestedAccessor const& a) noexcept
+    : __nested_accessor(a)
+  { }
+
+  // Needed for offset_policy, i.e., for submdspan of conjugated views
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherNestedAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherNestedAccessor, NestedAccessor)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr conjugated_accessor(conjugated_accessor<OtherNestedAccessor> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : __nested_accessor(other.nested_accessor())
+  { }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr typename offset_policy::pointer offset(pointer p, size_t i) const noexcept {
+    return __nested_accessor.offset(p, i);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return detail::__conj_if_needed(reference(__nested_accessor.access(p, i)));
+  }
+
+  MDSPAN_INLINE_FUNCTION constexpr NestedAccessor nested_accessor() const noexcept { return __nested_accessor; }
+
+private:
+
+  NestedAccessor __nested_accessor = { };
+
+};
+
+//==============================================================================
+
+namespace detail {
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<ElementType, Extents, Layout, Accessor>
+__conjugated_impl(true_type /* is_arithmetic */, mdspan<ElementType, Extents, Layout, Accessor> const& x)
+{
+  return x;
+}
+
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<
+  typename conjugated_accessor<Accessor>::element_type,
+  Extents, Layout, conjugated_accessor<Accessor>
+>
+__conjugated_impl(false_type /* is_arithmetic */, mdspan<ElementType, Extents, Layout, Accessor> const& x)
+{
+  using accessor_type = conjugated_accessor<Accessor>;
+  return mdspan<typename accessor_type::element_type, Extents, Layout, accessor_type>(
+    x.data(), x.mapping(), accessor_type(x.accessor())
+  );
+}
+
+} // end namespace detail
+
+// Read-only view of the complex conjugate of x.  Conjugating a real-valued
+// mdspan returns it unchanged, and conjugating a conjugated view returns the
+// original view.
+template <class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr auto conjugated(mdspan<ElementType, Extents, Layout, Accessor> const& x)
+  -> decltype(detail::__conjugated_impl(is_arithmetic<remove_cv_t<ElementType>>{}, x))
+{
+  return detail::__conjugated_impl(is_arithmetic<remove_cv_t<ElementType>>{}, x);
+}
+
+template <class ElementType, class Extents, class Layout, class NestedAccessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<typename NestedAccessor::element_type, Extents, Layout, NestedAccessor>
+conjugated(mdspan<ElementType, Extents, Layout, conjugated_accessor<NestedAccessor>> const& x)
+{
+  return mdspan<typename NestedAccessor::element_type, Extents, Layout, NestedAccessor>(
+    x.data(), x.mapping(), x.accessor().nested_accessor()
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
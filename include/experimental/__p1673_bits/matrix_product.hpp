@@ -0,0 +1,528 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__ext_bits/execution_policy.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// The widest vector registers the translation unit is compiled for, and how
+// many of them there are.  The register tile of the micro-kernel is sized
+// from these.
+#if defined(__AVX512F__)
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_vector_bytes = 64;
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_vector_registers = 32;
+#elif defined(__AVX__)
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_vector_bytes = 32;
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_vector_registers = 16;
+#else
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_vector_bytes = 16;
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_vector_registers = 16;
+#endif
+
+// With GCC-compatible compilers on x86, the micro-kernel is also compiled
+// for AVX2 and for AVX-512, whatever the translation unit targets, and the
+// widest the processor supports is picked at run time
+#if defined(__GNUC__) && !defined(__CUDACC__) && (defined(__x86_64__) || defined(__i386__))
+#  define _MDSPAN_GEMM_MULTIVERSIONING 1
+#else
+#  define _MDSPAN_GEMM_MULTIVERSIONING 0
+#endif
+
+// The instruction sets a micro-kernel can be compiled for; `native` is the
+// one the translation unit is compiled for
+enum class __gemm_isa { native, avx2, avx512 };
+
+template <__gemm_isa ISA>
+struct __gemm_isa_traits {
+  static constexpr size_t vector_bytes = __gemm_vector_bytes;
+  static constexpr size_t vector_registers = __gemm_vector_registers;
+};
+
+template <>
+struct __gemm_isa_traits<__gemm_isa::avx2> {
+  static constexpr size_t vector_bytes = 32;
+  static constexpr size_t vector_registers = 16;
+};
+
+template <>
+struct __gemm_isa_traits<__gemm_isa::avx512> {
+  static constexpr size_t vector_bytes = 64;
+  static constexpr size_t vector_registers = 32;
+};
+
+// Whether this processor can run the micro-kernel compiled for `isa`
+inline bool __gemm_isa_supported(__gemm_isa isa) {
+  switch(isa) {
+    case __gemm_isa::native: return true;
+#if _MDSPAN_GEMM_MULTIVERSIONING
+    case __gemm_isa::avx2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case __gemm_isa::avx512:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default: return false;
+  }
+}
+
+// The widest instruction set this processor supports, looked up once
+inline __gemm_isa __gemm_best_isa() {
+  static __gemm_isa const best =
+    __gemm_isa_supported(__gemm_isa::avx512) ? __gemm_isa::avx512 :
+    __gemm_isa_supported(__gemm_isa::avx2) ? __gemm_isa::avx2 :
+    __gemm_isa::native;
+  return best;
+}
+
+// Blocking of C = A * B (after Goto and van de Geijn):
+//
+// - the micro-kernel keeps an mr x nr tile of C in registers, nr being two
+//   vectors wide, and takes nearly all the vector registers for it, leaving
+//   two for a row of B and one for a broadcast element of A;
+// - a kc x nr micro-panel of B stays in L1 while it is multiplied by every
+//   mr x kc micro-panel of an mc x kc block of A, which stays in L2;
+// - a kc x nc panel of B stays in L3 while it is multiplied by every block
+//   of A.
+template <class T, __gemm_isa ISA = __gemm_isa::native>
+struct __gemm_blocking {
+  static constexpr size_t vector_bytes = __gemm_isa_traits<ISA>::vector_bytes;
+  static constexpr size_t vector_size = sizeof(T) < vector_bytes ? vector_bytes / sizeof(T) : 1;
+  static constexpr size_t nr = 2 * vector_size;
+  static constexpr size_t mr = (__gemm_isa_traits<ISA>::vector_registers - 4) / 2;
+  static constexpr size_t kc = 256;
+  static constexpr size_t mc = (256 * 1024 / (kc * sizeof(T))) / mr * mr > mr ? (256 * 1024 / (kc * sizeof(T))) / mr * mr : mr;
+  static constexpr size_t nc = (4 * 1024 * 1024 / (kc * sizeof(T))) / nr * nr > nr ? (4 * 1024 * 1024 / (kc * sizeof(T))) / nr * nr : nr;
+};
+
+// Whether extent R1 of Extents1 and extent R2 of Extents2 can be equal,
+// i.e., are not both static and different
+template <class Extents1, size_t R1, class Extents2, size_t R2>
+struct __static_extents_match : integral_constant<bool,
+  Extents1::static_extent(R1) == dynamic_extent || Extents2::static_extent(R2) == dynamic_extent ||
+  Extents1::static_extent(R1) == Extents2::static_extent(R2)
+> { };
+
+// Products with fewer multiply-adds than this skip the packing
+_MDSPAN_INLINE_VARIABLE constexpr size_t __gemm_small_product = 32 * 32 * 32;
+
+//------------------------------------------------------------------------------
+
+// Element access to an operand: straight through the accessor and the
+// strides for strided layouts (layout_left, layout_right, layout_stride and
+// submdspans of them), through operator() for the others
+template <class MDSpan, bool Strided = MDSpan::mapping_type::is_always_strided()>
+struct __matrix_operand {
+  explicit __matrix_operand(MDSpan const& m)
+    : acc(m.accessor()), p(m.data()), s0(size_t(m.stride(0))), s1(size_t(m.stride(1)))
+  { }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  typename MDSpan::reference operator()(size_t i, size_t j) const { return acc.access(p, i * s0 + j * s1); }
+  // whether consecutive elements of a row (column) are adjacent
+  bool row_unit_stride() const noexcept { return s1 == 1; }
+  bool column_unit_stride() const noexcept { return s0 == 1; }
+
+  typename MDSpan::accessor_type acc;
+  typename MDSpan::pointer p;
+  size_t s0, s1;
+};
+
+template <class MDSpan>
+struct __matrix_operand<MDSpan, false> {
+  explicit __matrix_operand(MDSpan const& m) : m(m) { }
+  MDSPAN_FORCE_INLINE_FUNCTION
+  typename MDSpan::reference operator()(size_t i, size_t j) const { return m(i, j); }
+  bool row_unit_stride() const noexcept { return true; }
+  bool column_unit_stride() const noexcept { return false; }
+
+  MDSpan m;
+};
+
+// Copies rows [i0, i0 + mc) and columns [p0, p0 + kc) of A into micro-panels
+// of mr rows, each stored with the mr elements of a column adjacent, and the
+// rows of the last one past the end of A zero
+template <size_t MR, class T, class OperandA>
+void __gemm_pack_a(T* dst, OperandA const& A, size_t i0, size_t mc, size_t p0, size_t kc) {
+  for(size_t ir = 0; ir < mc; ir += MR, dst += MR * kc) {
+    size_t rows = std::min(MR, mc - ir);
+    if(A.row_unit_stride()) {
+      for(size_t i = 0; i < rows; ++i) {
+        for(size_t p = 0; p < kc; ++p) dst[p * MR + i] = T(A(i0 + ir + i, p0 + p));
+      }
+    }
+    else {
+      for(size_t p = 0; p < kc; ++p) {
+        for(size_t i = 0; i < rows; ++i) dst[p * MR + i] = T(A(i0 + ir + i, p0 + p));
+      }
+    }
+    for(size_t p = 0; p < kc; ++p) {
+      for(size_t i = rows; i < MR; ++i) dst[p * MR + i] = T();
+    }
+  }
+}
+
+// Copies rows [p0, p0 + kc) and columns [j0, j0 + nc) of B into micro-panels
+// of nr columns, each stored with the nr elements of a row adjacent, and the
+// columns of the last one past the end of B zero
+template <size_t NR, class T, class OperandB>
+void __gemm_pack_b(T* dst, OperandB const& B, size_t p0, size_t kc, size_t j0, size_t nc) {
+  for(size_t jr = 0; jr < nc; jr += NR, dst += NR * kc) {
+    size_t cols = std::min(NR, nc - jr);
+    if(B.column_unit_stride()) {
+      for(size_t j = 0; j < cols; ++j) {
+        for(size_t p = 0; p < kc; ++p) dst[p * NR + j] = T(B(p0 + p, j0 + jr + j));
+      }
+    }
+    else {
+      for(size_t p = 0; p < kc; ++p) {
+        for(size_t j = 0; j < cols; ++j) dst[p * NR + j] = T(B(p0 + p, j0 + jr + j));
+      }
+    }
+    for(size_t p = 0; p < kc; ++p) {
+      for(size_t j = cols; j < NR; ++j) dst[p * NR + j] = T();
+    }
+  }
+}
+
+// tile = a * b for an mr x kc micro-panel a of A and a kc x nr micro-panel b
+// of B, with the mr x nr tile stored by rows
+template <size_t MR, size_t NR, class T>
+void __gemm_scalar_micro_kernel(size_t kc, T const* a, T const* b, T* tile) {
+  T acc[MR][NR] = { };
+  for(size_t p = 0; p < kc; ++p, a += MR, b += NR) {
+    for(size_t i = 0; i < MR; ++i) {
+      for(size_t j = 0; j < NR; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+  }
+  for(size_t i = 0; i < MR; ++i) {
+    for(size_t j = 0; j < NR; ++j) tile[i * NR + j] = acc[i][j];
+  }
+}
+
+#if defined(__GNUC__) && !defined(__CUDA_ARCH__)
+// The same with the tile held explicitly as MR x (NR / vector size) vector
+// registers.  Left to itself, the auto-vectorizer tends to vectorize the
+// loop over kc instead and shuffle the tile in and out of registers.
+// Always inlined, so that it takes the instruction set of its caller.
+template <size_t VectorBytes, size_t MR, size_t NR, class T>
+MDSPAN_FORCE_INLINE_FUNCTION
+inline void __gemm_vector_micro_kernel(size_t kc, T const* a, T const* b, T* tile) {
+  typedef T vector_type __attribute__((vector_size(VectorBytes)));
+  constexpr size_t vs = VectorBytes / sizeof(T);
+  constexpr size_t nv = NR / vs;
+  vector_type acc[MR][nv] = { };
+  for(size_t p = 0; p < kc; ++p, a += MR, b += NR) {
+    vector_type bv[nv];
+    for(size_t v = 0; v < nv; ++v) __builtin_memcpy(&bv[v], b + v * vs, sizeof(vector_type));
+    for(size_t i = 0; i < MR; ++i) {
+      for(size_t v = 0; v < nv; ++v) {
+        acc[i][v] += a[i] * bv[v];
+      }
+    }
+  }
+  for(size_t i = 0; i < MR; ++i) {
+    for(size_t v = 0; v < nv; ++v) __builtin_memcpy(tile + i * NR + v * vs, &acc[i][v], sizeof(vector_type));
+  }
+}
+
+// The vector micro-kernel compiled for each instruction set
+template <__gemm_isa ISA>
+struct __gemm_vector_kernel {
+  template <size_t MR, size_t NR, class T>
+  static void apply(size_t kc, T const* a, T const* b, T* tile) {
+    __gemm_vector_micro_kernel<__gemm_vector_bytes, MR, NR>(kc, a, b, tile);
+  }
+};
+
+#if _MDSPAN_GEMM_MULTIVERSIONING
+template <>
+struct __gemm_vector_kernel<__gemm_isa::avx2> {
+  template <size_t MR, size_t NR, class T>
+  __attribute__((target("avx2,fma")))
+  static void apply(size_t kc, T const* a, T const* b, T* tile) {
+    __gemm_vector_micro_kernel<32, MR, NR>(kc, a, b, tile);
+  }
+};
+
+template <>
+struct __gemm_vector_kernel<__gemm_isa::avx512> {
+  template <size_t MR, size_t NR, class T>
+  __attribute__((target("avx512f")))
+  static void apply(size_t kc, T const* a, T const* b, T* tile) {
+    __gemm_vector_micro_kernel<64, MR, NR>(kc, a, b, tile);
+  }
+};
+#endif
+
+template <__gemm_isa ISA, size_t MR, size_t NR, class T>
+inline void __gemm_micro_kernel(size_t kc, T const* a, T const* b, T* tile, true_type /* vectorizable */) {
+  __gemm_vector_kernel<ISA>::template apply<MR, NR>(kc, a, b, tile);
+}
+
+template <__gemm_isa ISA, size_t MR, size_t NR, class T>
+inline void __gemm_micro_kernel(size_t kc, T const* a, T const* b, T* tile, false_type /* vectorizable */) {
+  __gemm_scalar_micro_kernel<MR, NR>(kc, a, b, tile);
+}
+
+template <__gemm_isa ISA, size_t MR, size_t NR, class T>
+inline void __gemm_micro_kernel(size_t kc, T const* a, T const* b, T* tile) {
+  using vectorizable = integral_constant<bool, _MDSPAN_TRAIT(is_same, T, float) || _MDSPAN_TRAIT(is_same, T, double)>;
+  __gemm_micro_kernel<ISA, MR, NR>(kc, a, b, tile, vectorizable());
+}
+#else
+template <__gemm_isa ISA, size_t MR, size_t NR, class T>
+inline void __gemm_micro_kernel(size_t kc, T const* a, T const* b, T* tile) {
+  __gemm_scalar_micro_kernel<MR, NR>(kc, a, b, tile);
+}
+#endif
+
+// C(i0 : i0 + mc, j0 : j0 + nc) (+)= packed A block * packed B panel
+template <__gemm_isa ISA, size_t MR, size_t NR, class T, class OperandC>
+void __gemm_macro_kernel(
+  OperandC const& C, size_t i0, size_t mc, size_t j0, size_t nc, size_t kc,
+  T const* a, T const* b, bool accumulate
+) {
+  T tile[MR * NR];
+  for(size_t jr = 0; jr < nc; jr += NR) {
+    size_t cols = std::min(NR, nc - jr);
+    for(size_t ir = 0; ir < mc; ir += MR) {
+      size_t rows = std::min(MR, mc - ir);
+      __gemm_micro_kernel<ISA, MR, NR>(kc, a + ir * kc, b + jr * kc, tile);
+      for(size_t i = 0; i < rows; ++i) {
+        for(size_t j = 0; j < cols; ++j) {
+          if(accumulate) C(i0 + ir + i, j0 + jr + j) += tile[i * NR + j];
+          else C(i0 + ir + i, j0 + jr + j) = tile[i * NR + j];
+        }
+      }
+    }
+  }
+}
+
+// Rows [m0, m1) and columns [n0, n1) of C = A * B
+template <class T, __gemm_isa ISA, class OperandA, class OperandB, class OperandC>
+void __gemm_block(
+  OperandA const& A, OperandB const& B, OperandC const& C,
+  size_t m0, size_t m1, size_t n0, size_t n1, size_t k
+) {
+  using blocking = __gemm_blocking<T, ISA>;
+  constexpr size_t mr = blocking::mr, nr = blocking::nr;
+  if(m0 >= m1 || n0 >= n1) return;
+  std::vector<T> a_pack(std::min(blocking::mc, m1 - m0 + mr) * blocking::kc);
+  std::vector<T> b_pack(std::min(blocking::nc, n1 - n0 + nr) * blocking::kc);
+  for(size_t jc = n0; jc < n1; jc += blocking::nc) {
+    size_t nc = std::min(blocking::nc, n1 - jc);
+    for(size_t pc = 0; pc < k; pc += blocking::kc) {
+      size_t kc = std::min(blocking::kc, k - pc);
+      __gemm_pack_b<nr>(b_pack.data(), B, pc, kc, jc, nc);
+      for(size_t ic = m0; ic < m1; ic += blocking::mc) {
+        size_t mc = std::min(blocking::mc, m1 - ic);
+        __gemm_pack_a<mr>(a_pack.data(), A, ic, mc, pc, kc);
+        __gemm_macro_kernel<ISA, mr, nr>(C, ic, mc, jc, nc, kc, a_pack.data(), b_pack.data(), pc > 0);
+      }
+    }
+  }
+}
+
+// The threads as a grid_rows x (num_threads / grid_rows) grid over C, with
+// blocks as close to square as the divisors of num_threads allow
+inline size_t __gemm_grid_rows(size_t num_threads, size_t m, size_t n) {
+  size_t best = 1;
+  double best_ratio = 0;
+  for(size_t rows = 1; rows <= num_threads; ++rows) {
+    if(num_threads % rows != 0) continue;
+    double h = double(m) / double(rows), w = double(n) / double(num_threads / rows);
+    double ratio = h < w ? h / w : w / h;
+    if(ratio > best_ratio) {
+      best = rows;
+      best_ratio = ratio;
+    }
+  }
+  return best;
+}
+
+template <__gemm_isa ISA, class ExecutionPolicy, class OperandA, class OperandB, class OperandC, class T>
+void __gemm_blocked(
+  ExecutionPolicy policy, OperandA const& A, OperandB const& B, OperandC const& C,
+  size_t m, size_t n, size_t k, T
+) {
+  using blocking = __gemm_blocking<T, ISA>;
+  // each thread computes its own block of C, packing the parts of A and B it
+  // needs; blocks start on register tile boundaries
+  __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+    size_t grid_rows = __gemm_grid_rows(num_threads, m, n);
+    size_t grid_cols = num_threads / grid_rows;
+    size_t row_tiles = (m + blocking::mr - 1) / blocking::mr;
+    size_t col_tiles = (n + blocking::nr - 1) / blocking::nr;
+    size_t ti = t / grid_cols, tj = t % grid_cols;
+    __gemm_block<T, ISA>(A, B, C,
+      std::min(m, row_tiles * ti / grid_rows * blocking::mr),
+      std::min(m, row_tiles * (ti + 1) / grid_rows * blocking::mr),
+      std::min(n, col_tiles * tj / grid_cols * blocking::nr),
+      std::min(n, col_tiles * (tj + 1) / grid_cols * blocking::nr),
+      k);
+  });
+}
+
+template <class ExecutionPolicy, class OperandA, class OperandB, class OperandC, class T>
+void __gemm_blocked(
+  __gemm_isa isa, ExecutionPolicy policy, OperandA const& A, OperandB const& B, OperandC const& C,
+  size_t m, size_t n, size_t k, T, true_type /* vectorizable */
+) {
+  switch(isa) {
+#if _MDSPAN_GEMM_MULTIVERSIONING
+    case __gemm_isa::avx512: __gemm_blocked<__gemm_isa::avx512>(policy, A, B, C, m, n, k, T()); break;
+    case __gemm_isa::avx2: __gemm_blocked<__gemm_isa::avx2>(policy, A, B, C, m, n, k, T()); break;
+#endif
+    default: __gemm_blocked<__gemm_isa::native>(policy, A, B, C, m, n, k, T()); break;
+  }
+}
+
+template <class ExecutionPolicy, class OperandA, class OperandB, class OperandC, class T>
+void __gemm_blocked(
+  __gemm_isa, ExecutionPolicy policy, OperandA const& A, OperandB const& B, OperandC const& C,
+  size_t m, size_t n, size_t k, T, false_type /* vectorizable */
+) {
+  __gemm_blocked<__gemm_isa::native>(policy, A, B, C, m, n, k, T());
+}
+
+// C = A * B with the micro-kernel compiled for `isa`, which the processor
+// must support
+template <class ExecutionPolicy, class OperandA, class OperandB, class OperandC, class T>
+void __matrix_product(
+  ExecutionPolicy policy, OperandA const& A, OperandB const& B, OperandC const& C,
+  size_t m, size_t n, size_t k, T, __gemm_isa isa = __gemm_best_isa()
+) {
+  if(m == 0 || n == 0) return;
+  if(k == 0 || m * n * k < __gemm_small_product) {
+    for(size_t i = 0; i < m; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        T sum = T();
+        for(size_t p = 0; p < k; ++p) sum += T(A(i, p)) * T(B(p, j));
+        C(i, j) = sum;
+      }
+    }
+    return;
+  }
+  using vectorizable = integral_constant<bool, _MDSPAN_TRAIT(is_same, T, float) || _MDSPAN_TRAIT(is_same, T, double)>;
+  __gemm_blocked(isa, policy, A, B, C, m, n, k, T(), vectorizable());
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// C = A * B, for an m x k matrix A, a k x n matrix B and an m x n matrix C
+// that overlaps neither.  Extents that do not match fail a static_assert when
+// they are static, and an assert otherwise.
+//
+// Blocks of A and panels of B are packed (converted to C's value type) into
+// buffers laid out for the micro-kernel, which accumulates a tile of C in
+// vector registers; the tile shape follows the widest vector instructions
+// available.  With GCC-compatible compilers on x86, float and double
+// kernels for AVX2 and AVX-512 are compiled alongside the one for the
+// translation unit's own target, and the widest the processor supports is
+// used; elsewhere, the translation unit's target decides.  Packing
+// reads strided layouts directly in whichever order has unit stride, so
+// layout_left, layout_right and layout_stride operands, and views through
+// any accessor (e.g., scaled()), all reach the same kernel.  With
+// execution::par, every OpenMP thread computes its own block of C.
+template <
+  class ExecutionPolicy,
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeB, class ExtentsB, class LayoutB, class AccessorB,
+  class ElementTypeC, class ExtentsC, class LayoutC, class AccessorC
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+matrix_product(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeB, ExtentsB, LayoutB, AccessorB> B,
+  mdspan<ElementTypeC, ExtentsC, LayoutC, AccessorC> C
+)
+{
+  static_assert(ExtentsA::rank() == 2 && ExtentsB::rank() == 2 && ExtentsC::rank() == 2,
+    "std::experimental::matrix_product requires rank 2 operands");
+  static_assert(detail::__static_extents_match<ExtentsA, 0, ExtentsC, 0>::value &&
+    detail::__static_extents_match<ExtentsA, 1, ExtentsB, 0>::value &&
+    detail::__static_extents_match<ExtentsB, 1, ExtentsC, 1>::value,
+    "std::experimental::matrix_product requires an m x k A, a k x n B and an m x n C");
+  assert(A.extent(0) == C.extent(0) && A.extent(1) == B.extent(0) && B.extent(1) == C.extent(1));
+  using value_type = typename mdspan<ElementTypeC, ExtentsC, LayoutC, AccessorC>::value_type;
+  detail::__matrix_product(policy,
+    detail::__matrix_operand<decltype(A)>(A),
+    detail::__matrix_operand<decltype(B)>(B),
+    detail::__matrix_operand<decltype(C)>(C),
+    C.extent(0), C.extent(1), A.extent(1), value_type());
+}
+
+template <
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeB, class ExtentsB, class LayoutB, class AccessorB,
+  class ElementTypeC, class ExtentsC, class LayoutC, class AccessorC
+>
+void matrix_product(
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeB, ExtentsB, LayoutB, AccessorB> B,
+  mdspan<ElementTypeC, ExtentsC, LayoutC, AccessorC> C
+)
+{
+  matrix_product(execution::seq, A, B, C);
+}
+
+} // end namespace experimental
+} // end namespace std
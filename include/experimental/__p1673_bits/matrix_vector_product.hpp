@@ -0,0 +1,290 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "matrix_product.hpp"
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/default_accessor.hpp"
+#include "../__ext_bits/execution_policy.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+namespace detail {
+
+// Rows (for the dot product kernel) or columns (for the axpy kernel) of A
+// handled together, so that each load of x, or each load and store of y,
+// serves all of them
+_MDSPAN_INLINE_VARIABLE constexpr size_t __matvec_block = 4;
+
+// Elements of y kept in cache while the axpy kernel sweeps the columns of A
+_MDSPAN_INLINE_VARIABLE constexpr size_t __matvec_row_chunk = 2048;
+
+// Partial sums per row in the dot product kernel: two vector registers' worth
+template <class T>
+struct __matvec_lanes : integral_constant<size_t, 2 * __gemm_blocking<T>::vector_size> { };
+
+//------------------------------------------------------------------------------
+
+template <class T, class ElementType, class Extents, class Layout, class Accessor>
+T const* __copy_vector(mdspan<ElementType, Extents, Layout, Accessor> const& x, std::vector<T>& copy) {
+  copy.resize(x.extent(0));
+  for(size_t i = 0; i < copy.size(); ++i) copy[i] = T(x(i));
+  return copy.data();
+}
+
+template <class T, class ElementType, class Extents, class Layout, class Accessor>
+T const* __contiguous_vector(mdspan<ElementType, Extents, Layout, Accessor> const& x, std::vector<T>& copy, true_type /* direct */) {
+  if(x.extent(0) <= 1 || x.stride(0) == 1) return x.data();
+  return __copy_vector(x, copy);
+}
+
+template <class T, class ElementType, class Extents, class Layout, class Accessor>
+T const* __contiguous_vector(mdspan<ElementType, Extents, Layout, Accessor> const& x, std::vector<T>& copy, false_type /* direct */) {
+  return __copy_vector(x, copy);
+}
+
+template <class T, class ElementType, class Extents, class Layout, class Accessor>
+T* __contiguous_vector(mdspan<ElementType, Extents, Layout, Accessor> const& y, std::vector<T>& buffer, true_type /* direct */, bool /* output */) {
+  if(y.extent(0) <= 1 || y.stride(0) == 1) return y.data();
+  buffer.resize(y.extent(0));
+  return buffer.data();
+}
+
+template <class T, class ElementType, class Extents, class Layout, class Accessor>
+T* __contiguous_vector(mdspan<ElementType, Extents, Layout, Accessor> const& y, std::vector<T>& buffer, false_type /* direct */, bool /* output */) {
+  buffer.resize(y.extent(0));
+  return buffer.data();
+}
+
+// Whether the elements of a rank 1 mdspan can be used as an array of T in
+// place (given unit stride)
+template <class T, class ElementType, class Extents, class Layout, class Accessor>
+using __is_direct_vector = integral_constant<bool,
+  _MDSPAN_TRAIT(is_same, Accessor, default_accessor<ElementType>) &&
+  _MDSPAN_TRAIT(is_same, remove_cv_t<ElementType>, T) &&
+  Layout::template mapping<Extents>::is_always_strided()
+>;
+
+//------------------------------------------------------------------------------
+
+// y[r] = A(i + r, :) * x for R rows starting at `offset`, with several
+// partial sums per row, so that the loop over the row vectorizes despite the
+// order of floating-point additions
+template <size_t R, bool UnitStride, class T, class Accessor>
+void __matvec_dot_rows(
+  Accessor const& a, typename Accessor::pointer const& p, size_t offset,
+  size_t row_stride, size_t col_stride, size_t n, T const* x, T* y
+) {
+  constexpr size_t lanes = __matvec_lanes<T>::value;
+  size_t s = UnitStride ? 1 : col_stride;
+  T sum[R][lanes] = { };
+  size_t j = 0;
+  for(; j + lanes <= n; j += lanes) {
+    for(size_t r = 0; r < R; ++r) {
+      for(size_t l = 0; l < lanes; ++l) {
+        sum[r][l] += T(a.access(p, offset + r * row_stride + (j + l) * s)) * x[j + l];
+      }
+    }
+  }
+  for(; j < n; ++j) {
+    for(size_t r = 0; r < R; ++r) sum[r][0] += T(a.access(p, offset + r * row_stride + j * s)) * x[j];
+  }
+  for(size_t r = 0; r < R; ++r) {
+    for(size_t w = lanes / 2; w > 0; w /= 2) {
+      for(size_t l = 0; l < w; ++l) sum[r][l] += sum[r][l + w];
+    }
+    y[r] = sum[r][0];
+  }
+}
+
+// y[i] += A(i, j + c) * x[j + c] for C columns starting at `offset` and
+// rows [0, rows)
+template <size_t C, bool UnitStride, class T, class Accessor>
+void __matvec_axpy_columns(
+  Accessor const& a, typename Accessor::pointer const& p, size_t offset,
+  size_t row_stride, size_t col_stride, size_t rows, T const* x, T* y
+) {
+  size_t s = UnitStride ? 1 : row_stride;
+  T xs[C];
+  for(size_t c = 0; c < C; ++c) xs[c] = x[c];
+  for(size_t i = 0; i < rows; ++i) {
+    T acc = y[i];
+    for(size_t c = 0; c < C; ++c) acc += T(a.access(p, offset + i * s + c * col_stride)) * xs[c];
+    y[i] = acc;
+  }
+}
+
+// Rows [i0, i1) of y = A * x, walking each row of A
+template <class Operand, class T>
+void __matvec_by_rows(Operand const& A, size_t i0, size_t i1, size_t n, T const* x, T* y) {
+  constexpr size_t R = __matvec_block;
+  size_t i = i0;
+  for(; i + R <= i1; i += R) {
+    if(A.s1 == 1) __matvec_dot_rows<R, true>(A.acc, A.p, i * A.s0, A.s0, A.s1, n, x, y + i);
+    else __matvec_dot_rows<R, false>(A.acc, A.p, i * A.s0, A.s0, A.s1, n, x, y + i);
+  }
+  for(; i < i1; ++i) {
+    if(A.s1 == 1) __matvec_dot_rows<1, true>(A.acc, A.p, i * A.s0, A.s0, A.s1, n, x, y + i);
+    else __matvec_dot_rows<1, false>(A.acc, A.p, i * A.s0, A.s0, A.s1, n, x, y + i);
+  }
+}
+
+// Rows [i0, i1) of y = A * x, walking each column of A, a chunk of rows
+// at a time
+template <class Operand, class T>
+void __matvec_by_columns(Operand const& A, size_t i0, size_t i1, size_t n, T const* x, T* y) {
+  constexpr size_t C = __matvec_block;
+  for(size_t ic = i0; ic < i1; ic += __matvec_row_chunk) {
+    size_t rows = std::min(__matvec_row_chunk, i1 - ic);
+    T* yc = y + ic;
+    for(size_t i = 0; i < rows; ++i) yc[i] = T();
+    size_t j = 0;
+    for(; j + C <= n; j += C) {
+      if(A.s0 == 1) __matvec_axpy_columns<C, true>(A.acc, A.p, ic * A.s0 + j * A.s1, A.s0, A.s1, rows, x + j, yc);
+      else __matvec_axpy_columns<C, false>(A.acc, A.p, ic * A.s0 + j * A.s1, A.s0, A.s1, rows, x + j, yc);
+    }
+    for(; j < n; ++j) {
+      if(A.s0 == 1) __matvec_axpy_columns<1, true>(A.acc, A.p, ic * A.s0 + j * A.s1, A.s0, A.s1, rows, x + j, yc);
+      else __matvec_axpy_columns<1, false>(A.acc, A.p, ic * A.s0 + j * A.s1, A.s0, A.s1, rows, x + j, yc);
+    }
+  }
+}
+
+template <class ExecutionPolicy, class Operand, class T>
+void __matrix_vector_product(ExecutionPolicy policy, Operand const& A, size_t m, size_t n, T const* x, T* y, true_type /* strided */) {
+  // walk A in the direction with the smaller stride
+  bool by_columns = A.s0 < A.s1;
+  __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+    size_t i0 = m * t / num_threads, i1 = m * (t + 1) / num_threads;
+    if(by_columns) __matvec_by_columns(A, i0, i1, n, x, y);
+    else __matvec_by_rows(A, i0, i1, n, x, y);
+  });
+}
+
+template <class ExecutionPolicy, class Operand, class T>
+void __matrix_vector_product(ExecutionPolicy policy, Operand const& A, size_t m, size_t n, T const* x, T* y, false_type /* strided */) {
+  __on_each_thread(policy, [&](size_t t, size_t num_threads) {
+    for(size_t i = m * t / num_threads; i < m * (t + 1) / num_threads; ++i) {
+      T sum = T();
+      for(size_t j = 0; j < n; ++j) sum += T(A(i, j)) * x[j];
+      y[i] = sum;
+    }
+  });
+}
+
+} // end namespace detail
+
+//==============================================================================
+
+// y = A * x, for an m x n matrix A, a vector x of n elements and a vector y
+// of m elements that overlaps neither.  Extents that do not match fail a
+// static_assert when they are static, and an assert otherwise.
+//
+// A is walked in storage order: a layout_right A (or any with unit stride
+// along rows) a few rows at a time, each a dot product with x held in
+// several partial sums so that it vectorizes; a layout_left A (unit stride
+// down columns) a few columns at a time, each added to a chunk of y that
+// stays in cache.  Either way, each load of x or y serves several rows or
+// columns of A.  x and y are used in place when they are contiguous arrays
+// of y's value type, and through a temporary copy otherwise.  With
+// execution::par, the rows of y are split over the OpenMP threads.
+template <
+  class ExecutionPolicy,
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeX, class ExtentsX, class LayoutX, class AccessorX,
+  class ElementTypeY, class ExtentsY, class LayoutY, class AccessorY
+>
+enable_if_t<execution::is_execution_policy<ExecutionPolicy>::value>
+matrix_vector_product(
+  ExecutionPolicy policy,
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeX, ExtentsX, LayoutX, AccessorX> x,
+  mdspan<ElementTypeY, ExtentsY, LayoutY, AccessorY> y
+)
+{
+  static_assert(ExtentsA::rank() == 2 && ExtentsX::rank() == 1 && ExtentsY::rank() == 1,
+    "std::experimental::matrix_vector_product requires a rank 2 A and rank 1 x and y");
+  static_assert(detail::__static_extents_match<ExtentsA, 0, ExtentsY, 0>::value &&
+    detail::__static_extents_match<ExtentsA, 1, ExtentsX, 0>::value,
+    "std::experimental::matrix_vector_product requires an m x n A, an x of n elements and a y of m elements");
+  assert(A.extent(0) == y.extent(0) && A.extent(1) == x.extent(0));
+  using value_type = typename mdspan<ElementTypeY, ExtentsY, LayoutY, AccessorY>::value_type;
+  using strided = integral_constant<bool, LayoutA::template mapping<ExtentsA>::is_always_strided()>;
+  size_t m = A.extent(0), n = A.extent(1);
+  if(m == 0) return;
+  std::vector<value_type> x_copy, y_buffer;
+  value_type const* px = detail::__contiguous_vector(x, x_copy,
+    detail::__is_direct_vector<value_type, ElementTypeX, ExtentsX, LayoutX, AccessorX>());
+  value_type* py = detail::__contiguous_vector(y, y_buffer,
+    detail::__is_direct_vector<value_type, ElementTypeY, ExtentsY, LayoutY, AccessorY>(), true);
+  detail::__matrix_vector_product(policy, detail::__matrix_operand<decltype(A)>(A), m, n, px, py, strided());
+  if(!y_buffer.empty()) {
+    for(size_t i = 0; i < m; ++i) y(i) = y_buffer[i];
+  }
+}
+
+template <
+  class ElementTypeA, class ExtentsA, class LayoutA, class AccessorA,
+  class ElementTypeX, class ExtentsX, class LayoutX, class AccessorX,
+  class ElementTypeY, class ExtentsY, class LayoutY, class AccessorY
+>
+void matrix_vector_product(
+  mdspan<ElementTypeA, ExtentsA, LayoutA, AccessorA> A,
+  mdspan<ElementTypeX, ExtentsX, LayoutX, AccessorX> x,
+  mdspan<ElementTypeY, ExtentsY, LayoutY, AccessorY> y
+)
+{
+  matrix_vector_product(execution::seq, A, x, y);
+}
+
+} // end namespace experimental
+} // end namespace std
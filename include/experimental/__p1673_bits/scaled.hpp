@@ -0,0 +1,131 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Accessor that multiplies every element read through `NestedAccessor` by a
+// scaling factor, so that `scaled(alpha, x)` is a read-only view of
+// alpha * x which computes the products on access instead of storing them.
+template <class ScalingFactor, class NestedAccessor>
+class scaled_accessor {
+public:
+
+  using element_type = add_const_t<decltype(
+    declval<ScalingFactor const&>() * declval<typename NestedAccessor::reference>()
+  )>;
+  using reference = remove_const_t<element_type>;
+  using pointer = typename NestedAccessor::pointer;
+  using offset_policy = scaled_accessor<ScalingFactor, typename NestedAccessor::offset_policy>;
+
+  MDSPAN_INLINE_FUNCTION_DEFAULTED constexpr scaled_accessor() noexcept = default;
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr scaled_accessor(ScalingFactor const& s, NestedAccessor const& a) noexcept
+    : __scaling_factor(s), __nested_accessor(a)
+  { }
+
+  // Needed for offset_policy, i.e., for submdspan of scaled views
+  MDSPAN_TEMPLATE_REQUIRES(
+    class OtherScalingFactor, class OtherNestedAccessor,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, OtherScalingFactor, ScalingFactor) &&
+      _MDSPAN_TRAIT(is_convertible, OtherNestedAccessor, NestedAccessor)
+    )
+  )
+  MDSPAN_INLINE_FUNCTION
+  constexpr scaled_accessor(scaled_accessor<OtherScalingFactor, OtherNestedAccessor> const& other) noexcept // NOLINT(google-explicit-constructor)
+    : __scaling_factor(other.scaling_factor()), __nested_accessor(other.nested_accessor())
+  { }
+
+  MDSPAN_INLINE_FUNCTION
+  constexpr typename offset_policy::pointer offset(pointer p, size_t i) const noexcept {
+    return __nested_accessor.offset(p, i);
+  }
+
+  MDSPAN_FORCE_INLINE_FUNCTION
+  constexpr reference access(pointer p, size_t i) const noexcept {
+    return __scaling_factor * __nested_accessor.access(p, i);
+  }
+
+  MDSPAN_INLINE_FUNCTION constexpr ScalingFactor scaling_factor() const noexcept { return __scaling_factor; }
+  MDSPAN_INLINE_FUNCTION constexpr NestedAccessor nested_accessor() const noexcept { return __nested_accessor; }
+
+private:
+
+  ScalingFactor __scaling_factor = { };
+  NestedAccessor __nested_accessor = { };
+
+};
+
+//==============================================================================
+
+// Read-only view of alpha * x for an mdspan x of any layout
+template <class ScalingFactor, class ElementType, class Extents, class Layout, class Accessor>
+MDSPAN_INLINE_FUNCTION
+constexpr mdspan<
+  typename scaled_accessor<ScalingFactor, Accessor>::element_type,
+  Extents, Layout, scaled_accessor<ScalingFactor, Accessor>
+>
+scaled(ScalingFactor const& scaling_factor, mdspan<ElementType, Extents, Layout, Accessor> const& x)
+{
+  using accessor_type = scaled_accessor<ScalingFactor, Accessor>;
+  return mdspan<typename accessor_type::element_type, Extents, Layout, accessor_type>(
+    x.data(), x.mapping(), accessor_type(scaling_factor, x.accessor())
+  );
+}
+
+} // end namespace experimental
+} // end namespace std
@@ -0,0 +1,200 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include "../__p0009_bits/macros.hpp"
+#include "../__p0009_bits/mdspan.hpp"
+#include "../__p0009_bits/layout_right.hpp"
+#include "../__p0009_bits/extents.hpp"
+#include "../__p0009_bits/trait_backports.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace std {
+namespace experimental {
+
+//==============================================================================
+
+// Owning multidimensional array (after P1684): the elements live in a
+// contiguous container of at least `mapping().required_span_size()`
+// elements, and `view()` is an mdspan over them.  Copies and moves copy and
+// move the container.  Constructors that only take a shape value-initialize
+// the elements, so an array with all extents static is usable as soon as it
+// is default-constructed.
+template <
+  class ElementType, class Extents, class LayoutPolicy = layout_right,
+  class Container = std::vector<ElementType>
+>
+class mdarray {
+public:
+
+  using element_type = ElementType;
+  using value_type = remove_cv_t<ElementType>;
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using container_type = Container;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using pointer = element_type*;
+  using const_pointer = element_type const*;
+  using reference = element_type&;
+  using const_reference = element_type const&;
+
+  using mdspan_type = mdspan<element_type, extents_type, layout_type>;
+  using const_mdspan_type = mdspan<element_type const, extents_type, layout_type>;
+
+  static constexpr size_t rank() noexcept { return extents_type::rank(); }
+  static constexpr size_t rank_dynamic() noexcept { return extents_type::rank_dynamic(); }
+  static constexpr size_type static_extent(size_t r) noexcept { return extents_type::static_extent(r); }
+
+  //--------------------------------------------------------------------------------
+
+  mdarray() : mdarray(mapping_type()) { }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      (sizeof...(SizeTypes) == extents_type::rank_dynamic()) &&
+      (sizeof...(SizeTypes) > 0)
+    )
+  )
+  explicit mdarray(SizeTypes... dynamic_extents)
+    : mdarray(mapping_type(extents_type(size_type(dynamic_extents)...)))
+  { }
+
+  explicit mdarray(extents_type const& exts) : mdarray(mapping_type(exts)) { }
+
+  explicit mdarray(mapping_type const& m)
+    : __mapping(m), __container(size_type(m.required_span_size()))
+  { }
+
+  // Precondition: c.size() >= m.required_span_size()
+  mdarray(mapping_type const& m, container_type c)
+    : __mapping(m), __container(std::move(c))
+  { }
+
+  //--------------------------------------------------------------------------------
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      extents_type::rank() == sizeof...(SizeTypes)
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  reference operator()(SizeTypes... indices) noexcept {
+    return __container.data()[__mapping(size_type(indices)...)];
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class... SizeTypes,
+    /* requires */ (
+      _MDSPAN_FOLD_AND(_MDSPAN_TRAIT(is_convertible, SizeTypes, size_type) /* && ... */) &&
+      extents_type::rank() == sizeof...(SizeTypes)
+    )
+  )
+  MDSPAN_FORCE_INLINE_FUNCTION
+  const_reference operator()(SizeTypes... indices) const noexcept {
+    return __container.data()[__mapping(size_type(indices)...)];
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class SizeType, size_t N,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, SizeType, size_type) &&
+      N == extents_type::rank()
+    )
+  )
+  reference operator()(array<SizeType, N> const& indices) noexcept {
+    return view()(indices);
+  }
+
+  MDSPAN_TEMPLATE_REQUIRES(
+    class SizeType, size_t N,
+    /* requires */ (
+      _MDSPAN_TRAIT(is_convertible, SizeType, size_type) &&
+      N == extents_type::rank()
+    )
+  )
+  const_reference operator()(array<SizeType, N> const& indices) const noexcept {
+    return view()(indices);
+  }
+
+  //--------------------------------------------------------------------------------
+
+  mapping_type const& mapping() const noexcept { return __mapping; }
+  extents_type extents() const noexcept { return __mapping.extents(); }
+  size_type extent(size_t r) const noexcept { return __mapping.extents().extent(r); }
+  size_type size() const noexcept {
+    size_type n = 1;
+    for(size_t r = 0; r < rank(); ++r) n *= extent(r);
+    return n;
+  }
+  size_type stride(size_t r) const { return size_type(__mapping.stride(r)); }
+
+  pointer data() noexcept { return __container.data(); }
+  const_pointer data() const noexcept { return __container.data(); }
+
+  container_type& container() noexcept { return __container; }
+  container_type const& container() const noexcept { return __container; }
+
+  mdspan_type view() noexcept { return mdspan_type(__container.data(), __mapping); }
+  const_mdspan_type view() const noexcept { return const_mdspan_type(__container.data(), __mapping); }
+
+private:
+
+  mapping_type __mapping;
+  container_type __container;
+
+};
+
+} // end namespace experimental
+} // end namespace std
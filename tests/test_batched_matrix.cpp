@@ -0,0 +1,273 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+template <class T, size_t N, size_t M, class Layout>
+using batch_mdspan = stdex::mdspan<T, stdex::extents<dyn, N, M>, Layout>;
+
+// Owns the storage of a batch, sized from the mapping of its layout
+template <class T, size_t N, size_t M, class Layout>
+struct batch {
+  std::vector<T> storage;
+  batch_mdspan<T, N, M, Layout> view;
+
+  explicit batch(size_t count) {
+    using extents_type = stdex::extents<dyn, N, M>;
+    auto map = typename Layout::template mapping<extents_type>(extents_type(count));
+    storage.assign(map.required_span_size(), T(-1000));
+    view = batch_mdspan<T, N, M, Layout>(storage.data(), map);
+  }
+};
+
+// Small integers, so that products and determinants are exact
+template <class MDSpan>
+void fill_batch(MDSpan m, int seed) {
+  for(size_t b = 0; b < m.extent(0); ++b)
+    for(size_t i = 0; i < m.extent(1); ++i)
+      for(size_t j = 0; j < m.extent(2); ++j)
+        m(b, i, j) = typename MDSpan::value_type(int((b * 7 + i * 31 + j * 17 + size_t(seed)) % 11) - 5);
+}
+
+// Diagonally dominant, hence well conditioned
+template <class MDSpan>
+void fill_dominant(MDSpan m, bool symmetric) {
+  for(size_t b = 0; b < m.extent(0); ++b)
+    for(size_t i = 0; i < m.extent(1); ++i)
+      for(size_t j = 0; j < m.extent(2); ++j) {
+        size_t s = symmetric ? i + j : i * 3 + j;
+        m(b, i, j) = i == j ? double(10 + (b + i) % 5) : double(int((b * 5 + s * 13) % 7) - 3);
+      }
+}
+
+template <class MDSpanA, class MDSpanB, class MDSpanC>
+void expect_product(MDSpanA A, MDSpanB B, MDSpanC C) {
+  for(size_t b = 0; b < C.extent(0); ++b)
+    for(size_t i = 0; i < C.extent(1); ++i)
+      for(size_t j = 0; j < C.extent(2); ++j) {
+        typename MDSpanC::value_type expected = 0;
+        for(size_t k = 0; k < A.extent(2); ++k) expected += A(b, i, k) * B(b, k, j);
+        ASSERT_EQ(C(b, i, j), expected) << "at " << b << ", " << i << ", " << j;
+      }
+}
+
+template <class T, size_t N, size_t K, size_t M, class Layout, class Policy>
+void check_product(Policy policy, size_t count) {
+  batch<T, N, K, Layout> A(count);
+  batch<T, K, M, Layout> B(count);
+  batch<T, N, M, Layout> C(count);
+  fill_batch(A.view, 1);
+  fill_batch(B.view, 2);
+  stdex::batched_matrix_product(policy, A.view, B.view, C.view);
+  expect_product(A.view, B.view, C.view);
+}
+
+template <class MDSpan>
+double reference_determinant(MDSpan A, size_t b) {
+  constexpr size_t N = MDSpan::static_extent(1);
+  double m[N][N];
+  for(size_t i = 0; i < N; ++i)
+    for(size_t j = 0; j < N; ++j) m[i][j] = double(A(b, i, j));
+  // Gaussian elimination with partial pivoting
+  double det = 1;
+  for(size_t k = 0; k < N; ++k) {
+    size_t p = k;
+    for(size_t i = k + 1; i < N; ++i) if(std::abs(m[i][k]) > std::abs(m[p][k])) p = i;
+    if(m[p][k] == 0) return 0;
+    if(p != k) { for(size_t j = 0; j < N; ++j) std::swap(m[p][j], m[k][j]); det = -det; }
+    det *= m[k][k];
+    for(size_t i = k + 1; i < N; ++i) {
+      double f = m[i][k] / m[k][k];
+      for(size_t j = k; j < N; ++j) m[i][j] -= f * m[k][j];
+    }
+  }
+  return det;
+}
+
+template <class T, size_t N, class Layout, class Policy>
+void check_determinant(Policy policy, size_t count) {
+  batch<T, N, N, Layout> A(count);
+  std::vector<T> d(count, T(-1000));
+  fill_batch(A.view, 3);
+  stdex::batched_determinant(policy, A.view, stdex::mdspan<T, stdex::dextents<1>>(d.data(), count));
+  for(size_t b = 0; b < count; ++b) ASSERT_NEAR(double(d[b]), reference_determinant(A.view, b), 1e-9) << "at " << b;
+}
+
+template <size_t N, class Layout, class Policy>
+void check_inverse(Policy policy, size_t count) {
+  batch<double, N, N, Layout> A(count), X(count);
+  fill_dominant(A.view, false);
+  stdex::batched_inverse(policy, A.view, X.view);
+  for(size_t b = 0; b < count; ++b)
+    for(size_t i = 0; i < N; ++i)
+      for(size_t j = 0; j < N; ++j) {
+        double sum = 0;
+        for(size_t k = 0; k < N; ++k) sum += A.view(b, i, k) * X.view(b, k, j);
+        ASSERT_NEAR(sum, i == j ? 1.0 : 0.0, 1e-12) << "at " << b << ", " << i << ", " << j;
+      }
+}
+
+template <size_t N, class Layout, class Policy>
+void check_symmetric_eigen(Policy policy, size_t count) {
+  batch<double, N, N, Layout> A(count), V(count);
+  // w is rank 2: one row of N eigenvalues per matrix
+  std::vector<double> w_data(count * N, -1000.0);
+  stdex::mdspan<double, stdex::extents<dyn, N>> w(w_data.data(), count);
+  fill_dominant(A.view, true);
+  stdex::batched_symmetric_eigen(policy, A.view, w, V.view);
+  for(size_t b = 0; b < count; ++b) {
+    for(size_t k = 0; k + 1 < N; ++k) ASSERT_LE(w(b, k), w(b, k + 1)) << "at " << b;
+    for(size_t i = 0; i < N; ++i) {
+      for(size_t k = 0; k < N; ++k) {
+        // A v_k = w_k v_k
+        double av = 0;
+        for(size_t j = 0; j < N; ++j) av += A.view(b, i, j) * V.view(b, j, k);
+        ASSERT_NEAR(av, w(b, k) * V.view(b, i, k), 1e-10) << "at " << b << ", " << i << ", " << k;
+        // V^T V = I
+        double vv = 0;
+        for(size_t j = 0; j < N; ++j) vv += V.view(b, j, i) * V.view(b, j, k);
+        ASSERT_NEAR(vv, i == k ? 1.0 : 0.0, 1e-12) << "at " << b << ", " << i << ", " << k;
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST(TestBatchedMatrix, product) {
+  // batch sizes that are not multiples of the tile or of the block length
+  check_product<double, 3, 3, 3, stdex::layout_right>(stdex::execution::seq, 1);
+  check_product<double, 3, 3, 3, stdex::layout_right>(stdex::execution::par, 131);
+  check_product<double, 3, 3, 3, stdex::layout_left>(stdex::execution::seq, 131);
+  check_product<double, 3, 3, 3, stdex::layout_left>(stdex::execution::par, 1000);
+  check_product<float, 4, 4, 4, stdex::layout_aosoa<8>>(stdex::execution::seq, 131);
+  check_product<float, 4, 4, 4, stdex::layout_aosoa<8>>(stdex::execution::par, 1000);
+  // non-square, and blocks longer than a tile
+  check_product<double, 2, 3, 4, stdex::layout_left>(stdex::execution::seq, 77);
+  check_product<double, 2, 3, 4, stdex::layout_aosoa<128>>(stdex::execution::par, 300);
+  check_product<int, 3, 1, 2, stdex::layout_right>(stdex::execution::seq, 70);
+  check_product<int, 3, 1, 2, stdex::layout_aosoa<4>>(stdex::execution::seq, 0);
+}
+
+TEST(TestBatchedMatrix, determinant) {
+  check_determinant<double, 1, stdex::layout_right>(stdex::execution::seq, 9);
+  check_determinant<double, 2, stdex::layout_left>(stdex::execution::seq, 131);
+  check_determinant<double, 3, stdex::layout_right>(stdex::execution::par, 131);
+  check_determinant<double, 3, stdex::layout_left>(stdex::execution::par, 1000);
+  check_determinant<double, 4, stdex::layout_aosoa<4>>(stdex::execution::seq, 131);
+  check_determinant<int, 3, stdex::layout_aosoa<16>>(stdex::execution::par, 250);
+  check_determinant<int, 4, stdex::layout_right>(stdex::execution::seq, 65);
+}
+
+TEST(TestBatchedMatrix, inverse) {
+  check_inverse<1, stdex::layout_left>(stdex::execution::seq, 5);
+  check_inverse<2, stdex::layout_right>(stdex::execution::seq, 131);
+  check_inverse<3, stdex::layout_left>(stdex::execution::par, 1000);
+  check_inverse<3, stdex::layout_aosoa<8>>(stdex::execution::seq, 131);
+  check_inverse<4, stdex::layout_right>(stdex::execution::par, 131);
+  check_inverse<4, stdex::layout_aosoa<4>>(stdex::execution::par, 1000);
+}
+
+TEST(TestBatchedMatrix, symmetric_eigen) {
+  check_symmetric_eigen<1, stdex::layout_right>(stdex::execution::seq, 3);
+  check_symmetric_eigen<2, stdex::layout_left>(stdex::execution::seq, 131);
+  check_symmetric_eigen<3, stdex::layout_right>(stdex::execution::par, 131);
+  check_symmetric_eigen<3, stdex::layout_aosoa<8>>(stdex::execution::seq, 131);
+  check_symmetric_eigen<4, stdex::layout_left>(stdex::execution::par, 1000);
+  check_symmetric_eigen<4, stdex::layout_aosoa<4>>(stdex::execution::seq, 65);
+}
+
+TEST(TestBatchedMatrix, strided_operands) {
+  // all but the first matrix of a layout_left and of a layout_right batch
+  using extents_type = stdex::extents<dyn, 3, 3>;
+  using strided_mdspan = stdex::mdspan<double, extents_type, stdex::layout_stride>;
+  batch<double, 3, 3, stdex::layout_left> A(200), X(200);
+  batch<double, 3, 3, stdex::layout_right> B(200), C(200);
+  fill_batch(A.view, 4);
+  fill_batch(B.view, 5);
+  auto left_tail = [](auto& m) {
+    return strided_mdspan(m.storage.data() + 1, stdex::layout_stride::mapping<extents_type>(
+      extents_type(199), stdex::dextents<3>(1, 200, 600)));
+  };
+  auto right_tail = [](auto& m) {
+    return strided_mdspan(m.storage.data() + 9, stdex::layout_stride::mapping<extents_type>(
+      extents_type(199), stdex::dextents<3>(9, 3, 1)));
+  };
+  auto A_sub = left_tail(A);
+  auto B_sub = right_tail(B);
+  auto C_sub = right_tail(C);
+  stdex::batched_matrix_product(stdex::execution::par, A_sub, B_sub, C_sub);
+  expect_product(A_sub, B_sub, C_sub);
+  ASSERT_EQ(C.view(0, 0, 0), -1000.0);
+
+  std::vector<double> d(400, -1000.0);
+  stdex::mdspan<double, stdex::dextents<2>> d_pairs(d.data(), 199, 2);
+  auto d_sub = stdex::submdspan(d_pairs, stdex::full_extent, 1);
+  stdex::batched_determinant(B_sub, d_sub);
+  for(size_t b = 0; b < 199; ++b) {
+    ASSERT_NEAR(d_sub(b), reference_determinant(B_sub, b), 1e-9);
+    ASSERT_EQ(d_pairs(b, 0), -1000.0);
+  }
+
+  fill_dominant(A.view, false);
+  stdex::batched_inverse(A_sub, left_tail(X));
+  for(size_t b = 1; b < 200; ++b) {
+    for(size_t i = 0; i < 3; ++i) {
+      double sum = 0;
+      for(size_t k = 0; k < 3; ++k) sum += A.view(b, i, k) * X.view(b, k, i);
+      ASSERT_NEAR(sum, 1.0, 1e-12) << "at " << b;
+    }
+  }
+  ASSERT_EQ(X.view(0, 0, 0), -1000.0);
+}
@@ -0,0 +1,155 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+template <class Word>
+using bit_mdspan_3d = stdex::mdspan<bool, stdex::dextents<3>, stdex::layout_right, stdex::bitpacked_accessor<Word>>;
+
+TEST(TestBitpackedAccessor, element_access) {
+  using accessor_type = stdex::bitpacked_accessor<uint8_t>;
+  std::vector<uint8_t> words(accessor_type::words_for(3 * 7), 0);
+  ASSERT_EQ(words.size(), 3);
+  stdex::mdspan<bool, stdex::extents<3, 7>, stdex::layout_right, accessor_type> m(words.data());
+  m(0, 1) = true;
+  m(1, 2) = true;  // bit 9
+  m(2, 6) = true;  // bit 20
+  m(2, 6) = m(0, 0);
+  m(2, 5) |= true; // bit 19
+  ASSERT_EQ(words[0], 0x02);
+  ASSERT_EQ(words[1], 0x02);
+  ASSERT_EQ(words[2], 0x08);
+  ASSERT_TRUE(m(1, 2));
+  ASSERT_FALSE(m(1, 3));
+  // read-only views hand out plain bools
+  stdex::mdspan<bool const, stdex::extents<3, 7>, stdex::layout_right, stdex::bitpacked_accessor<uint8_t const>> cm = m;
+  static_assert(std::is_same<decltype(cm)::reference, bool>::value, "");
+  ASSERT_TRUE(cm(0, 1));
+}
+
+TEST(TestBitpackedAccessor, submdspan_sub_word_offsets) {
+  using accessor_type = stdex::bitpacked_accessor<uint8_t>;
+  std::vector<uint8_t> words(accessor_type::words_for(5 * 5), 0);
+  stdex::mdspan<bool, stdex::extents<dyn, dyn>, stdex::layout_right, accessor_type> m(words.data(), 5, 5);
+  for(size_t i = 0; i < 5; ++i) m(i, i) = true;
+  // rows start at bits 0, 5, 10, ...; row 3 starts at bit 7 of word 1
+  auto row = stdex::submdspan(m, 3, stdex::full_extent);
+  static_assert(std::is_same<decltype(row)::accessor_type, stdex::bitpacked_offset_accessor<uint8_t>>::value, "");
+  ASSERT_EQ(row.data().word, words.data() + 1);
+  ASSERT_EQ(row.data().bit, 7);
+  for(size_t j = 0; j < 5; ++j) ASSERT_EQ(bool(row(j)), j == 3);
+  // a submdspan of a submdspan keeps accumulating the bit offset
+  auto tail = stdex::submdspan(row, std::make_pair(2, 5));
+  ASSERT_EQ(tail.data().word, words.data() + 2);
+  ASSERT_EQ(tail.data().bit, 1);
+  tail(2) = true;
+  ASSERT_TRUE(m(3, 4));
+  auto column = stdex::submdspan(m, stdex::full_extent, 1);
+  ASSERT_TRUE(column(1));
+  ASSERT_FALSE(column(2));
+}
+
+TEST(TestMaskAlgorithms, count_any_all) {
+  size_t n = 13, count = 0;
+  std::vector<uint64_t> words(stdex::bitpacked_accessor<>::words_for(n * n * n), 0);
+  std::vector<char> reference(n * n * n, 0);
+  bit_mdspan_3d<uint64_t> m(words.data(), n, n, n);
+  stdex::mdspan<char, stdex::dextents<3>> r(reference.data(), n, n, n);
+  ASSERT_FALSE(stdex::mask_any(m));
+  ASSERT_FALSE(stdex::mask_all(m));
+  for(size_t i = 0; i < n; ++i)
+    for(size_t j = 0; j < n; ++j)
+      for(size_t k = 0; k < n; ++k)
+        if((i * 7 + j * 3 + k) % 5 == 0) { m(i, j, k) = true; r(i, j, k) = 1; ++count; }
+  ASSERT_EQ(stdex::mask_count(m), count);
+  ASSERT_EQ(stdex::mask_count(r), count);
+  ASSERT_TRUE(stdex::mask_any(m));
+  // strided and sub-word-offset views fall back to element access
+  auto slab = stdex::submdspan(m, std::make_pair(3, 9), stdex::full_extent, stdex::full_extent);
+  auto r_slab = stdex::submdspan(r, std::make_pair(3, 9), stdex::full_extent, stdex::full_extent);
+  ASSERT_EQ(stdex::mask_count(slab), stdex::mask_count(r_slab));
+  auto plane = stdex::submdspan(m, stdex::full_extent, 4, stdex::full_extent);
+  auto r_plane = stdex::submdspan(r, stdex::full_extent, 4, stdex::full_extent);
+  ASSERT_EQ(stdex::mask_count(plane), stdex::mask_count(r_plane));
+  for(auto& w : words) w = ~uint64_t(0);
+  ASSERT_TRUE(stdex::mask_all(m));
+  ASSERT_TRUE(stdex::mask_all(slab));
+  m(12, 12, 12) = false;
+  ASSERT_FALSE(stdex::mask_all(m));
+  ASSERT_TRUE(stdex::mask_all(slab));
+}
+
+TEST(TestMaskAlgorithms, and_or) {
+  size_t n = 100;
+  using accessor_type = stdex::bitpacked_accessor<uint32_t>;
+  std::vector<uint32_t> a_words(accessor_type::words_for(n), 0), b_words(a_words), out_words(a_words.size(), 0xffffffffu);
+  using vec = stdex::mdspan<bool, stdex::dextents<1>, stdex::layout_right, accessor_type>;
+  vec a(a_words.data(), n), b(b_words.data(), n), out(out_words.data(), n);
+  for(size_t i = 0; i < n; ++i) { a(i) = i % 2 == 0; b(i) = i % 3 == 0; }
+  stdex::mask_and(a, b, out);
+  for(size_t i = 0; i < n; ++i) ASSERT_EQ(bool(out(i)), i % 6 == 0);
+  // bits past the end of the mask are left alone
+  ASSERT_EQ(out_words.back() >> (n % 32), 0xffffffffu >> (n % 32));
+  stdex::mask_or(a, b, out);
+  for(size_t i = 0; i < n; ++i) ASSERT_EQ(bool(out(i)), i % 2 == 0 || i % 3 == 0);
+  // mismatched bit offsets take the element-wise path
+  auto a_tail = stdex::submdspan(a, std::make_pair(1, 61));
+  auto b_tail = stdex::submdspan(b, std::make_pair(2, 62));
+  auto out_tail = stdex::submdspan(out, std::make_pair(0, 60));
+  stdex::mask_and(a_tail, b_tail, out_tail);
+  for(size_t i = 0; i < 60; ++i) ASSERT_EQ(bool(out(i)), (i + 1) % 2 == 0 && (i + 2) % 3 == 0);
+  // and masks of plain bools work too
+  bool x[4] = {true, true, false, false}, y[4] = {true, false, true, false}, z[4] = { };
+  using bool_vec = stdex::mdspan<bool, stdex::extents<4>>;
+  stdex::mask_or(bool_vec(x), bool_vec(y), bool_vec(z));
+  ASSERT_TRUE(z[0] && z[1] && z[2] && !z[3]);
+}
@@ -0,0 +1,142 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+template <class T>
+T reversed_bytes(T v) {
+  unsigned char b[sizeof(T)];
+  std::memcpy(b, &v, sizeof(T));
+  for(size_t i = 0; i < sizeof(T) / 2; ++i) std::swap(b[i], b[sizeof(T) - 1 - i]);
+  std::memcpy(&v, b, sizeof(T));
+  return v;
+}
+
+} // end anonymous namespace
+
+TEST(TestByteswapAccessor, swaps_on_load) {
+  std::vector<uint32_t> stored = {0x01020304u, 0xa0b0c0d0u, 0x000000ffu, 0u, 7u, 8u};
+  stdex::mdspan<uint32_t const, stdex::extents<2, 3>, stdex::layout_right, stdex::byteswap_accessor<uint32_t const>>
+    s(stored.data());
+  static_assert(std::is_same<decltype(s(0, 0)), uint32_t>::value, "");
+  ASSERT_EQ(s(0, 0), 0x04030201u);
+  ASSERT_EQ(s(0, 1), 0xd0c0b0a0u);
+  ASSERT_EQ(s(0, 2), 0xff000000u);
+  ASSERT_EQ(s(1, 1), 7u << 24);
+}
+
+TEST(TestByteswapAccessor, swaps_on_store) {
+  std::vector<double> stored(4, 0.0);
+  stdex::mdspan<double, stdex::dextents<1>, stdex::layout_right, stdex::byteswap_accessor<double>> s(stored.data(), 4);
+  s(0) = 1.5;
+  s(1) = -2.25;
+  s(2) = s(0);
+  s(3) = 1.0;
+  s(3) += 0.5;
+  ASSERT_EQ(stored[0], reversed_bytes(1.5));
+  ASSERT_EQ(double(s(1)), -2.25);
+  ASSERT_EQ(double(s(2)), 1.5);
+  ASSERT_EQ(double(s(3)), 1.5);
+  // a const view of the same data
+  stdex::mdspan<double const, stdex::dextents<1>, stdex::layout_right, stdex::byteswap_accessor<double const>> c(s);
+  ASSERT_EQ(c(1), -2.25);
+}
+
+TEST(TestByteswapAccessor, big_endian_accessor) {
+  // 0x0102 stored big-endian
+  unsigned char bytes[2] = {0x01, 0x02};
+  uint16_t stored;
+  std::memcpy(&stored, bytes, 2);
+  stdex::mdspan<uint16_t const, stdex::extents<1>, stdex::layout_right, stdex::big_endian_accessor<uint16_t const>> s(&stored);
+  ASSERT_EQ(s(0), 0x0102);
+}
+
+template <class T>
+void test_bulk_copy(size_t n0, size_t n1) {
+  std::vector<T> native(n0 * n1), swapped(n0 * n1), out(n0 * n1);
+  for(size_t i = 0; i < native.size(); ++i) {
+    native[i] = T(i * 2654435761u + 17);
+    swapped[i] = reversed_bytes(native[i]);
+  }
+  using extents_type = stdex::dextents<2>;
+  stdex::mdspan<T const, extents_type, stdex::layout_right, stdex::byteswap_accessor<T const>> src(swapped.data(), n0, n1);
+  stdex::mdspan<T, extents_type> dst(out.data(), n0, n1);
+  stdex::copy(src, dst);
+  ASSERT_EQ(out, native);
+
+  // and back, into byte-swapped storage
+  std::vector<T> back(n0 * n1);
+  stdex::mdspan<T, extents_type, stdex::layout_right, stdex::byteswap_accessor<T>> back_view(back.data(), n0, n1);
+  stdex::copy(stdex::mdspan<T const, extents_type>(native.data(), n0, n1), back_view);
+  ASSERT_EQ(back, swapped);
+
+  // different layouts take the elementwise path
+  std::vector<T> left(n0 * n1);
+  stdex::mdspan<T, extents_type, stdex::layout_left> left_view(left.data(), n0, n1);
+  stdex::copy(src, left_view);
+  for(size_t i = 0; i < n0; ++i) {
+    for(size_t j = 0; j < n1; ++j) {
+      ASSERT_EQ(left_view(i, j), native[i * n1 + j]);
+    }
+  }
+}
+
+TEST(TestByteswapAccessor, bulk_copy) {
+  // sizes with and without a vector remainder
+  test_bulk_copy<uint16_t>(7, 9);
+  test_bulk_copy<uint32_t>(8, 8);
+  test_bulk_copy<uint32_t>(5, 13);
+  test_bulk_copy<uint64_t>(3, 11);
+  test_bulk_copy<int8_t>(4, 5);
+}
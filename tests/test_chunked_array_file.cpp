@@ -0,0 +1,180 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+TEST(TestChunkCodec, shuffle_rle_round_trip) {
+  std::vector<float> values(1000);
+  for(size_t i = 0; i < values.size(); ++i) values[i] = float(i % 7);
+  std::vector<unsigned char> encoded, scratch;
+  stdex::detail::__chunk_encode(stdex::chunk_codec::shuffle_rle, values.data(), values.size(), sizeof(float), encoded, scratch);
+  ASSERT_LT(encoded.size(), values.size() * sizeof(float) / 2);
+  std::vector<float> decoded(values.size());
+  ASSERT_TRUE(stdex::detail::__chunk_decode(stdex::chunk_codec::shuffle_rle, encoded.data(), encoded.size(),
+    decoded.data(), decoded.size(), sizeof(float), scratch));
+  ASSERT_EQ(values, decoded);
+  // truncated input is detected
+  ASSERT_FALSE(stdex::detail::__chunk_decode(stdex::chunk_codec::shuffle_rle, encoded.data(), encoded.size() - 1,
+    decoded.data(), decoded.size(), sizeof(float), scratch));
+}
+
+TEST(TestChunkCodec, incompressible_data_is_stored_raw) {
+  std::vector<uint8_t> values(300);
+  for(size_t i = 0; i < values.size(); ++i) values[i] = uint8_t(i * 37 + (i >> 3));
+  std::vector<unsigned char> encoded, scratch;
+  stdex::detail::__chunk_encode(stdex::chunk_codec::shuffle_rle, values.data(), values.size(), 1, encoded, scratch);
+  ASSERT_EQ(encoded.size(), values.size());
+  std::vector<uint8_t> decoded(values.size());
+  ASSERT_TRUE(stdex::detail::__chunk_decode(stdex::chunk_codec::shuffle_rle, encoded.data(), encoded.size(),
+    decoded.data(), decoded.size(), 1, scratch));
+  ASSERT_EQ(values, decoded);
+}
+
+#if defined(_MDSPAN_HAS_PREAD)
+
+namespace {
+
+std::string temp_path(char const* name) {
+  return testing::TempDir() + "mdspan_test_" + name + ".chunked";
+}
+
+template <class Policy>
+void test_round_trip(Policy policy, stdex::chunk_codec codec) {
+  auto path = temp_path("round_trip");
+  size_t n0 = 11, n1 = 6, n2 = 9;
+  std::vector<double> data(n0 * n1 * n2);
+  for(size_t i = 0; i < data.size(); ++i) data[i] = std::floor(double(i) / 5);
+  stdex::mdspan<double, stdex::dextents<3>> x(data.data(), n0, n1, n2);
+  {
+    stdex::chunked_array_writer<double, 3> writer(path.c_str(), x.extents(), {{4, 4, 4}}, codec);
+    ASSERT_EQ(writer.num_chunks(), 3 * 2 * 3);
+    // two slabs of whole chunks, and the clipped remainder
+    writer.write_slab(policy, stdex::submdspan(x, std::make_pair(0, 8), stdex::full_extent, stdex::full_extent), 0);
+    ASSERT_THROW(writer.close(), std::runtime_error);
+    writer.write_slab(policy, stdex::submdspan(x, std::make_pair(8, 11), stdex::full_extent, stdex::full_extent), 8);
+    if(codec == stdex::chunk_codec::shuffle_rle) {
+      ASSERT_LT(writer.stored_bytes(), data.size() * sizeof(double));
+    }
+    writer.close();
+  }
+  stdex::chunked_array_reader<double, 3> reader(path.c_str());
+  ASSERT_EQ(reader.extents().extent(0), n0);
+  ASSERT_EQ(reader.extents().extent(2), n2);
+  ASSERT_EQ(reader.chunk_extents()[1], 4);
+  ASSERT_EQ(reader.codec(), codec);
+  std::vector<double> out(data.size(), -1);
+  stdex::mdspan<double, stdex::dextents<3>> y(out.data(), n0, n1, n2);
+  reader.read_slab(policy, y, 0);
+  ASSERT_EQ(data, out);
+  // a slab that does not line up with the chunks, into a layout_left array
+  std::vector<double> part(5 * n1 * n2, -1);
+  stdex::mdspan<double, stdex::dextents<3>, stdex::layout_left> z(part.data(), 5, n1, n2);
+  reader.read_slab(policy, z, 3);
+  for(size_t i = 0; i < 5; ++i)
+    for(size_t j = 0; j < n1; ++j)
+      for(size_t k = 0; k < n2; ++k)
+        ASSERT_EQ(z(i, j, k), x(i + 3, j, k));
+  std::remove(path.c_str());
+}
+
+} // namespace
+
+TEST(TestChunkedArrayFile, round_trip_seq) { test_round_trip(stdex::execution::seq, stdex::chunk_codec::shuffle_rle); }
+TEST(TestChunkedArrayFile, round_trip_par) { test_round_trip(stdex::execution::par, stdex::chunk_codec::shuffle_rle); }
+TEST(TestChunkedArrayFile, round_trip_uncompressed) { test_round_trip(stdex::execution::seq, stdex::chunk_codec::none); }
+
+TEST(TestChunkedArrayFile, empty_final_slab) {
+  auto path = temp_path("empty_final_slab");
+  std::vector<int> data(10 * 5);
+  for(size_t i = 0; i < data.size(); ++i) data[i] = int(i);
+  stdex::mdspan<int, stdex::dextents<2>> x(data.data(), 10, 5);
+  {
+    // the last chunk row starts at 8, before the end of the array
+    stdex::chunked_array_writer<int, 2> writer(path.c_str(), x.extents(), {{4, 4}});
+    writer.write_slab(x, 0);
+    size_t stored = writer.stored_bytes();
+    // an empty slab of other data, which must not be read
+    std::vector<int> other(4 * 5, -7);
+    writer.write_slab(stdex::mdspan<int, stdex::dextents<2>>(other.data() + 2 * 5, 0, 5), 10);
+    ASSERT_EQ(writer.stored_bytes(), stored);
+    writer.close();
+  }
+  stdex::chunked_array_reader<int, 2> reader(path.c_str());
+  std::vector<int> out(data.size(), -1);
+  reader.read_slab(stdex::mdspan<int, stdex::dextents<2>>(out.data(), 10, 5), 0);
+  ASSERT_EQ(data, out);
+  std::remove(path.c_str());
+}
+
+TEST(TestChunkedArrayFile, errors) {
+  auto path = temp_path("errors");
+  std::vector<int> data(10 * 10, 7);
+  stdex::mdspan<int, stdex::dextents<2>> x(data.data(), 10, 10);
+  {
+    stdex::chunked_array_writer<int, 2> writer(path.c_str(), x.extents(), {{4, 5}});
+    // not at the start, and not ending on a chunk boundary
+    ASSERT_THROW(writer.write_slab(stdex::submdspan(x, std::make_pair(4, 8), stdex::full_extent), 4), std::invalid_argument);
+    ASSERT_THROW(writer.write_slab(stdex::submdspan(x, std::make_pair(0, 3), stdex::full_extent), 0), std::invalid_argument);
+    writer.write_slab(x, 0);
+    writer.close();
+  }
+  ASSERT_THROW((stdex::chunked_array_reader<double, 2>(path.c_str())), std::runtime_error);
+  ASSERT_THROW((stdex::chunked_array_reader<int, 3>(path.c_str())), std::runtime_error);
+  stdex::chunked_array_reader<int, 2> reader(path.c_str());
+  std::vector<int> out(5 * 10);
+  ASSERT_THROW(reader.read_slab(stdex::mdspan<int, stdex::dextents<2>>(out.data(), 5, 10), 6), std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+#endif // _MDSPAN_HAS_PREAD
@@ -0,0 +1,139 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+template <class StorageT>
+using converting_mdspan = stdex::mdspan<float, stdex::dextents<2>, stdex::layout_right, stdex::converting_accessor<StorageT, float>>;
+
+TEST(TestConvertingAccessor, float16_conversions) {
+  using traits = stdex::conversion_traits<stdex::float16_storage, float>;
+  ASSERT_EQ(traits::store(1.0f).bits, 0x3c00);
+  ASSERT_EQ(traits::store(-2.0f).bits, 0xc000);
+  ASSERT_EQ(traits::store(65504.0f).bits, 0x7bff);
+  ASSERT_EQ(traits::store(1e6f).bits, 0x7c00);
+  ASSERT_EQ(traits::store(std::ldexp(1.0f, -24)).bits, 0x0001);
+  ASSERT_EQ(traits::store(std::ldexp(1.0f, -26)).bits, 0x0000);
+  // ties round to even: 1 + 2^-11 lies halfway between 1 and 1 + 2^-10
+  ASSERT_EQ(traits::store(1.0f + std::ldexp(1.0f, -11)).bits, 0x3c00);
+  ASSERT_EQ(traits::store(1.0f + 3 * std::ldexp(1.0f, -11)).bits, 0x3c02);
+  ASSERT_TRUE(std::isnan(traits::load(traits::store(std::numeric_limits<float>::quiet_NaN()))));
+  // every finite half converts to float and back exactly
+  for(uint32_t bits = 0; bits < 0x10000; ++bits) {
+    if((bits & 0x7c00) == 0x7c00) continue;
+    auto h = stdex::float16_storage{ uint16_t(bits) };
+    ASSERT_EQ(traits::store(traits::load(h)).bits, bits);
+  }
+  ASSERT_EQ(traits::load(stdex::float16_storage{0x0001}), std::ldexp(1.0f, -24));
+  ASSERT_EQ(traits::load(stdex::float16_storage{0x3555}), 0.333251953125f);
+}
+
+TEST(TestConvertingAccessor, bfloat16_conversions) {
+  using traits = stdex::conversion_traits<stdex::bfloat16_storage, float>;
+  ASSERT_EQ(traits::store(1.0f).bits, 0x3f80);
+  ASSERT_EQ(traits::load(stdex::bfloat16_storage{0xc040}), -3.0f);
+  // ties round to even
+  ASSERT_EQ(traits::store(1.0f + std::ldexp(1.0f, -8)).bits, 0x3f80);
+  ASSERT_EQ(traits::store(1.0f + 3 * std::ldexp(1.0f, -8)).bits, 0x3f82);
+  ASSERT_TRUE(std::isnan(traits::load(traits::store(std::numeric_limits<float>::quiet_NaN()))));
+  ASSERT_TRUE(std::isinf(traits::load(traits::store(std::numeric_limits<float>::infinity()))));
+}
+
+TEST(TestConvertingAccessor, proxy_reference) {
+  std::vector<stdex::float16_storage> buffer(6);
+  converting_mdspan<stdex::float16_storage> a(buffer.data(), 2, 3);
+  static_assert(std::is_same<decltype(a)::value_type, float>::value, "");
+  for(size_t i = 0; i < 2; ++i) {
+    for(size_t j = 0; j < 3; ++j) {
+      a(i, j) = float(i * 3 + j) + 0.5f;
+    }
+  }
+  ASSERT_EQ(buffer[5].bits, 0x4580); // 5.5
+  a(1, 2) += 1.0f;
+  a(0, 0) = a(1, 2);
+  float x = a(0, 0);
+  ASSERT_EQ(x, 6.5f);
+  // 1/3 is rounded on write
+  a(0, 1) = 1.0f / 3.0f;
+  ASSERT_EQ(float(a(0, 1)), 0.333251953125f);
+
+  // read-only views return values, and submdspan keeps the conversion
+  converting_mdspan<stdex::float16_storage const> ca = a;
+  static_assert(std::is_same<decltype(ca)::reference, float>::value, "");
+  auto row = stdex::submdspan(ca, 1, stdex::full_extent);
+  ASSERT_EQ(row(0), 3.5f);
+}
+
+TEST(TestConvertingAccessor, quantized) {
+  using accessor_type = stdex::quantized_accessor<int8_t, float>;
+  std::vector<int8_t> buffer(4);
+  stdex::mdspan<float, stdex::extents<4>, stdex::layout_right, accessor_type> q(
+    buffer.data(), stdex::layout_right::mapping<stdex::extents<4>>(), accessor_type(0.5f, 10));
+  q(0) = 0.0f;
+  q(1) = 1.26f;
+  q(2) = 1000.0f;
+  q(3) = -1000.0f;
+  ASSERT_EQ(buffer[0], 10);
+  ASSERT_EQ(buffer[1], 13);
+  ASSERT_EQ(buffer[2], 127);
+  ASSERT_EQ(buffer[3], -128);
+  ASSERT_EQ(float(q(1)), 1.5f);
+  ASSERT_EQ(float(q(3)), -69.0f);
+  auto tail = stdex::submdspan(q, std::make_pair(2, 4));
+  ASSERT_EQ(tail.accessor().scale(), 0.5f);
+  ASSERT_EQ(tail.accessor().zero_point(), 10);
+  ASSERT_EQ(float(tail(0)), 58.5f);
+  q(0) = std::numeric_limits<float>::quiet_NaN();
+  ASSERT_EQ(buffer[0], 10);
+  ASSERT_EQ(float(q(0)), 0.0f);
+}
@@ -0,0 +1,159 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stdex = std::experimental;
+
+// 4 x 5 matrix
+//   [ 1 0 2 0 0 ]
+//   [ 0 0 0 0 0 ]
+//   [ 0 3 0 4 5 ]
+//   [ 6 0 0 0 7 ]
+struct csr_fixture {
+  std::vector<size_t> row_ptr = {0, 2, 2, 5, 7};
+  std::vector<int> col_idx = {0, 2, 1, 3, 4, 0, 4};
+  std::vector<double> values = {1, 2, 3, 4, 5, 6, 7};
+
+  stdex::csr_matrix_view<double const> view() const {
+    using view_type = stdex::csr_matrix_view<double const>;
+    return view_type(5,
+      view_type::row_ptr_type(row_ptr.data(), row_ptr.size()),
+      view_type::column_indices_type(col_idx.data(), col_idx.size()),
+      view_type::values_type(values.data(), values.size())
+    );
+  }
+};
+
+TEST(TestCSRMatrixView, sizes_and_rows) {
+  csr_fixture f;
+  auto A = f.view();
+  ASSERT_EQ(A.num_rows(), 4);
+  ASSERT_EQ(A.num_cols(), 5);
+  ASSERT_EQ(A.nnz(), 7);
+  ASSERT_EQ(A.row_values(1).extent(0), 0);
+  auto vals = A.row_values(2);
+  auto cols = A.row_column_indices(2);
+  ASSERT_EQ(vals.extent(0), 3);
+  ASSERT_EQ(cols(0), 1);
+  ASSERT_EQ(vals(2), 5);
+}
+
+TEST(TestCSRMatrixView, matrix_vector_product) {
+  csr_fixture f;
+  auto A = f.view();
+  std::vector<double> x_buffer = {1, 2, 3, 4, 5};
+  std::vector<double> expected = {7, 0, 47, 41};
+  auto x = stdex::mdspan<double const, stdex::dextents<1>>(x_buffer.data(), 5);
+  {
+    std::vector<double> y_buffer(4, -1);
+    stdex::sparse_matrix_vector_product(A, x, stdex::mdspan<double, stdex::dextents<1>>(y_buffer.data(), 4));
+    ASSERT_EQ(y_buffer, expected);
+  }
+  {
+    std::vector<double> y_buffer(4, -1);
+    stdex::sparse_matrix_vector_product(stdex::execution::par, A, x, stdex::mdspan<double, stdex::dextents<1>>(y_buffer.data(), 4));
+    ASSERT_EQ(y_buffer, expected);
+  }
+  {
+    // y may be strided, e.g., a column of a layout_left matrix
+    std::vector<double> y_buffer(8, -1);
+    auto Y = stdex::mdspan<double, stdex::dextents<2>, stdex::layout_right>(y_buffer.data(), 4, 2);
+    stdex::sparse_matrix_vector_product(A, x, stdex::submdspan(Y, stdex::full_extent, 1));
+    for(size_t i = 0; i < 4; ++i) {
+      ASSERT_EQ(Y(i, 0), -1);
+      ASSERT_EQ(Y(i, 1), expected[i]);
+    }
+  }
+}
+
+TEST(TestCSRMatrixView, balanced_row_split) {
+  // one heavy row in front of many light ones
+  std::vector<size_t> row_ptr = {0, 1000};
+  for(size_t i = 0; i < 1000; ++i) row_ptr.push_back(row_ptr.back() + 1);
+  std::vector<int> col_idx(row_ptr.back(), 0);
+  std::vector<float> values(row_ptr.back(), 1.0f);
+  using view_type = stdex::csr_matrix_view<float>;
+  view_type A(1,
+    view_type::row_ptr_type(row_ptr.data(), row_ptr.size()),
+    view_type::column_indices_type(col_idx.data(), col_idx.size()),
+    view_type::values_type(values.data(), values.size())
+  );
+  ASSERT_EQ(A.num_rows(), 1001);
+  for(size_t parts : {1, 2, 3, 4, 7}) {
+    ASSERT_EQ(A.balanced_row_split(0, parts), 0);
+    ASSERT_EQ(A.balanced_row_split(parts, parts), A.num_rows());
+    for(size_t p = 0; p < parts; ++p) {
+      ASSERT_LE(A.balanced_row_split(p, parts), A.balanced_row_split(p + 1, parts));
+    }
+  }
+  // every row costs its length plus one: the heavy row alone (1001) is about
+  // a third of the total (3001), the light rows 2 each
+  ASSERT_EQ(A.balanced_row_split(1, 4), 1);
+  ASSERT_EQ(A.balanced_row_split(1, 2), 251);
+  ASSERT_EQ(A.balanced_row_split(3, 4), 626);
+}
+
+TEST(TestCSRMatrixView, nonzero_first_offset) {
+  // rows 2 and 3 of the fixture matrix, sharing its column indices and values
+  csr_fixture f;
+  using view_type = stdex::csr_matrix_view<double const>;
+  view_type A(5,
+    view_type::row_ptr_type(f.row_ptr.data() + 2, 3),
+    view_type::column_indices_type(f.col_idx.data(), f.col_idx.size()),
+    view_type::values_type(f.values.data(), f.values.size())
+  );
+  ASSERT_EQ(A.num_rows(), 2);
+  ASSERT_EQ(A.nnz(), 5);
+  ASSERT_EQ(A.balanced_row_split(1, 2), 1);
+  std::vector<double> x_buffer = {1, 2, 3, 4, 5}, y_buffer(2);
+  stdex::sparse_matrix_vector_product(stdex::execution::par, A,
+    stdex::mdspan<double, stdex::dextents<1>>(x_buffer.data(), 5),
+    stdex::mdspan<double, stdex::dextents<1>>(y_buffer.data(), 2));
+  ASSERT_EQ(y_buffer[0], 47);
+  ASSERT_EQ(y_buffer[1], 41);
+}
@@ -0,0 +1,244 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+namespace stdex = std::experimental;
+
+namespace {
+
+// layout_right moved Offset elements into the span, so that the origin is
+// not at offset 0
+template <size_t Offset>
+struct layout_right_shifted {
+  template <class Extents>
+  struct mapping {
+    using extents_type = Extents;
+    using layout_type = layout_right_shifted;
+
+    mapping() = default;
+    explicit mapping(Extents const& e) : base(e) { }
+
+    Extents extents() const noexcept { return base.extents(); }
+    template <class... Indices>
+    size_t operator()(Indices... idx) const noexcept { return Offset + base(idx...); }
+    size_t required_span_size() const noexcept { return Offset + base.required_span_size(); }
+    size_t stride(size_t r) const noexcept { return base.stride(r); }
+
+    static constexpr bool is_always_unique() noexcept { return true; }
+    static constexpr bool is_always_contiguous() noexcept { return false; }
+    static constexpr bool is_always_strided() noexcept { return true; }
+    bool is_unique() const noexcept { return true; }
+    bool is_contiguous() const noexcept { return false; }
+    bool is_strided() const noexcept { return true; }
+
+    stdex::layout_right::mapping<Extents> base;
+  };
+};
+
+} // end anonymous namespace
+
+TEST(TestElements, test_elements_layout_right_order) {
+  std::vector<int> buffer(3 * 4 * 5);
+  std::iota(buffer.begin(), buffer.end(), 0);
+  stdex::mdspan<int, stdex::extents<3, stdex::dynamic_extent, 5>> a(buffer.data(), 4);
+  auto r = stdex::elements(a);
+  ASSERT_EQ(r.size(), 60);
+  size_t count = 0;
+  for(auto it = r.begin(); it != r.end(); ++it, ++count) {
+    auto idx = it.index();
+    EXPECT_EQ(idx[0], count / 20);
+    EXPECT_EQ(idx[1], count / 5 % 4);
+    EXPECT_EQ(idx[2], count % 5);
+    EXPECT_EQ(&*it, &a(idx[0], idx[1], idx[2]));
+  }
+  EXPECT_EQ(count, 60);
+}
+
+TEST(TestElements, test_elements_layout_left_order) {
+  std::vector<int> buffer(4 * 3 * 2);
+  std::iota(buffer.begin(), buffer.end(), 0);
+  stdex::mdspan<int, stdex::dextents<3>, stdex::layout_left> a(buffer.data(), 4, 3, 2);
+  int expected = 0;
+  for(auto it = stdex::elements(a).begin(); it != stdex::elements(a).end(); ++it) {
+    auto idx = it.index();
+    EXPECT_EQ(*it, expected++);
+    EXPECT_EQ(*it, a(idx[0], idx[1], idx[2]));
+  }
+  EXPECT_EQ(expected, 24);
+}
+
+TEST(TestElements, test_elements_layout_stride) {
+  // a 3 x 4 x 2 view with padding in every dimension, in a 4 x 6 x 5 array
+  std::vector<int> buffer(4 * 6 * 5, -1);
+  using map_type = stdex::layout_stride::mapping<stdex::dextents<3>>;
+  stdex::mdspan<int, stdex::dextents<3>, stdex::layout_stride> a(
+    buffer.data() + 7, map_type(stdex::dextents<3>(3, 4, 2), stdex::dextents<3>(30, 6, 2))
+  );
+  int value = 0;
+  for(int& x : stdex::elements(a)) x = value++;
+  EXPECT_EQ(value, 24);
+  value = 0;
+  for(size_t i = 0; i < 3; ++i)
+    for(size_t j = 0; j < 4; ++j)
+      for(size_t k = 0; k < 2; ++k)
+        EXPECT_EQ(a(i, j, k), value++);
+  EXPECT_EQ(std::count(buffer.begin(), buffer.end(), -1), 120 - 24);
+  auto r = stdex::elements(a);
+  EXPECT_EQ(std::accumulate(r.begin(), r.end(), 0), 23 * 24 / 2);
+}
+
+TEST(TestElements, test_elements_for_each_matches_iterators) {
+  std::vector<int> buffer(6 * 8);
+  std::iota(buffer.begin(), buffer.end(), 0);
+  stdex::mdspan<int, stdex::dextents<2>> a(buffer.data(), 6, 8);
+  // unit and non-unit innermost strides
+  using map_type = stdex::layout_stride::mapping<stdex::dextents<3>>;
+  stdex::mdspan<int, stdex::dextents<3>, stdex::layout_stride> s(
+    buffer.data() + 1, map_type(stdex::dextents<3>(2, 3, 4), stdex::dextents<3>(24, 8, 1))
+  );
+  stdex::mdspan<int, stdex::dextents<3>, stdex::layout_stride> t(
+    buffer.data() + 1, map_type(stdex::dextents<3>(2, 3, 4), stdex::dextents<3>(24, 4, 2))
+  );
+  auto check = [](auto m) {
+    std::vector<int> from_iterators, from_for_each;
+    for(int x : stdex::elements(m)) from_iterators.push_back(x);
+    stdex::elements(m).for_each([&](int x) { from_for_each.push_back(x); });
+    EXPECT_EQ(from_iterators.size(), m.size());
+    EXPECT_EQ(from_for_each, from_iterators);
+  };
+  check(a);
+  check(s);
+  check(t);
+}
+
+TEST(TestElements, test_elements_rank_0_and_empty) {
+  int x = 42;
+  stdex::mdspan<int, stdex::extents<>> s(&x);
+  auto r0 = stdex::elements(s);
+  ASSERT_EQ(r0.size(), 1);
+  auto it = r0.begin();
+  EXPECT_EQ(*it, 42);
+  EXPECT_EQ(++it, r0.end());
+
+  stdex::mdspan<int, stdex::dextents<2>> e(&x, 3, 0);
+  auto r = stdex::elements(e);
+  EXPECT_TRUE(r.empty());
+  EXPECT_EQ(r.begin(), r.end());
+  r.for_each([](int) { ADD_FAILURE(); });
+}
+
+TEST(TestElements, test_elements_nonzero_origin) {
+  std::vector<int> buffer(7 + 3 * 4);
+  std::iota(buffer.begin(), buffer.end(), 0);
+  using mapping_type = layout_right_shifted<7>::mapping<stdex::dextents<2>>;
+  stdex::mdspan<int, stdex::dextents<2>, layout_right_shifted<7>> a(buffer.data(), mapping_type(stdex::dextents<2>(3, 4)));
+  auto r = stdex::elements(a);
+  size_t count = 0;
+  for(auto it = r.begin(); it != r.end(); ++it, ++count) {
+    auto idx = it.index();
+    EXPECT_EQ(&*it, &a(idx[0], idx[1]));
+  }
+  EXPECT_EQ(count, 12);
+  int sum = 0;
+  r.for_each([&](int x) { sum += x; });
+  EXPECT_EQ(sum, stdex::reduce(a, 0));
+  EXPECT_EQ(sum, (7 + 18) * 12 / 2);
+}
+
+TEST(TestElements, test_elements_proxy_reference) {
+  std::vector<uint32_t> buffer(2 * 3);
+  for(size_t i = 0; i < buffer.size(); ++i) buffer[i] = __builtin_bswap32(uint32_t(i + 1));
+  stdex::mdspan<uint32_t const, stdex::dextents<2>, stdex::layout_right, stdex::byteswap_accessor<uint32_t const>> a(buffer.data(), 2, 3);
+  auto r = stdex::elements(a);
+  static_assert(std::is_same<decltype(r)::iterator::iterator_category, std::input_iterator_tag>::value, "");
+  EXPECT_EQ(std::accumulate(r.begin(), r.end(), uint32_t(0)), 21);
+}
+
+TEST(TestElements, test_elements_offset_policy_accessor) {
+  // bitpacked_accessor's offset_policy has a different data handle type
+  using accessor_type = stdex::bitpacked_accessor<uint8_t>;
+  std::vector<uint8_t> words(accessor_type::words_for(3 * 5 * 7), 0);
+  stdex::mdspan<bool, stdex::dextents<3>, stdex::layout_right, accessor_type> m(words.data(), 3, 5, 7);
+  for(size_t i = 0; i < 3; ++i)
+    for(size_t j = 0; j < 5; ++j)
+      for(size_t k = 0; k < 7; ++k)
+        m(i, j, k) = (i + j + k) % 3 == 0;
+  auto r = stdex::elements(m);
+  size_t count = 0;
+  for(auto it = r.begin(); it != r.end(); ++it, ++count) {
+    auto idx = it.index();
+    EXPECT_EQ(bool(*it), (idx[0] + idx[1] + idx[2]) % 3 == 0);
+  }
+  EXPECT_EQ(count, 3 * 5 * 7);
+  size_t num_set = 0;
+  r.for_each([&](bool b) { num_set += b ? 1 : 0; });
+  EXPECT_EQ(num_set, 35);
+}
+
+#if defined(__cpp_lib_ranges)
+TEST(TestElements, test_elements_ranges) {
+  std::vector<int> buffer(5 * 6);
+  stdex::mdspan<int, stdex::dextents<2>> a(buffer.data(), 5, 6);
+  auto sub = stdex::submdspan(a, std::make_pair(1, 4), std::make_pair(2, 5));
+  using range_type = decltype(stdex::elements(sub));
+  static_assert(std::ranges::forward_range<range_type>);
+  static_assert(std::ranges::common_range<range_type>);
+  static_assert(std::forward_iterator<range_type::iterator>);
+  std::ranges::fill(stdex::elements(sub), 1);
+  EXPECT_EQ(std::ranges::count(stdex::elements(a), 1), 9);
+  EXPECT_EQ(std::ranges::count(stdex::elements(sub), 1), 9);
+}
+#endif
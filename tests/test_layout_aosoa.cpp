@@ -0,0 +1,115 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+using layout_aosoa_4 = stdex::layout_aosoa<4>;
+
+TEST(TestLayoutAoSoA, full_blocks_are_contiguous) {
+  using extents_type = stdex::extents<dyn, 2, 3>;
+  auto map = layout_aosoa_4::mapping<extents_type>(extents_type(8));
+  ASSERT_EQ(map.element_count(), 6);
+  ASSERT_EQ(map.block_size(), 24);
+  ASSERT_EQ(map.num_blocks(), 2);
+  ASSERT_EQ(map.required_span_size(), 48);
+  ASSERT_TRUE(map.is_unique());
+  ASSERT_TRUE(map.is_contiguous());
+  // the same element of the objects of a block is contiguous
+  ASSERT_EQ(map(0, 0, 0), 0);
+  ASSERT_EQ(map(1, 0, 0), 1);
+  ASSERT_EQ(map(3, 0, 0), 3);
+  ASSERT_EQ(map(0, 0, 1), 4);
+  ASSERT_EQ(map(0, 1, 0), 12);
+  ASSERT_EQ(map(2, 1, 2), 22);
+  // second block
+  ASSERT_EQ(map(4, 0, 0), 24);
+  ASSERT_EQ(map(7, 1, 2), 47);
+}
+
+TEST(TestLayoutAoSoA, last_block_is_padded) {
+  using extents_type = stdex::extents<dyn, dyn>;
+  auto map = layout_aosoa_4::mapping<extents_type>(extents_type(10, 3));
+  ASSERT_EQ(map.num_blocks(), 3);
+  ASSERT_EQ(map.required_span_size(), 36);
+  ASSERT_FALSE(map.is_contiguous());
+  std::vector<int> hits(map.required_span_size(), 0);
+  for(size_t b = 0; b < 10; ++b) {
+    for(size_t e = 0; e < 3; ++e) {
+      size_t offset = map(b, e);
+      ASSERT_LT(offset, map.required_span_size());
+      ASSERT_EQ(offset / map.block_size(), b / 4);
+      ++hits[offset];
+    }
+  }
+  for(auto h : hits) ASSERT_LE(h, 1);
+  ASSERT_EQ(layout_aosoa_4::mapping<extents_type>(extents_type(0, 3)).required_span_size(), 0);
+}
+
+TEST(TestLayoutAoSoA, rank_one_is_a_plain_vector) {
+  using extents_type = stdex::extents<dyn>;
+  auto map = layout_aosoa_4::mapping<extents_type>(extents_type(6));
+  for(size_t b = 0; b < 6; ++b) ASSERT_EQ(map(b), b);
+  ASSERT_EQ(map.required_span_size(), 8);
+}
+
+TEST(TestLayoutAoSoA, mdspan_access_and_conversion) {
+  std::vector<int> data(2 * 4 * 4);
+  stdex::mdspan<int, stdex::extents<dyn, 2, 2>, layout_aosoa_4> m(data.data(), 7);
+  ASSERT_EQ(m.mapping().required_span_size(), data.size());
+  for(size_t b = 0; b < 7; ++b)
+    for(size_t i = 0; i < 2; ++i)
+      for(size_t j = 0; j < 2; ++j)
+        m(b, i, j) = int(b * 100 + i * 10 + j);
+  stdex::mdspan<int const, stdex::extents<dyn, dyn, dyn>, layout_aosoa_4> c = m;
+  ASSERT_EQ(c.extent(1), 2);
+  ASSERT_EQ(c(5, 1, 0), 510);
+  ASSERT_EQ(data[4 * 4 + 2 * 4 + 1], 510);
+  ASSERT_TRUE(c.mapping() == m.mapping());
+}
@@ -0,0 +1,136 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+using layout_bc_2_3 = stdex::layout_block_cyclic<2, 3>;
+
+TEST(TestLayoutBlockCyclic, single_process_is_layout_left) {
+  using extents_type = stdex::extents<dyn, dyn>;
+  auto map = layout_bc_2_3::mapping<extents_type>(extents_type(5, 7));
+  auto left = stdex::layout_left::mapping<extents_type>(extents_type(5, 7));
+  ASSERT_EQ(map.required_span_size(), left.required_span_size());
+  ASSERT_TRUE(map.is_unique());
+  ASSERT_TRUE(map.is_contiguous());
+  for(size_t i = 0; i < 5; ++i) {
+    for(size_t j = 0; j < 7; ++j) {
+      ASSERT_EQ(map(i, j), left(i, j));
+    }
+  }
+}
+
+TEST(TestLayoutBlockCyclic, local_extents_cover_global_extents) {
+  using extents_type = stdex::extents<11, 13>;
+  size_t total = 0;
+  for(size_t p = 0; p < 3; ++p) {
+    for(size_t q = 0; q < 2; ++q) {
+      auto map = layout_bc_2_3::mapping<extents_type>(extents_type(), {{3, 2}}, {{p, q}});
+      ASSERT_EQ(map.required_span_size(), map.local_extents().extent(0) * map.local_extents().extent(1));
+      total += map.required_span_size();
+    }
+  }
+  ASSERT_EQ(total, 11 * 13);
+}
+
+TEST(TestLayoutBlockCyclic, owner_and_local_offsets) {
+  using extents_type = stdex::dextents<2>;
+  constexpr size_t nprow = 3, npcol = 2, m = 11, n = 13;
+  std::vector<std::vector<int>> hits(nprow * npcol);
+  for(size_t p = 0; p < nprow; ++p) {
+    for(size_t q = 0; q < npcol; ++q) {
+      auto map = layout_bc_2_3::mapping<extents_type>(extents_type(m, n), {{nprow, npcol}}, {{p, q}});
+      hits[p * npcol + q].resize(map.required_span_size(), 0);
+    }
+  }
+  for(size_t i = 0; i < m; ++i) {
+    for(size_t j = 0; j < n; ++j) {
+      auto owner = layout_bc_2_3::mapping<extents_type>(extents_type(m, n), {{nprow, npcol}}, {{0, 0}}).owner(i, j);
+      ASSERT_EQ(owner[0], (i / 2) % nprow);
+      ASSERT_EQ(owner[1], (j / 3) % npcol);
+      auto map = layout_bc_2_3::mapping<extents_type>(extents_type(m, n), {{nprow, npcol}}, owner);
+      ASSERT_TRUE(map.is_local(i, j));
+      size_t offset = map(i, j);
+      ASSERT_LT(offset, map.required_span_size());
+      ++hits[owner[0] * npcol + owner[1]][offset];
+      // global_index() is the inverse of the mapping on the owning process
+      auto lexts = map.local_extents();
+      auto g = map.global_index(offset % lexts.extent(0), offset / lexts.extent(0));
+      ASSERT_EQ(g[0], i);
+      ASSERT_EQ(g[1], j);
+    }
+  }
+  // every local element is hit exactly once
+  for(auto const& h : hits) {
+    for(auto count : h) {
+      ASSERT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(TestLayoutBlockCyclic, mdspan_access) {
+  using extents_type = stdex::extents<4, 6>;
+  using mapping_type = layout_bc_2_3::mapping<extents_type>;
+  // process (1, 0) of a 2x2 grid owns rows {2, 3} and columns {0, 1, 2}
+  auto map = mapping_type(extents_type(), {{2, 2}}, {{1, 0}});
+  ASSERT_EQ(map.local_extents().extent(0), 2);
+  ASSERT_EQ(map.local_extents().extent(1), 3);
+  std::vector<int> local(map.required_span_size());
+  stdex::mdspan<int, extents_type, layout_bc_2_3> s(local.data(), map);
+  for(size_t i = 2; i < 4; ++i) {
+    for(size_t j = 0; j < 3; ++j) {
+      s(i, j) = int(10 * i + j);
+    }
+  }
+  // column-major local storage
+  ASSERT_EQ(local[0], 20);
+  ASSERT_EQ(local[1], 30);
+  ASSERT_EQ(local[2], 21);
+  ASSERT_EQ(local[5], 32);
+}
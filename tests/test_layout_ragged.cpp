@@ -0,0 +1,141 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace stdex = std::experimental;
+
+TEST(TestLayoutRagged, mapping) {
+  std::vector<size_t> offsets = {0, 3, 3, 4, 8};
+  using mapping_type = stdex::layout_ragged::mapping<stdex::dextents<2>>;
+  mapping_type map(stdex::dextents<2>(4, 4), offsets.data());
+  ASSERT_EQ(map.required_span_size(), 8);
+  ASSERT_EQ(map.row_length(0), 3);
+  ASSERT_EQ(map.row_length(1), 0);
+  ASSERT_EQ(map(0, 2), 2);
+  ASSERT_EQ(map(2, 0), 3);
+  ASSERT_EQ(map(3, 3), 7);
+  ASSERT_FALSE(map.is_unique());
+  ASSERT_EQ(map, mapping_type(stdex::dextents<2>(4, 4), offsets.data()));
+}
+
+TEST(TestLayoutRagged, offsets_from_counts) {
+  std::vector<int> counts_buffer(1000);
+  for(size_t i = 0; i < counts_buffer.size(); ++i) counts_buffer[i] = int(i % 7);
+  auto counts = stdex::mdspan<int const, stdex::dextents<1>>(counts_buffer.data(), counts_buffer.size());
+  std::vector<size_t> seq_buffer(1001, 42), par_buffer(1001, 42);
+  auto longest_seq = stdex::ragged_offsets_from_counts(stdex::execution::seq, counts,
+    stdex::mdspan<size_t, stdex::dextents<1>>(seq_buffer.data(), seq_buffer.size()));
+  auto longest_par = stdex::ragged_offsets_from_counts(stdex::execution::par, counts,
+    stdex::mdspan<size_t, stdex::dextents<1>>(par_buffer.data(), par_buffer.size()));
+  ASSERT_EQ(longest_seq, 6);
+  ASSERT_EQ(longest_par, 6);
+  ASSERT_EQ(seq_buffer[0], 0);
+  for(size_t i = 0; i < counts_buffer.size(); ++i) {
+    ASSERT_EQ(seq_buffer[i + 1], seq_buffer[i] + size_t(counts_buffer[i]));
+  }
+  ASSERT_EQ(seq_buffer, par_buffer);
+}
+
+#if defined(_OPENMP)
+TEST(TestLayoutRagged, offsets_from_counts_nested_parallel) {
+  // Called from a team of two with nested parallelism enabled, the inner
+  // team is larger than the calling one
+  std::vector<int> counts_buffer(1000);
+  for(size_t i = 0; i < counts_buffer.size(); ++i) counts_buffer[i] = int(i % 7);
+  auto counts = stdex::mdspan<int const, stdex::dextents<1>>(counts_buffer.data(), counts_buffer.size());
+  std::vector<size_t> expected(1001);
+  stdex::ragged_offsets_from_counts(stdex::execution::seq, counts,
+    stdex::mdspan<size_t, stdex::dextents<1>>(expected.data(), expected.size()));
+  int saved_levels = omp_get_max_active_levels();
+  omp_set_max_active_levels(2);
+  std::vector<std::vector<size_t>> results(2, std::vector<size_t>(1001));
+  std::vector<size_t> longest(2);
+  #pragma omp parallel num_threads(2)
+  {
+    size_t t = size_t(omp_get_thread_num());
+    longest[t] = stdex::ragged_offsets_from_counts(stdex::execution::par, counts,
+      stdex::mdspan<size_t, stdex::dextents<1>>(results[t].data(), results[t].size()));
+  }
+  omp_set_max_active_levels(saved_levels);
+  for(size_t t = 0; t < 2; ++t) {
+    ASSERT_EQ(longest[t], 6);
+    ASSERT_EQ(results[t], expected);
+  }
+}
+#endif
+
+TEST(TestLayoutRagged, ragged_array) {
+  std::vector<unsigned> counts_buffer = {2, 0, 5, 1};
+  auto counts = stdex::mdspan<unsigned, stdex::dextents<1>>(counts_buffer.data(), counts_buffer.size());
+  stdex::ragged_array<double> a(stdex::execution::par, counts);
+  ASSERT_EQ(a.num_rows(), 4);
+  ASSERT_EQ(a.size(), 8);
+  ASSERT_EQ(a.longest_row(), 5);
+  auto v = a.view();
+  ASSERT_EQ(v.extent(0), 4);
+  ASSERT_EQ(v.extent(1), 5);
+  for(size_t i = 0; i < a.num_rows(); ++i) {
+    ASSERT_EQ(a.row(i).extent(0), counts_buffer[i]);
+    for(size_t j = 0; j < a.row_length(i); ++j) {
+      ASSERT_EQ(v(i, j), 0.0);
+      v(i, j) = double(10 * i + j);
+    }
+  }
+  // rows are stored back to back
+  double expected[] = {0, 1, 20, 21, 22, 23, 24, 30};
+  for(size_t k = 0; k < a.size(); ++k) {
+    ASSERT_EQ(a.data()[k], expected[k]);
+  }
+  stdex::ragged_array<double> const& ca = a;
+  ASSERT_EQ(ca.row(2)(4), 24);
+  ASSERT_EQ(ca.offsets()(3), 7);
+}
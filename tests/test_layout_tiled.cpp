@@ -0,0 +1,117 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+using layout_tiled_2_4 = stdex::layout_tiled<2, 4>;
+
+TEST(TestLayoutTiled, exact_tiles_are_contiguous) {
+  using extents_type = stdex::extents<4, 8>;
+  auto map = layout_tiled_2_4::mapping<extents_type>(extents_type());
+  static_assert(layout_tiled_2_4::mapping<extents_type>::tile_size() == 8, "");
+  ASSERT_EQ(map.num_tiles(), 4);
+  ASSERT_EQ(map.required_span_size(), 32);
+  ASSERT_TRUE(map.is_unique());
+  ASSERT_TRUE(map.is_contiguous());
+  // tile (0, 1) is the second tile, stored in C order
+  ASSERT_EQ(map(0, 4), 8);
+  ASSERT_EQ(map(0, 5), 9);
+  ASSERT_EQ(map(1, 4), 12);
+  // tile (1, 0)
+  ASSERT_EQ(map(2, 0), 16);
+  ASSERT_EQ(map(3, 7), 31);
+}
+
+TEST(TestLayoutTiled, edge_tiles_are_padded) {
+  using extents_type = stdex::extents<dyn, dyn>;
+  auto map = layout_tiled_2_4::mapping<extents_type>(extents_type(5, 7));
+  ASSERT_EQ(map.tile_grid_extent(0), 3);
+  ASSERT_EQ(map.tile_grid_extent(1), 2);
+  ASSERT_EQ(map.required_span_size(), 6 * 8);
+  ASSERT_FALSE(map.is_contiguous());
+  std::vector<int> hits(map.required_span_size(), 0);
+  for(size_t i = 0; i < 5; ++i) {
+    for(size_t j = 0; j < 7; ++j) {
+      size_t offset = map(i, j);
+      ASSERT_LT(offset, map.required_span_size());
+      // every tile starts at a multiple of the tile size
+      ASSERT_EQ(offset / map.tile_size(), (i / 2) * 2 + j / 4);
+      ++hits[offset];
+    }
+  }
+  for(auto h : hits) ASSERT_LE(h, 1);
+  ASSERT_EQ(layout_tiled_2_4::mapping<extents_type>(extents_type(0, 7)).required_span_size(), 0);
+}
+
+TEST(TestLayoutTiled, mdspan_access) {
+  using extents_type = stdex::extents<dyn, dyn, dyn>;
+  using layout_type = stdex::layout_tiled<2, 2, 4>;
+  auto map = layout_type::mapping<extents_type>(extents_type(3, 4, 5));
+  std::vector<int> data(map.required_span_size(), -1);
+  stdex::mdspan<int, extents_type, layout_type> s(data.data(), map);
+  for(size_t i = 0; i < 3; ++i) {
+    for(size_t j = 0; j < 4; ++j) {
+      for(size_t k = 0; k < 5; ++k) {
+        s(i, j, k) = int(100 * i + 10 * j + k);
+      }
+    }
+  }
+  for(size_t i = 0; i < 3; ++i) {
+    for(size_t j = 0; j < 4; ++j) {
+      for(size_t k = 0; k < 5; ++k) {
+        ASSERT_EQ(s(i, j, k), int(100 * i + 10 * j + k));
+      }
+    }
+  }
+  // the first tile holds i, j in [0, 2) and k in [0, 4)
+  ASSERT_EQ(data[0], 0);
+  ASSERT_EQ(data[4], 10);
+  ASSERT_EQ(data[8], 100);
+}
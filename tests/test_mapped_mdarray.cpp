@@ -0,0 +1,151 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_MDSPAN_HAS_MMAP)
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+std::string temp_path(char const* name) {
+  return testing::TempDir() + "mdspan_test_" + name;
+}
+
+} // namespace
+
+TEST(TestMappedMdarray, create_then_reopen) {
+  auto path = temp_path("create_then_reopen");
+  using extents_type = stdex::extents<dyn, 4, dyn>;
+  using mapping_type = stdex::layout_right::mapping<extents_type>;
+  auto map = mapping_type(extents_type(3, 5));
+  {
+    stdex::mapped_mdarray<int, extents_type> a(path.c_str(), map, stdex::mapped_file_mode::create);
+    ASSERT_TRUE(a.is_mapped());
+    ASSERT_EQ(a.size(), 60);
+    auto v = a.view();
+    for(size_t i = 0; i < 3; ++i)
+      for(size_t j = 0; j < 4; ++j)
+        for(size_t k = 0; k < 5; ++k)
+          v(i, j, k) = int(100 * i + 10 * j + k);
+    a.sync();
+  }
+  {
+    stdex::mapped_mdarray<int const, extents_type> a(path.c_str(), map);
+    auto v = a.view();
+    ASSERT_EQ(v(2, 3, 4), 234);
+    ASSERT_EQ(v(1, 0, 2), 102);
+    ASSERT_EQ(a.data()[5], 10);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(TestMappedMdarray, unaligned_file_offset) {
+  auto path = temp_path("unaligned_file_offset");
+  using extents_type = stdex::dextents<2>;
+  auto map = stdex::layout_left::mapping<extents_type>(extents_type(7, 3));
+  {
+    // a 10 byte header, which create keeps
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite("0123456789", 1, 10, f);
+    std::fclose(f);
+    stdex::mapped_mdarray<char, extents_type, stdex::layout_left> a(path.c_str(), map, stdex::mapped_file_mode::create, 10);
+    for(size_t j = 0; j < 3; ++j)
+      for(size_t i = 0; i < 7; ++i)
+        a.view()(i, j) = char('a' + i + j);
+  }
+  stdex::mapped_mdarray<char const, extents_type, stdex::layout_left> header(
+    path.c_str(), stdex::layout_left::mapping<extents_type>(extents_type(10, 1)));
+  ASSERT_EQ(header.view()(9, 0), '9');
+  stdex::mapped_mdarray<char const, extents_type, stdex::layout_left> a(path.c_str(), map, stdex::mapped_file_mode::open_existing, 10);
+  ASSERT_EQ(a.view()(0, 0), 'a');
+  ASSERT_EQ(a.view()(6, 2), 'a' + 8);
+  // a mapped range past the end of the file is an error
+  using array_type = stdex::mapped_mdarray<char const, extents_type, stdex::layout_left>;
+  ASSERT_THROW(array_type(path.c_str(), map, stdex::mapped_file_mode::open_existing, 11), std::system_error);
+  std::remove(path.c_str());
+}
+
+TEST(TestMappedMdarray, errors_and_moves) {
+  using extents_type = stdex::extents<16>;
+  using array_type = stdex::mapped_mdarray<double const, extents_type>;
+  auto missing = temp_path("does_not_exist");
+  ASSERT_THROW(array_type(missing.c_str(), {}), std::system_error);
+  ASSERT_THROW(array_type(missing.c_str(), {}, stdex::mapped_file_mode::create), std::system_error);
+
+  auto path = temp_path("errors_and_moves");
+  stdex::mapped_mdarray<double, extents_type> a(path.c_str(), {}, stdex::mapped_file_mode::create);
+  a.view()(3) = 1.5;
+  auto b = std::move(a);
+  ASSERT_FALSE(a.is_mapped());
+  ASSERT_EQ(b.view()(3), 1.5);
+  a = std::move(b);
+  ASSERT_EQ(a.view()(3), 1.5);
+  std::remove(path.c_str());
+}
+
+TEST(TestMappedMdarray, traversal_advice) {
+  auto path = temp_path("traversal_advice");
+  using extents_type = stdex::dextents<3>;
+  // each (i, j) plane is 64 KiB, so stepping in i jumps pages
+  auto map = stdex::layout_right::mapping<extents_type>(extents_type(8, 128, 128));
+  stdex::mapped_mdarray<float, extents_type> a(path.c_str(), map, stdex::mapped_file_mode::create);
+  ASSERT_EQ(a.advise_traversal({{0, 1, 2}}), stdex::mapped_access::sequential);
+  ASSERT_EQ(a.advise_traversal({{0, 2, 1}}), stdex::mapped_access::normal);
+  ASSERT_EQ(a.advise_traversal({{2, 1, 0}}), stdex::mapped_access::random);
+  a.advise(stdex::mapped_access::willneed, 128 * 128, 2 * 128 * 128);
+  a.advise(stdex::mapped_access::normal);
+  std::remove(path.c_str());
+}
+
+#endif // _MDSPAN_HAS_MMAP
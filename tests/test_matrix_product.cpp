@@ -0,0 +1,186 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+// Small integers, so that every product is exact in float and double
+template <class MDSpan>
+void fill(MDSpan m, int seed) {
+  for(size_t i = 0; i < m.extent(0); ++i)
+    for(size_t j = 0; j < m.extent(1); ++j)
+      m(i, j) = typename MDSpan::value_type(int((i * 31 + j * 17 + size_t(seed)) % 11) - 5);
+}
+
+template <class MDSpanA, class MDSpanB, class MDSpanC>
+void expect_product(MDSpanA A, MDSpanB B, MDSpanC C) {
+  for(size_t i = 0; i < C.extent(0); ++i) {
+    for(size_t j = 0; j < C.extent(1); ++j) {
+      typename MDSpanC::value_type expected = 0;
+      for(size_t p = 0; p < A.extent(1); ++p) expected += A(i, p) * B(p, j);
+      ASSERT_EQ(C(i, j), expected) << "at " << i << ", " << j;
+    }
+  }
+}
+
+template <class T, class LayoutA, class LayoutB, class LayoutC, class Policy>
+void check_layouts(Policy policy, size_t m, size_t n, size_t k) {
+  std::vector<T> a(m * k), b(k * n), c(m * n, T(1000));
+  stdex::mdspan<T, stdex::dextents<2>, LayoutA> A(a.data(), m, k);
+  stdex::mdspan<T, stdex::dextents<2>, LayoutB> B(b.data(), k, n);
+  stdex::mdspan<T, stdex::dextents<2>, LayoutC> C(c.data(), m, n);
+  fill(A, 1);
+  fill(B, 2);
+  stdex::matrix_product(policy, A, B, C);
+  expect_product(A, B, C);
+}
+
+} // namespace
+
+TEST(TestMatrixProduct, small_and_ragged_sizes) {
+  check_layouts<double, stdex::layout_right, stdex::layout_right, stdex::layout_right>(stdex::execution::seq, 3, 4, 5);
+  // partial register tiles at every edge, and more than one block of k
+  check_layouts<double, stdex::layout_right, stdex::layout_right, stdex::layout_right>(stdex::execution::seq, 67, 53, 300);
+  check_layouts<float, stdex::layout_right, stdex::layout_right, stdex::layout_right>(stdex::execution::par, 131, 77, 290);
+  // more rows than one block of A
+  check_layouts<float, stdex::layout_right, stdex::layout_right, stdex::layout_right>(stdex::execution::par, 600, 40, 40);
+}
+
+TEST(TestMatrixProduct, every_layout_combination) {
+  check_layouts<double, stdex::layout_left, stdex::layout_left, stdex::layout_left>(stdex::execution::par, 45, 38, 61);
+  check_layouts<double, stdex::layout_left, stdex::layout_right, stdex::layout_right>(stdex::execution::seq, 45, 38, 61);
+  check_layouts<double, stdex::layout_right, stdex::layout_left, stdex::layout_left>(stdex::execution::par, 45, 38, 61);
+  check_layouts<float, stdex::layout_left, stdex::layout_right, stdex::layout_left>(stdex::execution::seq, 45, 38, 61);
+
+  // layout_stride views of larger matrices
+  std::vector<double> a(80 * 90), b(90 * 70), c(80 * 70);
+  stdex::mdspan<double, stdex::dextents<2>> A_full(a.data(), 80, 90);
+  stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> B_full(b.data(), 90, 70);
+  stdex::mdspan<double, stdex::dextents<2>> C_full(c.data(), 80, 70);
+  fill(A_full, 3);
+  fill(B_full, 4);
+  auto A = stdex::submdspan(A_full, std::make_pair(5, 75), std::make_pair(10, 80));
+  auto B = stdex::submdspan(B_full, std::make_pair(0, 70), std::make_pair(3, 53));
+  auto C = stdex::submdspan(C_full, std::make_pair(10, 80), std::make_pair(20, 70));
+  stdex::matrix_product(stdex::execution::par, A, B, C);
+  expect_product(A, B, C);
+  ASSERT_EQ(C_full(0, 0), 0.0);
+}
+
+TEST(TestMatrixProduct, accessors_and_value_types) {
+  std::vector<float> a(50 * 40);
+  std::vector<double> b(40 * 60), c(50 * 60);
+  stdex::mdspan<float, stdex::dextents<2>> A(a.data(), 50, 40);
+  stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> B(b.data(), 40, 60);
+  stdex::mdspan<double, stdex::dextents<2>> C(c.data(), 50, 60);
+  fill(A, 5);
+  fill(B, 6);
+  // float A is converted to C's value type, and scaled() goes through the accessor
+  stdex::matrix_product(stdex::scaled(2.0f, A), B, C);
+  expect_product(stdex::scaled(2.0f, A), B, C);
+
+  // a C without strides
+  using tiled = stdex::layout_tiled<4, 4>;
+  auto tiled_map = tiled::mapping<stdex::dextents<2>>(stdex::dextents<2>(50, 60));
+  std::vector<double> t(tiled_map.required_span_size());
+  stdex::mdspan<double, stdex::dextents<2>, tiled> T(t.data(), tiled_map);
+  stdex::matrix_product(stdex::execution::par, A, B, T);
+  expect_product(A, B, T);
+
+  // complex elements take the scalar kernel
+  using complex_type = std::complex<double>;
+  std::vector<complex_type> x(40 * 33, complex_type(1, -2)), y(33 * 35, complex_type(0.5, 3)), z(40 * 35);
+  stdex::mdspan<complex_type, stdex::dextents<2>> X(x.data(), 40, 33), Y(y.data(), 33, 35), Z(z.data(), 40, 35);
+  stdex::matrix_product(X, Y, Z);
+  ASSERT_EQ(Z(39, 34), 33.0 * complex_type(1, -2) * complex_type(0.5, 3));
+}
+
+TEST(TestMatrixProduct, empty_inner_dimension) {
+  std::vector<double> c(6, 7.0);
+  stdex::mdspan<double, stdex::extents<2, 0>> A(nullptr);
+  stdex::mdspan<double, stdex::extents<0, dyn>> B(nullptr, 3);
+  stdex::mdspan<double, stdex::extents<2, 3>> C(c.data());
+  stdex::matrix_product(A, B, C);
+  for(auto v : c) ASSERT_EQ(v, 0.0);
+}
+
+TEST(TestMatrixProduct, every_supported_isa) {
+  using isa = stdex::detail::__gemm_isa;
+  for(auto tier : { isa::native, isa::avx2, isa::avx512 }) {
+    if(!stdex::detail::__gemm_isa_supported(tier)) continue;
+    SCOPED_TRACE(int(tier));
+    std::vector<double> a(67 * 300), b(300 * 53), c(67 * 53);
+    stdex::mdspan<double, stdex::dextents<2>> A(a.data(), 67, 300), C(c.data(), 67, 53);
+    stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> B(b.data(), 300, 53);
+    fill(A, 7);
+    fill(B, 8);
+    stdex::detail::__matrix_product(stdex::execution::par,
+      stdex::detail::__matrix_operand<decltype(A)>(A),
+      stdex::detail::__matrix_operand<decltype(B)>(B),
+      stdex::detail::__matrix_operand<decltype(C)>(C),
+      67, 53, 300, double(), tier);
+    expect_product(A, B, C);
+
+    std::vector<float> x(131 * 290), y(290 * 77), z(131 * 77);
+    stdex::mdspan<float, stdex::dextents<2>> X(x.data(), 131, 290), Y(y.data(), 290, 77), Z(z.data(), 131, 77);
+    fill(X, 9);
+    fill(Y, 10);
+    stdex::detail::__matrix_product(stdex::execution::seq,
+      stdex::detail::__matrix_operand<decltype(X)>(X),
+      stdex::detail::__matrix_operand<decltype(Y)>(Y),
+      stdex::detail::__matrix_operand<decltype(Z)>(Z),
+      131, 77, 290, float(), tier);
+    expect_product(X, Y, Z);
+  }
+}
@@ -0,0 +1,161 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+namespace {
+
+// Small integers, so that every sum is exact in float and double
+template <class MDSpan>
+void fill_matrix(MDSpan m, int seed) {
+  for(size_t i = 0; i < m.extent(0); ++i)
+    for(size_t j = 0; j < m.extent(1); ++j)
+      m(i, j) = typename MDSpan::value_type(int((i * 31 + j * 17 + size_t(seed)) % 11) - 5);
+}
+
+template <class MDSpan>
+void fill_vector(MDSpan v, int seed) {
+  for(size_t i = 0; i < v.extent(0); ++i)
+    v(i) = typename MDSpan::value_type(int((i * 13 + size_t(seed)) % 7) - 3);
+}
+
+template <class MDSpanA, class MDSpanX, class MDSpanY>
+void expect_product(MDSpanA A, MDSpanX x, MDSpanY y) {
+  for(size_t i = 0; i < y.extent(0); ++i) {
+    typename MDSpanY::value_type expected = 0;
+    for(size_t j = 0; j < A.extent(1); ++j) expected += A(i, j) * x(j);
+    ASSERT_EQ(y(i), expected) << "at " << i;
+  }
+}
+
+template <class T, class Layout, class Policy>
+void check_layout(Policy policy, size_t m, size_t n) {
+  std::vector<T> a(m * n), x(n), y(m, T(1000));
+  stdex::mdspan<T, stdex::dextents<2>, Layout> A(a.data(), m, n);
+  stdex::mdspan<T, stdex::dextents<1>> X(x.data(), n), Y(y.data(), m);
+  fill_matrix(A, 1);
+  fill_vector(X, 2);
+  stdex::matrix_vector_product(policy, A, X, Y);
+  expect_product(A, X, Y);
+}
+
+} // namespace
+
+TEST(TestMatrixVectorProduct, layout_right_and_left) {
+  // partial blocks of rows, columns and partial sums
+  check_layout<double, stdex::layout_right>(stdex::execution::seq, 3, 5);
+  check_layout<double, stdex::layout_right>(stdex::execution::par, 103, 77);
+  check_layout<float, stdex::layout_right>(stdex::execution::seq, 64, 256);
+  check_layout<double, stdex::layout_left>(stdex::execution::seq, 3, 5);
+  check_layout<double, stdex::layout_left>(stdex::execution::par, 103, 77);
+  // more rows than one chunk of y
+  check_layout<float, stdex::layout_left>(stdex::execution::par, 5000, 9);
+  check_layout<double, stdex::layout_right>(stdex::execution::par, 5000, 9);
+}
+
+TEST(TestMatrixVectorProduct, strided_operands) {
+  std::vector<double> a(60 * 70), x(140), y(120, -1.0);
+  stdex::mdspan<double, stdex::dextents<2>> A_right(a.data(), 60, 70);
+  stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> A_left(a.data(), 60, 70);
+  stdex::mdspan<double, stdex::dextents<1>> x_full(x.data(), 140), y_full(y.data(), 120);
+  fill_matrix(A_right, 3);
+  fill_vector(x_full, 4);
+  // every other element of x and y
+  auto X = stdex::submdspan(stdex::mdspan<double, stdex::dextents<2>>(x.data(), 70, 2), stdex::full_extent, 1);
+  auto Y = stdex::submdspan(stdex::mdspan<double, stdex::dextents<2>>(y.data(), 60, 2), stdex::full_extent, 0);
+
+  stdex::matrix_vector_product(A_right, X, Y);
+  expect_product(A_right, X, Y);
+  ASSERT_EQ(y_full(1), -1.0);
+
+  auto A_sub = stdex::submdspan(A_left, std::make_pair(7, 59), std::make_pair(3, 63));
+  auto Y_sub = stdex::submdspan(y_full, std::make_pair(0, 52));
+  stdex::matrix_vector_product(stdex::execution::par, A_sub, stdex::submdspan(x_full, std::make_pair(0, 60)), Y_sub);
+  expect_product(A_sub, x_full, Y_sub);
+
+  // neither stride of A is one
+  auto A_every_other = stdex::submdspan(
+    stdex::mdspan<double, stdex::dextents<3>>(a.data(), 60, 35, 2), stdex::full_extent, stdex::full_extent, 1);
+  auto x_head = stdex::submdspan(x_full, std::make_pair(0, 35));
+  stdex::matrix_vector_product(stdex::execution::par, A_every_other, x_head, Y);
+  expect_product(A_every_other, x_head, Y);
+  auto A_transposed_every_other = stdex::submdspan(
+    stdex::mdspan<double, stdex::dextents<3>, stdex::layout_left>(a.data(), 2, 30, 70), 0, stdex::full_extent, stdex::full_extent);
+  auto Y_head = stdex::submdspan(y_full, std::make_pair(0, 30));
+  stdex::matrix_vector_product(A_transposed_every_other, X, Y_head);
+  expect_product(A_transposed_every_other, X, Y_head);
+}
+
+TEST(TestMatrixVectorProduct, accessors_and_layouts_without_strides) {
+  std::vector<float> a(40 * 50), x(50);
+  std::vector<double> y(40);
+  stdex::mdspan<float, stdex::dextents<2>> A(a.data(), 40, 50);
+  stdex::mdspan<float, stdex::dextents<1>> X(x.data(), 50);
+  stdex::mdspan<double, stdex::dextents<1>> Y(y.data(), 40);
+  fill_matrix(A, 5);
+  fill_vector(X, 6);
+  // float x is converted to y's value type, and scaled() goes through the accessor
+  stdex::matrix_vector_product(stdex::scaled(2.0f, A), X, Y);
+  expect_product(stdex::scaled(2.0f, A), X, Y);
+
+  using tiled = stdex::layout_tiled<4, 4>;
+  auto tiled_map = tiled::mapping<stdex::dextents<2>>(stdex::dextents<2>(40, 50));
+  std::vector<double> t(tiled_map.required_span_size());
+  stdex::mdspan<double, stdex::dextents<2>, tiled> T(t.data(), tiled_map);
+  fill_matrix(T, 7);
+  stdex::matrix_vector_product(stdex::execution::par, T, X, Y);
+  expect_product(T, X, Y);
+
+  // no columns
+  stdex::mdspan<double, stdex::extents<40, 0>> E(nullptr);
+  stdex::matrix_vector_product(E, stdex::mdspan<double, stdex::extents<0>>(nullptr), Y);
+  for(auto v : y) ASSERT_EQ(v, 0.0);
+}
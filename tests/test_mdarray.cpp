@@ -0,0 +1,91 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdarray>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestMDArray, static_extents_default_construct) {
+  stdex::mdarray<int, stdex::extents<2, 3>> a;
+  ASSERT_EQ(a.container().size(), 6);
+  ASSERT_EQ(a.size(), 6);
+  for(size_t i = 0; i < 2; ++i)
+    for(size_t j = 0; j < 3; ++j)
+      ASSERT_EQ(a(i, j), 0);
+  a(1, 2) = 7;
+  ASSERT_EQ(a.data()[5], 7);
+  ASSERT_EQ(a.view()(1, 2), 7);
+}
+
+TEST(TestMDArray, dynamic_extents_and_layout) {
+  stdex::mdarray<double, stdex::extents<dyn, 4, dyn>, stdex::layout_left> a(3, 5);
+  ASSERT_EQ(a.extent(0), 3);
+  ASSERT_EQ(a.extent(1), 4);
+  ASSERT_EQ(a.extent(2), 5);
+  ASSERT_EQ(a.stride(2), 12);
+  a(std::array<size_t, 3>{{ 2, 1, 4 }}) = 1.5;
+  ASSERT_EQ(a.data()[2 + 3 * 1 + 12 * 4], 1.5);
+
+  // copies are deep
+  auto b = a;
+  b(2, 1, 4) = 2.5;
+  ASSERT_EQ(a(2, 1, 4), 1.5);
+  auto const& cb = b;
+  static_assert(std::is_same<decltype(cb.view())::element_type, double const>::value, "");
+  ASSERT_EQ(cb.view()(2, 1, 4), 2.5);
+}
+
+TEST(TestMDArray, adopts_container) {
+  using array_type = stdex::mdarray<int, stdex::dextents<2>>;
+  std::vector<int> values = { 1, 2, 3, 4, 5, 6 };
+  array_type a(array_type::mapping_type(stdex::dextents<2>(3, 2)), std::move(values));
+  ASSERT_EQ(a(2, 0), 5);
+  ASSERT_EQ(a.container().size(), 6);
+}
@@ -0,0 +1,114 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+template <class T>
+using nontemporal_mdspan_2d = stdex::mdspan<T, stdex::dextents<2>, stdex::layout_right, stdex::nontemporal_accessor<T>>;
+
+// an element type without a streaming store on any target
+struct rgb {
+  rgb() = default;
+  explicit rgb(size_t v) : r(float(v)), g(float(v) + 0.25f), b(float(v) + 0.5f) { }
+  float r, g, b;
+  friend bool operator==(rgb const& x, rgb const& y) { return x.r == y.r && x.g == y.g && x.b == y.b; }
+};
+
+template <class T>
+void test_streaming_copy() {
+  size_t m = 17, n = 33;
+  std::vector<T> src(m * n), dst(m * n, T(0));
+  for(size_t k = 0; k < src.size(); ++k) src[k] = T(k % 100);
+  stdex::mdspan<T const, stdex::dextents<2>> s(src.data(), m, n);
+  nontemporal_mdspan_2d<T> d(dst.data(), m, n);
+  for(size_t i = 0; i < m; ++i) {
+    for(size_t j = 0; j < n; ++j) {
+      d(i, j) = s(i, j);
+    }
+  }
+  d.accessor().flush();
+  ASSERT_EQ(src, dst);
+}
+
+TEST(TestNontemporalAccessor, copy_int32) { test_streaming_copy<int32_t>(); }
+TEST(TestNontemporalAccessor, copy_int64) { test_streaming_copy<int64_t>(); }
+TEST(TestNontemporalAccessor, copy_float) { test_streaming_copy<float>(); }
+TEST(TestNontemporalAccessor, copy_double) { test_streaming_copy<double>(); }
+// no streaming store of this size, stored normally
+TEST(TestNontemporalAccessor, copy_int16) { test_streaming_copy<int16_t>(); }
+// non-arithmetic element types, stored normally
+TEST(TestNontemporalAccessor, copy_complex_double) { test_streaming_copy<std::complex<double>>(); }
+TEST(TestNontemporalAccessor, copy_struct) { test_streaming_copy<rgb>(); }
+
+TEST(TestNontemporalAccessor, reference_semantics) {
+  std::vector<double> data(6, 0.0);
+  stdex::mdspan<double, stdex::extents<2, 3>, stdex::layout_right, stdex::nontemporal_accessor<double>> m(data.data());
+  m(0, 1) = 2.5;
+  m(1, 2) = m(0, 1);
+  m.accessor().flush();
+  ASSERT_EQ(double(m(1, 2)), 2.5);
+  ASSERT_EQ(data[5], 2.5);
+  // read-only views hand out plain references
+  stdex::mdspan<double const, stdex::extents<2, 3>, stdex::layout_right, stdex::nontemporal_accessor<double const>> cm = m;
+  static_assert(std::is_same<decltype(cm)::reference, double const&>::value, "");
+  ASSERT_EQ(cm(0, 1), 2.5);
+}
+
+TEST(TestNontemporalAccessor, submdspan) {
+  std::vector<int> data(4 * 5, 0);
+  stdex::mdspan<int, stdex::extents<dyn, 5>, stdex::layout_right, stdex::nontemporal_accessor<int>> m(data.data(), 4);
+  auto column = stdex::submdspan(m, stdex::full_extent, 2);
+  for(size_t i = 0; i < 4; ++i) column(i) = int(i + 1);
+  column.accessor().flush();
+  for(size_t i = 0; i < 4; ++i) ASSERT_EQ(data[i * 5 + 2], int(i + 1));
+}
@@ -0,0 +1,220 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+std::string temp_path(char const* name) {
+  return testing::TempDir() + "mdspan_test_" + name + ".npy";
+}
+
+std::string read_file(std::string const& path) {
+  std::string contents;
+  std::FILE* f = std::fopen(path.c_str(), "rb");
+  char buffer[4096];
+  size_t n;
+  while((n = std::fread(buffer, 1, sizeof(buffer), f)) > 0) contents.append(buffer, n);
+  std::fclose(f);
+  return contents;
+}
+
+void write_file(std::string const& path, std::string const& contents) {
+  std::FILE* f = std::fopen(path.c_str(), "wb");
+  std::fwrite(contents.data(), 1, contents.size(), f);
+  std::fclose(f);
+}
+
+} // namespace
+
+TEST(TestNpy, header_format) {
+  auto path = temp_path("header_format");
+  std::vector<double> data = {0, 1, 2, 3, 4, 5};
+  stdex::save_npy(path.c_str(), stdex::mdspan<double, stdex::extents<2, 3>>(data.data()));
+  auto contents = read_file(path);
+  // as written by numpy.save
+  std::string dict = "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }";
+  ASSERT_EQ(contents.size(), 128 + 6 * sizeof(double));
+  ASSERT_EQ(contents.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+  ASSERT_EQ(contents[8], char(118));
+  ASSERT_EQ(contents[9], char(0));
+  ASSERT_EQ(contents.substr(10, dict.size()), dict);
+  ASSERT_EQ(contents[127], '\n');
+  auto h = stdex::read_npy_header(path.c_str());
+  ASSERT_EQ(h.descr, "<f8");
+  ASSERT_FALSE(h.fortran_order);
+  ASSERT_EQ(h.shape, (std::vector<size_t>{2, 3}));
+  ASSERT_EQ(h.data_offset, 128);
+  std::remove(path.c_str());
+}
+
+TEST(TestNpy, read_numpy_file) {
+  // numpy.save of np.arange(4, dtype='<i2').reshape(2, 2, order='F'), with
+  // the header dict formatted, padded and terminated the way numpy writes it
+  auto path = temp_path("read_numpy_file");
+  std::string dict = "{'descr': '<i2', 'fortran_order': True, 'shape': (2, 2), }";
+  dict.append(128 - 10 - dict.size() - 1, ' ');
+  dict += '\n';
+  std::string contents = std::string("\x93NUMPY\x01\x00", 8) + char(dict.size()) + char(0) + dict;
+  for(int16_t v : {0, 1, 2, 3}) contents.append(reinterpret_cast<char const*>(&v), 2);
+  write_file(path, contents);
+  std::vector<int16_t> out(4);
+  stdex::mdspan<int16_t, stdex::extents<2, 2>, stdex::layout_left> left(out.data());
+  stdex::load_npy(path.c_str(), left);
+  ASSERT_EQ(out, (std::vector<int16_t>{0, 1, 2, 3}));
+  ASSERT_EQ(left(1, 0), 1);
+  // loading into another layout transposes the storage
+  stdex::mdspan<int16_t, stdex::dextents<2>> right(out.data(), 2, 2);
+  stdex::load_npy(path.c_str(), right);
+  ASSERT_EQ(right(1, 0), 1);
+  ASSERT_EQ(right(0, 1), 2);
+  ASSERT_EQ(out, (std::vector<int16_t>{0, 2, 1, 3}));
+  std::remove(path.c_str());
+}
+
+TEST(TestNpy, round_trip_layouts) {
+  auto path = temp_path("round_trip_layouts");
+  size_t m = 5, n = 7, k = 3;
+  std::vector<float> src(m * n * k), dst(m * n * k, -1.f);
+  for(size_t i = 0; i < src.size(); ++i) src[i] = float(i);
+  using extents_type = stdex::extents<dyn, 7, dyn>;
+  stdex::mdspan<float, extents_type, stdex::layout_left> x(src.data(), m, k);
+  stdex::save_npy(path.c_str(), x);
+  auto h = stdex::read_npy_header(path.c_str());
+  ASSERT_TRUE(h.fortran_order);
+  ASSERT_EQ(h.shape, (std::vector<size_t>{5, 7, 3}));
+  stdex::mdspan<float, extents_type, stdex::layout_left> y(dst.data(), m, k);
+  stdex::load_npy(path.c_str(), y);
+  ASSERT_EQ(src, dst);
+
+  // a strided view (rows 1 to 3 of the last (i, j) plane) is written in C
+  // order through the staging buffer
+  using strided_mapping = stdex::layout_stride::mapping<stdex::dextents<2>>;
+  stdex::mdspan<float, stdex::dextents<2>, stdex::layout_stride> sub(
+    src.data() + 1 + 2 * m * n, strided_mapping(stdex::dextents<2>(3, 7), stdex::dextents<2>(1, m))
+  );
+  stdex::save_npy(path.c_str(), sub);
+  h = stdex::read_npy_header(path.c_str());
+  ASSERT_FALSE(h.fortran_order);
+  std::vector<float> sub_out(3 * 7);
+  stdex::mdspan<float, stdex::extents<3, 7>> z(sub_out.data());
+  stdex::load_npy(path.c_str(), z);
+  for(size_t i = 0; i < 3; ++i)
+    for(size_t j = 0; j < 7; ++j)
+      ASSERT_EQ(z(i, j), sub(i, j));
+  std::remove(path.c_str());
+}
+
+TEST(TestNpy, chunked_writer) {
+  auto path = temp_path("chunked_writer");
+  size_t rows = 1000, cols = 33;
+  std::vector<int64_t> data(rows * cols);
+  for(size_t i = 0; i < data.size(); ++i) data[i] = int64_t(i) * 3;
+  stdex::mdspan<int64_t, stdex::dextents<2>> x(data.data(), rows, cols);
+  {
+    stdex::npy_writer<int64_t> writer(path.c_str(), x.extents());
+    for(size_t first = 0; first < rows; first += 300) {
+      writer.append(stdex::submdspan(x, std::make_pair(first, std::min(rows, first + 300)), stdex::full_extent));
+    }
+    ASSERT_EQ(writer.written(), writer.size());
+    writer.close();
+  }
+  std::vector<int64_t> out(rows * cols);
+  stdex::load_npy(path.c_str(), stdex::mdspan<int64_t, stdex::dextents<2>>(out.data(), rows, cols));
+  ASSERT_EQ(data, out);
+  {
+    stdex::npy_writer<int64_t> writer(path.c_str(), x.extents());
+    writer.append(stdex::submdspan(x, std::make_pair(0, 10), stdex::full_extent));
+    ASSERT_THROW(writer.close(), std::runtime_error);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(TestNpy, mismatches) {
+  auto path = temp_path("mismatches");
+  std::vector<double> data(12, 1.0);
+  stdex::save_npy(path.c_str(), stdex::mdspan<double, stdex::extents<3, 4>>(data.data()));
+  auto h = stdex::read_npy_header(path.c_str());
+  using mapping_type = stdex::layout_right::mapping<stdex::extents<3, dyn>>;
+  ASSERT_EQ((stdex::npy_mapping<double, stdex::extents<3, dyn>, stdex::layout_right>(h)), mapping_type(stdex::extents<3, dyn>(4)));
+  ASSERT_THROW((stdex::npy_mapping<float, stdex::extents<3, dyn>, stdex::layout_right>(h)), std::runtime_error);
+  ASSERT_THROW((stdex::npy_mapping<double, stdex::extents<4, dyn>, stdex::layout_right>(h)), std::runtime_error);
+  ASSERT_THROW((stdex::npy_mapping<double, stdex::dextents<3>, stdex::layout_right>(h)), std::runtime_error);
+  ASSERT_THROW((stdex::npy_mapping<double, stdex::dextents<2>, stdex::layout_left>(h)), std::runtime_error);
+  write_file(path, "not an npy file");
+  ASSERT_THROW(stdex::read_npy_header(path.c_str()), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+#if defined(_MDSPAN_HAS_MMAP)
+TEST(TestNpy, map_npy) {
+  auto path = temp_path("map_npy");
+  std::vector<stdex::float16_storage> data(6);
+  for(size_t i = 0; i < data.size(); ++i) data[i] = stdex::float16_storage{uint16_t(0x3c00 + i)};
+  stdex::save_npy(path.c_str(), stdex::mdspan<stdex::float16_storage, stdex::extents<3, 2>>(data.data()));
+  ASSERT_EQ(stdex::read_npy_header(path.c_str()).descr, "<f2");
+  {
+    auto a = stdex::map_npy<stdex::float16_storage, stdex::extents<3, 2>>(path.c_str());
+    ASSERT_EQ(a.view()(2, 1).bits, 0x3c05);
+    a.view()(0, 0).bits = 0;
+  }
+  auto a = stdex::map_npy<stdex::float16_storage const, stdex::dextents<2>>(path.c_str());
+  ASSERT_EQ(a.extents().extent(0), 3);
+  ASSERT_EQ(a.view()(0, 0).bits, 0);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(a.data()) % 64, 0);
+  using left_array = stdex::mapped_mdarray<stdex::float16_storage const, stdex::dextents<2>, stdex::layout_left>;
+  ASSERT_THROW(left_array(stdex::map_npy<stdex::float16_storage const, stdex::dextents<2>, stdex::layout_left>(path.c_str())), std::runtime_error);
+  std::remove(path.c_str());
+}
+#endif // _MDSPAN_HAS_MMAP
@@ -0,0 +1,135 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+template <class T, class Extents, class Layout = stdex::layout_right>
+using offset_mdspan = stdex::mdspan<T, Extents, Layout, stdex::offset_ptr_accessor<T>>;
+
+TEST(TestOffsetPtr, null_copy_and_arithmetic) {
+  stdex::offset_ptr<int> null;
+  ASSERT_FALSE(null);
+  ASSERT_EQ(null.get(), nullptr);
+  ASSERT_EQ(stdex::offset_ptr<int>(nullptr).get(), nullptr);
+
+  int values[4] = { 1, 2, 3, 4 };
+  stdex::offset_ptr<int> p = values;
+  ASSERT_TRUE(p);
+  ASSERT_EQ(*p, 1);
+  ASSERT_EQ(p[3], 4);
+  // copies keep pointing at the target from their own address
+  std::vector<stdex::offset_ptr<int>> copies(3, p + 1);
+  for(auto const& q : copies) ASSERT_EQ(q.get(), values + 1);
+  ASSERT_EQ(copies[2] - p, 1);
+  stdex::offset_ptr<int const> c = copies[0];
+  ASSERT_EQ(c, values + 1);
+  c = nullptr;
+  ASSERT_FALSE(c);
+}
+
+TEST(TestOffsetPtrAccessor, element_access_and_submdspan) {
+  std::vector<int> buffer(3 * 4 * 5);
+  for(size_t i = 0; i < buffer.size(); ++i) buffer[i] = int(i);
+  using extents_type = stdex::extents<dyn, 4, dyn>;
+  offset_mdspan<int, extents_type> s(buffer.data(), 3, 5);
+  stdex::mdspan<int, extents_type> ref(buffer.data(), 3, 5);
+  for(size_t i = 0; i < 3; ++i)
+    for(size_t j = 0; j < 4; ++j)
+      for(size_t k = 0; k < 5; ++k)
+        ASSERT_EQ(&s(i, j, k), &ref(i, j, k));
+  ASSERT_EQ(s.data(), buffer.data());
+
+  auto row = stdex::submdspan(s, 2, 1, stdex::full_extent);
+  ASSERT_EQ(row.extent(0), 5);
+  ASSERT_EQ(row(3), ref(2, 1, 3));
+
+  // from a default_accessor view, and to a const view
+  offset_mdspan<int, extents_type> converted = ref;
+  offset_mdspan<int const, extents_type> read_only = converted;
+  ASSERT_EQ(read_only(1, 2, 3), ref(1, 2, 3));
+}
+
+#if defined(_MDSPAN_HAS_MMAP)
+
+// The same file mapped twice, at two different addresses, stands in for two
+// processes sharing a segment
+TEST(TestOffsetPtrAccessor, mdspan_stored_in_mapping) {
+  auto path = testing::TempDir() + "mdspan_test_offset_ptr";
+  using extents_type = stdex::extents<dyn, dyn>;
+  using stored_type = offset_mdspan<double, extents_type>;
+  using bytes_extents = stdex::dextents<1>;
+  auto bytes_map = stdex::layout_right::mapping<bytes_extents>(bytes_extents(4096));
+  {
+    stdex::mapped_mdarray<char, bytes_extents> first(path.c_str(), bytes_map, stdex::mapped_file_mode::create);
+    stdex::mapped_mdarray<char, bytes_extents> second(path.c_str(), bytes_map);
+    ASSERT_NE(first.data(), second.data());
+
+    // the view lives at the start of the file, its elements after it
+    auto* elements = reinterpret_cast<double*>(first.data() + 256);
+    auto* stored = ::new (first.data()) stored_type(elements, 6, 7);
+    for(size_t i = 0; i < 6; ++i)
+      for(size_t j = 0; j < 7; ++j)
+        (*stored)(i, j) = double(10 * i + j);
+
+    auto const& other = *reinterpret_cast<stored_type const*>(second.data());
+    ASSERT_EQ(other.extent(0), 6);
+    ASSERT_EQ(other.extent(1), 7);
+    ASSERT_EQ(other.data().get(), reinterpret_cast<double*>(second.data() + 256));
+    ASSERT_EQ(other(5, 6), 56.0);
+    ASSERT_EQ(&other(2, 3), reinterpret_cast<double*>(second.data() + 256) + 17);
+  }
+  std::remove(path.c_str());
+}
+
+#endif // _MDSPAN_HAS_MMAP
@@ -0,0 +1,194 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+#if defined(_MDSPAN_HAS_PREAD)
+
+namespace {
+
+using extents_type = stdex::extents<dyn, dyn, dyn>;
+using layout_type = stdex::layout_tiled<2, 2, 4>;
+using mapping_type = layout_type::mapping<extents_type>;
+
+int value_at(size_t i, size_t j, size_t k) { return int(100 * i + 10 * j + k); }
+
+// Writes a 5 x 4 x 7 array of value_at() in layout_tiled<2, 2, 4> to `path`
+mapping_type write_tiled_file(std::string const& path) {
+  auto map = mapping_type(extents_type(5, 4, 7));
+  std::vector<int> data(map.required_span_size(), 0);
+  stdex::mdspan<int, extents_type, layout_type> s(data.data(), map);
+  for(size_t i = 0; i < s.extent(0); ++i) {
+    for(size_t j = 0; j < s.extent(1); ++j) {
+      for(size_t k = 0; k < s.extent(2); ++k) {
+        s(i, j, k) = value_at(i, j, k);
+      }
+    }
+  }
+  std::FILE* f = std::fopen(path.c_str(), "wb");
+  std::fwrite(data.data(), sizeof(int), data.size(), f);
+  std::fclose(f);
+  return map;
+}
+
+std::string temp_path(char const* name) {
+  return testing::TempDir() + "mdspan_test_" + name + ".tiles";
+}
+
+} // end anonymous namespace
+
+TEST(TestTileCache, pin_hits_misses_and_eviction) {
+  auto path = temp_path("tile_cache");
+  auto map = write_tiled_file(path);
+  stdex::tile_cache<int> cache(path.c_str(), map.tile_size(), 2);
+  ASSERT_EQ(cache.num_tiles(), map.num_tiles());
+
+  int const* t0 = cache.pin(0);
+  ASSERT_EQ(t0[0], value_at(0, 0, 0));
+  ASSERT_EQ(t0[5], value_at(0, 1, 1));
+  cache.unpin(0);
+  ASSERT_EQ(cache.pin(0), t0);
+  cache.unpin(0);
+  int const* t1 = cache.pin(1);
+  // tile 1 starts at (0, 0, 4)
+  ASSERT_EQ(t1[0], value_at(0, 0, 4));
+  // tile 0 is pinned, tile 1 is the only candidate once tile 2 is resident
+  cache.pin(0);
+  ASSERT_THROW(cache.pin(2), std::runtime_error);
+  cache.unpin(1);
+  int const* t2 = cache.pin(2);
+  ASSERT_EQ(t2[0], value_at(0, 2, 0));
+  cache.unpin(0);
+  cache.unpin(2);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.misses, 3);
+  ASSERT_EQ(stats.hits, 2);
+  ASSERT_EQ(stats.evictions, 1);
+  ASSERT_EQ(stats.hit_rate(), 0.4);
+  cache.reset_stats();
+  ASSERT_EQ(cache.stats().misses, 0);
+  std::remove(path.c_str());
+}
+
+TEST(TestTileCache, prefetch_loads_in_the_background) {
+  auto path = temp_path("tile_cache_prefetch");
+  auto map = write_tiled_file(path);
+  stdex::tile_cache<int> cache(path.c_str(), map.tile_size(), 4);
+  cache.prefetch(3);
+  cache.prefetch(map.num_tiles()); // out of range, ignored
+  for(int tries = 0; tries < 1000 && cache.stats().prefetches == 0; ++tries) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(cache.stats().prefetches, 1);
+  int const* t3 = cache.pin(3);
+  ASSERT_EQ(t3[0], value_at(0, 2, 4));
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.misses, 0);
+  ASSERT_EQ(stats.hits, 1);
+  ASSERT_EQ(stats.prefetch_hits, 1);
+  cache.unpin(3);
+  std::remove(path.c_str());
+}
+
+TEST(TestTileCache, missing_file) {
+  ASSERT_THROW(stdex::tile_cache<int>(temp_path("does_not_exist").c_str(), 16, 2), std::system_error);
+}
+
+TEST(TestPagedAccessor, mdspan_access) {
+  auto path = temp_path("paged_accessor");
+  auto map = write_tiled_file(path);
+  // fewer resident tiles than the array has
+  stdex::tile_cache<int> cache(path.c_str(), map.tile_size(), 3);
+  ASSERT_LT(cache.capacity(), map.num_tiles());
+  stdex::mdspan<int const, extents_type, layout_type, stdex::paged_accessor<int>> s(
+    0, map, stdex::paged_accessor<int>(cache, 2)
+  );
+  for(int pass = 0; pass < 2; ++pass) {
+    for(size_t i = 0; i < s.extent(0); ++i) {
+      for(size_t j = 0; j < s.extent(1); ++j) {
+        for(size_t k = 0; k < s.extent(2); ++k) {
+          ASSERT_EQ(s(i, j, k), value_at(i, j, k));
+        }
+      }
+    }
+  }
+  auto stats = cache.stats();
+  ASSERT_GT(stats.hits + stats.misses, 0);
+  ASSERT_GT(stats.evictions, 0);
+  std::remove(path.c_str());
+}
+
+TEST(TestPagedAccessor, copies_pin_their_own_tiles) {
+  auto path = temp_path("paged_accessor_copies");
+  auto map = write_tiled_file(path);
+  stdex::tile_cache<int> cache(path.c_str(), map.tile_size(), 2);
+  stdex::paged_accessor<int> a(cache, 0);
+  ASSERT_EQ(a.access(0, 1), value_at(0, 0, 1));
+  {
+    stdex::paged_accessor<int> b(a);
+    ASSERT_EQ(b.cache(), &cache);
+    ASSERT_EQ(b.access(map.tile_size(), 0), value_at(0, 0, 4));
+    // a keeps tile 0 and b tile 1 pinned
+    ASSERT_THROW(cache.pin(2), std::runtime_error);
+  }
+  // b unpinned its tile when it was destroyed
+  cache.pin(2);
+  cache.unpin(2);
+  std::remove(path.c_str());
+}
+
+#endif // defined(_MDSPAN_HAS_PREAD)
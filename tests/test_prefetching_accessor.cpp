@@ -0,0 +1,101 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+#include <experimental/linalg>
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestPrefetchingAccessor, column_traversal) {
+  std::vector<int> data(6 * 5);
+  for(size_t k = 0; k < data.size(); ++k) data[k] = int(k);
+  stdex::mdspan<int, stdex::extents<6, dyn>> m(data.data(), 5);
+  auto pm = stdex::prefetched<2>(m, 0);
+  static_assert(std::is_same<decltype(pm)::accessor_type,
+    stdex::prefetching_accessor<stdex::default_accessor<int>, 2>>::value, "");
+  ASSERT_EQ(pm.accessor().lookahead(), 10);
+  for(size_t j = 0; j < 5; ++j) {
+    for(size_t i = 0; i < 6; ++i) {
+      ASSERT_EQ(pm(i, j), m(i, j));
+    }
+  }
+  pm(3, 4) = -1;
+  ASSERT_EQ(data[19], -1);
+}
+
+TEST(TestPrefetchingAccessor, dynamic_distance) {
+  std::vector<double> data(4 * 8, 1.0);
+  stdex::mdspan<double, stdex::dextents<2>, stdex::layout_left> m(data.data(), 4, 8);
+  auto pm = stdex::prefetched(m, 1, 3);
+  static_assert(std::is_same<decltype(pm)::accessor_type,
+    stdex::prefetching_accessor<stdex::default_accessor<double>>>::value, "");
+  ASSERT_EQ(pm.accessor().lookahead(), 12);
+  auto none = stdex::prefetched(m, 1, 0);
+  ASSERT_EQ(none.accessor().lookahead(), 0);
+  ASSERT_EQ(none(3, 7), 1.0);
+}
+
+TEST(TestPrefetchingAccessor, submdspan_keeps_lookahead) {
+  std::vector<int> data(8 * 8);
+  for(size_t k = 0; k < data.size(); ++k) data[k] = int(k);
+  stdex::mdspan<int const, stdex::dextents<2>> m(data.data(), 8, 8);
+  auto pm = stdex::prefetched<4>(m, 0);
+  auto column = stdex::submdspan(pm, stdex::full_extent, 3);
+  ASSERT_EQ(column.accessor().lookahead(), 32);
+  for(size_t i = 0; i < 8; ++i) ASSERT_EQ(column(i), int(8 * i + 3));
+}
+
+TEST(TestPrefetchingAccessor, nested_accessor) {
+  std::vector<double> data(3 * 3, 2.0);
+  stdex::mdspan<double, stdex::extents<3, 3>> m(data.data());
+  auto pm = stdex::prefetched<1>(stdex::scaled(1.5, m), 0);
+  static_assert(std::is_same<decltype(pm)::reference, double>::value, "");
+  ASSERT_EQ(pm(2, 1), 3.0);
+  ASSERT_EQ(pm.accessor().nested_accessor().scaling_factor(), 1.5);
+}
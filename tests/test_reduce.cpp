@@ -0,0 +1,213 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+// Distinct values with a pattern that makes any misplaced element visible
+std::vector<int64_t> make_values(size_t n) {
+  std::vector<int64_t> v(n);
+  for(size_t i = 0; i < n; ++i) v[i] = int64_t((i * 7919) % 1009) - 500;
+  return v;
+}
+
+template <class MDSpan>
+int64_t naive_sum(MDSpan m) {
+  int64_t sum = 0;
+  for(size_t i = 0; i < m.extent(0); ++i)
+    for(size_t j = 0; j < m.extent(1); ++j)
+      for(size_t k = 0; k < m.extent(2); ++k)
+        sum += m(i, j, k);
+  return sum;
+}
+
+template <class MDSpan, class Compare>
+std::array<size_t, 3> naive_location(MDSpan m, Compare comp) {
+  std::array<size_t, 3> best = { };
+  for(size_t i = 0; i < m.extent(0); ++i)
+    for(size_t j = 0; j < m.extent(1); ++j)
+      for(size_t k = 0; k < m.extent(2); ++k)
+        if(comp(m(i, j, k), m(best[0], best[1], best[2]))) best = {{ i, j, k }};
+  return best;
+}
+
+} // namespace
+
+TEST(TestReduce, sum_in_every_layout) {
+  auto values = make_values(5 * 6 * 7);
+  stdex::mdspan<int64_t, stdex::extents<dyn, 6, dyn>> right(values.data(), 5, 7);
+  stdex::mdspan<int64_t, stdex::extents<dyn, 6, dyn>, stdex::layout_left> left(values.data(), 5, 7);
+  // strided, and only partly mergeable
+  auto sub_right = stdex::submdspan(right, std::make_pair(1, 4), stdex::full_extent, std::make_pair(2, 7));
+  auto sub_left = stdex::submdspan(left, stdex::full_extent, std::make_pair(1, 5), std::make_pair(0, 3));
+
+  ASSERT_EQ(stdex::reduce(right), naive_sum(right));
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, left, int64_t(3)), naive_sum(left) + 3);
+  ASSERT_EQ(stdex::reduce(stdex::execution::seq, sub_right, int64_t(0)), naive_sum(sub_right));
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, sub_left, int64_t(0)), naive_sum(sub_left));
+
+  // a padded tiled layout has neither strides nor a contiguous codomain
+  using tiled = stdex::layout_tiled<2, 4, 4>;
+  auto tiled_map = tiled::mapping<stdex::dextents<3>>(stdex::dextents<3>(5, 6, 7));
+  std::vector<int64_t> tiled_values(tiled_map.required_span_size(), 1000000);
+  stdex::mdspan<int64_t, stdex::dextents<3>, tiled> t(tiled_values.data(), tiled_map);
+  for(size_t i = 0; i < 5; ++i)
+    for(size_t j = 0; j < 6; ++j)
+      for(size_t k = 0; k < 7; ++k)
+        t(i, j, k) = right(i, j, k);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, t), naive_sum(right));
+}
+
+TEST(TestReduce, transform_reduce_and_custom_op) {
+  std::vector<double> values = { 3, -1, 4, -1, 5, -9, 2, 6 };
+  stdex::mdspan<double, stdex::extents<2, 4>> m(values.data());
+  auto squares = stdex::transform_reduce(stdex::execution::par, m, 0.0, std::plus<>(), [](double x) { return x * x; });
+  ASSERT_EQ(squares, 173.0);
+  auto largest = stdex::reduce(m, -100.0, [](double a, double b) { return a < b ? b : a; });
+  ASSERT_EQ(largest, 6.0);
+  // reducing into a different type
+  auto negatives = stdex::transform_reduce(m, size_t(0), std::plus<>(), [](double x) { return size_t(x < 0); });
+  ASSERT_EQ(negatives, 3);
+}
+
+TEST(TestReduce, rank_0_and_empty) {
+  int one = 42;
+  stdex::mdspan<int, stdex::extents<>> scalar(&one);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, scalar, 1), 43);
+  auto loc = stdex::minloc(scalar);
+  ASSERT_EQ(loc.value, 42);
+
+  stdex::mdspan<int, stdex::dextents<2>> empty(nullptr, 3, 0);
+  ASSERT_EQ(stdex::reduce(empty, 5), 5);
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, empty), 0);
+}
+
+TEST(TestReduce, long_runs_use_every_lane) {
+  std::vector<float> values(1003, 0.5f);
+  values[1002] = 1.0f;
+  stdex::mdspan<float, stdex::dextents<1>> m(values.data(), values.size());
+  ASSERT_EQ(stdex::reduce(m, 0.0f), 502.0f);
+  stdex::mdspan<float, stdex::dextents<1>, stdex::layout_stride> every_other(
+    values.data() + 1, stdex::layout_stride::mapping<stdex::dextents<1>>(stdex::dextents<1>(501), stdex::dextents<1>(2)));
+  ASSERT_EQ(stdex::reduce(stdex::execution::par, every_other, 0.0f), 250.5f);
+}
+
+TEST(TestMinMaxLoc, matches_naive_search) {
+  auto values = make_values(5 * 6 * 7);
+  stdex::mdspan<int64_t, stdex::dextents<3>> right(values.data(), 5, 6, 7);
+  stdex::mdspan<int64_t, stdex::dextents<3>, stdex::layout_left> left(values.data(), 5, 6, 7);
+  auto sub = stdex::submdspan(left, std::make_pair(1, 5), stdex::full_extent, std::make_pair(1, 6));
+
+  auto check = [](auto m) {
+    auto lo = stdex::minloc(stdex::execution::par, m);
+    auto expected_lo = naive_location(m, std::less<>());
+    ASSERT_EQ(lo.index, expected_lo);
+    ASSERT_EQ(lo.value, m(expected_lo[0], expected_lo[1], expected_lo[2]));
+    auto hi = stdex::maxloc(m);
+    auto expected_hi = naive_location(m, std::greater<>());
+    ASSERT_EQ(hi.index, expected_hi);
+    ASSERT_EQ(hi.value, m(expected_hi[0], expected_hi[1], expected_hi[2]));
+  };
+  check(right);
+  check(left);
+  check(sub);
+}
+
+TEST(TestMinMaxLoc, ties_resolve_to_smallest_index) {
+  // layout_left visits (1, 0) before (0, 1); the result must not depend on that
+  std::vector<int> values(12, 0);
+  stdex::mdspan<int, stdex::extents<3, 4>, stdex::layout_left> m(values.data());
+  m(2, 0) = -1;
+  m(0, 3) = -1;
+  m(1, 2) = 5;
+  m(0, 1) = 5;
+  auto lo = stdex::minloc(stdex::execution::par, m);
+  ASSERT_EQ(lo.value, -1);
+  ASSERT_EQ(lo.index[0], 0);
+  ASSERT_EQ(lo.index[1], 3);
+  auto hi = stdex::maxloc(m);
+  ASSERT_EQ(hi.value, 5);
+  ASSERT_EQ(hi.index[0], 0);
+  ASSERT_EQ(hi.index[1], 1);
+}
+
+#if defined(_OPENMP)
+TEST(TestReduce, nested_parallel) {
+  // Called from a team of two with nested parallelism enabled, the inner
+  // teams may be larger than the calling one
+  auto values = make_values(40 * 30 * 20);
+  stdex::mdspan<int64_t, stdex::extents<dyn, dyn, dyn>> m(values.data(), 40, 30, 20);
+  int64_t expected = naive_sum(m);
+  auto expected_lo = naive_location(m, std::less<>());
+  int saved_levels = omp_get_max_active_levels();
+  omp_set_max_active_levels(2);
+  std::vector<int64_t> sums(2);
+  std::vector<std::array<size_t, 3>> locations(2);
+  #pragma omp parallel num_threads(2)
+  {
+    size_t t = size_t(omp_get_thread_num());
+    sums[t] = stdex::reduce(stdex::execution::par, m, int64_t(0));
+    locations[t] = stdex::minloc(stdex::execution::par, m).index;
+  }
+  omp_set_max_active_levels(saved_levels);
+  for(size_t t = 0; t < 2; ++t) {
+    ASSERT_EQ(sums[t], expected);
+    ASSERT_EQ(locations[t], expected_lo);
+  }
+}
+#endif
@@ -0,0 +1,163 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+std::vector<int64_t> make_values(size_t n) {
+  std::vector<int64_t> v(n);
+  for(size_t i = 0; i < n; ++i) v[i] = int64_t((i * 7919) % 1009) - 500;
+  return v;
+}
+
+// Checks reduce_axis<Axis>(policy, m) of a rank 3 m against a plain loop
+template <size_t Axis, class Policy, class MDSpan>
+void check_sum(Policy policy, MDSpan m) {
+  auto r = stdex::reduce_axis<Axis>(policy, m);
+  static_assert(decltype(r)::rank() == 2, "");
+  size_t n = m.extent(Axis);
+  for(size_t i = 0; i < r.extent(0); ++i) {
+    for(size_t j = 0; j < r.extent(1); ++j) {
+      int64_t expected = 0;
+      for(size_t a = 0; a < n; ++a) {
+        std::array<size_t, 3> idx = { };
+        idx[Axis] = a;
+        idx[Axis == 0 ? 1 : 0] = i;
+        idx[Axis == 2 ? 1 : 2] = j;
+        expected += m(idx);
+      }
+      ASSERT_EQ(r(i, j), expected) << "axis " << Axis << " at " << i << ", " << j;
+    }
+  }
+}
+
+template <class Policy, class MDSpan>
+void check_every_axis(Policy policy, MDSpan m) {
+  check_sum<0>(policy, m);
+  check_sum<1>(policy, m);
+  check_sum<2>(policy, m);
+}
+
+} // namespace
+
+TEST(TestReduceAxis, result_type) {
+  using extents_type = stdex::extents<dyn, 6, 7>;
+  std::vector<float> values(5 * 6 * 7);
+  stdex::mdspan<float const, extents_type> right(values.data(), 5);
+  stdex::mdspan<float, extents_type, stdex::layout_left> left(values.data(), 5);
+  static_assert(std::is_same<decltype(stdex::reduce_axis<0>(right)),
+    stdex::mdarray<float, stdex::extents<6, 7>>>::value, "");
+  static_assert(std::is_same<decltype(stdex::reduce_axis<1>(right)),
+    stdex::mdarray<float, stdex::extents<dyn, 7>>>::value, "");
+  static_assert(std::is_same<decltype(stdex::reduce_axis<2>(left)),
+    stdex::mdarray<float, stdex::extents<dyn, 6>, stdex::layout_left>>::value, "");
+  auto r = stdex::reduce_axis<2>(left);
+  ASSERT_EQ(r.extent(0), 5);
+  ASSERT_EQ(r.extent(1), 6);
+}
+
+TEST(TestReduceAxis, sum_in_every_layout) {
+  auto values = make_values(5 * 6 * 7);
+  stdex::mdspan<int64_t, stdex::extents<dyn, 6, dyn>> right(values.data(), 5, 7);
+  stdex::mdspan<int64_t, stdex::extents<dyn, 6, dyn>, stdex::layout_left> left(values.data(), 5, 7);
+  auto sub_right = stdex::submdspan(right, std::make_pair(1, 4), stdex::full_extent, std::make_pair(2, 7));
+  auto sub_left = stdex::submdspan(left, stdex::full_extent, std::make_pair(1, 5), std::make_pair(0, 3));
+  // a permuted layout_stride, where no dimension order matches the indices
+  using stride_mapping = stdex::layout_stride::mapping<stdex::dextents<3>>;
+  stdex::mdspan<int64_t, stdex::dextents<3>, stdex::layout_stride> permuted(
+    values.data(), stride_mapping(stdex::dextents<3>(6, 5, 7), stdex::dextents<3>(1, 42, 6)));
+
+  check_every_axis(stdex::execution::seq, right);
+  check_every_axis(stdex::execution::par, right);
+  check_every_axis(stdex::execution::seq, left);
+  check_every_axis(stdex::execution::par, left);
+  check_every_axis(stdex::execution::par, sub_right);
+  check_every_axis(stdex::execution::seq, sub_left);
+  check_every_axis(stdex::execution::par, permuted);
+
+  using tiled = stdex::layout_tiled<2, 4, 4>;
+  auto tiled_map = tiled::mapping<stdex::dextents<3>>(stdex::dextents<3>(5, 6, 7));
+  std::vector<int64_t> tiled_values(tiled_map.required_span_size(), 1000000);
+  stdex::mdspan<int64_t, stdex::dextents<3>, tiled> t(tiled_values.data(), tiled_map);
+  for(size_t i = 0; i < 5; ++i)
+    for(size_t j = 0; j < 6; ++j)
+      for(size_t k = 0; k < 7; ++k)
+        t(i, j, k) = right(i, j, k);
+  check_every_axis(stdex::execution::par, t);
+}
+
+TEST(TestReduceAxis, custom_op_and_degenerate_extents) {
+  std::vector<double> values = { 3, -1, 4, -1, 5, -9, 2, 6 };
+  stdex::mdspan<double, stdex::extents<2, 4>> m(values.data());
+  auto largest = stdex::reduce_axis<0>(stdex::execution::par, m, [](double a, double b) { return a < b ? b : a; });
+  ASSERT_EQ(largest(0), 5.0);
+  ASSERT_EQ(largest(1), -1.0);
+  ASSERT_EQ(largest(2), 4.0);
+  ASSERT_EQ(largest(3), 6.0);
+
+  // rank 1 reduces to rank 0
+  stdex::mdspan<double, stdex::dextents<1>> v(values.data(), values.size());
+  ASSERT_EQ(stdex::reduce_axis<0>(v)(), 9.0);
+
+  // an extent of 1 along the axis copies, one of 0 leaves zeros
+  stdex::mdspan<double, stdex::extents<dyn, 1, dyn>> one(values.data(), 2, 4);
+  auto copied = stdex::reduce_axis<1>(stdex::execution::par, one);
+  ASSERT_EQ(copied(1, 2), values[6]);
+  stdex::mdspan<double, stdex::dextents<2>> empty(values.data(), 3, 0);
+  auto zeros = stdex::reduce_axis<1>(empty);
+  ASSERT_EQ(zeros.extent(0), 3);
+  ASSERT_EQ(zeros(2), 0.0);
+  ASSERT_EQ(stdex::reduce_axis<0>(empty).extent(0), 0);
+}
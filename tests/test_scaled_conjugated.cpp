@@ -0,0 +1,112 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/linalg>
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+TEST(TestScaledAccessor, scaled) {
+  std::vector<double> buffer = {1, 2, 3, 4, 5, 6};
+  stdex::mdspan<double, stdex::extents<2, 3>> A(buffer.data());
+  auto sA = stdex::scaled(2.0, A);
+  static_assert(std::is_same<decltype(sA)::element_type, double const>::value, "");
+  static_assert(std::is_same<decltype(sA)::reference, double>::value, "");
+  ASSERT_EQ(sA.data(), A.data());
+  ASSERT_EQ(sA(1, 2), 12);
+  // scaling by an int promotes to the type of the product
+  auto iA = stdex::scaled(3, A);
+  static_assert(std::is_same<decltype(iA)::value_type, double>::value, "");
+  ASSERT_EQ(iA(0, 1), 6);
+  // nested scaling
+  ASSERT_EQ(stdex::scaled(0.5, sA)(1, 0), 4);
+}
+
+TEST(TestScaledAccessor, submdspan_of_scaled) {
+  std::vector<double> buffer(20);
+  for(size_t i = 0; i < buffer.size(); ++i) buffer[i] = double(i);
+  stdex::mdspan<double, stdex::extents<dyn, dyn>, stdex::layout_left> A(buffer.data(), 4, 5);
+  auto sA = stdex::scaled(-1.0, A);
+  auto column = stdex::submdspan(sA, stdex::full_extent, 3);
+  auto row = stdex::submdspan(sA, 2, stdex::full_extent);
+  ASSERT_EQ(column.extent(0), 4);
+  ASSERT_EQ(row.extent(0), 5);
+  for(size_t i = 0; i < 4; ++i) ASSERT_EQ(column(i), -A(i, 3));
+  for(size_t j = 0; j < 5; ++j) ASSERT_EQ(row(j), -A(2, j));
+  ASSERT_EQ(row.accessor().scaling_factor(), -1.0);
+}
+
+TEST(TestConjugatedAccessor, conjugated) {
+  using complex_type = std::complex<double>;
+  std::vector<complex_type> buffer = {{1, 2}, {3, -4}, {5, 6}, {-7, 8}};
+  stdex::mdspan<complex_type, stdex::extents<2, 2>> A(buffer.data());
+  auto cA = stdex::conjugated(A);
+  static_assert(std::is_same<decltype(cA)::accessor_type,
+    stdex::conjugated_accessor<stdex::default_accessor<complex_type>>>::value, "");
+  ASSERT_EQ(cA(0, 0), complex_type(1, -2));
+  ASSERT_EQ(cA(1, 1), complex_type(-7, -8));
+  // conjugating twice gives back the original view
+  auto ccA = stdex::conjugated(cA);
+  static_assert(std::is_same<decltype(ccA), decltype(A)>::value, "");
+  ASSERT_EQ(ccA.data(), A.data());
+  // submdspan keeps the conjugation
+  auto row = stdex::submdspan(cA, 0, stdex::full_extent);
+  ASSERT_EQ(row(1), complex_type(3, 4));
+  // alpha * A^H composes from the two
+  auto scA = stdex::scaled(complex_type(0, 1), cA);
+  ASSERT_EQ(scA(0, 1), complex_type(-4, 3));
+}
+
+TEST(TestConjugatedAccessor, conjugated_real_is_identity) {
+  std::vector<float> buffer = {1, 2, 3};
+  stdex::mdspan<float const, stdex::extents<3>> x(buffer.data());
+  auto cx = stdex::conjugated(x);
+  static_assert(std::is_same<decltype(cx), decltype(x)>::value, "");
+  ASSERT_EQ(cx(2), 3.0f);
+}
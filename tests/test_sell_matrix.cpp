@@ -0,0 +1,146 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace stdex = std::experimental;
+
+namespace {
+
+// 5x6 matrix with rows of length 2, 0, 4, 1, 3
+struct small_csr {
+  std::vector<size_t> row_ptr = {0, 2, 2, 6, 7, 10};
+  std::vector<int> col_idx = {0, 3,   0, 1, 2, 5,   4,   1, 2, 3};
+  std::vector<double> values = {1, 2,   3, 4, 5, 6,   7,   8, 9, 10};
+
+  double dense(size_t i, size_t j) const {
+    for(size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+      if(size_t(col_idx[k]) == j) return values[k];
+    }
+    return 0;
+  }
+
+  template <size_t C>
+  stdex::sell_matrix<double, C> to_sell(size_t sigma) const {
+    return stdex::sell_matrix<double, C>(6,
+      stdex::mdspan<size_t const, stdex::dextents<1>>(row_ptr.data(), row_ptr.size()),
+      stdex::mdspan<int const, stdex::dextents<1>>(col_idx.data(), col_idx.size()),
+      stdex::mdspan<double const, stdex::dextents<1>>(values.data(), values.size()),
+      sigma
+    );
+  }
+};
+
+} // end anonymous namespace
+
+TEST(TestSellMatrix, chunk_structure_without_sorting) {
+  small_csr csr;
+  auto A = csr.to_sell<2>(1);
+  ASSERT_EQ(A.num_rows(), 5);
+  ASSERT_EQ(A.num_chunks(), 3);
+  auto map = A.mapping();
+  ASSERT_EQ(map.chunk_width(0), 2);
+  ASSERT_EQ(map.chunk_width(1), 4);
+  ASSERT_EQ(map.chunk_width(2), 3);
+  ASSERT_EQ(A.num_stored(), 2 * (2 + 4 + 3));
+  ASSERT_EQ(map.required_span_size(), A.num_stored());
+  // the k-th entries of the rows of a chunk are adjacent
+  ASSERT_EQ(map(1, 0), map(0, 0) + 1);
+  ASSERT_EQ(map(0, 1), map(0, 0) + 2);
+}
+
+TEST(TestSellMatrix, values_and_column_indices) {
+  small_csr csr;
+  for(size_t sigma : {1, 2, 5}) {
+    auto A = csr.to_sell<2>(sigma);
+    auto vals = A.values();
+    auto cols = A.column_indices();
+    auto perm = A.row_permutation();
+    for(size_t slot = 0; slot < perm.extent(0); ++slot) {
+      size_t row = size_t(perm(slot));
+      if(row >= A.num_rows()) continue;
+      size_t len = csr.row_ptr[row + 1] - csr.row_ptr[row];
+      for(size_t k = 0; k < len; ++k) {
+        ASSERT_EQ(vals(slot, k), csr.values[csr.row_ptr[row] + k]);
+        ASSERT_EQ(cols(slot, k), csr.col_idx[csr.row_ptr[row] + k]);
+      }
+      for(size_t k = len; k < A.mapping().chunk_width(slot / 2); ++k) {
+        ASSERT_EQ(vals(slot, k), 0);
+      }
+    }
+  }
+}
+
+TEST(TestSellMatrix, sorting_reduces_padding) {
+  small_csr csr;
+  ASSERT_LT(csr.to_sell<2>(5).num_stored(), csr.to_sell<2>(1).num_stored());
+}
+
+template <size_t C>
+void check_spmv(small_csr const& csr, size_t sigma) {
+  auto A = csr.to_sell<C>(sigma);
+  std::vector<double> x = {1, -2, 3, -4, 5, -6};
+  std::vector<double> y(5, 42);
+  stdex::sparse_matrix_vector_product(A,
+    stdex::mdspan<double, stdex::dextents<1>>(x.data(), x.size()),
+    stdex::mdspan<double, stdex::dextents<1>>(y.data(), y.size())
+  );
+  for(size_t i = 0; i < 5; ++i) {
+    double expected = 0;
+    for(size_t j = 0; j < 6; ++j) expected += csr.dense(i, j) * x[j];
+    ASSERT_EQ(y[i], expected);
+  }
+}
+
+TEST(TestSellMatrix, spmv_matches_dense) {
+  small_csr csr;
+  check_spmv<1>(csr, 1);
+  check_spmv<2>(csr, 1);
+  check_spmv<2>(csr, 4);
+  check_spmv<4>(csr, 5);
+  check_spmv<8>(csr, 8);
+}
@@ -0,0 +1,166 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#if defined(_MDSPAN_HAS_MMAP)
+
+#include <unistd.h>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+namespace {
+
+std::string segment_name(char const* tag) {
+  return std::string("/mdspan_test_") + tag + "_" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(TestSharedMdarray, consumer_sees_producer_elements) {
+  auto name = segment_name("basic");
+  using extents_type = stdex::extents<dyn, 4, dyn>;
+  stdex::shared_mdarray<float, extents_type> producer(name.c_str(), stdex::layout_right::mapping<extents_type>(extents_type(3, 5)));
+  ASSERT_TRUE(producer.is_owner());
+  ASSERT_EQ(producer.size(), 60);
+  auto p = producer.view();
+  for(size_t i = 0; i < 3; ++i)
+    for(size_t j = 0; j < 4; ++j)
+      for(size_t k = 0; k < 5; ++k)
+        p(i, j, k) = float(100 * i + 10 * j + k);
+
+  stdex::shared_mdarray<float const, extents_type> consumer(name.c_str());
+  ASSERT_FALSE(consumer.is_owner());
+  ASSERT_EQ(consumer.extents(), producer.extents());
+  auto c = consumer.view();
+  ASSERT_EQ(c(2, 3, 4), 234.0f);
+  ASSERT_EQ(c(1, 0, 2), 102.0f);
+  // later stores are visible without copying
+  p(0, 0, 0) = -1.0f;
+  ASSERT_EQ(c(0, 0, 0), -1.0f);
+}
+
+TEST(TestSharedMdarray, layout_left_and_layout_stride) {
+  auto name = segment_name("layouts");
+  using extents_type = stdex::dextents<2>;
+  {
+    stdex::shared_mdarray<int, extents_type, stdex::layout_left> producer(name.c_str(), stdex::layout_left::mapping<extents_type>(extents_type(3, 2)));
+    producer.view()(2, 1) = 7;
+    stdex::shared_mdarray<int const, extents_type, stdex::layout_left> consumer(name.c_str());
+    ASSERT_EQ(consumer.mapping(), producer.mapping());
+    ASSERT_EQ(consumer.data()[5], 7);
+    ASSERT_THROW((stdex::shared_mdarray<int const, extents_type>(name.c_str())), std::runtime_error);
+  }
+  {
+    // every other column of a 3 x 8 row-major block
+    auto m = stdex::layout_stride::mapping<extents_type>(extents_type(3, 4), stdex::dextents<2>(8, 2));
+    stdex::shared_mdarray<int, extents_type, stdex::layout_stride> producer(name.c_str(), m);
+    producer.view()(1, 3) = 11;
+    stdex::shared_mdarray<int const, extents_type, stdex::layout_stride> consumer(name.c_str());
+    ASSERT_EQ(consumer.mapping().stride(0), 8);
+    ASSERT_EQ(consumer.mapping().stride(1), 2);
+    ASSERT_EQ(consumer.view()(1, 3), 11);
+  }
+}
+
+TEST(TestSharedMdarray, header_mismatch_throws) {
+  auto name = segment_name("mismatch");
+  using extents_type = stdex::extents<4, 6>;
+  stdex::shared_mdarray<double, extents_type> producer(name.c_str(), stdex::layout_right::mapping<extents_type>());
+  ASSERT_THROW((stdex::shared_mdarray<float const, extents_type>(name.c_str())), std::runtime_error);
+  ASSERT_THROW((stdex::shared_mdarray<double const, stdex::extents<4, 5>>(name.c_str())), std::runtime_error);
+  ASSERT_THROW((stdex::shared_mdarray<double const, stdex::dextents<3>>(name.c_str())), std::runtime_error);
+  stdex::shared_mdarray<double const, stdex::dextents<2>> consumer(name.c_str());
+  ASSERT_EQ(consumer.extents().extent(1), 6);
+}
+
+TEST(TestSharedMdarray, owner_removes_name) {
+  auto name = segment_name("unlink");
+  using extents_type = stdex::dextents<1>;
+  {
+    stdex::shared_mdarray<int, extents_type> producer(name.c_str(), stdex::layout_right::mapping<extents_type>(extents_type(16)));
+    stdex::shared_mdarray<int const, extents_type> consumer(name.c_str());
+    ASSERT_EQ(consumer.size(), 16);
+  }
+  ASSERT_THROW((stdex::shared_mdarray<int const, extents_type>(name.c_str())), std::system_error);
+}
+
+TEST(TestSharedMdarray, publish_and_wait_for_update) {
+  auto name = segment_name("publish");
+  using extents_type = stdex::dextents<1>;
+  stdex::shared_mdarray<int, extents_type> producer(name.c_str(), stdex::layout_right::mapping<extents_type>(extents_type(1024)));
+  stdex::shared_mdarray<int const, extents_type> consumer(name.c_str());
+  ASSERT_EQ(consumer.generation(), 0);
+
+  constexpr int frames = 50;
+  std::atomic<int> acked(0);
+  std::thread writer([&] {
+    auto v = producer.view();
+    for(int f = 1; f <= frames; ++f) {
+      for(size_t i = 0; i < v.extent(0); ++i) v(i) = f;
+      producer.publish();
+      while(acked.load() != f) std::this_thread::yield();
+    }
+  });
+  uint64_t seen = 0;
+  for(int f = 1; f <= frames; ++f) {
+    seen = consumer.wait_for_update(seen);
+    EXPECT_EQ(seen, uint64_t(f));
+    auto v = consumer.view();
+    EXPECT_EQ(v(0), f);
+    EXPECT_EQ(v(1023), f);
+    acked.store(f);
+  }
+  writer.join();
+}
+
+#endif // _MDSPAN_HAS_MMAP
@@ -0,0 +1,163 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace stdex = std::experimental;
+_MDSPAN_INLINE_VARIABLE constexpr auto dyn = stdex::dynamic_extent;
+
+#if defined(_MDSPAN_HAS_PREAD)
+
+namespace {
+
+using extents_type = stdex::extents<dyn, 3, 5>;
+
+std::string temp_path(char const* name) {
+  return testing::TempDir() + "mdspan_test_" + name + ".raw";
+}
+
+// Writes `header_bytes` of padding followed by rows * 3 * 5 consecutive
+// integers
+void write_file(std::string const& path, size_t rows, size_t header_bytes) {
+  std::vector<char> header(header_bytes, 'x');
+  std::vector<int> data(rows * 15);
+  for(size_t i = 0; i < data.size(); ++i) data[i] = int(i);
+  std::FILE* f = std::fopen(path.c_str(), "wb");
+  std::fwrite(header.data(), 1, header.size(), f);
+  std::fwrite(data.data(), sizeof(int), data.size(), f);
+  std::fclose(f);
+}
+
+void test_all_slabs(stdex::slab_reader_options const& options, size_t header_bytes) {
+  auto path = temp_path("slab_reader");
+  size_t rows = 23;
+  write_file(path, rows, header_bytes);
+  stdex::slab_reader<int, extents_type> reader(path.c_str(), extents_type(rows), 4, options);
+  ASSERT_EQ(reader.num_slabs(), 6);
+  ASSERT_NE(reader.backend(), stdex::slab_io_backend::automatic);
+  for(int pass = 0; pass < 2; ++pass) {
+    size_t expected_first = 0;
+    reader.for_each_slab([&](stdex::mdspan<int const, extents_type> slab, size_t first) {
+      ASSERT_EQ(first, expected_first);
+      ASSERT_EQ(slab.extent(0), first + 4 <= rows ? 4 : rows - first);
+      ASSERT_EQ(reinterpret_cast<uintptr_t>(slab.data()) % alignof(int), 0);
+      for(size_t i = 0; i < slab.extent(0); ++i) {
+        for(size_t j = 0; j < 3; ++j) {
+          for(size_t k = 0; k < 5; ++k) {
+            ASSERT_EQ(slab(i, j, k), int(((first + i) * 3 + j) * 5 + k));
+          }
+        }
+      }
+      expected_first += slab.extent(0);
+    });
+    ASSERT_EQ(expected_first, rows);
+  }
+  std::remove(path.c_str());
+}
+
+} // end anonymous namespace
+
+TEST(TestSlabReader, io_uring_or_fallback) {
+  stdex::slab_reader_options options;
+  options.backend = stdex::slab_io_backend::io_uring;
+  test_all_slabs(options, 0);
+  options.num_buffers = 3;
+  options.file_offset = 12;
+  test_all_slabs(options, 12);
+}
+
+TEST(TestSlabReader, threads) {
+  stdex::slab_reader_options options;
+  options.backend = stdex::slab_io_backend::threads;
+  test_all_slabs(options, 0);
+  options.num_buffers = 1;
+  options.file_offset = 8;
+  test_all_slabs(options, 8);
+}
+
+TEST(TestSlabReader, direct_io_with_unaligned_offset) {
+  stdex::slab_reader_options options;
+  options.direct_io = true;
+  options.file_offset = 100;
+  test_all_slabs(options, 100);
+  options.backend = stdex::slab_io_backend::threads;
+  test_all_slabs(options, 100);
+}
+
+TEST(TestSlabReader, callback_exception_stops_the_pipeline) {
+  auto path = temp_path("slab_reader_exception");
+  write_file(path, 40, 0);
+  for(auto backend : {stdex::slab_io_backend::automatic, stdex::slab_io_backend::threads}) {
+    stdex::slab_reader_options options;
+    options.backend = backend;
+    options.num_buffers = 4;
+    stdex::slab_reader<int, extents_type> reader(path.c_str(), extents_type(40), 2, options);
+    size_t calls = 0;
+    ASSERT_THROW(reader.for_each_slab([&](stdex::mdspan<int const, extents_type>, size_t) {
+      if(++calls == 3) throw std::runtime_error("stop");
+    }), std::runtime_error);
+    // the reader can be used again
+    calls = 0;
+    reader.for_each_slab([&](stdex::mdspan<int const, extents_type>, size_t) { ++calls; });
+    ASSERT_EQ(calls, 20);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(TestSlabReader, file_too_small) {
+  auto path = temp_path("slab_reader_small");
+  write_file(path, 3, 0);
+  ASSERT_THROW((stdex::slab_reader<int, extents_type>(path.c_str(), extents_type(4), 2)), std::system_error);
+  std::remove(path.c_str());
+  ASSERT_THROW((stdex::slab_reader<int, extents_type>(path.c_str(), extents_type(4), 2)), std::system_error);
+}
+
+#endif // defined(_MDSPAN_HAS_PREAD)
@@ -0,0 +1,198 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+namespace {
+
+struct heat_kernel {
+  template <class S>
+  double operator()(S const& s) const {
+    return 0.4 * s(0, 0, 0) + 0.1 * (s(-1, 0, 0) + s(1, 0, 0) + s(0, -1, 0) + s(0, 1, 0) + s(0, 0, -1) + s(0, 0, 1));
+  }
+};
+
+// asymmetric, so that mixing up the dimensions shows
+struct box_kernel {
+  template <class S>
+  double operator()(S const& s) const {
+    double sum = 0;
+    for(int d0 = -1; d0 <= 1; ++d0)
+      for(int d1 = -1; d1 <= 1; ++d1)
+        for(int d2 = -1; d2 <= 1; ++d2)
+          sum += double(1 + (d0 + 1) + 3 * (d1 + 1) + 9 * (d2 + 1)) * s(d0, d1, d2);
+    return sum / 378.0;
+  }
+};
+
+struct star2_kernel {
+  template <class S>
+  double operator()(S const& s) const {
+    return 0.5 * s(0, 0, 0) + 0.05 * (s(-2, 0, 0) + s(2, 0, 0) + s(0, -2, 0) + s(0, 2, 0))
+      + 0.025 * (s(0, 0, -2) + s(0, 0, 2) + s(-1, 0, 0) + s(0, 1, 0));
+  }
+};
+
+// s(d0, d1, d2) over a layout_right grid, as a kernel sees it
+struct reference_neighborhood {
+  double operator()(ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2) const {
+    return grid(size_t(ptrdiff_t(i) + d0), size_t(ptrdiff_t(j) + d1), size_t(ptrdiff_t(k) + d2));
+  }
+  stdex::mdspan<double const, stdex::dextents<3>> grid;
+  size_t i, j, k;
+};
+
+template <class Kernel>
+std::vector<double> reference_steps(std::vector<double> u, size_t n0, size_t n1, size_t n2,
+  size_t radius, size_t time_steps, Kernel const& kernel)
+{
+  std::vector<double> next(u);
+  for(size_t t = 0; t < time_steps; ++t) {
+    stdex::mdspan<double const, stdex::dextents<3>> grid(u.data(), n0, n1, n2);
+    for(size_t i = radius; i + radius < n0; ++i)
+      for(size_t j = radius; j + radius < n1; ++j)
+        for(size_t k = radius; k + radius < n2; ++k)
+          next[(i * n1 + j) * n2 + k] = kernel(reference_neighborhood{grid, i, j, k});
+    u = next;
+  }
+  return u;
+}
+
+std::vector<double> initial_grid(size_t n0, size_t n1, size_t n2) {
+  std::vector<double> u(n0 * n1 * n2);
+  for(size_t i = 0; i < u.size(); ++i) u[i] = double((i * 37) % 101) / 7.0;
+  return u;
+}
+
+template <class Layout, class Policy, class Kernel>
+void check_stencil(Policy policy, size_t n0, size_t n1, size_t n2, size_t radius, size_t time_steps,
+  Kernel const& kernel, stdex::stencil_tiling tiling = { })
+{
+  auto u = initial_grid(n0, n1, n2);
+  auto expected = reference_steps(u, n0, n1, n2, radius, time_steps, kernel);
+  std::vector<double> in_data(u.size()), out_data(u.size(), -1.0);
+  stdex::mdspan<double, stdex::dextents<3>, Layout> in(in_data.data(), n0, n1, n2), out(out_data.data(), n0, n1, n2);
+  for(size_t i = 0; i < n0; ++i)
+    for(size_t j = 0; j < n1; ++j)
+      for(size_t k = 0; k < n2; ++k) in(i, j, k) = u[(i * n1 + j) * n2 + k];
+
+  stdex::apply_stencil(policy, in, out, radius, time_steps, kernel, tiling);
+  for(size_t i = 0; i < n0; ++i)
+    for(size_t j = 0; j < n1; ++j)
+      for(size_t k = 0; k < n2; ++k)
+        ASSERT_EQ(out(i, j, k), expected[(i * n1 + j) * n2 + k]) << "at " << i << ", " << j << ", " << k;
+}
+
+} // namespace
+
+TEST(TestStencil, matches_step_by_step_sweeps) {
+  for(size_t steps : {0, 1, 2, 3, 5}) {
+    check_stencil<stdex::layout_right>(stdex::execution::seq, 13, 17, 11, 1, steps, heat_kernel());
+    check_stencil<stdex::layout_left>(stdex::execution::seq, 13, 17, 11, 1, steps, heat_kernel());
+    check_stencil<stdex::layout_right>(stdex::execution::seq, 9, 12, 14, 1, steps, box_kernel());
+    check_stencil<stdex::layout_left>(stdex::execution::seq, 9, 12, 14, 1, steps, box_kernel());
+    check_stencil<stdex::layout_right>(stdex::execution::seq, 12, 10, 15, 2, steps, star2_kernel());
+  }
+}
+
+TEST(TestStencil, overlapping_tiles) {
+  // tiles much smaller than the halo, and ragged edge tiles
+  for(size_t steps : {1, 2, 4}) {
+    for(auto tiling : {stdex::stencil_tiling{1, 1}, stdex::stencil_tiling{3, 4}, stdex::stencil_tiling{5, 0}}) {
+      check_stencil<stdex::layout_right>(stdex::execution::seq, 11, 13, 17, 1, steps, heat_kernel(), tiling);
+      check_stencil<stdex::layout_left>(stdex::execution::par, 11, 13, 17, 1, steps, box_kernel(), tiling);
+      check_stencil<stdex::layout_right>(stdex::execution::par, 11, 13, 17, 2, steps, star2_kernel(), tiling);
+    }
+  }
+  check_stencil<stdex::layout_right>(stdex::execution::par, 30, 40, 50, 1, 3, heat_kernel());
+}
+
+TEST(TestStencil, thin_grids_and_pointwise_kernels) {
+  // extents of at most 2 * radius leave every point on the boundary
+  check_stencil<stdex::layout_right>(stdex::execution::seq, 2, 9, 9, 1, 3, heat_kernel());
+  check_stencil<stdex::layout_left>(stdex::execution::seq, 9, 9, 2, 1, 3, heat_kernel());
+  check_stencil<stdex::layout_right>(stdex::execution::seq, 3, 3, 3, 1, 2, box_kernel());
+  check_stencil<stdex::layout_right>(stdex::execution::seq, 4, 9, 9, 2, 2, star2_kernel());
+  check_stencil<stdex::layout_right>(stdex::execution::seq, 1, 1, 1, 1, 2, heat_kernel());
+  auto twice = [](auto const& s) { return 2.0 * s(0, 0, 0); };
+  check_stencil<stdex::layout_right>(stdex::execution::par, 5, 6, 7, 0, 3, twice, stdex::stencil_tiling{2, 3});
+}
+
+TEST(TestStencil, strided_and_converting_operands) {
+  // the odd elements of a layout_right grid in, a float grid out
+  size_t n0 = 10, n1 = 11, n2 = 12;
+  auto u = initial_grid(n0, n1, n2);
+  auto expected = reference_steps(u, n0, n1, n2, 1, 3, heat_kernel());
+  std::vector<double> in_data(2 * u.size());
+  stdex::mdspan<double, stdex::extents<stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent, 2>> pairs(
+    in_data.data(), n0, n1, n2);
+  auto in = stdex::submdspan(pairs, stdex::full_extent, stdex::full_extent, stdex::full_extent, 1);
+  for(size_t i = 0; i < n0; ++i)
+    for(size_t j = 0; j < n1; ++j)
+      for(size_t k = 0; k < n2; ++k) in(i, j, k) = u[(i * n1 + j) * n2 + k];
+  std::vector<float> out_data(u.size());
+  stdex::mdspan<float, stdex::dextents<3>> out(out_data.data(), n0, n1, n2);
+  stdex::apply_stencil(in, out, 1, 3, [](auto const& s) {
+    return 0.4f * s(0, 0, 0) + 0.1f * (s(-1, 0, 0) + s(1, 0, 0) + s(0, -1, 0) + s(0, 1, 0) + s(0, 0, -1) + s(0, 0, 1));
+  });
+  for(size_t i = 0; i < out_data.size(); ++i) ASSERT_NEAR(out_data[i], expected[i], 1e-4) << "at " << i;
+
+  // and into the even elements of another one
+  std::vector<double> out_pairs_data(2 * u.size(), -1.0);
+  stdex::mdspan<double, stdex::extents<stdex::dynamic_extent, stdex::dynamic_extent, stdex::dynamic_extent, 2>> out_pairs(
+    out_pairs_data.data(), n0, n1, n2);
+  stdex::apply_stencil(stdex::execution::par, in,
+    stdex::submdspan(out_pairs, stdex::full_extent, stdex::full_extent, stdex::full_extent, 0), 1, 3, heat_kernel(),
+    stdex::stencil_tiling{4, 5});
+  for(size_t i = 0; i < u.size(); ++i) {
+    ASSERT_EQ(out_pairs_data[2 * i], expected[i]) << "at " << i;
+    ASSERT_EQ(out_pairs_data[2 * i + 1], -1.0);
+  }
+}
@@ -0,0 +1,164 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2019) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <experimental/mdspan_ext>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace stdex = std::experimental;
+
+namespace {
+
+template <class Tile>
+constexpr bool has_static_extents() {
+  return Tile::rank_dynamic() == 0;
+}
+
+} // end anonymous namespace
+
+TEST(TestTiles, test_tiles_visit_every_element_once) {
+  std::vector<int> buffer(10 * 7, 0);
+  stdex::mdspan<int, stdex::dextents<2>> a(buffer.data(), 10, 7);
+  auto tr = stdex::tiles(a, stdex::tile_extents<4, 3>{});
+  ASSERT_EQ(tr.extent(0), 3);
+  ASSERT_EQ(tr.extent(1), 3);
+  ASSERT_EQ(tr.size(), 9);
+
+  size_t num_full = 0, num_partial = 0;
+  tr.for_each([&](auto t, std::array<size_t, 2> origin) {
+    using tile_type = decltype(t);
+    EXPECT_EQ(origin[0] % 4, 0);
+    EXPECT_EQ(origin[1] % 3, 0);
+    if(has_static_extents<tile_type>()) {
+      EXPECT_EQ(tile_type::static_extent(0), 4);
+      EXPECT_EQ(tile_type::static_extent(1), 3);
+      EXPECT_TRUE(origin[0] + 4 <= 10 && origin[1] + 3 <= 7);
+      ++num_full;
+    } else {
+      EXPECT_TRUE(origin[0] + 4 > 10 || origin[1] + 3 > 7);
+      EXPECT_EQ(t.extent(0), std::min<size_t>(4, 10 - origin[0]));
+      EXPECT_EQ(t.extent(1), std::min<size_t>(3, 7 - origin[1]));
+      ++num_partial;
+    }
+    for(size_t i = 0; i < t.extent(0); ++i) {
+      for(size_t j = 0; j < t.extent(1); ++j) {
+        EXPECT_EQ(&t(i, j), &a(origin[0] + i, origin[1] + j));
+        ++t(i, j);
+      }
+    }
+  });
+  EXPECT_EQ(num_full, 4);
+  EXPECT_EQ(num_partial, 5);
+  for(int v : buffer) EXPECT_EQ(v, 1);
+}
+
+TEST(TestTiles, test_tiles_order_follows_layout) {
+  std::vector<int> buffer(5 * 4);
+  std::vector<std::array<size_t, 2>> right_origins, left_origins;
+  stdex::mdspan<int, stdex::dextents<2>> a_right(buffer.data(), 5, 4);
+  stdex::tiles(a_right, stdex::tile_extents<2, 2>{}).for_each([&](auto, std::array<size_t, 2> o) {
+    right_origins.push_back(o);
+  });
+  stdex::mdspan<int, stdex::dextents<2>, stdex::layout_left> a_left(buffer.data(), 5, 4);
+  stdex::tiles(a_left, stdex::tile_extents<2, 2>{}).for_each([&](auto, std::array<size_t, 2> o) {
+    left_origins.push_back(o);
+  });
+  std::vector<std::array<size_t, 2>> expected_right = {
+    {{0, 0}}, {{0, 2}}, {{2, 0}}, {{2, 2}}, {{4, 0}}, {{4, 2}}
+  };
+  std::vector<std::array<size_t, 2>> expected_left = {
+    {{0, 0}}, {{2, 0}}, {{4, 0}}, {{0, 2}}, {{2, 2}}, {{4, 2}}
+  };
+  EXPECT_EQ(right_origins, expected_right);
+  EXPECT_EQ(left_origins, expected_left);
+
+  // a column-major layout_stride view is visited like layout_left
+  std::vector<std::array<size_t, 2>> stride_origins;
+  using map_type = stdex::layout_stride::mapping<stdex::dextents<2>>;
+  stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride> a_stride(
+    buffer.data(), map_type(stdex::dextents<2>(5, 4), stdex::dextents<2>(1, 5))
+  );
+  stdex::tiles(a_stride, stdex::tile_extents<2, 2>{}).for_each([&](auto, std::array<size_t, 2> o) {
+    stride_origins.push_back(o);
+  });
+  EXPECT_EQ(stride_origins, expected_left);
+}
+
+TEST(TestTiles, test_tiles_strided_parent) {
+  // every other column of a 6 x 10 layout_right array
+  std::vector<int> buffer(6 * 10, 0);
+  using map_type = stdex::layout_stride::mapping<stdex::dextents<2>>;
+  stdex::mdspan<int, stdex::dextents<2>, stdex::layout_stride> a(
+    buffer.data(), map_type(stdex::dextents<2>(6, 5), stdex::dextents<2>(10, 2))
+  );
+  stdex::tiles(a, stdex::tile_extents<4, 2>{}).for_each([&](auto t, std::array<size_t, 2> o) {
+    for(size_t i = 0; i < t.extent(0); ++i) {
+      for(size_t j = 0; j < t.extent(1); ++j) {
+        t(i, j) = int(10 * (o[0] + i) + 2 * (o[1] + j)) + 1;
+      }
+    }
+  });
+  for(size_t i = 0; i < 6; ++i) {
+    for(size_t j = 0; j < 10; ++j) {
+      EXPECT_EQ(buffer[10 * i + j], j % 2 == 0 ? int(10 * i + j) + 1 : 0);
+    }
+  }
+}
+
+TEST(TestTiles, test_tiles_par_3d) {
+  std::vector<int> buffer(9 * 8 * 11, 0);
+  stdex::mdspan<int, stdex::extents<9, stdex::dynamic_extent, 11>> a(buffer.data(), 8);
+  auto tr = stdex::tiles(a, stdex::tile_extents<4, 4, 4>{});
+  ASSERT_EQ(tr.size(), 3 * 2 * 3);
+  tr.for_each(stdex::execution::par, [](auto t, std::array<size_t, 3>) {
+    for(size_t i = 0; i < t.extent(0); ++i)
+      for(size_t j = 0; j < t.extent(1); ++j)
+        for(size_t k = 0; k < t.extent(2); ++k)
+          ++t(i, j, k);
+  });
+  for(int v : buffer) EXPECT_EQ(v, 1);
+}